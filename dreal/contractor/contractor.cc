@@ -17,11 +17,17 @@
 
 #include <algorithm>
 #include <atomic>
+#include <stdexcept>
 #include <utility>
 
+#include "dreal/contractor/contractor_acid.h"
+#include "dreal/contractor/contractor_adaptive_fixpoint.h"
 #include "dreal/contractor/contractor_cell.h"
+#include "dreal/contractor/contractor_cid.h"
 #include "dreal/contractor/contractor_fixpoint.h"
 #include "dreal/contractor/contractor_forall.h"
+#include "dreal/contractor/contractor_hc4.h"
+#include "dreal/contractor/contractor_hc4_dag.h"
 #include "dreal/contractor/contractor_ibex_fwdbwd.h"
 #include "dreal/contractor/contractor_ibex_fwdbwd_mt.h"
 #include "dreal/contractor/contractor_ibex_polytope.h"
@@ -29,8 +35,12 @@
 #include "dreal/contractor/contractor_id.h"
 #include "dreal/contractor/contractor_integer.h"
 #include "dreal/contractor/contractor_join.h"
+#include "dreal/contractor/contractor_linear.h"
+#include "dreal/contractor/contractor_newton.h"
 #include "dreal/contractor/contractor_seq.h"
+#include "dreal/contractor/contractor_shaving.h"
 #include "dreal/contractor/contractor_worklist_fixpoint.h"
+#include "dreal/util/logging.h"
 #include "dreal/util/stat.h"
 
 using std::any_of;
@@ -138,6 +148,18 @@ Contractor make_contractor_seq(const vector<Contractor>& contractors,
 
 Contractor make_contractor_ibex_fwdbwd(Formula f, const Box& box,
                                        const Config& config) {
+  if (config.use_native_hc4()) {
+    // A ContractorHc4 keeps an immutable tape shared by all the
+    // threads. We only fall back to IBEX if ExpressionTape does not
+    // support f. Note that the choice does not depend on the number of
+    // jobs, so that the pruning does not either.
+    try {
+      return make_contractor_hc4(f, box, config);
+    } catch (const std::runtime_error& e) {
+      DREAL_LOG_DEBUG("make_contractor_ibex_fwdbwd: Use IBEX for {} ({})",
+                      f.to_string(), e.what());
+    }
+  }
   if (config.number_of_jobs() > 1) {
     const auto ctc =
         make_shared<ContractorIbexFwdbwdMt>(std::move(f), box, config);
@@ -157,6 +179,46 @@ Contractor make_contractor_ibex_fwdbwd(Formula f, const Box& box,
   }
 }  // namespace dreal
 
+Contractor make_contractor_hc4(Formula f, const Box& box,
+                               const Config& config) {
+  const auto ctc = make_shared<ContractorHc4>(std::move(f), box, config);
+  if (ctc->is_dummy()) {
+    return make_contractor_id(config);
+  } else {
+    return Contractor{ctc};
+  }
+}
+
+Contractor make_contractor_hc4_dag(const vector<Formula>& formulas,
+                                   const Box& box, const Config& config) {
+  const auto ctc = make_shared<ContractorHc4Dag>(formulas, box, config);
+  if (ctc->is_dummy()) {
+    return make_contractor_id(config);
+  } else {
+    return Contractor{ctc};
+  }
+}
+
+Contractor make_contractor_linear(const vector<Formula>& formulas,
+                                  const Box& box, const Config& config) {
+  const auto ctc = make_shared<ContractorLinear>(formulas, box, config);
+  if (ctc->is_dummy()) {
+    return make_contractor_id(config);
+  } else {
+    return Contractor{ctc};
+  }
+}
+
+Contractor make_contractor_newton(const vector<Formula>& formulas,
+                                  const Box& box, const Config& config) {
+  const auto ctc = make_shared<ContractorNewton>(formulas, box, config);
+  if (ctc->is_dummy()) {
+    return make_contractor_id(config);
+  } else {
+    return Contractor{ctc};
+  }
+}
+
 Contractor make_contractor_ibex_polytope(vector<Formula> formulas,
                                          const Box& box, const Config& config) {
   if (config.number_of_jobs() > 1) {
@@ -189,6 +251,18 @@ Contractor make_contractor_fixpoint(TerminationCondition term_cond,
   }
 }
 
+Contractor make_contractor_adaptive_fixpoint(
+    TerminationCondition term_cond, const vector<Contractor>& contractors,
+    const Config& config) {
+  vector<Contractor> ctcs{Flatten(contractors)};
+  if (ctcs.empty()) {
+    return make_contractor_id(config);
+  } else {
+    return Contractor{make_shared<ContractorAdaptiveFixpoint>(
+        std::move(term_cond), std::move(ctcs), config)};
+  }
+}
+
 Contractor make_contractor_worklist_fixpoint(
     TerminationCondition term_cond, const vector<Contractor>& contractors,
     const Config& config) {
@@ -217,6 +291,33 @@ Contractor make_contractor_join(vector<Contractor> vec, const Config& config) {
   return Contractor{make_shared<ContractorJoin>(std::move(vec), config)};
 }
 
+Contractor make_contractor_shaving(Contractor contractor, const int num_slices,
+                                   const Config& config) {
+  if (is_id(contractor)) {
+    return contractor;
+  }
+  return Contractor{make_shared<ContractorShaving>(std::move(contractor),
+                                                   num_slices, config)};
+}
+
+Contractor make_contractor_cid(Contractor contractor, const int num_slices,
+                               const Config& config) {
+  if (is_id(contractor)) {
+    return contractor;
+  }
+  return Contractor{
+      make_shared<ContractorCid>(std::move(contractor), num_slices, config)};
+}
+
+Contractor make_contractor_acid(Contractor contractor, const int num_slices,
+                                const Config& config) {
+  if (is_id(contractor)) {
+    return contractor;
+  }
+  return Contractor{
+      make_shared<ContractorAcid>(std::move(contractor), num_slices, config)};
+}
+
 ostream& operator<<(ostream& os, const Contractor& ctc) {
   if (ctc.ptr_) {
     os << *(ctc.ptr_);
@@ -236,12 +337,27 @@ bool is_seq(const Contractor& contractor) {
 bool is_ibex_fwdbwd(const Contractor& contractor) {
   return contractor.kind() == Contractor::Kind::IBEX_FWDBWD;
 }
+bool is_hc4(const Contractor& contractor) {
+  return contractor.kind() == Contractor::Kind::HC4;
+}
+bool is_hc4_dag(const Contractor& contractor) {
+  return contractor.kind() == Contractor::Kind::HC4_DAG;
+}
+bool is_linear(const Contractor& contractor) {
+  return contractor.kind() == Contractor::Kind::LINEAR;
+}
+bool is_newton(const Contractor& contractor) {
+  return contractor.kind() == Contractor::Kind::NEWTON;
+}
 bool is_ibex_polytope(const Contractor& contractor) {
   return contractor.kind() == Contractor::Kind::IBEX_POLYTOPE;
 }
 bool is_fixpoint(const Contractor& contractor) {
   return contractor.kind() == Contractor::Kind::FIXPOINT;
 }
+bool is_adaptive_fixpoint(const Contractor& contractor) {
+  return contractor.kind() == Contractor::Kind::ADAPTIVE_FIXPOINT;
+}
 bool is_worklist_fixpoint(const Contractor& contractor) {
   return contractor.kind() == Contractor::Kind::WORKLIST_FIXPOINT;
 }
@@ -251,6 +367,15 @@ bool is_worklist_approx_fixpoint(const Contractor& contractor) {
 bool is_forall(const Contractor& contractor) {
   return contractor.kind() == Contractor::Kind::FORALL;
 }
+bool is_shaving(const Contractor& contractor) {
+  return contractor.kind() == Contractor::Kind::SHAVING;
+}
+bool is_cid(const Contractor& contractor) {
+  return contractor.kind() == Contractor::Kind::CID;
+}
+bool is_acid(const Contractor& contractor) {
+  return contractor.kind() == Contractor::Kind::ACID;
+}
 bool is_join(const Contractor& contractor) {
   return contractor.kind() == Contractor::Kind::JOIN;
 }
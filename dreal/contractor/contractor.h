@@ -31,11 +31,19 @@ class ContractorId;
 class ContractorInteger;
 class ContractorSeq;
 class ContractorIbexFwdbwd;
+class ContractorHc4;
+class ContractorHc4Dag;
+class ContractorLinear;
+class ContractorNewton;
 class ContractorIbexPolytope;
 class ContractorFixpoint;
+class ContractorAdaptiveFixpoint;
 class ContractorWorklistFixpoint;
 class ContractorWorklistApproxFixpoint;
 class ContractorJoin;
+class ContractorShaving;
+class ContractorCid;
+class ContractorAcid;
 template <typename ContextType>
 class ContractorForall;
 
@@ -69,12 +77,20 @@ class Contractor {
     INTEGER,
     SEQ,
     IBEX_FWDBWD,
+    HC4,
+    HC4_DAG,
+    LINEAR,
+    NEWTON,
     IBEX_POLYTOPE,
     FIXPOINT,
+    ADAPTIVE_FIXPOINT,
     WORKLIST_FIXPOINT,
     WORKLIST_APPROX_FIXPOINT,
     FORALL,
     JOIN,
+    SHAVING,
+    CID,
+    ACID,
   };
 
   explicit Contractor(const Config& config);
@@ -124,12 +140,26 @@ class Contractor {
       const std::vector<Contractor>& contractors, const Config& config);
   friend Contractor make_contractor_ibex_fwdbwd(Formula f, const Box& box,
                                                 const Config& config);
+  friend Contractor make_contractor_hc4(Formula f, const Box& box,
+                                        const Config& config);
+  friend Contractor make_contractor_hc4_dag(
+      const std::vector<Formula>& formulas, const Box& box,
+      const Config& config);
+  friend Contractor make_contractor_linear(
+      const std::vector<Formula>& formulas, const Box& box,
+      const Config& config);
+  friend Contractor make_contractor_newton(
+      const std::vector<Formula>& formulas, const Box& box,
+      const Config& config);
   friend Contractor make_contractor_ibex_polytope(std::vector<Formula> formulas,
                                                   const Box& box,
                                                   const Config& config);
   friend Contractor make_contractor_fixpoint(
       TerminationCondition term_cond,
       const std::vector<Contractor>& contractors, const Config& config);
+  friend Contractor make_contractor_adaptive_fixpoint(
+      TerminationCondition term_cond,
+      const std::vector<Contractor>& contractors, const Config& config);
   friend Contractor make_contractor_worklist_fixpoint(
       TerminationCondition term_cond,
       const std::vector<Contractor>& contractors, const Config& config);
@@ -142,6 +172,13 @@ class Contractor {
                                            const Config& config);
   friend Contractor make_contractor_join(std::vector<Contractor> vec,
                                          const Config& config);
+  friend Contractor make_contractor_shaving(Contractor contractor,
+                                            int num_slices,
+                                            const Config& config);
+  friend Contractor make_contractor_cid(Contractor contractor, int num_slices,
+                                        const Config& config);
+  friend Contractor make_contractor_acid(Contractor contractor, int num_slices,
+                                         const Config& config);
 
   // Note that the following converter functions are only for
   // low-level operations. To use them, you need to include
@@ -152,15 +189,28 @@ class Contractor {
   friend std::shared_ptr<ContractorSeq> to_seq(const Contractor& contractor);
   friend std::shared_ptr<ContractorIbexFwdbwd> to_ibex_fwdbwd(
       const Contractor& contractor);
+  friend std::shared_ptr<ContractorHc4> to_hc4(const Contractor& contractor);
+  friend std::shared_ptr<ContractorHc4Dag> to_hc4_dag(
+      const Contractor& contractor);
+  friend std::shared_ptr<ContractorLinear> to_linear(
+      const Contractor& contractor);
+  friend std::shared_ptr<ContractorNewton> to_newton(
+      const Contractor& contractor);
   friend std::shared_ptr<ContractorIbexPolytope> to_ibex_polytope(
       const Contractor& contractor);
   friend std::shared_ptr<ContractorFixpoint> to_fixpoint(
       const Contractor& contractor);
+  friend std::shared_ptr<ContractorAdaptiveFixpoint> to_adaptive_fixpoint(
+      const Contractor& contractor);
   friend std::shared_ptr<ContractorWorklistFixpoint> to_worklist_fixpoint(
       const Contractor& contractor);
   friend std::shared_ptr<ContractorWorklistApproxFixpoint>
   to_worklist_approx_fixpoint(const Contractor& contractor);
   friend std::shared_ptr<ContractorJoin> to_join(const Contractor& contractor);
+  friend std::shared_ptr<ContractorShaving> to_shaving(
+      const Contractor& contractor);
+  friend std::shared_ptr<ContractorCid> to_cid(const Contractor& contractor);
+  friend std::shared_ptr<ContractorAcid> to_acid(const Contractor& contractor);
   template <typename ContextType>
   friend std::shared_ptr<ContractorForall<ContextType>> to_forall(
       const Contractor& contractor);
@@ -188,16 +238,55 @@ Contractor make_contractor_seq(const std::vector<Contractor>& contractors,
                                const Config& config);
 
 /// Returns a contractor wrapping IBEX's forward/backward contractor.
-/// If the number of jobs (in @p config) > 1, it creates a
-/// multi-threaded version of the contractor, which is based on
-/// ContractorIbexFwdbwdMt. Otherwise, it creates an instance of
-/// ContractorIbexFwdbwd.
+/// If Config::use_native_hc4() is set (in @p config), it creates a
+/// ContractorHc4 instead, which is immutable and shared by all the
+/// jobs. Otherwise, or if @p f is not supported by ContractorHc4, it
+/// creates a multi-threaded version of the contractor, which is based
+/// on ContractorIbexFwdbwdMt, if the number of jobs > 1, and an
+/// instance of ContractorIbexFwdbwd if not. ContractorIbexFwdbwdMt
+/// compiles @p f once and only keeps IBEX's scratch space per thread.
 ///
 /// @see ContractorIbexFwdbwd.
 /// @see ContractorIbexFwdbwdMt.
+/// @see ContractorHc4.
 Contractor make_contractor_ibex_fwdbwd(Formula f, const Box& box,
                                        const Config& config);
 
+/// Returns a forward/backward contractor which runs HC4Revise over a
+/// native expression tape (see ExpressionTape). Unlike
+/// ContractorIbexFwdbwd, the returned contractor is thread-safe and it
+/// is shared by all the jobs.
+///
+/// @see ContractorHc4.
+Contractor make_contractor_hc4(Formula f, const Box& box,
+                               const Config& config);
+
+/// Returns an HC4 contractor which compiles all of @p formulas into a
+/// single expression DAG. A sub-expression shared by multiple formulas
+/// is evaluated only once per pruning step. Like make_contractor_hc4,
+/// the returned contractor is thread-safe.
+///
+/// @see ContractorHc4Dag.
+Contractor make_contractor_hc4_dag(const std::vector<Formula>& formulas,
+                                   const Box& box, const Config& config);
+
+/// Returns a bound-propagation contractor for the linear constraints
+/// in @p formulas. The constraints are stored in a sparse matrix and
+/// a change of a variable only revisits the constraints which include
+/// it. The returned contractor is thread-safe.
+///
+/// @see ContractorLinear.
+Contractor make_contractor_linear(const std::vector<Formula>& formulas,
+                                  const Box& box, const Config& config);
+
+/// Returns an interval Newton contractor for the square system of
+/// equalities in @p formulas. It only prunes a box whose relevant
+/// domains are narrower than `config.newton_threshold()`.
+///
+/// @see ContractorNewton.
+Contractor make_contractor_newton(const std::vector<Formula>& formulas,
+                                  const Box& box, const Config& config);
+
 /// Returns a contractor wrapping IBEX's polytope contractor.  If then
 /// number of jobs (in @p config) > 1, it creates a multi-threaded version of
 /// the contractor, which is based on ContractorIbexPolytopeMt. Otherwise, it
@@ -216,6 +305,17 @@ Contractor make_contractor_fixpoint(TerminationCondition term_cond,
                                     const std::vector<Contractor>& contractors,
                                     const Config& config);
 
+/// Returns an adaptive fixed-point contractor. Like
+/// make_contractor_fixpoint, the returned contractor applies the
+/// contractors in @p vec until @p term_cond is met. It reorders the
+/// contractors by their observed pruning gain and cost, and defers
+/// the ones with low gain to the last sweep.
+///
+/// @see ContractorAdaptiveFixpoint.
+Contractor make_contractor_adaptive_fixpoint(
+    TerminationCondition term_cond, const std::vector<Contractor>& contractors,
+    const Config& config);
+
 /// Returns a worklist fixed-point contractor. The returned contractor
 /// applies the contractors in @p vec sequentially until @p term_cond
 /// is met.
@@ -244,6 +344,29 @@ Contractor make_contractor_worklist_approx_fixpoint(
 Contractor make_contractor_join(std::vector<Contractor> vec,
                                 const Config& config);
 
+/// Returns a 3B (shaving) contractor which refutes the slices at the
+/// ends of each domain with @p contractor. Each domain is cut into @p
+/// num_slices slices.
+///
+/// @see ContractorShaving.
+Contractor make_contractor_shaving(Contractor contractor, int num_slices,
+                                   const Config& config);
+
+/// Returns a CID (constructive interval disjunction) contractor which
+/// prunes the slices of each domain with @p contractor and takes the
+/// hull of the results. Each domain is cut into @p num_slices slices.
+///
+/// @see ContractorCid.
+Contractor make_contractor_cid(Contractor contractor, int num_slices,
+                               const Config& config);
+
+/// Returns an adaptive CID contractor which tunes the number of
+/// variables to handle online.
+///
+/// @see ContractorAcid.
+Contractor make_contractor_acid(Contractor contractor, int num_slices,
+                                const Config& config);
+
 /// Returns a forall contractor.
 ///
 /// @note the implementation is at `dreal/contractor/contractor_forall.h` file.
@@ -266,12 +389,27 @@ bool is_seq(const Contractor& contractor);
 /// Returns true if @p contractor is IBEX fwdbwd contractor.
 bool is_ibex_fwdbwd(const Contractor& contractor);
 
+/// Returns true if @p contractor is HC4 contractor.
+bool is_hc4(const Contractor& contractor);
+
+/// Returns true if @p contractor is HC4 DAG contractor.
+bool is_hc4_dag(const Contractor& contractor);
+
+/// Returns true if @p contractor is linear contractor.
+bool is_linear(const Contractor& contractor);
+
+/// Returns true if @p contractor is interval Newton contractor.
+bool is_newton(const Contractor& contractor);
+
 /// Returns true if @p contractor is IBEX polytope contractor.
 bool is_ibex_polytope(const Contractor& contractor);
 
 /// Returns true if @p contractor is fixpoint contractor.
 bool is_fixpoint(const Contractor& contractor);
 
+/// Returns true if @p contractor is adaptive-fixpoint contractor.
+bool is_adaptive_fixpoint(const Contractor& contractor);
+
 /// Returns true if @p contractor is worklist-fixpoint contractor.
 bool is_worklist_fixpoint(const Contractor& contractor);
 
@@ -284,4 +422,13 @@ bool is_forall(const Contractor& contractor);
 /// Returns true if @p contractor is join contractor.
 bool is_join(const Contractor& contractor);
 
+/// Returns true if @p contractor is 3B (shaving) contractor.
+bool is_shaving(const Contractor& contractor);
+
+/// Returns true if @p contractor is CID contractor.
+bool is_cid(const Contractor& contractor);
+
+/// Returns true if @p contractor is ACID contractor.
+bool is_acid(const Contractor& contractor);
+
 }  // namespace dreal
@@ -0,0 +1,167 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/contractor/contractor_acid.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "dreal/contractor/contractor_cid.h"
+#include "dreal/contractor/contractor_shaving.h"
+#include "dreal/util/assert.h"
+#include "dreal/util/logging.h"
+#include "dreal/util/stat.h"
+#include "dreal/util/timer.h"
+
+using std::cout;
+using std::memory_order_relaxed;
+using std::ostream;
+using std::stable_sort;
+using std::vector;
+
+namespace dreal {
+
+namespace {
+class ContractorAcidStat : public Stat {
+ public:
+  explicit ContractorAcidStat(const bool enabled) : Stat{enabled} {};
+  ContractorAcidStat(const ContractorAcidStat&) = delete;
+  ContractorAcidStat(ContractorAcidStat&&) = delete;
+  ContractorAcidStat& operator=(const ContractorAcidStat&) = delete;
+  ContractorAcidStat& operator=(ContractorAcidStat&&) = delete;
+  ~ContractorAcidStat() override {
+    if (enabled()) {
+      using fmt::print;
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of ACID Pruning",
+            "Pruning level", num_pruning_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of ACID Var-CID Calls", "Pruning level",
+            num_var_cid_calls_);
+      if (num_pruning_) {
+        print(cout, "{:<45} @ {:<20} = {:>15f} sec\n",
+              "Total time spent in ACID Pruning", "Pruning level",
+              timer_pruning_.seconds());
+      }
+    }
+  }
+
+  int num_pruning_{0};
+  int num_var_cid_calls_{0};
+
+  Timer timer_pruning_;
+};
+
+// Returns the average relative width reduction from @p old_box to @p
+// box over the dimensions set in @p dims whose widths are finite and
+// positive in @p old_box.
+double ComputeGain(const Box& old_box, const Box& box,
+                   const DynamicBitset& dims) {
+  double sum{0.0};
+  int n{0};
+  for (DynamicBitset::size_type i = 0; i < dims.size(); ++i) {
+    const double old_width{old_box[i].diam()};
+    if (!dims[i] || old_box[i].is_unbounded() || old_width <= 0.0) {
+      continue;
+    }
+    sum += 1.0 - box[i].diam() / old_width;
+    ++n;
+  }
+  return n == 0 ? 0.0 : sum / n;
+}
+}  // namespace
+
+constexpr int ContractorAcid::kLearningPeriod;
+constexpr double ContractorAcid::kMinGain;
+
+ContractorAcid::ContractorAcid(Contractor contractor, const int num_slices,
+                               const Config& config)
+    : ContractorCell{Contractor::Kind::ACID, contractor.input(), config},
+      contractor_{std::move(contractor)},
+      num_slices_{num_slices},
+      num_vars_{static_cast<int>(input().count())} {
+  DREAL_ASSERT(num_slices_ >= 2);
+  if (contractor_.include_forall()) {
+    set_include_forall();
+  }
+}
+
+void ContractorAcid::Prune(ContractorStatus* cs) const {
+  thread_local ContractorAcidStat stat{DREAL_LOG_INFO_ENABLED};
+  TimerGuard timer_guard(&stat.timer_pruning_, stat.enabled());
+  if (stat.enabled()) {
+    stat.num_pruning_++;
+  }
+  contractor_.Prune(cs);
+  if (cs->box().empty()) {
+    return;
+  }
+  const vector<int> order{ComputeOrder(cs->box())};
+  const bool learning{
+      num_calls_.fetch_add(1, memory_order_relaxed) % kLearningPeriod == 0};
+  const int n{learning ? static_cast<int>(order.size())
+                       : std::min(num_vars_.load(memory_order_relaxed),
+                                  static_cast<int>(order.size()))};
+  // The number of variables up to the last useful var-CID call.
+  int num_useful{0};
+  for (int k = 0; k < n; ++k) {
+    const int i{order[k]};
+    // A previous var-CID call may have made the domain too small.
+    if (!IsShavable(cs->box()[i], config().precision())) {
+      continue;
+    }
+    const Box old_box{cs->box()};
+    if (stat.enabled()) {
+      stat.num_var_cid_calls_++;
+    }
+    if (!PruneVarCid(contractor_, i, num_slices_, cs)) {
+      DREAL_LOG_DEBUG("ContractorAcid::Prune: {} is refuted.",
+                      cs->box().variable(i));
+      return;
+    }
+    if (learning && ComputeGain(old_box, cs->box(), input()) > kMinGain) {
+      num_useful = k + 1;
+    }
+  }
+  if (learning) {
+    const int old_num_vars{num_vars_.load(memory_order_relaxed)};
+    num_vars_.store((old_num_vars + num_useful + 1) / 2, memory_order_relaxed);
+    DREAL_LOG_DEBUG("ContractorAcid::Prune: # of variables {} -> {}",
+                    old_num_vars, num_vars_.load(memory_order_relaxed));
+  }
+}
+
+vector<int> ContractorAcid::ComputeOrder(const Box& box) const {
+  vector<int> order;
+  const DynamicBitset& in{input()};
+  for (DynamicBitset::size_type i = 0; i < in.size(); ++i) {
+    if (in[i] && IsShavable(box[i], config().precision())) {
+      order.push_back(i);
+    }
+  }
+  stable_sort(order.begin(), order.end(), [&box](const int a, const int b) {
+    return box[a].diam() > box[b].diam();
+  });
+  return order;
+}
+
+int ContractorAcid::num_vars() const {
+  return num_vars_.load(memory_order_relaxed);
+}
+
+ostream& ContractorAcid::display(ostream& os) const {
+  return os << "ACID(" << contractor_ << ", " << num_slices_ << ")";
+}
+
+}  // namespace dreal
@@ -0,0 +1,90 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <atomic>
+#include <ostream>
+#include <vector>
+
+#include "dreal/contractor/contractor.h"
+#include "dreal/contractor/contractor_cell.h"
+
+namespace dreal {
+
+/// Adaptive CID (ACID) contractor built on top of a contractor C.
+///
+/// It works like ContractorCid but applies var-CID (PruneVarCid) only
+/// to the first k variables, sorted in descending order of their
+/// widths. The number k is tuned online: every kLearningPeriod calls,
+/// it applies var-CID to all the variables and records the position
+/// of the last variable whose var-CID reduces the box by more than
+/// kMinGain. Then k is updated to the average of its previous value
+/// and the recorded one.
+///
+/// The counters are shared by all threads and updated without
+/// synchronization other than relaxed atomic operations. Therefore,
+/// with multiple threads, the value of k depends on timing.
+class ContractorAcid : public ContractorCell {
+ public:
+  /// Every this many calls, it learns the number of variables to
+  /// handle by applying var-CID to all of them.
+  static constexpr int kLearningPeriod{50};
+
+  /// The minimum gain, the average relative width reduction of the
+  /// input variables, of a var-CID call to be considered useful.
+  static constexpr double kMinGain{0.01};
+
+  /// Deletes default constructor.
+  ContractorAcid() = delete;
+
+  /// Constructs an ACID contractor which uses @p contractor on the
+  /// slices. Each domain is cut into @p num_slices slices.
+  ContractorAcid(Contractor contractor, int num_slices, const Config& config);
+
+  /// Deleted copy constructor.
+  ContractorAcid(const ContractorAcid&) = delete;
+
+  /// Deleted move constructor.
+  ContractorAcid(ContractorAcid&&) = delete;
+
+  /// Deleted copy assign operator.
+  ContractorAcid& operator=(const ContractorAcid&) = delete;
+
+  /// Deleted move assign operator.
+  ContractorAcid& operator=(ContractorAcid&&) = delete;
+
+  /// Default destructor.
+  ~ContractorAcid() override = default;
+
+  void Prune(ContractorStatus* cs) const override;
+  std::ostream& display(std::ostream& os) const override;
+
+  /// Returns the current number of variables to which it applies
+  /// var-CID outside of the learning calls.
+  int num_vars() const;
+
+ private:
+  // Returns the shavable input variables in descending order of their
+  // widths in @p box.
+  std::vector<int> ComputeOrder(const Box& box) const;
+
+  const Contractor contractor_;
+  const int num_slices_;
+  mutable std::atomic<int> num_vars_;
+  mutable std::atomic<int> num_calls_{0};
+};
+
+}  // namespace dreal
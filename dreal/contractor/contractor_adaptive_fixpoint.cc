@@ -0,0 +1,232 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/contractor/contractor_adaptive_fixpoint.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+#include "dreal/util/assert.h"
+#include "dreal/util/exception.h"
+#include "dreal/util/interrupt.h"
+#include "dreal/util/logging.h"
+#include "dreal/util/stat.h"
+
+using std::cout;
+using std::memory_order_relaxed;
+using std::ostream;
+using std::size_t;
+using std::vector;
+
+namespace dreal {
+
+namespace {
+class ContractorAdaptiveFixpointStat : public Stat {
+ public:
+  explicit ContractorAdaptiveFixpointStat(const bool enabled)
+      : Stat{enabled} {};
+  ContractorAdaptiveFixpointStat(const ContractorAdaptiveFixpointStat&) =
+      delete;
+  ContractorAdaptiveFixpointStat(ContractorAdaptiveFixpointStat&&) = delete;
+  ContractorAdaptiveFixpointStat& operator=(
+      const ContractorAdaptiveFixpointStat&) = delete;
+  ContractorAdaptiveFixpointStat& operator=(ContractorAdaptiveFixpointStat&&) =
+      delete;
+  ~ContractorAdaptiveFixpointStat() override {
+    if (enabled()) {
+      using fmt::print;
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of Adaptive Fixpoint Calls", "Pruning level",
+            num_calls_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of Adaptive Fixpoint Calls (skipped)", "Pruning level",
+            num_skipped_calls_);
+    }
+  }
+
+  int num_calls_{0};
+  int num_skipped_calls_{0};
+};
+}  // namespace
+
+constexpr double ContractorAdaptiveFixpoint::kSkipThreshold;
+
+ContractorAdaptiveFixpoint::ContractorAdaptiveFixpoint(
+    TerminationCondition term_cond, vector<Contractor> contractors,
+    const Config& config)
+    : ContractorCell{Contractor::Kind::ADAPTIVE_FIXPOINT,
+                     DynamicBitset(ComputeInputSize(contractors)), config},
+      term_cond_{std::move(term_cond)},
+      contractors_{std::move(contractors)},
+      decay_{config.adaptive_fixpoint_decay()},
+      scores_(contractors_.size()) {
+  DREAL_ASSERT(!contractors_.empty());
+  DREAL_ASSERT(0.0 < decay_ && decay_ < 1.0);
+  DynamicBitset& input{mutable_input()};
+  input_sizes_.reserve(contractors_.size());
+  for (const Contractor& c : contractors_) {
+    input |= c.input();
+    if (c.include_forall()) {
+      set_include_forall();
+    }
+    input_sizes_.push_back(std::max<double>(1.0, c.input().count()));
+  }
+}
+
+vector<size_t> ContractorAdaptiveFixpoint::ComputeOrder() const {
+  vector<double> keys(contractors_.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const double cost{scores_[i].cost.load(memory_order_relaxed)};
+    keys[i] = scores_[i].gain.load(memory_order_relaxed) /
+              std::max(cost, std::numeric_limits<double>::min());
+  }
+  vector<size_t> order(contractors_.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&keys](const size_t i, const size_t j) {
+                     return keys[i] > keys[j];
+                   });
+  return order;
+}
+
+bool ContractorAdaptiveFixpoint::Apply(const size_t i,
+                                       ContractorStatus* const cs,
+                                       DynamicBitset* const output) const {
+  cs->mutable_output().reset();
+  const auto start = std::chrono::steady_clock::now();
+  contractors_[i].Prune(cs);
+  const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() -
+                                              start};
+  const DynamicBitset& changed{cs->output()};
+  *output |= changed;
+
+  const bool empty{cs->box().empty()};
+  double gain{0.0};
+  if (empty) {
+    gain = 1.0;
+  } else {
+    cs->UpdateChangeMagnitudes();
+    const vector<double>& magnitudes{cs->change_magnitudes()};
+    for (DynamicBitset::size_type k = changed.find_first();
+         k != DynamicBitset::npos; k = changed.find_next(k)) {
+      gain += magnitudes[k];
+    }
+    gain = std::min(1.0, gain / input_sizes_[i]);
+  }
+
+  // The following read-modify-writes are not atomic. A lost update
+  // only affects the scheduling, not the result.
+  Score& score{scores_[i]};
+  score.gain.store(decay_ * score.gain.load(memory_order_relaxed) +
+                       (1.0 - decay_) * gain,
+                   memory_order_relaxed);
+  score.cost.store(decay_ * score.cost.load(memory_order_relaxed) +
+                       (1.0 - decay_) * elapsed.count(),
+                   memory_order_relaxed);
+  return !empty;
+}
+
+void ContractorAdaptiveFixpoint::Run(ContractorStatus* const cs,
+                                     DynamicBitset* const output) const {
+  thread_local ContractorAdaptiveFixpointStat stat{DREAL_LOG_INFO_ENABLED};
+  const Box::IntervalVector& iv{cs->box().interval_vector()};
+  Box::IntervalVector old_iv{iv};
+  cs->ResetChangeMagnitudes();
+  const vector<size_t> order{ComputeOrder()};
+  // skipped[i] means that the i-th contractor is skipped in a sweep
+  // since the last final sweep.
+  DynamicBitset skipped(contractors_.size());
+  while (true) {
+    // Note that 'DREAL_CHECK_INTERRUPT' is only defined in setup.py,
+    // when we build dReal python package.
+#ifdef DREAL_CHECK_INTERRUPT
+    if (g_interrupted) {
+      DREAL_LOG_DEBUG("KeyboardInterrupt(SIGINT) Detected.");
+      throw std::runtime_error("KeyboardInterrupt(SIGINT) Detected.");
+    }
+#endif
+    old_iv = iv;
+    for (const size_t i : order) {
+      if (scores_[i].gain.load(memory_order_relaxed) < kSkipThreshold) {
+        skipped.set(i);
+        if (stat.enabled()) {
+          stat.num_skipped_calls_++;
+        }
+        continue;
+      }
+      if (stat.enabled()) {
+        stat.num_calls_++;
+      }
+      if (!Apply(i, cs, output)) {
+        return;
+      }
+    }
+    if (!term_cond_(old_iv, iv)) {
+      continue;
+    }
+    if (skipped.none()) {
+      return;
+    }
+    // Final sweep: apply the skipped contractors before we stop.
+    old_iv = iv;
+    for (DynamicBitset::size_type i = skipped.find_first();
+         i != DynamicBitset::npos; i = skipped.find_next(i)) {
+      if (stat.enabled()) {
+        stat.num_calls_++;
+      }
+      if (!Apply(i, cs, output)) {
+        return;
+      }
+    }
+    skipped.reset();
+    if (term_cond_(old_iv, iv)) {
+      return;
+    }
+  }
+}
+
+void ContractorAdaptiveFixpoint::Prune(ContractorStatus* cs) const {
+  // Apply() resets the output of `cs` to measure the effect of each
+  // contractor. We accumulate the outputs and restore it at the end.
+  DynamicBitset output{cs->output()};
+  Run(cs, &output);
+  cs->mutable_output() = std::move(output);
+}
+
+ostream& ContractorAdaptiveFixpoint::display(ostream& os) const {
+  os << "AdaptiveFixpoint(";
+  for (const Contractor& c : contractors_) {
+    os << c << ", ";
+  }
+  return os << ")";
+}
+
+const std::vector<Contractor>& ContractorAdaptiveFixpoint::contractors()
+    const {
+  return contractors_;
+}
+
+double ContractorAdaptiveFixpoint::gain(const int i) const {
+  return scores_[i].gain.load(memory_order_relaxed);
+}
+
+double ContractorAdaptiveFixpoint::cost(const int i) const {
+  return scores_[i].cost.load(memory_order_relaxed);
+}
+
+}  // namespace dreal
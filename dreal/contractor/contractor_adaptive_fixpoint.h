@@ -0,0 +1,121 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+#include "dreal/contractor/contractor.h"
+#include "dreal/contractor/contractor_cell.h"
+#include "dreal/util/box.h"
+
+namespace dreal {
+
+/// Adaptive fixpoint contractor. Like ContractorFixpoint, it applies
+/// C₁, ..., Cₙ until it satisfies a given termination condition. In
+/// addition, it keeps an exponentially-decayed score of each Cᵢ:
+///
+///  - gain: the average relative width reduction of the input
+///    dimensions of Cᵢ per call (1.0 if Cᵢ empties the box).
+///  - cost: the average time spent in a call of Cᵢ.
+///
+/// In each call of Prune, the contractors are applied in descending
+/// order of gain / cost. A contractor whose gain drops below
+/// kSkipThreshold is skipped in the sweeps of the fixpoint loop. Before
+/// it stops, however, it applies all the skipped contractors once more
+/// and resumes the loop if they make progress. This way, the scores of
+/// the skipped contractors are kept up to date and the result is as
+/// tight as the one of ContractorFixpoint.
+///
+/// The scores are shared by all threads and updated without
+/// synchronization other than relaxed atomic stores. Therefore, the
+/// order of the contractors depends on timing.
+class ContractorAdaptiveFixpoint : public ContractorCell {
+ public:
+  /// A contractor whose decayed gain is below this value is skipped
+  /// until the final sweep.
+  static constexpr double kSkipThreshold{0.01};
+
+  /// Deletes default constructor.
+  ContractorAdaptiveFixpoint() = delete;
+
+  /// Constructs an adaptive fixpoint contractor with a termination
+  /// condition (Box × Box → Bool) and a sequence of Contractors {C₁,
+  /// ..., Cₙ}. It uses `config.adaptive_fixpoint_decay()` as the decay
+  /// factor of the scores.
+  ContractorAdaptiveFixpoint(TerminationCondition term_cond,
+                             std::vector<Contractor> contractors,
+                             const Config& config);
+
+  /// Deleted copy constructor.
+  ContractorAdaptiveFixpoint(const ContractorAdaptiveFixpoint&) = delete;
+
+  /// Deleted move constructor.
+  ContractorAdaptiveFixpoint(ContractorAdaptiveFixpoint&&) = delete;
+
+  /// Deleted copy assign operator.
+  ContractorAdaptiveFixpoint& operator=(const ContractorAdaptiveFixpoint&) =
+      delete;
+
+  /// Deleted move assign operator.
+  ContractorAdaptiveFixpoint& operator=(ContractorAdaptiveFixpoint&&) = delete;
+
+  /// Default destructor.
+  ~ContractorAdaptiveFixpoint() override = default;
+
+  void Prune(ContractorStatus* cs) const override;
+  std::ostream& display(std::ostream& os) const override;
+
+  const std::vector<Contractor>& contractors() const;
+
+  /// Returns the current decayed gain of the i-th contractor.
+  double gain(int i) const;
+
+  /// Returns the current decayed cost (in seconds) of the i-th
+  /// contractor.
+  double cost(int i) const;
+
+ private:
+  struct Score {
+    std::atomic<double> gain{1.0};
+    std::atomic<double> cost{0.0};
+  };
+
+  // Returns the indices of contractors_ sorted in descending order of
+  // gain / cost.
+  std::vector<std::size_t> ComputeOrder() const;
+
+  // Runs the fixpoint loop. The union of the outputs of the
+  // contractors is accumulated in @p output.
+  void Run(ContractorStatus* cs, DynamicBitset* output) const;
+
+  // Applies the i-th contractor to @p cs and updates its score using
+  // the change magnitudes recorded in @p cs. Returns false if the box
+  // becomes empty.
+  bool Apply(std::size_t i, ContractorStatus* cs, DynamicBitset* output) const;
+
+  // Stop the fixed-point iteration if term_cond(old_box, new_box) is true.
+  const TerminationCondition term_cond_;
+  const std::vector<Contractor> contractors_;
+  // input_sizes_[i] = max(1, |contractors_[i].input()|).
+  std::vector<double> input_sizes_;
+  const double decay_;
+  mutable std::vector<Score> scores_;
+};
+
+}  // namespace dreal
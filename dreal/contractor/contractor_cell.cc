@@ -17,14 +17,22 @@
 
 #include <utility>
 
+#include "dreal/contractor/contractor_acid.h"
+#include "dreal/contractor/contractor_adaptive_fixpoint.h"
+#include "dreal/contractor/contractor_cid.h"
 #include "dreal/contractor/contractor_fixpoint.h"
 #include "dreal/contractor/contractor_forall.h"
+#include "dreal/contractor/contractor_hc4.h"
+#include "dreal/contractor/contractor_hc4_dag.h"
 #include "dreal/contractor/contractor_ibex_fwdbwd.h"
 #include "dreal/contractor/contractor_ibex_polytope.h"
 #include "dreal/contractor/contractor_id.h"
 #include "dreal/contractor/contractor_integer.h"
 #include "dreal/contractor/contractor_join.h"
+#include "dreal/contractor/contractor_linear.h"
+#include "dreal/contractor/contractor_newton.h"
 #include "dreal/contractor/contractor_seq.h"
+#include "dreal/contractor/contractor_shaving.h"
 #include "dreal/contractor/contractor_worklist_fixpoint.h"
 #include "dreal/util/assert.h"
 
@@ -83,15 +91,36 @@ shared_ptr<ContractorIbexFwdbwd> to_ibex_fwdbwd(const Contractor& contractor) {
   DREAL_ASSERT(is_ibex_fwdbwd(contractor));
   return static_pointer_cast<ContractorIbexFwdbwd>(contractor.ptr_);
 }
+shared_ptr<ContractorHc4> to_hc4(const Contractor& contractor) {
+  DREAL_ASSERT(is_hc4(contractor));
+  return static_pointer_cast<ContractorHc4>(contractor.ptr_);
+}
+shared_ptr<ContractorHc4Dag> to_hc4_dag(const Contractor& contractor) {
+  DREAL_ASSERT(is_hc4_dag(contractor));
+  return static_pointer_cast<ContractorHc4Dag>(contractor.ptr_);
+}
 shared_ptr<ContractorIbexPolytope> to_ibex_polytope(
     const Contractor& contractor) {
   DREAL_ASSERT(is_ibex_polytope(contractor));
   return static_pointer_cast<ContractorIbexPolytope>(contractor.ptr_);
 }
+shared_ptr<ContractorLinear> to_linear(const Contractor& contractor) {
+  DREAL_ASSERT(is_linear(contractor));
+  return static_pointer_cast<ContractorLinear>(contractor.ptr_);
+}
+shared_ptr<ContractorNewton> to_newton(const Contractor& contractor) {
+  DREAL_ASSERT(is_newton(contractor));
+  return static_pointer_cast<ContractorNewton>(contractor.ptr_);
+}
 shared_ptr<ContractorFixpoint> to_fixpoint(const Contractor& contractor) {
   DREAL_ASSERT(is_fixpoint(contractor));
   return static_pointer_cast<ContractorFixpoint>(contractor.ptr_);
 }
+shared_ptr<ContractorAdaptiveFixpoint> to_adaptive_fixpoint(
+    const Contractor& contractor) {
+  DREAL_ASSERT(is_adaptive_fixpoint(contractor));
+  return static_pointer_cast<ContractorAdaptiveFixpoint>(contractor.ptr_);
+}
 shared_ptr<ContractorWorklistFixpoint> to_worklist_fixpoint(
     const Contractor& contractor) {
   DREAL_ASSERT(is_worklist_fixpoint(contractor));
@@ -106,5 +135,17 @@ shared_ptr<ContractorJoin> to_join(const Contractor& contractor) {
   DREAL_ASSERT(is_join(contractor));
   return static_pointer_cast<ContractorJoin>(contractor.ptr_);
 }
+shared_ptr<ContractorShaving> to_shaving(const Contractor& contractor) {
+  DREAL_ASSERT(is_shaving(contractor));
+  return static_pointer_cast<ContractorShaving>(contractor.ptr_);
+}
+shared_ptr<ContractorCid> to_cid(const Contractor& contractor) {
+  DREAL_ASSERT(is_cid(contractor));
+  return static_pointer_cast<ContractorCid>(contractor.ptr_);
+}
+shared_ptr<ContractorAcid> to_acid(const Contractor& contractor) {
+  DREAL_ASSERT(is_acid(contractor));
+  return static_pointer_cast<ContractorAcid>(contractor.ptr_);
+}
 
 }  // namespace dreal
@@ -33,10 +33,18 @@ class ContractorId;
 class ContractorInteger;
 class ContractorSeq;
 class ContractorIbexFwdbwd;
+class ContractorHc4;
+class ContractorHc4Dag;
+class ContractorLinear;
+class ContractorNewton;
 class ContractorIbexPolytope;
 class ContractorFixpoint;
+class ContractorAdaptiveFixpoint;
 class ContractorWorklistFixpoint;
 class ContractorJoin;
+class ContractorShaving;
+class ContractorCid;
+class ContractorAcid;
 template <typename ContextType>
 class ContractorForall;
 
@@ -116,6 +124,18 @@ std::shared_ptr<ContractorSeq> to_seq(const Contractor& contractor);
 std::shared_ptr<ContractorIbexFwdbwd> to_ibex_fwdbwd(
     const Contractor& contractor);
 
+/// Converts @p contractor to ContractorHc4.
+std::shared_ptr<ContractorHc4> to_hc4(const Contractor& contractor);
+
+/// Converts @p contractor to ContractorHc4Dag.
+std::shared_ptr<ContractorHc4Dag> to_hc4_dag(const Contractor& contractor);
+
+/// Converts @p contractor to ContractorLinear.
+std::shared_ptr<ContractorLinear> to_linear(const Contractor& contractor);
+
+/// Converts @p contractor to ContractorNewton.
+std::shared_ptr<ContractorNewton> to_newton(const Contractor& contractor);
+
 /// Converts @p contractor to ContractorIbexPolytop.
 std::shared_ptr<ContractorIbexPolytope> to_ibex_polytope(
     const Contractor& contractor);
@@ -123,6 +143,10 @@ std::shared_ptr<ContractorIbexPolytope> to_ibex_polytope(
 /// Converts @p contractor to ContractorFixpoint.
 std::shared_ptr<ContractorFixpoint> to_fixpoint(const Contractor& contractor);
 
+/// Converts @p contractor to ContractorAdaptiveFixpoint.
+std::shared_ptr<ContractorAdaptiveFixpoint> to_adaptive_fixpoint(
+    const Contractor& contractor);
+
 /// Converts @p contractor to ContractorWorklistFixpoint.
 std::shared_ptr<ContractorWorklistFixpoint> to_worklist_fixpoint(
     const Contractor& contractor);
@@ -130,6 +154,15 @@ std::shared_ptr<ContractorWorklistFixpoint> to_worklist_fixpoint(
 /// Converts @p contractor to ContractorJoin.
 std::shared_ptr<ContractorJoin> to_join(const Contractor& contractor);
 
+/// Converts @p contractor to ContractorShaving.
+std::shared_ptr<ContractorShaving> to_shaving(const Contractor& contractor);
+
+/// Converts @p contractor to ContractorCid.
+std::shared_ptr<ContractorCid> to_cid(const Contractor& contractor);
+
+/// Converts @p contractor to ContractorAcid.
+std::shared_ptr<ContractorAcid> to_acid(const Contractor& contractor);
+
 /// Converts @p contractor to ContractorForall.
 template <typename ContextType>
 std::shared_ptr<ContractorForall<ContextType>> to_forall(
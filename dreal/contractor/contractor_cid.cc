@@ -0,0 +1,125 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/contractor/contractor_cid.h"
+
+#include <utility>
+
+#include "dreal/contractor/contractor_shaving.h"
+#include "dreal/util/assert.h"
+#include "dreal/util/logging.h"
+#include "dreal/util/stat.h"
+#include "dreal/util/timer.h"
+
+using std::cout;
+using std::ostream;
+
+namespace dreal {
+
+namespace {
+class ContractorCidStat : public Stat {
+ public:
+  explicit ContractorCidStat(const bool enabled) : Stat{enabled} {};
+  ContractorCidStat(const ContractorCidStat&) = delete;
+  ContractorCidStat(ContractorCidStat&&) = delete;
+  ContractorCidStat& operator=(const ContractorCidStat&) = delete;
+  ContractorCidStat& operator=(ContractorCidStat&&) = delete;
+  ~ContractorCidStat() override {
+    if (enabled()) {
+      using fmt::print;
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of CID Pruning",
+            "Pruning level", num_pruning_);
+      if (num_pruning_) {
+        print(cout, "{:<45} @ {:<20} = {:>15f} sec\n",
+              "Total time spent in CID Pruning", "Pruning level",
+              timer_pruning_.seconds());
+      }
+    }
+  }
+
+  int num_pruning_{0};
+
+  Timer timer_pruning_;
+};
+}  // namespace
+
+bool PruneVarCid(const Contractor& contractor, const int i,
+                 const int num_slices, ContractorStatus* const cs) {
+  DREAL_ASSERT(num_slices >= 2);
+  const Box old_box{cs->box()};
+  const Box::Interval& iv{old_box[i]};
+  DREAL_ASSERT(!iv.is_unbounded());
+  const double width{iv.diam() / num_slices};
+  // Joins the results of the slices into an initially empty box.
+  cs->mutable_box().set_empty();
+  for (int k = 0; k < num_slices; ++k) {
+    const double slice_lb{k == 0 ? iv.lb() : iv.lb() + k * width};
+    const double slice_ub{k == num_slices - 1 ? iv.ub()
+                                              : iv.lb() + (k + 1) * width};
+    ContractorStatus slice{old_box};
+    slice.mutable_box()[i] = Box::Interval(slice_lb, slice_ub);
+    contractor.Prune(&slice);
+    cs->InplaceJoin(slice);
+  }
+  const Box& box{cs->box()};
+  if (box.empty()) {
+    cs->mutable_output().set();
+    return false;
+  }
+  for (int j = 0; j < box.size(); ++j) {
+    if (box[j] != old_box[j]) {
+      cs->mutable_output().set(j);
+    }
+  }
+  return true;
+}
+
+ContractorCid::ContractorCid(Contractor contractor, const int num_slices,
+                             const Config& config)
+    : ContractorCell{Contractor::Kind::CID, contractor.input(), config},
+      contractor_{std::move(contractor)},
+      num_slices_{num_slices} {
+  DREAL_ASSERT(num_slices_ >= 2);
+  if (contractor_.include_forall()) {
+    set_include_forall();
+  }
+}
+
+void ContractorCid::Prune(ContractorStatus* cs) const {
+  thread_local ContractorCidStat stat{DREAL_LOG_INFO_ENABLED};
+  TimerGuard timer_guard(&stat.timer_pruning_, stat.enabled());
+  if (stat.enabled()) {
+    stat.num_pruning_++;
+  }
+  contractor_.Prune(cs);
+  const DynamicBitset& in{input()};
+  for (DynamicBitset::size_type i = 0; i < in.size(); ++i) {
+    if (cs->box().empty()) {
+      return;
+    }
+    if (in[i] && IsShavable(cs->box()[i], config().precision()) &&
+        !PruneVarCid(contractor_, i, num_slices_, cs)) {
+      DREAL_LOG_DEBUG("ContractorCid::Prune: {} is refuted.",
+                      cs->box().variable(i));
+      return;
+    }
+  }
+}
+
+ostream& ContractorCid::display(ostream& os) const {
+  return os << "CID(" << contractor_ << ", " << num_slices_ << ")";
+}
+
+}  // namespace dreal
@@ -0,0 +1,77 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <ostream>
+
+#include "dreal/contractor/contractor.h"
+#include "dreal/contractor/contractor_cell.h"
+#include "dreal/contractor/contractor_status.h"
+
+namespace dreal {
+
+/// Constructive interval disjunction (CID) contractor built on top of
+/// a contractor C.
+///
+/// It first applies C. Then, for each input variable x of C, it cuts
+/// the domain of x into `num_slices` slices, applies C to each of the
+/// sub-boxes, and replaces the box with the hull of the results (see
+/// PruneVarCid). Unlike ContractorShaving, this can also tighten the
+/// other variables, for instance when all the slices agree on a
+/// bound of y which C cannot derive from the whole box.
+class ContractorCid : public ContractorCell {
+ public:
+  /// Deletes default constructor.
+  ContractorCid() = delete;
+
+  /// Constructs a CID contractor which uses @p contractor on the
+  /// slices. Each domain is cut into @p num_slices slices.
+  ContractorCid(Contractor contractor, int num_slices, const Config& config);
+
+  /// Deleted copy constructor.
+  ContractorCid(const ContractorCid&) = delete;
+
+  /// Deleted move constructor.
+  ContractorCid(ContractorCid&&) = delete;
+
+  /// Deleted copy assign operator.
+  ContractorCid& operator=(const ContractorCid&) = delete;
+
+  /// Deleted move assign operator.
+  ContractorCid& operator=(ContractorCid&&) = delete;
+
+  /// Default destructor.
+  ~ContractorCid() override = default;
+
+  void Prune(ContractorStatus* cs) const override;
+  std::ostream& display(std::ostream& os) const override;
+
+ private:
+  const Contractor contractor_;
+  const int num_slices_;
+};
+
+/// Applies var-CID on the i-th dimension of the box in @p cs. It cuts
+/// `box[i]` into @p num_slices slices of the same width, prunes each
+/// of them with @p contractor, and updates the box with the hull of
+/// the results. The used constraints of all the slices are added to
+/// @p cs. Returns false if all the slices are refuted.
+///
+/// @pre `box[i]` is bounded.
+bool PruneVarCid(const Contractor& contractor, int i, int num_slices,
+                 ContractorStatus* cs);
+
+}  // namespace dreal
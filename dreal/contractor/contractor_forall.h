@@ -19,6 +19,7 @@
 #include <memory>
 #include <ostream>
 #include <stdexcept>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -96,6 +97,11 @@ class ContractorForall : public ContractorCell {
         inner_delta;
     context_for_counterexample_.mutable_config().mutable_use_polytope() =
         config.use_polytope_in_forall();
+    // Only the outermost context saves and restores checkpoints.
+    context_for_counterexample_.mutable_config().mutable_checkpoint() =
+        std::string{};
+    context_for_counterexample_.mutable_config().mutable_resume() =
+        std::string{};
     contractor_ = GenericContractorGenerator{}.Generate(
         get_quantified_formula(f_), ExtendBox(box, quantified_variables_),
         context_for_counterexample_.config());
@@ -0,0 +1,166 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/contractor/contractor_hc4.h"
+
+#include <utility>
+#include <vector>
+
+#include "dreal/util/assert.h"
+#include "dreal/util/exception.h"
+#include "dreal/util/logging.h"
+#include "dreal/util/stat.h"
+#include "dreal/util/timer.h"
+
+using std::cout;
+using std::make_unique;
+using std::ostream;
+using std::vector;
+
+namespace dreal {
+
+namespace {
+class ContractorHc4Stat : public Stat {
+ public:
+  explicit ContractorHc4Stat(const bool enabled) : Stat{enabled} {};
+  ContractorHc4Stat(const ContractorHc4Stat&) = delete;
+  ContractorHc4Stat(ContractorHc4Stat&&) = delete;
+  ContractorHc4Stat& operator=(const ContractorHc4Stat&) = delete;
+  ContractorHc4Stat& operator=(ContractorHc4Stat&&) = delete;
+  ~ContractorHc4Stat() override {
+    if (enabled()) {
+      using fmt::print;
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of HC4 Pruning",
+            "Pruning level", num_pruning_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of HC4 Pruning (zero-effect)", "Pruning level",
+            num_zero_effect_pruning_);
+      if (num_pruning_) {
+        print(cout, "{:<45} @ {:<20} = {:>15f} sec\n",
+              "Total time spent in HC4 Pruning", "Pruning level",
+              timer_pruning_.seconds());
+      }
+      print(cout, "{:<45} @ {:<20} = {:>15f} sec\n",
+            "Total time spent in making HC4 tapes", "Pruning level",
+            timer_make_tape_.seconds());
+    }
+  }
+
+  int num_zero_effect_pruning_{0};
+  int num_pruning_{0};
+
+  Timer timer_pruning_;
+  Timer timer_make_tape_;
+};
+
+// Finds an expression `e` and an interval `range` such that @p f (if
+// @p polarity is true) or ¬@p f (otherwise) is equivalent to `e ∈
+// range`.
+bool ExtractConstraint(const Formula& f, const bool polarity,
+                       Expression* const e, Box::Interval* const range) {
+  switch (f.get_kind()) {
+    case FormulaKind::True:
+      return false;
+    case FormulaKind::Eq:
+    case FormulaKind::Neq:
+      if (polarity != (f.get_kind() == FormulaKind::Eq)) {
+        return false;
+      }
+      *range = Box::Interval::ZERO;
+      break;
+    case FormulaKind::Gt:
+    case FormulaKind::Geq:
+      *range = polarity ? Box::Interval::POS_REALS : Box::Interval::NEG_REALS;
+      break;
+    case FormulaKind::Lt:
+    case FormulaKind::Leq:
+      *range = polarity ? Box::Interval::NEG_REALS : Box::Interval::POS_REALS;
+      break;
+    case FormulaKind::Not:
+      return ExtractConstraint(get_operand(f), !polarity, e, range);
+    default:
+      throw DREAL_RUNTIME_ERROR("ContractorHc4: {} is not supported.",
+                                f.to_string());
+  }
+  *e = get_lhs_expression(f) - get_rhs_expression(f);
+  return true;
+}
+}  // namespace
+
+bool ExtractHc4Constraint(const Formula& f, Expression* const e,
+                          Box::Interval* const range) {
+  return ExtractConstraint(f, true, e, range);
+}
+
+//--------------------------------
+// Implementation of ContractorHc4
+//--------------------------------
+ContractorHc4::ContractorHc4(Formula f, const Box& box, const Config& config)
+    : ContractorCell{Contractor::Kind::HC4, DynamicBitset(box.size()), config},
+      f_{std::move(f)} {
+  static ContractorHc4Stat stat{DREAL_LOG_INFO_ENABLED};
+  TimerGuard timer_guard(&stat.timer_make_tape_, stat.enabled());
+  Expression e;
+  if (ExtractHc4Constraint(f_, &e, &range_)) {
+    tape_ = make_unique<const ExpressionTape>(e, box);
+    // Build input.
+    DynamicBitset& input{mutable_input()};
+    for (const Variable& var : f_.GetFreeVariables()) {
+      input.set(box.index(var));
+    }
+  }
+}
+
+void ContractorHc4::Prune(ContractorStatus* cs) const {
+  thread_local ContractorHc4Stat stat{DREAL_LOG_INFO_ENABLED};
+  // The values of the tape nodes. It is shared by all the HC4
+  // contractors which run in this thread.
+  thread_local vector<Box::Interval> values;
+  DREAL_ASSERT(tape_);
+
+  Box::IntervalVector& iv{cs->mutable_box().mutable_interval_vector()};
+  DREAL_LOG_TRACE("ContractorHc4::Prune");
+  DREAL_LOG_TRACE("F = {}", f_);
+  TimerGuard timer_guard(&stat.timer_pruning_, stat.enabled());
+  bool changed{false};
+  const bool feasible{tape_->Revise(range_, &iv, &values,
+                                    &cs->mutable_output(), &changed)};
+  if (stat.enabled()) {
+    stat.num_pruning_++;
+  }
+  // Update output.
+  if (!feasible) {
+    changed = true;
+    iv.set_empty();
+    cs->mutable_output().set();
+  }
+  // Update used constraints.
+  if (changed) {
+    cs->AddUsedConstraint(f_);
+  } else {
+    if (stat.enabled()) {
+      stat.num_zero_effect_pruning_++;
+    }
+    DREAL_LOG_TRACE("NO CHANGE");
+  }
+}
+
+ostream& ContractorHc4::display(ostream& os) const {
+  return os << "Hc4(" << f_ << ")";
+}
+
+bool ContractorHc4::is_dummy() const { return !tape_; }
+
+}  // namespace dreal
@@ -0,0 +1,83 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <memory>
+#include <ostream>
+
+#include "dreal/contractor/contractor_cell.h"
+#include "dreal/contractor/contractor_status.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+#include "dreal/util/expression_tape.h"
+
+namespace dreal {
+
+/// Forward/backward (HC4Revise) contractor which runs over an
+/// ExpressionTape instead of an ibex::Function.
+///
+/// A constraint `e rop 0` is compiled into a tape of `e` and the range
+/// of `e` which satisfies the constraint. The tape is immutable and the
+/// values of its nodes are kept in a thread-local scratch vector.
+/// Therefore, unlike ContractorIbexFwdbwd, an instance can be shared by
+/// multiple threads.
+class ContractorHc4 : public ContractorCell {
+ public:
+  /// Deleted default constructor.
+  ContractorHc4() = delete;
+
+  /// Constructs Hc4 contractor using @p f and @p box.
+  ContractorHc4(Formula f, const Box& box, const Config& config);
+
+  /// Deleted copy constructor.
+  ContractorHc4(const ContractorHc4&) = delete;
+
+  /// Deleted move constructor.
+  ContractorHc4(ContractorHc4&&) = delete;
+
+  /// Deleted copy assign operator.
+  ContractorHc4& operator=(const ContractorHc4&) = delete;
+
+  /// Deleted move assign operator.
+  ContractorHc4& operator=(ContractorHc4&&) = delete;
+
+  ~ContractorHc4() override = default;
+
+  void Prune(ContractorStatus* cs) const override;
+
+  std::ostream& display(std::ostream& os) const override;
+
+  /// Returns true if it has no internal tape. It happens when @p f is
+  /// a trivially true formula or a disequality, which we do not prune.
+  bool is_dummy() const;
+
+ private:
+  const Formula f_;
+  std::unique_ptr<const ExpressionTape> tape_;
+  Box::Interval range_;
+};
+
+/// Finds an expression `e` and an interval `range` such that @p f is
+/// equivalent to `e ∈ range`. It follows the conversion done by
+/// IbexConverter. Returns false if we do not prune with @p f (i.e. a
+/// disequality or a trivially true formula).
+///
+/// @throws std::runtime_error if @p f is not a relational formula or
+/// a negation of it.
+bool ExtractHc4Constraint(const Formula& f, Expression* e,
+                          Box::Interval* range);
+
+}  // namespace dreal
@@ -0,0 +1,163 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/contractor/contractor_hc4_dag.h"
+
+#include <vector>
+
+#include "dreal/contractor/contractor_hc4.h"
+#include "dreal/util/assert.h"
+#include "dreal/util/logging.h"
+#include "dreal/util/stat.h"
+#include "dreal/util/timer.h"
+
+using std::cout;
+using std::make_unique;
+using std::ostream;
+using std::vector;
+
+namespace dreal {
+
+namespace {
+class ContractorHc4DagStat : public Stat {
+ public:
+  explicit ContractorHc4DagStat(const bool enabled) : Stat{enabled} {};
+  ContractorHc4DagStat(const ContractorHc4DagStat&) = delete;
+  ContractorHc4DagStat(ContractorHc4DagStat&&) = delete;
+  ContractorHc4DagStat& operator=(const ContractorHc4DagStat&) = delete;
+  ContractorHc4DagStat& operator=(ContractorHc4DagStat&&) = delete;
+  ~ContractorHc4DagStat() override {
+    if (enabled()) {
+      using fmt::print;
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of HC4-DAG Pruning",
+            "Pruning level", num_pruning_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of HC4-DAG Pruning (zero-effect)", "Pruning level",
+            num_zero_effect_pruning_);
+      if (num_pruning_) {
+        print(cout, "{:<45} @ {:<20} = {:>15f} sec\n",
+              "Total time spent in HC4-DAG Pruning", "Pruning level",
+              timer_pruning_.seconds());
+      }
+      print(cout, "{:<45} @ {:<20} = {:>15f} sec\n",
+            "Total time spent in making HC4-DAG tapes", "Pruning level",
+            timer_make_tape_.seconds());
+    }
+  }
+
+  int num_zero_effect_pruning_{0};
+  int num_pruning_{0};
+
+  Timer timer_pruning_;
+  Timer timer_make_tape_;
+};
+}  // namespace
+
+//-----------------------------------
+// Implementation of ContractorHc4Dag
+//-----------------------------------
+ContractorHc4Dag::ContractorHc4Dag(const vector<Formula>& formulas,
+                                   const Box& box, const Config& config)
+    : ContractorCell{Contractor::Kind::HC4_DAG, DynamicBitset(box.size()),
+                     config} {
+  static ContractorHc4DagStat stat{DREAL_LOG_INFO_ENABLED};
+  TimerGuard timer_guard(&stat.timer_make_tape_, stat.enabled());
+  vector<Expression> roots;
+  DynamicBitset& input{mutable_input()};
+  for (const Formula& f : formulas) {
+    Expression e;
+    Box::Interval range;
+    if (!ExtractHc4Constraint(f, &e, &range)) {
+      continue;
+    }
+    formulas_.push_back(f);
+    ranges_.push_back(range);
+    roots.push_back(e);
+    for (const Variable& var : f.GetFreeVariables()) {
+      input.set(box.index(var));
+    }
+  }
+  if (!roots.empty()) {
+    tape_ = make_unique<const ExpressionTape>(roots, box);
+  }
+}
+
+void ContractorHc4Dag::Prune(ContractorStatus* cs) const {
+  thread_local ContractorHc4DagStat stat{DREAL_LOG_INFO_ENABLED};
+  // The values of the tape nodes. It is shared by all the HC4
+  // contractors which run in this thread.
+  thread_local vector<Box::Interval> values;
+  DREAL_ASSERT(tape_);
+
+  Box::IntervalVector& iv{cs->mutable_box().mutable_interval_vector()};
+  DREAL_LOG_TRACE("ContractorHc4Dag::Prune");
+  TimerGuard timer_guard(&stat.timer_pruning_, stat.enabled());
+  if (stat.enabled()) {
+    stat.num_pruning_++;
+  }
+  // A forward pass over the whole DAG is shared by all the roots.
+  bool feasible{tape_->Forward(iv, &values)};
+  if (!feasible) {
+    // We cannot tell which constraint caused the emptiness.
+    cs->AddUsedConstraint(formulas_);
+  }
+  // Constraints whose backward pass narrowed a node. The effect of a
+  // pass which narrows nothing is invisible to the later passes, so the
+  // other constraints do not need to be in the explanation.
+  vector<Formula> used;
+  for (int i = 0; feasible && i < tape_->num_roots(); ++i) {
+    bool narrowed{false};
+    if (!tape_->Backward(i, ranges_[i], &values, &narrowed)) {
+      feasible = false;
+      used.push_back(formulas_[i]);
+      cs->AddUsedConstraint(used);
+    } else if (narrowed) {
+      used.push_back(formulas_[i]);
+    }
+  }
+  bool changed{false};
+  if (feasible) {
+    tape_->Update(values, &iv, &cs->mutable_output(), &changed);
+  }
+
+  // Update output.
+  if (!feasible) {
+    iv.set_empty();
+    cs->mutable_output().set();
+  } else if (changed) {
+    // Update used constraints.
+    cs->AddUsedConstraint(used);
+  } else {
+    if (stat.enabled()) {
+      stat.num_zero_effect_pruning_++;
+    }
+    DREAL_LOG_TRACE("NO CHANGE");
+  }
+}
+
+ostream& ContractorHc4Dag::display(ostream& os) const {
+  os << "Hc4Dag(";
+  for (size_t i = 0; i < formulas_.size(); ++i) {
+    if (i > 0) {
+      os << ", ";
+    }
+    os << formulas_[i];
+  }
+  return os << ")";
+}
+
+bool ContractorHc4Dag::is_dummy() const { return !tape_; }
+
+}  // namespace dreal
@@ -0,0 +1,77 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "dreal/contractor/contractor_cell.h"
+#include "dreal/contractor/contractor_status.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+#include "dreal/util/expression_tape.h"
+
+namespace dreal {
+
+/// HC4 contractor over a set of constraints which are compiled into a
+/// single ExpressionTape.
+///
+/// A sub-expression shared by multiple constraints is a single node in
+/// the tape. Therefore, a pruning step evaluates it once in the forward
+/// pass and the backward projections of all the constraints narrow the
+/// same node. Like ContractorHc4, an instance can be shared by
+/// multiple threads.
+class ContractorHc4Dag : public ContractorCell {
+ public:
+  /// Deleted default constructor.
+  ContractorHc4Dag() = delete;
+
+  /// Constructs Hc4Dag contractor using @p formulas and @p box.
+  ContractorHc4Dag(const std::vector<Formula>& formulas, const Box& box,
+                   const Config& config);
+
+  /// Deleted copy constructor.
+  ContractorHc4Dag(const ContractorHc4Dag&) = delete;
+
+  /// Deleted move constructor.
+  ContractorHc4Dag(ContractorHc4Dag&&) = delete;
+
+  /// Deleted copy assign operator.
+  ContractorHc4Dag& operator=(const ContractorHc4Dag&) = delete;
+
+  /// Deleted move assign operator.
+  ContractorHc4Dag& operator=(ContractorHc4Dag&&) = delete;
+
+  ~ContractorHc4Dag() override = default;
+
+  void Prune(ContractorStatus* cs) const override;
+
+  std::ostream& display(std::ostream& os) const override;
+
+  /// Returns true if none of the formulas is used for pruning (i.e.
+  /// they are all disequalities).
+  bool is_dummy() const;
+
+ private:
+  // The formulas which are compiled into tape_. The i-th root of tape_
+  // is the expression of formulas_[i] whose range is ranges_[i].
+  std::vector<Formula> formulas_;
+  std::vector<Box::Interval> ranges_;
+  std::unique_ptr<const ExpressionTape> tape_;
+};
+
+}  // namespace dreal
@@ -96,6 +96,11 @@ ContractorIbexFwdbwd::ContractorIbexFwdbwd(Formula f, const Box& box,
 }
 
 void ContractorIbexFwdbwd::Prune(ContractorStatus* cs) const {
+  Prune(nullptr, cs);
+}
+
+void ContractorIbexFwdbwd::Prune(ibex::CtcFwdBwd* const ctc,
+                                 ContractorStatus* cs) const {
   thread_local ContractorIbexFwdbwdStat stat{DREAL_LOG_INFO_ENABLED};
   DREAL_ASSERT(!is_dummy_ && num_ctr_);
 
@@ -105,8 +110,14 @@ void ContractorIbexFwdbwd::Prune(ContractorStatus* cs) const {
   DREAL_LOG_TRACE("F = {}", f_);
   const Box::IntervalVector old_iv{iv};
   stat.timer_pruning_.resume();
-  const bool is_inner{num_ctr_->f.backward(num_ctr_->right_hand_side(),
-                                           iv)};  // true if unchanged.
+  bool is_inner{false};  // true if unchanged.
+  if (ctc) {
+    // CtcFwdBwd does not tell if the box is inner. We find the changes
+    // below.
+    ctc->contract(iv);
+  } else {
+    is_inner = num_ctr_->f.backward(num_ctr_->right_hand_side(), iv);
+  }
   stat.timer_pruning_.pause();
   if (stat.enabled()) {
     stat.num_pruning_++;
@@ -152,4 +163,9 @@ ostream& ContractorIbexFwdbwd::display(ostream& os) const {
 
 bool ContractorIbexFwdbwd::is_dummy() const { return is_dummy_; }
 
+const ibex::NumConstraint& ContractorIbexFwdbwd::num_ctr() const {
+  DREAL_ASSERT(num_ctr_);
+  return *num_ctr_;
+}
+
 }  // namespace dreal
@@ -52,6 +52,19 @@ class ContractorIbexFwdbwd : public ContractorCell {
 
   void Prune(ContractorStatus* cs) const override;
 
+  /// Prunes @p cs like Prune(cs), but runs @p ctc instead of the
+  /// backward projection of the compiled constraint. @p ctc should be
+  /// built from num_ctr(). IBEX evaluates the nodes of a constraint in
+  /// a scratch space that is not thread-safe, so ContractorIbexFwdbwdMt
+  /// shares this contractor among the threads and gives each thread its
+  /// own @p ctc.
+  void Prune(ibex::CtcFwdBwd* ctc, ContractorStatus* cs) const;
+
+  /// Returns the compiled constraint.
+  ///
+  /// @pre It is not a dummy contractor.
+  const ibex::NumConstraint& num_ctr() const;
+
   std::ostream& display(std::ostream& os) const override;
 
   /// Returns true if it has no internal ibex contractor.
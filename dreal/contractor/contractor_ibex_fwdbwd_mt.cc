@@ -33,25 +33,25 @@ ContractorIbexFwdbwdMt::ContractorIbexFwdbwdMt(Formula f, const Box& box,
                      DynamicBitset(box.size()), config},
       f_{std::move(f)},
       config_{config},
+      shared_ctc_{make_unique<ContractorIbexFwdbwd>(f_, box, config_)},
       ctc_ready_(config_.number_of_jobs(), 0),
       ctcs_(ctc_ready_.size()) {
   DREAL_LOG_DEBUG("ContractorIbexFwdbwdMt::ContractorIbexFwdbwdMt");
-  ContractorIbexFwdbwd* const ctc{GetCtcOrCreate(box)};
-  DREAL_ASSERT(ctc);
   // Build input.
-  mutable_input() = ctc->input();
+  mutable_input() = shared_ctc_->input();
 
-  is_dummy_ = ctc->is_dummy();
+  is_dummy_ = shared_ctc_->is_dummy();
 }
 
-ContractorIbexFwdbwd* ContractorIbexFwdbwdMt::GetCtcOrCreate(
-    const Box& box) const {
+ContractorIbexFwdbwdMt::~ContractorIbexFwdbwdMt() = default;
+
+ibex::CtcFwdBwd* ContractorIbexFwdbwdMt::GetCtcOrCreate() const {
   thread_local const int kThreadId{ThreadPool::get_thread_id()};
   if (ctc_ready_[kThreadId]) {
     return ctcs_[kThreadId].get();
   }
-  auto ctc_unique_ptr = make_unique<ContractorIbexFwdbwd>(f_, box, config_);
-  ContractorIbexFwdbwd* ctc{ctc_unique_ptr.get()};
+  auto ctc_unique_ptr = make_unique<ibex::CtcFwdBwd>(shared_ctc_->num_ctr());
+  ibex::CtcFwdBwd* ctc{ctc_unique_ptr.get()};
   DREAL_ASSERT(ctc);
   ctcs_[kThreadId] = std::move(ctc_unique_ptr);
   ctc_ready_[kThreadId] = 1;
@@ -60,9 +60,9 @@ ContractorIbexFwdbwd* ContractorIbexFwdbwdMt::GetCtcOrCreate(
 
 void ContractorIbexFwdbwdMt::Prune(ContractorStatus* cs) const {
   DREAL_ASSERT(!is_dummy_);
-  ContractorIbexFwdbwd* const ctc{GetCtcOrCreate(cs->box())};
+  ibex::CtcFwdBwd* const ctc{GetCtcOrCreate()};
   DREAL_ASSERT(ctc);
-  return ctc->Prune(cs);
+  return shared_ctc_->Prune(ctc, cs);
 }
 
 ostream& ContractorIbexFwdbwdMt::display(ostream& os) const {
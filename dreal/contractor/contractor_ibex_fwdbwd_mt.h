@@ -29,9 +29,11 @@ namespace dreal {
 
 /// Multi-thread version of ContractorIbexFwdbwd contractor.
 ///
-/// The base ContractorIbexFwdbwd is not thread-safe. When there are N jobs, it
-/// creates N ContractorIbexFwdbwd instances internally and make sure that each
-/// thread calls a designated instance.
+/// The base ContractorIbexFwdbwd is not thread-safe, as IBEX evaluates
+/// a constraint in a scratch space of its own. This contractor compiles
+/// the constraint once, in a ContractorIbexFwdbwd shared by all the
+/// threads. Each thread only has its own ibex::CtcFwdBwd, which holds
+/// the scratch space, built from the shared constraint.
 class ContractorIbexFwdbwdMt : public ContractorCell {
  public:
   /// Deleted default constructor.
@@ -52,7 +54,7 @@ class ContractorIbexFwdbwdMt : public ContractorCell {
   /// Deleted move assign operator.
   ContractorIbexFwdbwdMt& operator=(ContractorIbexFwdbwdMt&&) = delete;
 
-  ~ContractorIbexFwdbwdMt() override = default;
+  ~ContractorIbexFwdbwdMt() override;
 
   void Prune(ContractorStatus* cs) const override;
 
@@ -62,15 +64,18 @@ class ContractorIbexFwdbwdMt : public ContractorCell {
   bool is_dummy() const;
 
  private:
-  ContractorIbexFwdbwd* GetCtcOrCreate(const Box& box) const;
+  ibex::CtcFwdBwd* GetCtcOrCreate() const;
 
   const Formula f_;
   bool is_dummy_{false};
   const Config config_;
 
+  // The compiled constraint, shared by all the threads.
+  const std::unique_ptr<ContractorIbexFwdbwd> shared_ctc_;
+
   // ctc_ready_[i] is 1 indicates that ctcs_[i] is ready to be used.
   mutable std::vector<int> ctc_ready_;
-  mutable std::vector<std::unique_ptr<ContractorIbexFwdbwd>> ctcs_;
+  mutable std::vector<std::unique_ptr<ibex::CtcFwdBwd>> ctcs_;
 };
 
 }  // namespace dreal
@@ -83,9 +83,31 @@ ContractorIbexPolytope::ContractorIbexPolytope(vector<Formula> formulas,
 void ContractorIbexPolytope::Prune(ContractorStatus* cs) const {
   DREAL_ASSERT(!is_dummy_ && ctc_);
   Box::IntervalVector& iv{cs->mutable_box().mutable_interval_vector()};
+  // The skips below depend on the history of calls of this instance.
+  // With multiple jobs, the history is not reproducible as a thread
+  // picks its instance by its ID (see ContractorIbexPolytopeMt), so we
+  // do not skip if a deterministic result is requested.
+  if (!config().deterministic()) {
+    if (config().polytope_skip_unchanged() && IsUnchanged(iv)) {
+      DREAL_LOG_TRACE(
+          "ContractorIbexPolytope::Prune: SKIP (NO INPUT CHANGE)");
+      return;
+    }
+    if (num_calls_++ % config().polytope_frequency() != 0) {
+      DREAL_LOG_TRACE("ContractorIbexPolytope::Prune: SKIP (FREQUENCY)");
+      return;
+    }
+  }
   const Box::IntervalVector old_iv = iv;
   DREAL_LOG_TRACE("ContractorIbexPolytope::Prune");
   ctc_->contract(iv);
+  if (config().polytope_skip_unchanged()) {
+    if (iv.is_empty()) {
+      last_iv_ = nullopt;
+    } else {
+      last_iv_ = iv;
+    }
+  }
   bool changed{false};
   // Update output.
   if (iv.is_empty()) {
@@ -121,6 +143,19 @@ ostream& ContractorIbexPolytope::display(ostream& os) const {
   return os;
 }
 
+bool ContractorIbexPolytope::IsUnchanged(const Box::IntervalVector& iv) const {
+  if (!last_iv_ || last_iv_->size() != iv.size()) {
+    return false;
+  }
+  const DynamicBitset& in{input()};
+  for (DynamicBitset::size_type i = 0; i < in.size(); ++i) {
+    if (in[i] && (*last_iv_)[i] != iv[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool ContractorIbexPolytope::is_dummy() const { return is_dummy_; }
 
 }  // namespace dreal
@@ -25,6 +25,7 @@
 #include "dreal/contractor/contractor_cell.h"
 #include "dreal/symbolic/symbolic.h"
 #include "dreal/util/box.h"
+#include "dreal/util/optional.h"
 
 namespace dreal {
 
@@ -41,6 +42,24 @@ struct ExprCtrDeleter {
   }
 };
 
+/// Contractor wrapping IBEX's polytope hull contractor.
+///
+/// Each call of ibex::CtcPolytopeHull linearizes the constraints and
+/// solves 2n LPs, so it can avoid the calls which are unlikely to
+/// prune:
+///
+///  - With `Config::polytope_skip_unchanged()`, it remembers the box
+///    which it returned at the last call. If the domains of its input
+///    variables are the same in a given box, it returns immediately.
+///    Note that CtcPolytopeHull linearizes the constraints around the
+///    box, so a second call could prune more.
+///
+///  - It solves the LPs at every `Config::polytope_frequency()`-th call
+///    and does nothing at the other calls.
+///
+/// It does neither if `Config::deterministic()` is set.
+///
+/// This class is not thread-safe. See ContractorIbexPolytopeMt.
 class ContractorIbexPolytope : public ContractorCell {
  public:
   /// Constructs IbexPolytope contractor using @p f and @p vars.
@@ -69,9 +88,18 @@ class ContractorIbexPolytope : public ContractorCell {
   bool is_dummy() const;
 
  private:
+  // Returns true if the domains of the input variables in @p iv are
+  // the same as the ones in last_iv_.
+  bool IsUnchanged(const Box::IntervalVector& iv) const;
+
   const std::vector<Formula> formulas_;
   bool is_dummy_{false};
 
+  // The box returned by the last call of Prune which solved the LPs.
+  mutable optional<Box::IntervalVector> last_iv_;
+  // The number of calls of Prune which are not skipped by IsUnchanged.
+  mutable int num_calls_{0};
+
   IbexConverter ibex_converter_;
   std::unique_ptr<ibex::SystemFactory> system_factory_;
   std::unique_ptr<ibex::System> system_;
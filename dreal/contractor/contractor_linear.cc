@@ -0,0 +1,417 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/contractor/contractor_linear.h"
+
+#include <cmath>
+#include <limits>
+#include <map>
+#include <utility>
+
+#include "dreal/contractor/contractor_hc4.h"
+#include "dreal/util/assert.h"
+#include "dreal/util/logging.h"
+#include "dreal/util/stat.h"
+#include "dreal/util/timer.h"
+
+using std::cout;
+using std::numeric_limits;
+using std::ostream;
+using std::pair;
+using std::vector;
+
+namespace dreal {
+
+namespace {
+class ContractorLinearStat : public Stat {
+ public:
+  explicit ContractorLinearStat(const bool enabled) : Stat{enabled} {};
+  ContractorLinearStat(const ContractorLinearStat&) = delete;
+  ContractorLinearStat(ContractorLinearStat&&) = delete;
+  ContractorLinearStat& operator=(const ContractorLinearStat&) = delete;
+  ContractorLinearStat& operator=(ContractorLinearStat&&) = delete;
+  ~ContractorLinearStat() override {
+    if (enabled()) {
+      using fmt::print;
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of Linear Pruning",
+            "Pruning level", num_pruning_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of Linear Pruning (zero-effect)", "Pruning level",
+            num_zero_effect_pruning_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of Linear Row Propagations", "Pruning level",
+            num_row_propagations_);
+      if (num_pruning_) {
+        print(cout, "{:<45} @ {:<20} = {:>15f} sec\n",
+              "Total time spent in Linear Pruning", "Pruning level",
+              timer_pruning_.seconds());
+      }
+    }
+  }
+
+  int num_zero_effect_pruning_{0};
+  int num_pruning_{0};
+  int num_row_propagations_{0};
+
+  Timer timer_pruning_;
+};
+
+constexpr double kInfinity{numeric_limits<double>::infinity()};
+
+// Each row is propagated at most this many times (on average) in a
+// call of ContractorLinear::Prune. It bounds the number of steps when
+// the propagation converges slowly (e.g. x ≥ y + 1 ∧ y ≥ x + 1 over
+// unbounded domains).
+constexpr int kMaxPropagationsPerRow{32};
+
+// Adds `factor · e` into `Σⱼ coeffs[j]·box[j] + constant`. Returns false
+// if @p e is not linear.
+bool Linearize(const Expression& e, const Box& box,
+               const Box::Interval& factor, std::map<int, Box::Interval>* coeffs,
+               Box::Interval* constant) {
+  switch (e.get_kind()) {
+    case ExpressionKind::Constant:
+      *constant += factor * Box::Interval(get_constant_value(e));
+      return true;
+    case ExpressionKind::RealConstant:
+      *constant += factor * Box::Interval(get_lb_of_real_constant(e),
+                                          get_ub_of_real_constant(e));
+      return true;
+    case ExpressionKind::Var: {
+      const Variable& var{get_variable(e)};
+      if (!box.has_variable(var)) {
+        return false;
+      }
+      const int j{box.index(var)};
+      auto it = coeffs->find(j);
+      if (it == coeffs->end()) {
+        coeffs->emplace(j, factor);
+      } else {
+        it->second += factor;
+      }
+      return true;
+    }
+    case ExpressionKind::Add:
+      *constant += factor * Box::Interval(get_constant_in_addition(e));
+      for (const pair<const Expression, double>& p :
+           get_expr_to_coeff_map_in_addition(e)) {
+        if (!Linearize(p.first, box, factor * Box::Interval(p.second), coeffs,
+                       constant)) {
+          return false;
+        }
+      }
+      return true;
+    case ExpressionKind::Mul: {
+      const std::map<Expression, Expression>& base_to_exponent{
+          get_base_to_exponent_map_in_multiplication(e)};
+      if (base_to_exponent.size() != 1 ||
+          !is_constant(base_to_exponent.begin()->second, 1.0)) {
+        return false;
+      }
+      return Linearize(
+          base_to_exponent.begin()->first, box,
+          factor * Box::Interval(get_constant_in_multiplication(e)), coeffs,
+          constant);
+    }
+    default:
+      return false;
+  }
+}
+
+// Returns the sum of the finite lower bounds (or upper bounds) of the
+// terms in a row, and the number of the terms whose bound is infinite.
+struct Activity {
+  Box::Interval finite_sum{0.0};
+  int num_infinite{0};
+
+  void Add(const double v) {
+    if (std::isinf(v)) {
+      ++num_infinite;
+    } else {
+      finite_sum += Box::Interval(v);
+    }
+  }
+
+  void Remove(const double v) {
+    if (std::isinf(v)) {
+      --num_infinite;
+    } else {
+      finite_sum -= Box::Interval(v);
+    }
+  }
+
+  // Returns a lower bound (if @p lower is true) or an upper bound of
+  // the activity.
+  double Bound(const bool lower) const {
+    if (num_infinite > 0) {
+      return lower ? -kInfinity : kInfinity;
+    }
+    return lower ? finite_sum.lb() : finite_sum.ub();
+  }
+
+  // Returns a lower bound (if @p lower is true) or an upper bound of
+  // the activity excluding a term whose bound is @p v.
+  double Residual(const double v, const bool lower) const {
+    const int num_infinite_others{num_infinite - (std::isinf(v) ? 1 : 0)};
+    if (num_infinite_others > 0) {
+      return lower ? -kInfinity : kInfinity;
+    }
+    const Box::Interval sum{std::isinf(v) ? finite_sum
+                                          : finite_sum - Box::Interval(v)};
+    return lower ? sum.lb() : sum.ub();
+  }
+};
+
+// Returns @p a - @p b rounded downward (if @p lower is true) or upward.
+double Sub(const double a, const double b, const bool lower) {
+  if (std::isinf(a) || std::isinf(b)) {
+    return lower ? -kInfinity : kInfinity;
+  }
+  const Box::Interval d{Box::Interval(a) - Box::Interval(b)};
+  return lower ? d.lb() : d.ub();
+}
+
+// Returns true if updating @p old_x to @p new_x is worth propagating.
+bool IsSignificant(const Box::Interval& old_x, const Box::Interval& new_x) {
+  if (new_x.lb() <= old_x.lb() && new_x.ub() >= old_x.ub()) {
+    return false;
+  }
+  const double old_width{old_x.diam()};
+  if (std::isinf(old_width)) {
+    return (std::isinf(old_x.lb()) && !std::isinf(new_x.lb())) ||
+           (std::isinf(old_x.ub()) && !std::isinf(new_x.ub()));
+  }
+  return new_x.diam() <
+         old_width * (1.0 - ContractorLinear::kMinRelativeReduction);
+}
+}  // namespace
+
+constexpr double ContractorLinear::kMinRelativeReduction;
+
+bool ExtractLinearConstraint(const Formula& f, const Box& box,
+                             vector<pair<int, Box::Interval>>* const terms,
+                             Box::Interval* const range) {
+  if (!is_relational(f) && !is_negation(f)) {
+    return false;
+  }
+  if (is_negation(f) && !is_relational(get_operand(f))) {
+    return false;
+  }
+  Expression e;
+  if (!ExtractHc4Constraint(f, &e, range)) {
+    return false;
+  }
+  std::map<int, Box::Interval> coeffs;
+  Box::Interval constant{0.0};
+  if (!Linearize(e, box, Box::Interval(1.0), &coeffs, &constant)) {
+    return false;
+  }
+  terms->clear();
+  for (const pair<const int, Box::Interval>& p : coeffs) {
+    if (p.second != Box::Interval::ZERO) {
+      terms->push_back(p);
+    }
+  }
+  if (terms->empty()) {
+    return false;
+  }
+  *range -= constant;
+  return true;
+}
+
+//-----------------------------------
+// Implementation of ContractorLinear
+//-----------------------------------
+ContractorLinear::ContractorLinear(const vector<Formula>& formulas,
+                                   const Box& box, const Config& config)
+    : ContractorCell{Contractor::Kind::LINEAR, DynamicBitset(box.size()),
+                     config} {
+  // 1. Build the rows (CSR).
+  vector<pair<int, Box::Interval>> terms;
+  Box::Interval range;
+  row_offsets_.push_back(0);
+  vector<int> column_sizes(box.size(), 0);
+  for (const Formula& f : formulas) {
+    if (!ExtractLinearConstraint(f, box, &terms, &range)) {
+      DREAL_LOG_DEBUG("ContractorLinear: {} is ignored.", f);
+      continue;
+    }
+    formulas_.push_back(f);
+    ranges_.push_back(range);
+    for (const pair<int, Box::Interval>& term : terms) {
+      columns_.push_back(term.first);
+      coeffs_.push_back(term.second);
+      ++column_sizes[term.first];
+      mutable_input().set(term.first);
+    }
+    row_offsets_.push_back(static_cast<int>(columns_.size()));
+  }
+
+  // 2. Build the columns (CSC).
+  column_offsets_.resize(box.size() + 1, 0);
+  for (int j = 0; j < box.size(); ++j) {
+    column_offsets_[j + 1] = column_offsets_[j] + column_sizes[j];
+  }
+  entries_.resize(columns_.size());
+  rows_.resize(columns_.size());
+  vector<int> next{column_offsets_.begin(), column_offsets_.end() - 1};
+  for (int r = 0; r < num_rows(); ++r) {
+    for (int k = row_offsets_[r]; k < row_offsets_[r + 1]; ++k) {
+      const int i{next[columns_[k]]++};
+      entries_[i] = k;
+      rows_[i] = r;
+    }
+  }
+}
+
+void ContractorLinear::Prune(ContractorStatus* cs) const {
+  thread_local ContractorLinearStat stat{DREAL_LOG_INFO_ENABLED};
+  // The scratch vectors are shared by all the linear contractors which
+  // run in this thread.
+  //
+  // contrib_lb[k] and contrib_ub[k] are the bounds of the k-th entry
+  // which are currently counted in the activities of its row.
+  thread_local vector<double> contrib_lb;
+  thread_local vector<double> contrib_ub;
+  thread_local vector<Activity> min_activities;
+  thread_local vector<Activity> max_activities;
+  thread_local vector<int> queue;
+  TimerGuard timer_guard(&stat.timer_pruning_, stat.enabled());
+  if (stat.enabled()) {
+    stat.num_pruning_++;
+  }
+
+  Box::IntervalVector& iv{cs->mutable_box().mutable_interval_vector()};
+  const int num_entries{static_cast<int>(columns_.size())};
+  contrib_lb.resize(num_entries);
+  contrib_ub.resize(num_entries);
+  min_activities.assign(num_rows(), Activity{});
+  max_activities.assign(num_rows(), Activity{});
+
+  // 1. Compute the activities of all the rows.
+  for (int r = 0; r < num_rows(); ++r) {
+    for (int k = row_offsets_[r]; k < row_offsets_[r + 1]; ++k) {
+      const Box::Interval contrib{coeffs_[k] * iv[columns_[k]]};
+      contrib_lb[k] = contrib.lb();
+      contrib_ub[k] = contrib.ub();
+      min_activities[r].Add(contrib_lb[k]);
+      max_activities[r].Add(contrib_ub[k]);
+    }
+  }
+
+  // 2. Propagate. The queue is a FIFO of the rows to propagate and
+  // queued[r] indicates that the r-th row is in the queue.
+  queue.resize(num_rows());
+  DynamicBitset queued(num_rows());
+  queued.set();
+  for (int r = 0; r < num_rows(); ++r) {
+    queue[r] = r;
+  }
+  int head{0};
+  int size{num_rows()};
+  int budget{kMaxPropagationsPerRow * num_rows()};
+  // used[r] indicates that the r-th row has pruned the box.
+  DynamicBitset used(num_rows());
+  bool changed{false};
+  int empty_row{-1};
+  while (size > 0 && budget-- > 0 && empty_row < 0) {
+    const int r{queue[head]};
+    head = (head + 1) % num_rows();
+    --size;
+    queued.reset(r);
+    if (stat.enabled()) {
+      stat.num_row_propagations_++;
+    }
+    const Box::Interval& range{ranges_[r]};
+    if (min_activities[r].Bound(true) > range.ub() ||
+        max_activities[r].Bound(false) < range.lb()) {
+      empty_row = r;
+      break;
+    }
+    for (int k = row_offsets_[r]; k < row_offsets_[r + 1]; ++k) {
+      // coeffs_[k] · x ∈ [range.lb - max(others), range.ub - min(others)].
+      const double lb{Sub(range.lb(),
+                          max_activities[r].Residual(contrib_ub[k], false),
+                          true)};
+      const double ub{Sub(range.ub(),
+                          min_activities[r].Residual(contrib_lb[k], true),
+                          false)};
+      if (std::isinf(lb) && std::isinf(ub)) {
+        continue;
+      }
+      if (coeffs_[k].contains(0.0)) {
+        continue;
+      }
+      const int j{columns_[k]};
+      const Box::Interval new_x{
+          iv[j] & (Box::Interval(lb, ub) / coeffs_[k])};
+      if (new_x.is_empty()) {
+        empty_row = r;
+        break;
+      }
+      if (!IsSignificant(iv[j], new_x)) {
+        continue;
+      }
+      iv[j] = new_x;
+      cs->mutable_output().set(j);
+      used.set(r);
+      changed = true;
+      // Update the activities of the rows in the j-th column and
+      // schedule them.
+      for (int i = column_offsets_[j]; i < column_offsets_[j + 1]; ++i) {
+        const int k2{entries_[i]};
+        const int r2{rows_[i]};
+        const Box::Interval contrib{coeffs_[k2] * new_x};
+        min_activities[r2].Remove(contrib_lb[k2]);
+        max_activities[r2].Remove(contrib_ub[k2]);
+        contrib_lb[k2] = contrib.lb();
+        contrib_ub[k2] = contrib.ub();
+        min_activities[r2].Add(contrib_lb[k2]);
+        max_activities[r2].Add(contrib_ub[k2]);
+        if (r2 != r && !queued[r2]) {
+          queued.set(r2);
+          queue[(head + size) % num_rows()] = r2;
+          ++size;
+        }
+      }
+    }
+  }
+
+  // 3. Update the output and the used constraints.
+  if (empty_row >= 0) {
+    iv.set_empty();
+    cs->mutable_output().set();
+    used.set(empty_row);
+  }
+  for (DynamicBitset::size_type r = used.find_first(); r != DynamicBitset::npos;
+       r = used.find_next(r)) {
+    cs->AddUsedConstraint(formulas_[r]);
+  }
+  if (!changed && empty_row < 0 && stat.enabled()) {
+    stat.num_zero_effect_pruning_++;
+  }
+}
+
+ostream& ContractorLinear::display(ostream& os) const {
+  os << "Linear(";
+  for (const Formula& f : formulas_) {
+    os << f << ", ";
+  }
+  return os << ")";
+}
+
+bool ContractorLinear::is_dummy() const { return formulas_.empty(); }
+
+}  // namespace dreal
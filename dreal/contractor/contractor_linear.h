@@ -0,0 +1,113 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "dreal/contractor/contractor_cell.h"
+#include "dreal/contractor/contractor_status.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+
+namespace dreal {
+
+/// Bound-propagation contractor for a set of linear constraints.
+///
+/// A constraint `Σⱼ aⱼ·xⱼ ∈ [l, u]` is a row of a sparse matrix which
+/// is stored in the CSR format (and in the CSC format for the reverse
+/// lookup). For each row, Prune maintains the min/max activities
+/// `Σⱼ min(aⱼ·xⱼ)` and `Σⱼ max(aⱼ·xⱼ)` and tightens each variable with
+/// the residual activity of the other variables. When a variable
+/// changes, only the activities of the rows in its column are updated
+/// and those rows are scheduled again. All the arithmetic is done with
+/// outward-rounded intervals, so the result is sound.
+///
+/// The matrix is immutable and the activities are kept in thread-local
+/// scratch vectors. Therefore, an instance can be shared by multiple
+/// threads.
+class ContractorLinear : public ContractorCell {
+ public:
+  /// A variable is updated (and its rows are scheduled) only if its
+  /// width shrinks by more than this ratio or one of its infinite
+  /// bounds becomes finite.
+  static constexpr double kMinRelativeReduction{1e-3};
+
+  /// Deleted default constructor.
+  ContractorLinear() = delete;
+
+  /// Constructs a linear contractor using @p formulas and @p box. A
+  /// formula which is not linear (see ExtractLinearConstraint) is
+  /// ignored.
+  ContractorLinear(const std::vector<Formula>& formulas, const Box& box,
+                   const Config& config);
+
+  /// Deleted copy constructor.
+  ContractorLinear(const ContractorLinear&) = delete;
+
+  /// Deleted move constructor.
+  ContractorLinear(ContractorLinear&&) = delete;
+
+  /// Deleted copy assign operator.
+  ContractorLinear& operator=(const ContractorLinear&) = delete;
+
+  /// Deleted move assign operator.
+  ContractorLinear& operator=(ContractorLinear&&) = delete;
+
+  ~ContractorLinear() override = default;
+
+  void Prune(ContractorStatus* cs) const override;
+
+  std::ostream& display(std::ostream& os) const override;
+
+  /// Returns true if it has no row.
+  bool is_dummy() const;
+
+ private:
+  int num_rows() const { return static_cast<int>(formulas_.size()); }
+
+  // formulas_[r] is the constraint of the r-th row.
+  std::vector<Formula> formulas_;
+  // ranges_[r] is the range of the r-th row after moving its constant
+  // term to the right-hand side.
+  std::vector<Box::Interval> ranges_;
+
+  // CSR: The entries of the r-th row are in [row_offsets_[r],
+  // row_offsets_[r + 1]). The k-th entry is `coeffs_[k] ·
+  // x[columns_[k]]`.
+  std::vector<int> row_offsets_;
+  std::vector<int> columns_;
+  std::vector<Box::Interval> coeffs_;
+
+  // CSC: The entries of the j-th column are entries_[i] for i in
+  // [column_offsets_[j], column_offsets_[j + 1]), and rows_[i] is the
+  // row of entries_[i].
+  std::vector<int> column_offsets_;
+  std::vector<int> entries_;
+  std::vector<int> rows_;
+};
+
+/// Finds the terms `(j, aⱼ)` and an interval `range` such that @p f is
+/// equivalent to `Σⱼ aⱼ·box[j] ∈ range`. The coefficients are intervals
+/// to enclose the rounding errors in collecting them. Returns false if
+/// @p f is not a linear constraint, it has no variable, or we do not
+/// prune with @p f (see ExtractHc4Constraint).
+bool ExtractLinearConstraint(
+    const Formula& f, const Box& box,
+    std::vector<std::pair<int, Box::Interval>>* terms, Box::Interval* range);
+
+}  // namespace dreal
@@ -0,0 +1,366 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/contractor/contractor_newton.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "dreal/contractor/contractor_hc4.h"
+#include "dreal/util/assert.h"
+#include "dreal/util/logging.h"
+#include "dreal/util/stat.h"
+#include "dreal/util/timer.h"
+
+using std::cout;
+using std::make_unique;
+using std::ostream;
+using std::vector;
+
+namespace dreal {
+
+namespace {
+class ContractorNewtonStat : public Stat {
+ public:
+  explicit ContractorNewtonStat(const bool enabled) : Stat{enabled} {};
+  ContractorNewtonStat(const ContractorNewtonStat&) = delete;
+  ContractorNewtonStat(ContractorNewtonStat&&) = delete;
+  ContractorNewtonStat& operator=(const ContractorNewtonStat&) = delete;
+  ContractorNewtonStat& operator=(ContractorNewtonStat&&) = delete;
+  ~ContractorNewtonStat() override {
+    if (enabled()) {
+      using fmt::print;
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of Newton Pruning",
+            "Pruning level", num_pruning_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of Newton Steps",
+            "Pruning level", num_steps_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of Newton Certified Boxes", "Pruning level",
+            num_certified_);
+      if (num_pruning_) {
+        print(cout, "{:<45} @ {:<20} = {:>15f} sec\n",
+              "Total time spent in Newton Pruning", "Pruning level",
+              timer_pruning_.seconds());
+      }
+    }
+  }
+
+  int num_pruning_{0};
+  int num_steps_{0};
+  int num_certified_{0};
+
+  Timer timer_pruning_;
+};
+
+// Finds an augmenting path from the k-th equation in the bipartite
+// graph between the equations and the dimensions (Kuhn's algorithm).
+bool Augment(const int k, const vector<vector<int>>& candidates,
+             vector<bool>* const visited, vector<int>* const match_of_dim) {
+  for (const int dim : candidates[k]) {
+    if ((*visited)[dim]) {
+      continue;
+    }
+    (*visited)[dim] = true;
+    const int other{(*match_of_dim)[dim]};
+    if (other < 0 || Augment(other, candidates, visited, match_of_dim)) {
+      (*match_of_dim)[dim] = k;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Inverts the n × n matrix @p m (row-major) in place by Gauss-Jordan
+// elimination with partial pivoting. Returns false if it is singular.
+bool Invert(const int n, vector<double>* const m) {
+  vector<double>& a{*m};
+  vector<double> inv(n * n, 0.0);
+  for (int i = 0; i < n; ++i) {
+    inv[i * n + i] = 1.0;
+  }
+  for (int col = 0; col < n; ++col) {
+    int pivot{col};
+    for (int r = col + 1; r < n; ++r) {
+      if (std::fabs(a[r * n + col]) > std::fabs(a[pivot * n + col])) {
+        pivot = r;
+      }
+    }
+    const double p{a[pivot * n + col]};
+    if (p == 0.0 || !std::isfinite(p)) {
+      return false;
+    }
+    if (pivot != col) {
+      for (int c = 0; c < n; ++c) {
+        std::swap(a[pivot * n + c], a[col * n + c]);
+        std::swap(inv[pivot * n + c], inv[col * n + c]);
+      }
+    }
+    for (int c = 0; c < n; ++c) {
+      a[col * n + c] /= p;
+      inv[col * n + c] /= p;
+    }
+    for (int r = 0; r < n; ++r) {
+      const double factor{a[r * n + col]};
+      if (r == col || factor == 0.0) {
+        continue;
+      }
+      for (int c = 0; c < n; ++c) {
+        a[r * n + c] -= factor * a[col * n + c];
+        inv[r * n + c] -= factor * inv[col * n + c];
+      }
+    }
+  }
+  *m = std::move(inv);
+  return true;
+}
+}  // namespace
+
+constexpr int ContractorNewton::kMaxIterations;
+constexpr double ContractorNewton::kMinReduction;
+
+ContractorNewton::ContractorNewton(const vector<Formula>& formulas,
+                                   const Box& box, const Config& config)
+    : ContractorCell{Contractor::Kind::NEWTON, DynamicBitset(box.size()),
+                     config} {
+  // 1. Collect the equalities which we can differentiate and compile.
+  vector<Formula> equalities;
+  vector<Expression> functions;
+  vector<vector<int>> candidates;
+  for (const Formula& f : formulas) {
+    if (!is_equal_to(f)) {
+      continue;
+    }
+    Expression e;
+    Box::Interval range;
+    if (!ExtractHc4Constraint(f, &e, &range)) {
+      continue;
+    }
+    vector<int> dims;
+    try {
+      for (const Variable& var : e.GetVariables()) {
+        // Checks if `e` is differentiable with respect to `var`.
+        e.Differentiate(var);
+        dims.push_back(box.index(var));
+      }
+      // Checks if `e` can be compiled.
+      ExpressionTape{e, box};
+    } catch (const std::runtime_error& ex) {
+      DREAL_LOG_DEBUG("ContractorNewton: {} is ignored. {}", f, ex.what());
+      continue;
+    }
+    if (dims.empty()) {
+      continue;
+    }
+    equalities.push_back(f);
+    functions.push_back(e);
+    candidates.push_back(std::move(dims));
+  }
+
+  // 2. Match the equalities with the variables.
+  vector<int> match_of_dim(box.size(), -1);
+  for (int k = 0; k < static_cast<int>(equalities.size()); ++k) {
+    vector<bool> visited(box.size(), false);
+    Augment(k, candidates, &visited, &match_of_dim);
+  }
+  vector<Expression> matched_functions;
+  for (int dim = 0; dim < box.size(); ++dim) {
+    const int k{match_of_dim[dim]};
+    if (k >= 0) {
+      formulas_.push_back(equalities[k]);
+      matched_functions.push_back(functions[k]);
+      dims_.push_back(dim);
+    }
+  }
+  if (is_dummy()) {
+    return;
+  }
+
+  // 3. Compile F and its Jacobian.
+  const int n{size()};
+  vector<Expression> jacobian;
+  jacobian.reserve(n * n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      jacobian.push_back(
+          matched_functions[i].Differentiate(box.variable(dims_[j])));
+    }
+  }
+  functions_ = make_unique<const ExpressionTape>(matched_functions, box);
+  jacobian_ = make_unique<const ExpressionTape>(jacobian, box);
+
+  // The parameters are also inputs.
+  DynamicBitset& input{mutable_input()};
+  for (const Formula& f : formulas_) {
+    for (const Variable& var : f.GetFreeVariables()) {
+      input.set(box.index(var));
+    }
+  }
+  DREAL_LOG_DEBUG("ContractorNewton: {} x {} system", n, n);
+}
+
+bool ContractorNewton::Step(Box::IntervalVector* const iv,
+                            bool* const certified) const {
+  thread_local vector<Box::Interval> values;
+  const int n{size()};
+
+  // 1. J = J(X).
+  if (!jacobian_->Forward(*iv, &values)) {
+    return true;
+  }
+  vector<Box::Interval> jacobian(n * n);
+  vector<double> y(n * n);
+  for (int k = 0; k < n * n; ++k) {
+    jacobian[k] = values[jacobian_->root(k)];
+    if (jacobian[k].is_unbounded()) {
+      return true;
+    }
+    y[k] = jacobian[k].mid();
+  }
+
+  // 2. Y = mid(J)⁻¹.
+  if (!Invert(n, &y)) {
+    return true;
+  }
+
+  // 3. F(c) where c is the midpoint of X.
+  vector<double> c(n);
+  Box::IntervalVector mid_iv{*iv};
+  for (int i = 0; i < n; ++i) {
+    c[i] = (*iv)[dims_[i]].mid();
+    mid_iv[dims_[i]] = Box::Interval(c[i]);
+  }
+  if (!functions_->Forward(mid_iv, &values)) {
+    return true;
+  }
+  vector<Box::Interval> f_c(n);
+  for (int i = 0; i < n; ++i) {
+    f_c[i] = values[functions_->root(i)];
+  }
+
+  // 4. Gauss-Seidel on Y·J·(x - c) = -Y·F(c).
+  *certified = true;
+  for (int i = 0; i < n; ++i) {
+    Box::Interval b{0.0};
+    for (int k = 0; k < n; ++k) {
+      b += y[i * n + k] * f_c[k];
+    }
+    Box::Interval a_ii;
+    Box::Interval sum{b};
+    for (int j = 0; j < n; ++j) {
+      Box::Interval a_ij{0.0};
+      for (int k = 0; k < n; ++k) {
+        a_ij += y[i * n + k] * jacobian[k * n + j];
+      }
+      if (j == i) {
+        a_ii = a_ij;
+      } else {
+        sum += a_ij * ((*iv)[dims_[j]] - c[j]);
+      }
+    }
+    if (a_ii.contains(0.0)) {
+      *certified = false;
+      continue;
+    }
+    const Box::Interval image{c[i] - sum / a_ii};
+    Box::Interval& x_i{(*iv)[dims_[i]]};
+    if (!image.is_interior_subset(x_i)) {
+      *certified = false;
+    }
+    x_i &= image;
+    if (x_i.is_empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ContractorNewton::Prune(ContractorStatus* cs) const {
+  thread_local ContractorNewtonStat stat{DREAL_LOG_INFO_ENABLED};
+  DREAL_ASSERT(!is_dummy());
+  Box::IntervalVector& iv{cs->mutable_box().mutable_interval_vector()};
+  // Returns the maximum width of the matched variables.
+  const auto max_width = [this, &iv]() {
+    double ret{0.0};
+    for (const int dim : dims_) {
+      ret = std::max(ret, iv[dim].diam());
+    }
+    return ret;
+  };
+  double width{max_width()};
+  if (!(width <= config().newton_threshold())) {
+    // Note that the width can be NaN if a domain is empty.
+    return;
+  }
+  TimerGuard timer_guard(&stat.timer_pruning_, stat.enabled());
+  if (stat.enabled()) {
+    stat.num_pruning_++;
+  }
+  bool changed{false};
+  bool certified{false};
+  vector<Box::Interval> old_values(size());
+  for (int step = 0; step < kMaxIterations && width > 0.0; ++step) {
+    for (int i = 0; i < size(); ++i) {
+      old_values[i] = iv[dims_[i]];
+    }
+    if (stat.enabled()) {
+      stat.num_steps_++;
+    }
+    bool certified_step{false};
+    if (!Step(&iv, &certified_step)) {
+      DREAL_LOG_DEBUG("ContractorNewton::Prune: no solution.");
+      cs->mutable_box().set_empty();
+      cs->mutable_output().set();
+      cs->AddUsedConstraint(formulas_);
+      return;
+    }
+    certified = certified || certified_step;
+    for (int i = 0; i < size(); ++i) {
+      if (iv[dims_[i]] != old_values[i]) {
+        cs->mutable_output().set(dims_[i]);
+        changed = true;
+      }
+    }
+    const double new_width{max_width()};
+    if (new_width > (1.0 - kMinReduction) * width) {
+      break;
+    }
+    width = new_width;
+  }
+  if (certified) {
+    // The box still contains the unique solution as the following
+    // steps do not lose any solution.
+    cs->SetCertifiedConstraints(formulas_);
+    if (stat.enabled()) {
+      stat.num_certified_++;
+    }
+  }
+  if (changed) {
+    cs->AddUsedConstraint(formulas_);
+  }
+}
+
+bool ContractorNewton::is_dummy() const { return formulas_.empty(); }
+
+ostream& ContractorNewton::display(ostream& os) const {
+  os << "Newton(";
+  for (const Formula& f : formulas_) {
+    os << f << ", ";
+  }
+  return os << ")";
+}
+
+}  // namespace dreal
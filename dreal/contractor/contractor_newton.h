@@ -0,0 +1,112 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "dreal/contractor/contractor_cell.h"
+#include "dreal/contractor/contractor_status.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+#include "dreal/util/expression_tape.h"
+
+namespace dreal {
+
+/// Interval Newton contractor for a square system of equalities.
+///
+/// At construction, it collects the equalities `fᵢ(x) = 0` from given
+/// formulas and matches each of them with a distinct variable which
+/// occurs in it (a maximum bipartite matching). The matched equalities
+/// and variables form a square system `F(x, p) = 0` where the
+/// remaining variables `p` are treated as interval parameters. The
+/// Jacobian `∂fᵢ/∂xⱼ` is computed symbolically. Both `F` and the
+/// Jacobian are compiled into ExpressionTapes.
+///
+/// Prune applies the preconditioned interval Gauss-Seidel operator:
+/// with the midpoint `c` of X, `Y = mid(J(X))⁻¹`, `A = Y·J(X)`, and `b
+/// = Y·F(c)`, it updates `Xᵢ ← Xᵢ ∩ (cᵢ - (bᵢ + Σⱼ≠ᵢ Aᵢⱼ(Xⱼ - cⱼ)) /
+/// Aᵢᵢ)`. If all the images are in the interiors of the domains, the
+/// box has a unique solution of the system (for each value of the
+/// parameters). It iterates while the box shrinks, which converges
+/// quadratically once the solution is certified. It also records the
+/// certificate in ContractorStatus (see
+/// ContractorStatus::SetCertifiedConstraints), so that ICP does not
+/// branch on the matched equalities in the box.
+///
+/// It only runs when the widths of the domains of the matched
+/// variables are at most `Config::newton_threshold()`.
+class ContractorNewton : public ContractorCell {
+ public:
+  /// The maximum number of Newton steps in a call of Prune.
+  static constexpr int kMaxIterations{10};
+
+  /// It stops iterating if a Newton step does not reduce the maximum
+  /// width of the domains by this ratio.
+  static constexpr double kMinReduction{0.1};
+
+  /// Deleted default constructor.
+  ContractorNewton() = delete;
+
+  /// Constructs a Newton contractor using the equalities in @p
+  /// formulas. A formula which is not an equality or which is not
+  /// differentiable is ignored.
+  ContractorNewton(const std::vector<Formula>& formulas, const Box& box,
+                   const Config& config);
+
+  /// Deleted copy constructor.
+  ContractorNewton(const ContractorNewton&) = delete;
+
+  /// Deleted move constructor.
+  ContractorNewton(ContractorNewton&&) = delete;
+
+  /// Deleted copy assign operator.
+  ContractorNewton& operator=(const ContractorNewton&) = delete;
+
+  /// Deleted move assign operator.
+  ContractorNewton& operator=(ContractorNewton&&) = delete;
+
+  ~ContractorNewton() override = default;
+
+  void Prune(ContractorStatus* cs) const override;
+
+  std::ostream& display(std::ostream& os) const override;
+
+  /// Returns true if it has no equality to use.
+  bool is_dummy() const;
+
+  /// Returns the size of the square system.
+  int size() const { return static_cast<int>(formulas_.size()); }
+
+ private:
+  // Applies a Gauss-Seidel step to @p iv. It sets @p certified true if
+  // it proves that @p iv has a unique solution. Returns false if it
+  // proves that @p iv has no solution.
+  bool Step(Box::IntervalVector* iv, bool* certified) const;
+
+  // formulas_[i] is the equality `fᵢ(x) = 0` matched with the variable
+  // whose index in the box is dims_[i].
+  std::vector<Formula> formulas_;
+  std::vector<int> dims_;
+
+  // The i-th root of functions_ is fᵢ and the (i * n + j)-th root of
+  // jacobian_ is ∂fᵢ/∂x_{dims_[j]}.
+  std::unique_ptr<const ExpressionTape> functions_;
+  std::unique_ptr<const ExpressionTape> jacobian_;
+};
+
+}  // namespace dreal
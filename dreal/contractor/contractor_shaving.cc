@@ -0,0 +1,172 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/contractor/contractor_shaving.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "dreal/util/assert.h"
+#include "dreal/util/logging.h"
+#include "dreal/util/stat.h"
+#include "dreal/util/timer.h"
+
+using std::cout;
+using std::ostream;
+
+namespace dreal {
+
+namespace {
+class ContractorShavingStat : public Stat {
+ public:
+  explicit ContractorShavingStat(const bool enabled) : Stat{enabled} {};
+  ContractorShavingStat(const ContractorShavingStat&) = delete;
+  ContractorShavingStat(ContractorShavingStat&&) = delete;
+  ContractorShavingStat& operator=(const ContractorShavingStat&) = delete;
+  ContractorShavingStat& operator=(ContractorShavingStat&&) = delete;
+  ~ContractorShavingStat() override {
+    if (enabled()) {
+      using fmt::print;
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of 3B Pruning",
+            "Pruning level", num_pruning_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of 3B Refuted Slices", "Pruning level",
+            num_refuted_slices_);
+      if (num_pruning_) {
+        print(cout, "{:<45} @ {:<20} = {:>15f} sec\n",
+              "Total time spent in 3B Pruning", "Pruning level",
+              timer_pruning_.seconds());
+      }
+    }
+  }
+
+  int num_pruning_{0};
+  int num_refuted_slices_{0};
+
+  Timer timer_pruning_;
+};
+
+// Adds the explanation of @p slice, whose box is refuted, into @p cs.
+void AddExplanation(const ContractorStatus& slice, ContractorStatus* const cs) {
+  for (const Formula& f : slice.Explanation()) {
+    cs->AddUsedConstraint(f);
+  }
+}
+}  // namespace
+
+bool IsShavable(const Box::Interval& iv, const double precision) {
+  return !iv.is_unbounded() && iv.is_bisectable() && iv.diam() >= precision;
+}
+
+ContractorShaving::ContractorShaving(Contractor contractor,
+                                     const int num_slices,
+                                     const Config& config)
+    : ContractorCell{Contractor::Kind::SHAVING, contractor.input(), config},
+      contractor_{std::move(contractor)},
+      num_slices_{num_slices} {
+  DREAL_ASSERT(num_slices_ >= 2);
+  if (contractor_.include_forall()) {
+    set_include_forall();
+  }
+}
+
+void ContractorShaving::Prune(ContractorStatus* cs) const {
+  thread_local ContractorShavingStat stat{DREAL_LOG_INFO_ENABLED};
+  TimerGuard timer_guard(&stat.timer_pruning_, stat.enabled());
+  if (stat.enabled()) {
+    stat.num_pruning_++;
+  }
+  contractor_.Prune(cs);
+  const DynamicBitset& in{input()};
+  for (DynamicBitset::size_type i = 0; i < in.size(); ++i) {
+    if (cs->box().empty()) {
+      return;
+    }
+    if (!in[i] || !IsShavable(cs->box()[i], config().precision())) {
+      continue;
+    }
+    const Box::Interval old_iv{cs->box()[i]};
+    const bool consistent{Shave(i, cs, &stat.num_refuted_slices_)};
+    if (!consistent) {
+      DREAL_LOG_DEBUG("ContractorShaving::Prune: {} is refuted.",
+                      cs->box().variable(i));
+      return;
+    }
+    if (cs->box()[i] != old_iv) {
+      cs->mutable_output().set(i);
+    }
+  }
+}
+
+bool ContractorShaving::Shave(const int i, ContractorStatus* const cs,
+                              int* const num_refuted_slices) const {
+  Box& box{cs->mutable_box()};
+  const Box::Interval iv{box[i]};
+  const double width{iv.diam() / num_slices_};
+
+  // 1. Shave from the left until we find a slice which is not refuted.
+  double lb{iv.ub()};
+  for (int k = 0; k < num_slices_; ++k) {
+    const double slice_lb{k == 0 ? iv.lb() : iv.lb() + k * width};
+    const double slice_ub{k == num_slices_ - 1 ? iv.ub()
+                                               : iv.lb() + (k + 1) * width};
+    ContractorStatus slice{box};
+    slice.mutable_box()[i] = Box::Interval(slice_lb, slice_ub);
+    contractor_.Prune(&slice);
+    if (!slice.box().empty()) {
+      lb = slice.box()[i].lb();
+      break;
+    }
+    ++*num_refuted_slices;
+    AddExplanation(slice, cs);
+    if (k == num_slices_ - 1) {
+      // All the slices are refuted.
+      box.set_empty();
+      cs->mutable_output().set();
+      return false;
+    }
+  }
+  box[i] = Box::Interval(lb, iv.ub());
+
+  // 2. Shave from the right down to `lb`. Even if all these slices are
+  // refuted, the point `lb` is kept since the first step could not
+  // refute it.
+  double ub{iv.ub()};
+  for (int k = 0; k < num_slices_; ++k) {
+    const double slice_ub{k == 0 ? iv.ub() : iv.ub() - k * width};
+    const double slice_lb{std::max(lb, iv.ub() - (k + 1) * width)};
+    if (slice_ub <= lb) {
+      break;
+    }
+    ContractorStatus slice{box};
+    slice.mutable_box()[i] = Box::Interval(slice_lb, slice_ub);
+    contractor_.Prune(&slice);
+    if (!slice.box().empty()) {
+      ub = slice.box()[i].ub();
+      break;
+    }
+    ++*num_refuted_slices;
+    AddExplanation(slice, cs);
+    ub = slice_lb;
+  }
+  box[i] = Box::Interval(lb, ub);
+  return true;
+}
+
+ostream& ContractorShaving::display(ostream& os) const {
+  return os << "Shaving(" << contractor_ << ", " << num_slices_ << ")";
+}
+
+}  // namespace dreal
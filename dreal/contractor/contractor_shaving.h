@@ -0,0 +1,80 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <ostream>
+
+#include "dreal/contractor/contractor.h"
+#include "dreal/contractor/contractor_cell.h"
+#include "dreal/util/box.h"
+
+namespace dreal {
+
+/// 3B (shaving) contractor built on top of a contractor C.
+///
+/// It first applies C. Then, for each input variable x of C, it cuts
+/// the domain of x into `num_slices` slices and tries to refute the
+/// left-most slice with C. If C empties the slice, the lower bound of
+/// x is moved to the upper bound of the slice and it tries the next
+/// one. The same is done from the right. This way, it removes the
+/// parts of the domains which C alone cannot remove as it only
+/// reasons about the bounds of the whole box.
+///
+/// Variables with unbounded domains or whose width is below the
+/// precision are not shaved.
+class ContractorShaving : public ContractorCell {
+ public:
+  /// Deletes default constructor.
+  ContractorShaving() = delete;
+
+  /// Constructs a 3B contractor which shaves with @p contractor. Each
+  /// domain is cut into @p num_slices slices.
+  ContractorShaving(Contractor contractor, int num_slices,
+                    const Config& config);
+
+  /// Deleted copy constructor.
+  ContractorShaving(const ContractorShaving&) = delete;
+
+  /// Deleted move constructor.
+  ContractorShaving(ContractorShaving&&) = delete;
+
+  /// Deleted copy assign operator.
+  ContractorShaving& operator=(const ContractorShaving&) = delete;
+
+  /// Deleted move assign operator.
+  ContractorShaving& operator=(ContractorShaving&&) = delete;
+
+  /// Default destructor.
+  ~ContractorShaving() override = default;
+
+  void Prune(ContractorStatus* cs) const override;
+  std::ostream& display(std::ostream& os) const override;
+
+ private:
+  // Shaves the i-th dimension of the box in @p cs from both sides and
+  // adds the number of refuted slices to @p num_refuted_slices.
+  // Returns false if the box becomes empty.
+  bool Shave(int i, ContractorStatus* cs, int* num_refuted_slices) const;
+
+  const Contractor contractor_;
+  const int num_slices_;
+};
+
+/// Returns true if we shave (or split) @p iv, whose width should be
+/// finite and not smaller than @p precision.
+bool IsShavable(const Box::Interval& iv, double precision);
+
+}  // namespace dreal
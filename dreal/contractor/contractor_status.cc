@@ -16,6 +16,7 @@
 #include "dreal/contractor/contractor_status.h"
 
 #include <atomic>
+#include <cmath>
 #include <utility>
 
 #include "dreal/util/assert.h"
@@ -65,6 +66,28 @@ class ContractorStatusStat : public Stat {
   std::atomic<int> num_explanation_generation_{0};
 };
 
+// The change magnitude given to a bound change which keeps the width
+// infinite, e.g. (-oo, oo) => [0, oo). Such a change has no relative
+// width reduction but is still worth propagating.
+constexpr double kUnboundedChange{0.5};
+
+// Returns the relative reduction from @p old_iv to @p new_iv.
+double RelativeReduction(const Box::Interval& old_iv,
+                         const Box::Interval& new_iv) {
+  const double old_width{old_iv.is_empty() ? 0.0 : old_iv.diam()};
+  const double new_width{new_iv.is_empty() ? 0.0 : new_iv.diam()};
+  if (std::isinf(old_width)) {
+    if (!std::isinf(new_width)) {
+      return 1.0;
+    }
+    return new_iv == old_iv ? 0.0 : kUnboundedChange;
+  }
+  if (!(new_width < old_width)) {
+    return 0.0;
+  }
+  return 1.0 - new_width / old_width;
+}
+
 }  // namespace
 
 ContractorStatus::ContractorStatus(Box box, const int branching_point)
@@ -87,6 +110,31 @@ const DynamicBitset& ContractorStatus::output() const { return output_; }
 
 DynamicBitset& ContractorStatus::mutable_output() { return output_; }
 
+void ContractorStatus::ResetChangeMagnitudes() {
+  const Box::IntervalVector& iv{box_.interval_vector()};
+  intervals_.resize(iv.size());
+  change_magnitudes_.assign(iv.size(), 0.0);
+  for (int i = 0; i < iv.size(); ++i) {
+    intervals_[i] = iv[i];
+  }
+}
+
+void ContractorStatus::UpdateChangeMagnitudes() {
+  DREAL_ASSERT(intervals_.size() == static_cast<size_t>(box_.size()));
+  const Box::IntervalVector& iv{box_.interval_vector()};
+  for (DynamicBitset::size_type i = output_.find_first();
+       i != DynamicBitset::npos; i = output_.find_next(i)) {
+    const Box::Interval interval{iv.is_empty() ? Box::Interval::EMPTY_SET
+                                               : iv[i]};
+    change_magnitudes_[i] = RelativeReduction(intervals_[i], interval);
+    intervals_[i] = interval;
+  }
+}
+
+const vector<double>& ContractorStatus::change_magnitudes() const {
+  return change_magnitudes_;
+}
+
 void ContractorStatus::AddUsedConstraint(const Formula& f) {
   DREAL_LOG_DEBUG("ContractorStatus::AddUsedConstraint({}) box is empty? {}", f,
                   box_.empty());
@@ -165,6 +213,22 @@ set<Formula> ContractorStatus::Explanation() const {
   return GenerateExplanation(unsat_witness_, used_constraints_);
 }
 
+set<Formula> ContractorStatus::Explanation(const Variables& variables) const {
+  return GenerateExplanation(variables, used_constraints_);
+}
+
+void ContractorStatus::SetCertifiedConstraints(
+    const vector<Formula>& formulas) {
+  certified_constraints_.clear();
+  certified_constraints_.insert(formulas.begin(), formulas.end());
+  certified_box_ = box_;
+}
+
+bool ContractorStatus::IsCertified(const Box& box, const Formula& f) const {
+  return !certified_constraints_.empty() &&
+         certified_constraints_.count(f) > 0 && box == certified_box_;
+}
+
 ContractorStatus& ContractorStatus::InplaceJoin(
     const ContractorStatus& contractor_status) {
   box_.InplaceUnion(contractor_status.box());
@@ -50,9 +50,35 @@ class ContractorStatus {
   /// Returns a mutable reference of the output field.
   DynamicBitset& mutable_output();
 
+  /// Takes a snapshot of the intervals of the box. The following calls
+  /// of UpdateChangeMagnitudes() measure the changes from it.
+  void ResetChangeMagnitudes();
+
+  /// For each dimension `i` set in output(), records the magnitude of
+  /// the change of `box()[i]` since the last call (or since
+  /// ResetChangeMagnitudes()) in `change_magnitudes()[i]`.
+  ///
+  /// @pre ResetChangeMagnitudes() has been called.
+  void UpdateChangeMagnitudes();
+
+  /// Returns the per-variable change magnitudes. `change_magnitudes()[i]`
+  /// is in [0, 1] where 0 means no change and 1 means that the width
+  /// is reduced from infinity to a finite value (or to zero). A bound
+  /// change which keeps the width infinite, e.g. (-∞, ∞) ⇒ [0, ∞), has
+  /// a positive magnitude as well.
+  /// Only the entries of the dimensions set in output() are updated by
+  /// the last UpdateChangeMagnitudes() call. It is empty if
+  /// ResetChangeMagnitudes() has not been called.
+  const std::vector<double>& change_magnitudes() const;
+
   /// Returns explanation, a list of formula responsible for the unsat.
   std::set<Formula> Explanation() const;
 
+  /// Returns a list of used constraints responsible for the domains of
+  /// @p variables in the box. It is computed in the same way as
+  /// Explanation() with @p variables as the unsat witness.
+  std::set<Formula> Explanation(const Variables& variables) const;
+
   /// Add a formula @p f into the used constraints.
   void AddUsedConstraint(const Formula& f);
 
@@ -62,6 +88,16 @@ class ContractorStatus {
   /// Add a variable @p var which is directly responsible for the unsat.
   void AddUnsatWitness(const Variable& var);
 
+  /// Records that the current box contains a solution of @p formulas
+  /// (for each value of the other variables in it). It replaces the
+  /// previous record.
+  void SetCertifiedConstraints(const std::vector<Formula>& formulas);
+
+  /// Returns true if @p f is recorded by the last
+  /// SetCertifiedConstraints() call and @p box is the box at that time.
+  /// ICP does not need to branch on @p f in @p box.
+  bool IsCertified(const Box& box, const Formula& f) const;
+
   /// Updates the contractor status by taking join with @p contractor_status.
   ///
   /// @pre The boxes of this and @p contractor_status have the same variables
@@ -84,6 +120,13 @@ class ContractorStatus {
   // changed after running the contractor.
   DynamicBitset output_;
 
+  // Intervals of the box when the change magnitudes were last updated
+  // and the relative width reductions since then. They are allocated on
+  // demand by ResetChangeMagnitudes() and used by the worklist
+  // contractors to prioritize their work.
+  std::vector<Box::Interval> intervals_;
+  std::vector<double> change_magnitudes_;
+
   // A set of constraints used during pruning processes. This is an
   // over-approximation of an explanation.
   std::set<Formula> used_constraints_;
@@ -91,6 +134,11 @@ class ContractorStatus {
   // A set of variables directly responsible for the unsat result. This
   // is used to generate an explanation.
   Variables unsat_witness_;
+
+  // The constraints which are certified to have a solution in
+  // certified_box_, e.g. by the interval Newton contractor.
+  std::set<Formula> certified_constraints_;
+  Box certified_box_;
 };
 
 /// Returns a join of @p contractor_status1 and @p contractor_status2.
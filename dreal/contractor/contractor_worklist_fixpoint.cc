@@ -17,6 +17,7 @@
 
 #include <algorithm>  // To suppress cpplint
 #include <cmath>
+#include <queue>
 #include <utility>
 
 #include "dreal/util/assert.h"
@@ -38,6 +39,100 @@ void UpdateWorklist(const DynamicBitset& output,
     i_bit = output.find_next(i_bit);
   }
 }
+
+// A contractor in a PriorityWorklist and its priority.
+struct WorklistEntry {
+  double priority;
+  size_t index;
+};
+
+// Higher priority comes first. Among the entries of the same
+// priority, the one with the smaller index comes first.
+bool operator<(const WorklistEntry& lhs, const WorklistEntry& rhs) {
+  if (lhs.priority != rhs.priority) {
+    return lhs.priority < rhs.priority;
+  }
+  return lhs.index > rhs.index;
+}
+
+// Worklist of contractors ordered by priorities. Raising the priority
+// of a scheduled contractor pushes a new entry and the old one becomes
+// stale. Stale entries are skipped when they reach the top.
+class PriorityWorklist {
+ public:
+  explicit PriorityWorklist(const size_t size) : priorities_(size, -1.0) {}
+
+  // Schedules the i-th contractor with @p priority. If it is already
+  // scheduled, its priority becomes the max of the two.
+  void Push(const size_t i, const double priority) {
+    if (priority > priorities_[i]) {
+      priorities_[i] = priority;
+      queue_.push({priority, i});
+    }
+  }
+
+  // Removes the contractor of the highest priority and returns its
+  // index.
+  // @pre !empty()
+  size_t Pop() {
+    DropStaleEntries();
+    const size_t i{queue_.top().index};
+    queue_.pop();
+    priorities_[i] = -1.0;
+    return i;
+  }
+
+  bool empty() {
+    DropStaleEntries();
+    return queue_.empty();
+  }
+
+ private:
+  void DropStaleEntries() {
+    while (!queue_.empty() &&
+           queue_.top().priority != priorities_[queue_.top().index]) {
+      queue_.pop();
+    }
+  }
+
+  // priorities_[i] is the priority of the i-th contractor if it is
+  // scheduled. Otherwise, it is -1.0.
+  std::vector<double> priorities_;
+  std::priority_queue<WorklistEntry> queue_;
+};
+
+// Prunes @p cs with @p contractor and schedules the contractors which
+// depend on the changed variables in @p worklist. Returns false if the
+// box becomes empty.
+bool PruneAndSchedule(const Contractor& contractor,
+                      const vector<DynamicBitset>& input_to_contractors,
+                      const vector<double>& costs, ContractorStatus* const cs,
+                      PriorityWorklist* const worklist) {
+  // TODO(soonho): Need to save cs->output() and restore after
+  // running this function. For now, it should be OK since we do not
+  // call ContractorWorklistFixpoint::Prune() recursively.
+  cs->mutable_output().reset();
+  contractor.Prune(cs);
+  if (cs->box().empty()) {
+    return false;
+  }
+  cs->UpdateChangeMagnitudes();
+  const DynamicBitset& output{cs->output()};
+  const vector<double>& magnitudes{cs->change_magnitudes()};
+  for (DynamicBitset::size_type i = output.find_first();
+       i != DynamicBitset::npos; i = output.find_next(i)) {
+    // The i-th variable is not changed.
+    if (!(magnitudes[i] > 0.0)) {
+      continue;
+    }
+    const DynamicBitset& contractors{input_to_contractors[i]};
+    for (DynamicBitset::size_type j = contractors.find_first();
+         j != DynamicBitset::npos; j = contractors.find_next(j)) {
+      worklist->Push(j, magnitudes[i] / costs[j]);
+    }
+  }
+  return true;
+}
 }  // namespace
 
 ContractorWorklistFixpoint::ContractorWorklistFixpoint(
@@ -59,13 +154,15 @@ ContractorWorklistFixpoint::ContractorWorklistFixpoint(
     }
   }
 
-  // Setup input_to_contractors_.
+  // Setup input_to_contractors_ and costs_.
+  costs_.reserve(contractors_.size());
   for (size_t j = 0; j < contractors_.size(); ++j) {
     for (size_t i = 0; i < contractors_[j].input().size(); ++i) {
       if (contractors_[j].input()[i]) {
         input_to_contractors_[i].set(j);
       }
     }
+    costs_.push_back(std::max<double>(1.0, contractors_[j].input().count()));
   }
 }
 
@@ -88,28 +185,20 @@ while ¬Q.empty() ∧ ¬TermCond(b, b'):
         Q.push({ctc ∣ ctc ∈ Ctc ∧ i ∈ ctc.input()})
 */
 void ContractorWorklistFixpoint::Prune(ContractorStatus* cs) const {
-  // worklist[i] means that i-th contractor in contractors_ needs to be
-  // applied.
-  DynamicBitset worklist(contractors_.size());
+  PriorityWorklist worklist(contractors_.size());
   const int branching_point = cs->branching_point();
 
-  // DREAL_LOG_ERROR("ContractorWorklistFixpoint::Prune -- Fill the Queue");
   // 1. Fill the queue.
   const Box::IntervalVector& iv{cs->box().interval_vector()};
   Box::IntervalVector old_iv{iv};
+  cs->ResetChangeMagnitudes();
   if (branching_point < 0) {
     // No branching_point information specified, add all contractors.
     for (const auto& contractor : contractors_) {
-      // TODO(soonho): Need to save cs->output() and restore after
-      // running UpdateWorklist() below. For now, it should be OK
-      // since we do not call ContractorWorklistFixpoint::Prune()
-      // recursively.
-      cs->mutable_output().reset();
-      contractor.Prune(cs);
-      if (cs->box().empty()) {
+      if (!PruneAndSchedule(contractor, input_to_contractors_, costs_, cs,
+                            &worklist)) {
         return;
       }
-      UpdateWorklist(cs->output(), input_to_contractors_, &worklist);
     }
   } else {
     DREAL_ASSERT(static_cast<size_t>(branching_point) <
@@ -119,40 +208,30 @@ void ContractorWorklistFixpoint::Prune(ContractorStatus* cs) const {
 
     DynamicBitset::size_type i_bit = contractors_to_check.find_first();
     while (i_bit != DynamicBitset::npos) {
-      cs->mutable_output().reset();
-      contractors_[i_bit].Prune(cs);
-      if (cs->box().empty()) {
+      if (!PruneAndSchedule(contractors_[i_bit], input_to_contractors_,
+                            costs_, cs, &worklist)) {
         return;
       }
-      UpdateWorklist(cs->output(), input_to_contractors_, &worklist);
       i_bit = contractors_to_check.find_next(i_bit);
     }
   }
-  if (worklist.none() || term_cond_(old_iv, iv)) {
+  if (worklist.empty() || term_cond_(old_iv, iv)) {
     return;
   }
 
-  // 2. Run worklist algorithm
+  // 2. Run worklist algorithm. Each sweep applies at most
+  // contractors_.size() contractors of the highest priorities. It stops
+  // when the worklist becomes empty or when a sweep does not improve
+  // the box enough (term_cond_).
   do {
-    DynamicBitset::size_type ctc_idx = worklist.find_first();
     old_iv = iv;
-    while (true) {
-      worklist.set(ctc_idx, false);
-      cs->mutable_output().reset();
-      contractors_[ctc_idx].Prune(cs);
-      if (cs->box().empty()) {
-        return;
-      }
-      UpdateWorklist(cs->output(), input_to_contractors_, &worklist);
-      if (worklist.none()) {
+    for (size_t n = 0; n < contractors_.size() && !worklist.empty(); ++n) {
+      if (!PruneAndSchedule(contractors_[worklist.Pop()],
+                            input_to_contractors_, costs_, cs, &worklist)) {
         return;
       }
-      ctc_idx = worklist.find_next(ctc_idx);
-      if (ctc_idx == DynamicBitset::npos) {
-        ctc_idx = worklist.find_first();
-      }
     }
-  } while (!term_cond_(old_iv, iv));
+  } while (!worklist.empty() && !term_cond_(old_iv, iv));
 }
 
 ostream& ContractorWorklistFixpoint::display(ostream& os) const {
@@ -27,6 +27,19 @@ namespace dreal {
 /// Fixpoint contractor using the worklist algorithm: apply C₁, ..., Cₙ
 /// until it reaches a fixpoint or it satisfies a given termination
 /// condition.
+///
+/// The worklist is a priority queue. When a pruning step changes the
+/// i-th variable, every Cⱼ whose input includes i is scheduled with
+/// the priority `m / cost(Cⱼ)` where `m` is the relative width
+/// reduction of the i-th variable (see
+/// ContractorStatus::change_magnitudes()) and `cost(Cⱼ)` is the number
+/// of its input variables. A scheduled contractor keeps the highest
+/// priority it is given, and ties are broken by the index. A change
+/// which does not reduce the width of a variable schedules nothing.
+///
+/// The contractors are applied in sweeps of at most n steps. After
+/// each sweep, it stops if the termination condition holds for the
+/// boxes before and after the sweep.
 class ContractorWorklistFixpoint : public ContractorCell {
  public:
   /// Deletes default constructor.
@@ -71,6 +84,10 @@ class ContractorWorklistFixpoint : public ContractorCell {
   // because i ∈ contractors_[j].input(). This map is constructed in
   // the constructor.
   std::vector<DynamicBitset> input_to_contractors_;
+
+  // costs_[j] = max(1, |contractors_[j].input()|). It is a static
+  // estimate of the cost of running contractors_[j].
+  std::vector<double> costs_;
 };
 
 class ContractorWorklistApproxFixpoint : public ContractorCell {
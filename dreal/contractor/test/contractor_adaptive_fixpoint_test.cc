@@ -0,0 +1,106 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/contractor/contractor_adaptive_fixpoint.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dreal/contractor/contractor_status.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+
+namespace dreal {
+namespace {
+
+using std::vector;
+
+class ContractorAdaptiveFixpointTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    box_[x_] = Box::Interval(0.0, 10.0);
+    box_[y_] = Box::Interval(0.0, 10.0);
+    box_[z_] = Box::Interval(0.0, 10.0);
+  }
+
+  vector<Contractor> MakeContractors(const vector<Formula>& formulas) const {
+    vector<Contractor> ctcs;
+    for (const Formula& f : formulas) {
+      ctcs.push_back(make_contractor_hc4(f, box_, config_));
+    }
+    return ctcs;
+  }
+
+  const Variable x_{"x", Variable::Type::CONTINUOUS};
+  const Variable y_{"y", Variable::Type::CONTINUOUS};
+  const Variable z_{"z", Variable::Type::CONTINUOUS};
+  Box box_{{x_, y_, z_}};
+  const Config config_;
+};
+
+// It computes the same box as the plain fixpoint contractor.
+TEST_F(ContractorAdaptiveFixpointTest, SameAsFixpoint) {
+  const vector<Contractor> ctcs{MakeContractors({x_ + y_ == 4, x_ - y_ == 1})};
+  const Contractor fixpoint{
+      make_contractor_fixpoint(DefaultTerminationCondition(), ctcs, config_)};
+  const Contractor adaptive{make_contractor_adaptive_fixpoint(
+      DefaultTerminationCondition(), ctcs, config_)};
+  EXPECT_TRUE(is_adaptive_fixpoint(adaptive));
+
+  ContractorStatus cs_fixpoint{box_};
+  ContractorStatus cs_adaptive{box_};
+  fixpoint.Prune(&cs_fixpoint);
+  adaptive.Prune(&cs_adaptive);
+  EXPECT_EQ(cs_fixpoint.box(), cs_adaptive.box());
+  EXPECT_EQ(cs_fixpoint.output(), cs_adaptive.output());
+  EXPECT_TRUE(cs_adaptive.output()[0]);
+  EXPECT_TRUE(cs_adaptive.output()[1]);
+  EXPECT_FALSE(cs_adaptive.output()[2]);
+}
+
+TEST_F(ContractorAdaptiveFixpointTest, Unsat) {
+  const Contractor adaptive{make_contractor_adaptive_fixpoint(
+      DefaultTerminationCondition(), MakeContractors({x_ + y_ >= 30, z_ >= 1}),
+      config_)};
+  ContractorStatus cs{box_};
+  adaptive.Prune(&cs);
+  EXPECT_TRUE(cs.box().empty());
+}
+
+// A contractor which never prunes the box loses its gain while the
+// one which prunes keeps it. Skipping the former does not change the
+// result.
+TEST_F(ContractorAdaptiveFixpointTest, Gain) {
+  const Contractor adaptive{make_contractor_adaptive_fixpoint(
+      DefaultTerminationCondition(), MakeContractors({x_ + z_ <= 100, y_ <= 1}),
+      config_)};
+  const auto ctc = to_adaptive_fixpoint(adaptive);
+  for (int i = 0; i < 100; ++i) {
+    ContractorStatus cs{box_};
+    adaptive.Prune(&cs);
+    EXPECT_EQ(cs.box()[x_], box_[x_]);
+    EXPECT_EQ(cs.box()[y_], Box::Interval(0.0, 1.0));
+    EXPECT_EQ(cs.box()[z_], box_[z_]);
+    EXPECT_FALSE(cs.output()[0]);
+    EXPECT_TRUE(cs.output()[1]);
+  }
+  EXPECT_LT(ctc->gain(0), ContractorAdaptiveFixpoint::kSkipThreshold);
+  EXPECT_GT(ctc->gain(1), ContractorAdaptiveFixpoint::kSkipThreshold);
+  EXPECT_GE(ctc->cost(0), 0.0);
+}
+
+}  // namespace
+}  // namespace dreal
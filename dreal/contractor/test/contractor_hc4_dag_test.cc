@@ -0,0 +1,119 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/contractor/contractor_hc4_dag.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dreal/contractor/contractor_status.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+
+namespace dreal {
+namespace {
+
+using std::vector;
+
+class ContractorHc4DagTest : public ::testing::Test {
+ protected:
+  const Variable x_{"x", Variable::Type::CONTINUOUS};
+  const Variable y_{"y", Variable::Type::CONTINUOUS};
+  const Variable z_{"z", Variable::Type::CONTINUOUS};
+  const vector<Variable> vars_{{x_, y_, z_}};
+  Box box_{vars_};
+};
+
+TEST_F(ContractorHc4DagTest, Sat) {
+  // x + y = 4 and x - y = 0.
+  const vector<Formula> formulas{x_ + y_ == 4, x_ - y_ == 0};
+  box_[x_] = Box::Interval(-1.0, 2.0);
+  box_[y_] = Box::Interval(0.0, 3.0);
+  box_[z_] = Box::Interval(0.0, 1.0);
+  ContractorStatus cs{box_};
+  const ContractorHc4Dag ctc{formulas, box_, Config{}};
+
+  // Inputs
+  EXPECT_TRUE(ctc.input()[0]);
+  EXPECT_TRUE(ctc.input()[1]);
+  EXPECT_FALSE(ctc.input()[2]);
+
+  ctc.Prune(&cs);
+
+  EXPECT_EQ(cs.box()[x_], Box::Interval(2.0));
+  EXPECT_EQ(cs.box()[y_], Box::Interval(2.0));
+  EXPECT_EQ(cs.box()[z_], Box::Interval(0.0, 1.0));
+  EXPECT_TRUE(cs.output()[0]);
+  EXPECT_TRUE(cs.output()[1]);
+  EXPECT_FALSE(cs.output()[2]);
+}
+
+TEST_F(ContractorHc4DagTest, Unsat) {
+  const vector<Formula> formulas{sin(x_) == y_, x_ <= 10};
+  box_[x_] = Box::Interval(0.1, 0.2);
+  box_[y_] = Box::Interval(0.2, 0.3);
+  ContractorStatus cs{box_};
+  const ContractorHc4Dag ctc{formulas, box_, Config{}};
+
+  ctc.Prune(&cs);
+
+  EXPECT_TRUE(cs.box().empty());
+  EXPECT_TRUE(cs.output()[0]);
+  EXPECT_TRUE(cs.output()[1]);
+  EXPECT_TRUE(cs.output()[2]);
+}
+
+TEST_F(ContractorHc4DagTest, NoChange) {
+  const vector<Formula> formulas{x_ + y_ <= 10, x_ * y_ >= -10};
+  box_[x_] = Box::Interval(0.0, 1.0);
+  box_[y_] = Box::Interval(0.0, 1.0);
+  ContractorStatus cs{box_};
+  const ContractorHc4Dag ctc{formulas, box_, Config{}};
+
+  ctc.Prune(&cs);
+
+  EXPECT_EQ(cs.box(), box_);
+  EXPECT_TRUE(cs.output().none());
+}
+
+TEST_F(ContractorHc4DagTest, Dummy) {
+  EXPECT_TRUE((ContractorHc4Dag{{x_ != y_}, box_, Config{}}.is_dummy()));
+  EXPECT_FALSE(
+      (ContractorHc4Dag{{x_ != y_, x_ == y_}, box_, Config{}}.is_dummy()));
+  EXPECT_TRUE(is_id(make_contractor_hc4_dag({x_ != y_}, box_, Config{})));
+  EXPECT_TRUE(
+      is_hc4_dag(make_contractor_hc4_dag({x_ == y_}, box_, Config{})));
+}
+
+// The value of a shared sub-expression, which is narrowed by the
+// backward pass of a constraint, is used by the later constraints.
+TEST_F(ContractorHc4DagTest, SharedSubexpression) {
+  // x * y is a single node in the DAG.
+  const vector<Formula> formulas{x_ * y_ >= 4, z_ == x_ * y_};
+  box_[x_] = Box::Interval(0.0, 2.0);
+  box_[y_] = Box::Interval(0.0, 2.0);
+  box_[z_] = Box::Interval(-10.0, 10.0);
+  ContractorStatus cs{box_};
+  ContractorHc4Dag{formulas, box_, Config{}}.Prune(&cs);
+
+  // x * y ≥ 4 ⇒ x * y = 4, x = 2, y = 2 ⇒ z = 4.
+  EXPECT_EQ(cs.box()[x_], Box::Interval(2.0));
+  EXPECT_EQ(cs.box()[y_], Box::Interval(2.0));
+  EXPECT_EQ(cs.box()[z_], Box::Interval(4.0));
+}
+
+}  // namespace
+}  // namespace dreal
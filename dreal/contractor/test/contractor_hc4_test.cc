@@ -0,0 +1,178 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/contractor/contractor_hc4.h"
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dreal/contractor/contractor_ibex_fwdbwd.h"
+#include "dreal/contractor/contractor_status.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+
+namespace dreal {
+namespace {
+
+using std::thread;
+using std::vector;
+
+class ContractorHc4Test : public ::testing::Test {
+ protected:
+  const Variable x_{"x", Variable::Type::CONTINUOUS};
+  const Variable y_{"y", Variable::Type::CONTINUOUS};
+  const Variable z_{"z", Variable::Type::CONTINUOUS};
+  const vector<Variable> vars_{{x_, y_, z_}};
+  Box box_{vars_};
+};
+
+TEST_F(ContractorHc4Test, Sat) {
+  const Formula f{cos(x_) == sin(y_)};
+  box_[x_] = Box::Interval(0.0, 3.14 / 2);
+  box_[y_] = Box::Interval(0.2, 0.3);
+  box_[z_] = Box::Interval(0.0, 1.0);
+  ContractorStatus cs{box_};
+  const ContractorHc4 ctc{f, box_, Config{}};
+
+  // Inputs
+  EXPECT_TRUE(ctc.input()[0]);
+  EXPECT_TRUE(ctc.input()[1]);
+  EXPECT_FALSE(ctc.input()[2]);
+
+  ctc.Prune(&cs);
+
+  // x : [1.2708, 1.3708]
+  // y : [0.2, 0.3]
+  // z : [0.0, 1.0]
+  EXPECT_FALSE(cs.box().empty());
+  EXPECT_TRUE(cs.box()[x_].is_subset(Box::Interval(1.270, 1.371)));
+  EXPECT_EQ(cs.box()[y_], Box::Interval(0.2, 0.3));
+  EXPECT_EQ(cs.box()[z_], Box::Interval(0.0, 1.0));
+
+  // Outputs. Only x-dimension is changed.
+  EXPECT_TRUE(cs.output()[0]);
+  EXPECT_FALSE(cs.output()[1]);
+  EXPECT_FALSE(cs.output()[2]);
+}
+
+TEST_F(ContractorHc4Test, Unsat) {
+  const Formula f{sin(x_) == y_};
+  box_[x_] = Box::Interval(0.1, 0.2);
+  box_[y_] = Box::Interval(0.2, 0.3);
+  box_[z_] = Box::Interval(0.0, 1.0);
+  ContractorStatus cs{box_};
+  const ContractorHc4 ctc{f, box_, Config{}};
+
+  ctc.Prune(&cs);
+
+  // After pruning, the box is empty and all dimensions are changed.
+  EXPECT_TRUE(cs.box().empty());
+  EXPECT_TRUE(cs.output()[0]);
+  EXPECT_TRUE(cs.output()[1]);
+  EXPECT_TRUE(cs.output()[2]);
+}
+
+TEST_F(ContractorHc4Test, NoChange) {
+  const Formula f{x_ + y_ <= 10};
+  box_[x_] = Box::Interval(0.0, 1.0);
+  box_[y_] = Box::Interval(0.0, 1.0);
+  ContractorStatus cs{box_};
+  const ContractorHc4 ctc{f, box_, Config{}};
+
+  ctc.Prune(&cs);
+
+  EXPECT_EQ(cs.box(), box_);
+  EXPECT_TRUE(cs.output().none());
+}
+
+TEST_F(ContractorHc4Test, Negation) {
+  // ¬(x ≥ y + 1) ⇔ x < y + 1.
+  const Formula f{!(x_ >= y_ + 1)};
+  box_[x_] = Box::Interval(0.0, 10.0);
+  box_[y_] = Box::Interval(0.0, 2.0);
+  ContractorStatus cs{box_};
+  const ContractorHc4 ctc{f, box_, Config{}};
+
+  ctc.Prune(&cs);
+
+  EXPECT_EQ(cs.box()[x_], Box::Interval(0.0, 3.0));
+  EXPECT_EQ(cs.box()[y_], Box::Interval(0.0, 2.0));
+}
+
+TEST_F(ContractorHc4Test, Dummy) {
+  EXPECT_TRUE((ContractorHc4{x_ != y_, box_, Config{}}.is_dummy()));
+  EXPECT_TRUE((ContractorHc4{!(x_ == y_), box_, Config{}}.is_dummy()));
+  EXPECT_FALSE((ContractorHc4{!(x_ != y_), box_, Config{}}.is_dummy()));
+  EXPECT_TRUE(is_id(make_contractor_hc4(x_ != y_, box_, Config{})));
+  EXPECT_TRUE(is_hc4(make_contractor_hc4(x_ == y_, box_, Config{})));
+}
+
+// Checks that HC4 computes the same result as IBEX's forward/backward
+// contractor.
+TEST_F(ContractorHc4Test, CompareWithIbex) {
+  const vector<Formula> formulas{
+      x_ * y_ + exp(z_) >= 3,
+      pow(x_, 3) - 2 * y_ == z_,
+      atan2(y_, x_) <= 0.5,
+      sqrt(x_ + y_) + abs(z_) < 2,
+      min(x_, y_) + max(y_, z_) == 1,
+  };
+  box_[x_] = Box::Interval(0.5, 3.0);
+  box_[y_] = Box::Interval(0.1, 2.0);
+  box_[z_] = Box::Interval(-1.0, 1.0);
+  for (const Formula& f : formulas) {
+    ContractorStatus cs_hc4{box_};
+    ContractorStatus cs_ibex{box_};
+    ContractorHc4{f, box_, Config{}}.Prune(&cs_hc4);
+    ContractorIbexFwdbwd{f, box_, Config{}}.Prune(&cs_ibex);
+    for (int i = 0; i < box_.size(); ++i) {
+      EXPECT_NEAR(cs_hc4.box()[i].lb(), cs_ibex.box()[i].lb(), 1e-9) << f;
+      EXPECT_NEAR(cs_hc4.box()[i].ub(), cs_ibex.box()[i].ub(), 1e-9) << f;
+    }
+  }
+}
+
+// A contractor is shared by multiple threads.
+TEST_F(ContractorHc4Test, MultipleThreads) {
+  const Formula f{cos(x_) == sin(y_)};
+  box_[x_] = Box::Interval(0.0, 3.14 / 2);
+  box_[y_] = Box::Interval(0.2, 0.3);
+  const ContractorHc4 ctc{f, box_, Config{}};
+  ContractorStatus expected{box_};
+  ctc.Prune(&expected);
+
+  vector<thread> threads;
+  vector<Box> results(4);
+  for (Box& result : results) {
+    threads.emplace_back([this, &ctc, &result]() {
+      for (int i = 0; i < 100; ++i) {
+        ContractorStatus cs{box_};
+        ctc.Prune(&cs);
+        result = cs.box();
+      }
+    });
+  }
+  for (thread& t : threads) {
+    t.join();
+  }
+  for (const Box& result : results) {
+    EXPECT_EQ(result, expected.box());
+  }
+}
+
+}  // namespace
+}  // namespace dreal
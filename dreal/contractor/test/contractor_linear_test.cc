@@ -0,0 +1,124 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/contractor/contractor_linear.h"
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dreal/contractor/contractor.h"
+#include "dreal/contractor/contractor_status.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+
+namespace dreal {
+namespace {
+
+using std::numeric_limits;
+using std::pair;
+using std::vector;
+
+class ContractorLinearTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    box_[x_] = Box::Interval(0.0, 10.0);
+    box_[y_] = Box::Interval(0.0, 10.0);
+    box_[z_] = Box::Interval(0.0, 10.0);
+  }
+
+  const Variable x_{"x", Variable::Type::CONTINUOUS};
+  const Variable y_{"y", Variable::Type::CONTINUOUS};
+  const Variable z_{"z", Variable::Type::CONTINUOUS};
+  Box box_{{x_, y_, z_}};
+  const Config config_;
+};
+
+TEST_F(ContractorLinearTest, Extract) {
+  vector<pair<int, Box::Interval>> terms;
+  Box::Interval range;
+
+  // 2x - 3y + 1 <= 2x + 5  ⇔  -3y ∈ [-∞, 4].
+  EXPECT_TRUE(ExtractLinearConstraint(2 * x_ - 3 * y_ + 1 <= 2 * x_ + 5, box_,
+                                      &terms, &range));
+  ASSERT_EQ(terms.size(), 1);
+  EXPECT_EQ(terms[0].first, 1 /* y */);
+  EXPECT_EQ(terms[0].second, Box::Interval(-3.0));
+  EXPECT_EQ(range.lb(), -numeric_limits<double>::infinity());
+  EXPECT_EQ(range.ub(), 4.0);
+
+  // Non-linear constraints.
+  EXPECT_FALSE(ExtractLinearConstraint(x_ * y_ <= 3, box_, &terms, &range));
+  EXPECT_FALSE(ExtractLinearConstraint(sin(x_) == 0, box_, &terms, &range));
+  // Disequalities are not used in pruning.
+  EXPECT_FALSE(ExtractLinearConstraint(x_ + y_ != 3, box_, &terms, &range));
+}
+
+TEST_F(ContractorLinearTest, Propagation) {
+  const Contractor ctc{make_contractor_linear(
+      {x_ + y_ == 4, x_ - y_ >= 2, z_ >= 2 * x_ + 1}, box_, config_)};
+  EXPECT_TRUE(is_linear(ctc));
+  ContractorStatus cs{box_};
+  ctc.Prune(&cs);
+  const Box& box{cs.box()};
+  // The fixpoint of the bound propagation is x ∈ [2, 4], y ∈ [0, 2],
+  // and z ∈ [5, 10].
+  EXPECT_NEAR(box[x_].lb(), 2.0, 1e-9);
+  EXPECT_NEAR(box[x_].ub(), 4.0, 1e-9);
+  EXPECT_NEAR(box[y_].lb(), 0.0, 1e-9);
+  EXPECT_NEAR(box[y_].ub(), 2.0, 1e-9);
+  EXPECT_NEAR(box[z_].lb(), 5.0, 1e-9);
+  EXPECT_NEAR(box[z_].ub(), 10.0, 1e-9);
+  // The result is sound.
+  EXPECT_LE(box[x_].lb(), 2.0);
+  EXPECT_GE(box[y_].ub(), 2.0);
+  EXPECT_LE(box[z_].lb(), 5.0);
+  EXPECT_TRUE(cs.output()[0]);
+  EXPECT_TRUE(cs.output()[1]);
+  EXPECT_TRUE(cs.output()[2]);
+}
+
+TEST_F(ContractorLinearTest, Unsat) {
+  const Contractor ctc{make_contractor_linear(
+      {x_ + y_ + z_ >= 25, x_ + y_ <= 5, z_ <= 2 * y_ + 1}, box_, config_)};
+  ContractorStatus cs{box_};
+  ctc.Prune(&cs);
+  EXPECT_TRUE(cs.box().empty());
+  EXPECT_FALSE(cs.Explanation().empty());
+}
+
+TEST_F(ContractorLinearTest, Unbounded) {
+  box_[y_] = Box::Interval(0.0, numeric_limits<double>::infinity());
+  const Contractor ctc{
+      make_contractor_linear({x_ + y_ <= 5, z_ - y_ >= 0}, box_, config_)};
+  ContractorStatus cs{box_};
+  ctc.Prune(&cs);
+  // y becomes bounded by the first row, and then z is not changed
+  // by the second row.
+  EXPECT_NEAR(cs.box()[y_].ub(), 5.0, 1e-9);
+  EXPECT_GE(cs.box()[y_].ub(), 5.0);
+  EXPECT_EQ(cs.box()[z_], box_[z_]);
+}
+
+TEST_F(ContractorLinearTest, NonLinearIgnored) {
+  const Contractor ctc{
+      make_contractor_linear({x_ * y_ >= 200, sin(z_) == 2}, box_, config_)};
+  EXPECT_TRUE(is_id(ctc));
+}
+
+}  // namespace
+}  // namespace dreal
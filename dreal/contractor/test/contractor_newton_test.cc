@@ -0,0 +1,114 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/contractor/contractor_newton.h"
+
+#include <gtest/gtest.h>
+
+#include "dreal/contractor/contractor.h"
+#include "dreal/contractor/contractor_status.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+
+namespace dreal {
+namespace {
+
+class ContractorNewtonTest : public ::testing::Test {
+ protected:
+  void SetUp() override { config_.mutable_newton_threshold() = 1.0; }
+
+  const Variable x_{"x", Variable::Type::CONTINUOUS};
+  const Variable y_{"y", Variable::Type::CONTINUOUS};
+  const Variable z_{"z", Variable::Type::CONTINUOUS};
+  Box box_{{x_, y_, z_}};
+  Config config_;
+
+  // The unique solution of (f1 ∧ f2) is x = y = 1 for x, y > 0.
+  const Formula f1_{x_ * x_ + y_ * y_ == 2};
+  const Formula f2_{x_ - y_ == 0};
+};
+
+TEST_F(ContractorNewtonTest, Converge) {
+  box_[x_] = Box::Interval(0.9, 1.1);
+  box_[y_] = Box::Interval(0.8, 1.2);
+  const Contractor ctc{
+      make_contractor_newton({f1_, f2_, z_ >= x_}, box_, config_)};
+  ASSERT_TRUE(is_newton(ctc));
+  EXPECT_EQ(to_newton(ctc)->size(), 2);
+  ContractorStatus cs{box_};
+  ctc.Prune(&cs);
+  const Box& box{cs.box()};
+  EXPECT_TRUE(box[x_].contains(1.0));
+  EXPECT_TRUE(box[y_].contains(1.0));
+  EXPECT_LT(box[x_].diam(), 1e-10);
+  EXPECT_LT(box[y_].diam(), 1e-10);
+  EXPECT_EQ(box[z_], box_[z_]);
+  EXPECT_TRUE(cs.output()[0]);
+  EXPECT_TRUE(cs.output()[1]);
+  EXPECT_FALSE(cs.output()[2]);
+
+  // The box is certified to have a solution of f1 and f2.
+  EXPECT_TRUE(cs.IsCertified(box, f1_));
+  EXPECT_TRUE(cs.IsCertified(box, f2_));
+  EXPECT_FALSE(cs.IsCertified(box, z_ >= x_));
+  // The certificate is only for the box.
+  EXPECT_FALSE(cs.IsCertified(box_, f1_));
+}
+
+TEST_F(ContractorNewtonTest, Unsat) {
+  box_[x_] = Box::Interval(1.2, 1.3);
+  box_[y_] = Box::Interval(1.2, 1.3);
+  const Contractor ctc{make_contractor_newton({f1_, f2_}, box_, config_)};
+  ContractorStatus cs{box_};
+  ctc.Prune(&cs);
+  EXPECT_TRUE(cs.box().empty());
+  EXPECT_FALSE(cs.Explanation().empty());
+}
+
+TEST_F(ContractorNewtonTest, Threshold) {
+  box_[x_] = Box::Interval(0.0, 10.0);
+  box_[y_] = Box::Interval(0.0, 10.0);
+  const Contractor ctc{make_contractor_newton({f1_, f2_}, box_, config_)};
+  ContractorStatus cs{box_};
+  ctc.Prune(&cs);
+  EXPECT_EQ(cs.box(), box_);
+  EXPECT_TRUE(cs.output().none());
+  EXPECT_FALSE(cs.IsCertified(cs.box(), f1_));
+}
+
+// x + y² = 1 has one equality and two variables. The unmatched
+// variable is used as a parameter.
+TEST_F(ContractorNewtonTest, Parameter) {
+  box_[x_] = Box::Interval(0.0, 0.5);
+  box_[y_] = Box::Interval(0.9, 0.95);
+  const Contractor ctc{
+      make_contractor_newton({x_ + y_ * y_ == 1}, box_, config_)};
+  ASSERT_TRUE(is_newton(ctc));
+  EXPECT_EQ(to_newton(ctc)->size(), 1);
+  ContractorStatus cs{box_};
+  ctc.Prune(&cs);
+  // x ∈ 1 - [0.81, 0.9025].
+  EXPECT_NEAR(cs.box()[x_].lb(), 0.0975, 1e-9);
+  EXPECT_NEAR(cs.box()[x_].ub(), 0.19, 1e-9);
+  EXPECT_EQ(cs.box()[y_], box_[y_]);
+}
+
+TEST_F(ContractorNewtonTest, NoEquality) {
+  EXPECT_TRUE(
+      is_id(make_contractor_newton({x_ >= y_, x_ + y_ != 3}, box_, config_)));
+}
+
+}  // namespace
+}  // namespace dreal
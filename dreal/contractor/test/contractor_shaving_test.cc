@@ -0,0 +1,137 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/contractor/contractor_shaving.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dreal/contractor/contractor_acid.h"
+#include "dreal/contractor/contractor_cid.h"
+#include "dreal/contractor/contractor_status.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+
+namespace dreal {
+namespace {
+
+using std::vector;
+
+// Tests ContractorShaving (3B), ContractorCid, and ContractorAcid.
+class ContractorShavingTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    box_[x_] = Box::Interval(-10.0, 10.0);
+    box_[y_] = Box::Interval(-10.0, 10.0);
+  }
+
+  Contractor MakeFixpoint(const vector<Formula>& formulas) const {
+    vector<Contractor> ctcs;
+    for (const Formula& f : formulas) {
+      ctcs.push_back(make_contractor_hc4(f, box_, config_));
+    }
+    return make_contractor_fixpoint(DefaultTerminationCondition(), ctcs,
+                                    config_);
+  }
+
+  const Variable x_{"x", Variable::Type::CONTINUOUS};
+  const Variable y_{"y", Variable::Type::CONTINUOUS};
+  Box box_{{x_, y_}};
+  const Config config_;
+
+  // x + y = 0 ∧ x - y = 0 has a unique solution (0, 0), but HC4 cannot
+  // prune the initial box with them.
+  const vector<Formula> formulas_{x_ + y_ == 0, x_ - y_ == 0};
+};
+
+TEST_F(ContractorShavingTest, Hc4IsWeak) {
+  ContractorStatus cs{box_};
+  MakeFixpoint(formulas_).Prune(&cs);
+  EXPECT_EQ(cs.box(), box_);
+}
+
+TEST_F(ContractorShavingTest, ThreeB) {
+  const Contractor ctc{make_contractor_shaving(MakeFixpoint(formulas_),
+                                               4 /* num_slices */, config_)};
+  EXPECT_TRUE(is_shaving(ctc));
+  ContractorStatus cs{box_};
+  ctc.Prune(&cs);
+  EXPECT_TRUE(cs.box()[x_].contains(0.0));
+  EXPECT_TRUE(cs.box()[y_].contains(0.0));
+  EXPECT_LT(cs.box()[x_].diam(), 1e-6);
+  EXPECT_LT(cs.box()[y_].diam(), 1e-6);
+  EXPECT_TRUE(cs.output()[0]);
+  EXPECT_TRUE(cs.output()[1]);
+}
+
+TEST_F(ContractorShavingTest, Cid) {
+  const Contractor ctc{make_contractor_cid(MakeFixpoint(formulas_),
+                                           4 /* num_slices */, config_)};
+  EXPECT_TRUE(is_cid(ctc));
+  ContractorStatus cs{box_};
+  ctc.Prune(&cs);
+  EXPECT_TRUE(cs.box()[x_].contains(0.0));
+  EXPECT_TRUE(cs.box()[y_].contains(0.0));
+  EXPECT_LT(cs.box()[x_].diam(), 1e-6);
+  EXPECT_LT(cs.box()[y_].diam(), 1e-6);
+  EXPECT_TRUE(cs.output()[0]);
+  EXPECT_TRUE(cs.output()[1]);
+}
+
+TEST_F(ContractorShavingTest, Unsat) {
+  const Contractor fixpoint{MakeFixpoint({x_ + y_ == 0, x_ - y_ == 0,
+                                          x_ * x_ >= 1})};
+  {
+    ContractorStatus cs{box_};
+    fixpoint.Prune(&cs);
+    EXPECT_FALSE(cs.box().empty());
+  }
+  for (const Contractor& ctc :
+       {make_contractor_shaving(fixpoint, 4, config_),
+        make_contractor_cid(fixpoint, 4, config_),
+        make_contractor_acid(fixpoint, 4, config_)}) {
+    ContractorStatus cs{box_};
+    ctc.Prune(&cs);
+    EXPECT_TRUE(cs.box().empty());
+    EXPECT_FALSE(cs.Explanation().empty());
+  }
+}
+
+TEST_F(ContractorShavingTest, Acid) {
+  const Contractor ctc{make_contractor_acid(MakeFixpoint({x_ + y_ <= 100}),
+                                            4 /* num_slices */, config_)};
+  EXPECT_TRUE(is_acid(ctc));
+  const auto acid = to_acid(ctc);
+  EXPECT_EQ(acid->num_vars(), 2);
+
+  // The first call learns that var-CID is useless here.
+  for (int i = 0; i < 2 * ContractorAcid::kLearningPeriod; ++i) {
+    ContractorStatus cs{box_};
+    ctc.Prune(&cs);
+    EXPECT_EQ(cs.box(), box_);
+  }
+  EXPECT_EQ(acid->num_vars(), 1);
+}
+
+TEST_F(ContractorShavingTest, IdIsNotWrapped) {
+  const Contractor id{make_contractor_id(config_)};
+  EXPECT_TRUE(is_id(make_contractor_shaving(id, 4, config_)));
+  EXPECT_TRUE(is_id(make_contractor_cid(id, 4, config_)));
+  EXPECT_TRUE(is_id(make_contractor_acid(id, 4, config_)));
+}
+
+}  // namespace
+}  // namespace dreal
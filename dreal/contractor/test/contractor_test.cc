@@ -15,10 +15,16 @@
 */
 #include "dreal/contractor/contractor.h"
 
+#include <thread>
 #include <type_traits>
+#include <vector>
 
 #include <gtest/gtest.h>
 
+#include "dreal/contractor/contractor_status.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+
 namespace dreal {
 namespace {
 
@@ -31,5 +37,56 @@ GTEST_TEST(ContractorTest, IsNothrowMoveConstructible) {
                 "Contractor should be nothrow_move_constructible.");
 }
 
+// With --native-hc4, make_contractor_ibex_fwdbwd returns a single
+// contractor shared by all the threads.
+GTEST_TEST(ContractorTest, IbexFwdbwdMultipleJobs) {
+  const Variable x{"x", Variable::Type::CONTINUOUS};
+  const Variable y{"y", Variable::Type::CONTINUOUS};
+  Box box{{x, y}};
+  box[x] = Box::Interval(0.0, 3.14 / 2);
+  box[y] = Box::Interval(0.2, 0.3);
+  Config config;
+  config.mutable_use_native_hc4() = true;
+  config.mutable_number_of_jobs() = 4;
+  const Contractor ctc{make_contractor_ibex_fwdbwd(cos(x) == sin(y), box,
+                                                   config)};
+  EXPECT_TRUE(is_hc4(ctc));
+  EXPECT_TRUE(is_id(make_contractor_ibex_fwdbwd(x != y, box, config)));
+
+  ContractorStatus expected{box};
+  ctc.Prune(&expected);
+  std::vector<std::thread> threads;
+  std::vector<Box> results(config.number_of_jobs());
+  for (Box& result : results) {
+    threads.emplace_back([&box, &ctc, &result]() {
+      ContractorStatus cs{box};
+      ctc.Prune(&cs);
+      result = cs.box();
+    });
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+  for (const Box& result : results) {
+    EXPECT_EQ(result, expected.box());
+  }
+
+  // The number of jobs does not change the pruning, with or without
+  // --native-hc4.
+  for (const bool native_hc4 : {true, false}) {
+    Config config_single_job;
+    config_single_job.mutable_use_native_hc4() = native_hc4;
+    Config config_multiple_jobs{config_single_job};
+    config_multiple_jobs.mutable_number_of_jobs() = 4;
+    ContractorStatus cs_single_job{box};
+    ContractorStatus cs_multiple_jobs{box};
+    make_contractor_ibex_fwdbwd(cos(x) == sin(y), box, config_single_job)
+        .Prune(&cs_single_job);
+    make_contractor_ibex_fwdbwd(cos(x) == sin(y), box, config_multiple_jobs)
+        .Prune(&cs_multiple_jobs);
+    EXPECT_EQ(cs_single_job.box(), cs_multiple_jobs.box());
+  }
+}
+
 }  // namespace
 }  // namespace dreal
@@ -0,0 +1,166 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/contractor/contractor_worklist_fixpoint.h"
+
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dreal/contractor/contractor_status.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+
+namespace dreal {
+namespace {
+
+using std::numeric_limits;
+using std::vector;
+
+class ContractorWorklistFixpointTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    box_[x_] = Box::Interval(0.0, 10.0);
+    box_[y_] = Box::Interval(0.0, 10.0);
+    box_[z_] = Box::Interval(0.0, 10.0);
+  }
+
+  vector<Contractor> MakeContractors(const vector<Formula>& formulas) const {
+    vector<Contractor> ctcs;
+    for (const Formula& f : formulas) {
+      ctcs.push_back(make_contractor_hc4(f, box_, config_));
+    }
+    return ctcs;
+  }
+
+  const Variable x_{"x", Variable::Type::CONTINUOUS};
+  const Variable y_{"y", Variable::Type::CONTINUOUS};
+  const Variable z_{"z", Variable::Type::CONTINUOUS};
+  Box box_{{x_, y_, z_}};
+  const Config config_;
+};
+
+TEST_F(ContractorWorklistFixpointTest, ChangeMagnitudes) {
+  ContractorStatus cs{box_};
+  EXPECT_TRUE(cs.change_magnitudes().empty());
+  cs.mutable_box()[y_] = Box::Interval(0.0, numeric_limits<double>::infinity());
+  cs.ResetChangeMagnitudes();
+  cs.mutable_box()[x_] = Box::Interval(0.0, 1.0);
+  cs.mutable_box()[y_] = Box::Interval(0.0, 5.0);
+  cs.mutable_output().set(0);
+  cs.mutable_output().set(1);
+  cs.UpdateChangeMagnitudes();
+  EXPECT_DOUBLE_EQ(cs.change_magnitudes()[0], 0.9);
+  EXPECT_DOUBLE_EQ(cs.change_magnitudes()[1], 1.0);
+  EXPECT_DOUBLE_EQ(cs.change_magnitudes()[2], 0.0);
+
+  // The magnitudes are measured from the last update.
+  cs.mutable_box()[x_] = Box::Interval(0.0, 0.5);
+  cs.mutable_output().reset();
+  cs.mutable_output().set(0);
+  cs.UpdateChangeMagnitudes();
+  EXPECT_DOUBLE_EQ(cs.change_magnitudes()[0], 0.5);
+}
+
+// A bound change which keeps the width infinite has a positive
+// magnitude.
+TEST_F(ContractorWorklistFixpointTest, ChangeMagnitudesUnbounded) {
+  const double inf{numeric_limits<double>::infinity()};
+  ContractorStatus cs{box_};
+  cs.mutable_box()[x_] = Box::Interval(-inf, inf);
+  cs.mutable_box()[y_] = Box::Interval(-inf, inf);
+  cs.ResetChangeMagnitudes();
+  cs.mutable_box()[x_] = Box::Interval(0.0, inf);
+  cs.mutable_output().set(0);
+  cs.mutable_output().set(1);
+  cs.UpdateChangeMagnitudes();
+  EXPECT_GT(cs.change_magnitudes()[0], 0.0);
+  EXPECT_DOUBLE_EQ(cs.change_magnitudes()[1], 0.0);
+}
+
+// Bounds are propagated over unbounded domains.
+TEST_F(ContractorWorklistFixpointTest, Unbounded) {
+  const double inf{numeric_limits<double>::infinity()};
+  const Contractor worklist{make_contractor_worklist_fixpoint(
+      DefaultTerminationCondition(),
+      MakeContractors({x_ >= 0, y_ == x_ + 1}), config_)};
+  ContractorStatus cs{box_};
+  cs.mutable_box()[x_] = Box::Interval(-inf, inf);
+  cs.mutable_box()[y_] = Box::Interval(-inf, inf);
+  worklist.Prune(&cs);
+  EXPECT_EQ(cs.box()[x_].lb(), 0.0);
+  EXPECT_EQ(cs.box()[y_].lb(), 1.0);
+}
+
+// It computes the same box as the plain fixpoint contractor.
+TEST_F(ContractorWorklistFixpointTest, SameAsFixpoint) {
+  const vector<Contractor> ctcs{
+      MakeContractors({x_ + y_ == 4, x_ - y_ == 1, z_ >= x_ + 5})};
+  const Contractor fixpoint{
+      make_contractor_fixpoint(DefaultTerminationCondition(), ctcs, config_)};
+  const Contractor worklist{make_contractor_worklist_fixpoint(
+      DefaultTerminationCondition(), ctcs, config_)};
+  ContractorStatus cs_fixpoint{box_};
+  ContractorStatus cs_worklist{box_};
+  fixpoint.Prune(&cs_fixpoint);
+  worklist.Prune(&cs_worklist);
+  for (int i = 0; i < box_.size(); ++i) {
+    EXPECT_NEAR(cs_fixpoint.box()[i].lb(), cs_worklist.box()[i].lb(), 1e-2);
+    EXPECT_NEAR(cs_fixpoint.box()[i].ub(), cs_worklist.box()[i].ub(), 1e-2);
+  }
+}
+
+TEST_F(ContractorWorklistFixpointTest, Branching) {
+  // The box is obtained by branching on z. Only the contractors which
+  // depend on z are scheduled first.
+  const Contractor worklist{make_contractor_worklist_fixpoint(
+      DefaultTerminationCondition(),
+      MakeContractors({x_ <= 3, y_ >= z_, x_ + y_ <= 5}), config_)};
+  ContractorStatus cs{box_, 2 /* z */};
+  cs.mutable_box()[z_] = Box::Interval(4.0, 10.0);
+  worklist.Prune(&cs);
+  EXPECT_EQ(cs.box()[y_], Box::Interval(4.0, 5.0));
+  EXPECT_EQ(cs.box()[x_], Box::Interval(0.0, 1.0));
+  EXPECT_EQ(cs.box()[z_], Box::Interval(4.0, 5.0));
+}
+
+TEST_F(ContractorWorklistFixpointTest, Unsat) {
+  const Contractor worklist{make_contractor_worklist_fixpoint(
+      DefaultTerminationCondition(),
+      MakeContractors({x_ >= y_ + 1, y_ >= z_ + 1, z_ >= x_ + 1}), config_)};
+  ContractorStatus cs{box_};
+  worklist.Prune(&cs);
+  EXPECT_TRUE(cs.box().empty());
+}
+
+TEST_F(ContractorWorklistFixpointTest, SlowConvergence) {
+  // Each contractor shrinks a domain by 1, so the exact fixpoint (the
+  // empty box) needs about 1e9 steps. It should stop once the
+  // termination condition says that the box is not improved enough.
+  box_[x_] = Box::Interval(0.0, 1e9);
+  box_[y_] = Box::Interval(0.0, 1e9);
+  const Contractor worklist{make_contractor_worklist_fixpoint(
+      DefaultTerminationCondition(),
+      MakeContractors({x_ >= y_ + 1, y_ >= x_ + 1}), config_)};
+  ContractorStatus cs{box_};
+  worklist.Prune(&cs);
+  ASSERT_FALSE(cs.box().empty());
+  EXPECT_GT(cs.box()[x_].diam(), 1e8);
+  EXPECT_GT(cs.box()[y_].diam(), 1e8);
+}
+
+}  // namespace
+}  // namespace dreal
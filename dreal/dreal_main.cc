@@ -15,8 +15,14 @@
 */
 #include "dreal/dreal_main.h"
 
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
 #include <csignal>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 #include <fmt/format.h>
@@ -48,7 +54,7 @@ string get_version_string() {
 }
 }  // namespace
 
-MainProgram::MainProgram(int argc, const char* argv[]) {
+MainProgram::MainProgram(int argc, const char* argv[]) : program_{argv[0]} {
   AddOptions();
   opt_.parse(argc, argv);  // Parse Options
   is_options_all_valid_ = ValidateOptions();
@@ -133,6 +139,27 @@ void MainProgram::AddOptions() {
            "Use polytope contractor in forall contractor.\n",
            "--forall-polytope");
 
+  auto* const polytope_frequency_option_validator =
+      new ez::ezOptionValidator("s4" /* 4byte integer */, "ge", "1");
+  opt_.add("1" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Solve the LPs of --polytope at every k-th call (default = 1)\n",
+           "--polytope-frequency", polytope_frequency_option_validator);
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Run --polytope only when the other contractors reach a\n"
+           "fixpoint.\n",
+           "--polytope-on-stall");
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Skip --polytope if its input is the same as its last output.\n",
+           "--polytope-skip-unchanged");
+
   opt_.add("false" /* Default */, false /* Required? */,
            0 /* Number of args expected. */,
            0 /* Delimiter if expecting multiple args. */,
@@ -144,6 +171,141 @@ void MainProgram::AddOptions() {
            "Use local optimization algorithm for exist-forall problems.\n",
            "--local-optimization");
 
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Use native HC4 contractors instead of IBEX's forward/backward\n"
+           "contractors.\n",
+           "--native-hc4");
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Compile all constraints into a single expression DAG sharing\n"
+           "common sub-expressions (native HC4).\n",
+           "--shared-dag");
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Evaluate the two sub-boxes of a branching at once with batched\n"
+           "interval kernels (best-first and MCTS search).\n",
+           "--batch-evaluation");
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Schedule contractors in a fixpoint by their observed pruning\n"
+           "gain and cost, deferring low-yield ones.\n",
+           "--adaptive-fixpoint");
+
+  auto* const decay_option_validator =
+      new ez::ezOptionValidator("d" /* double */, "gtlt", "0,1");
+  const string kDefaultAdaptiveFixpointDecay{
+      fmt::format("{}", Config::kDefaultAdaptiveFixpointDecay)};
+  opt_.add(kDefaultAdaptiveFixpointDecay.c_str() /* Default */,
+           false /* Required? */, 1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           fmt::format("Decay factor of the scores in --adaptive-fixpoint, "
+                       "in (0, 1) (default = {})\n",
+                       kDefaultAdaptiveFixpointDecay)
+               .c_str(),
+           "--adaptive-fixpoint-decay", decay_option_validator);
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Propagate the bounds of all linear constraints with a single\n"
+           "sparse contractor.\n",
+           "--linear-contractor");
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Use interval Newton on the square system of equalities once\n"
+           "the box is narrower than --newton-threshold.\n",
+           "--newton");
+
+  auto* const newton_threshold_option_validator =
+      new ez::ezOptionValidator("d" /* double */, "gt", "0");
+  const string kDefaultNewtonThreshold{
+      fmt::format("{}", Config::kDefaultNewtonThreshold)};
+  opt_.add(kDefaultNewtonThreshold.c_str() /* Default */,
+           false /* Required? */, 1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           fmt::format("Width under which --newton prunes a box "
+                       "(default = {})\n",
+                       kDefaultNewtonThreshold)
+               .c_str(),
+           "--newton-threshold", newton_threshold_option_validator);
+
+  auto* const shaving_option_validator =
+      new ez::ezOptionValidator("t", "in", "none,3b,cid,acid", false);
+  opt_.add("none" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Shaving contractor to strengthen the pruning. Any one of these\n"
+           "(default = none):\n"
+           "  none = no shaving\n"
+           "  3b   = refute the slices at the ends of each domain\n"
+           "  cid  = take the hull of the pruned slices of each domain\n"
+           "  acid = cid on an adaptively tuned number of variables\n",
+           "--shaving", shaving_option_validator);
+
+  auto* const shaving_slices_option_validator =
+      new ez::ezOptionValidator("s4" /* 4byte integer */, "ge", "2");
+  opt_.add("4" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Number of slices of a domain in --shaving (default = 4)\n",
+           "--shaving-slices", shaving_slices_option_validator);
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Check the theory literals of a Boolean assignment one by one\n"
+           "without branching, and learn an inconsistent prefix before\n"
+           "running ICP.\n",
+           "--online-theory-check");
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Add the theory literals implied by the box pruned in\n"
+           "--online-theory-check to the SAT solver. It implies\n"
+           "--online-theory-check.\n",
+           "--theory-propagation");
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Shrink the explanation of a theory conflict before learning\n"
+           "it, by deleting the constraints which are not needed to refute\n"
+           "the rest without branching.\n",
+           "--minimize-explanation");
+
+  auto* const minimize_explanation_budget_option_validator =
+      new ez::ezOptionValidator("d" /* double */, "gt", "0");
+  const string kDefaultExplanationMinimizationBudget{
+      fmt::format("{}", Config::kDefaultExplanationMinimizationBudget)};
+  opt_.add(kDefaultExplanationMinimizationBudget.c_str() /* Default */,
+           false /* Required? */, 1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           fmt::format("Time budget of --minimize-explanation per conflict "
+                       "(in second, default = {})\n",
+                       Config::kDefaultExplanationMinimizationBudget)
+               .c_str(),
+           "--minimize-explanation-budget",
+           minimize_explanation_budget_option_validator);
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Reuse the boxes pruned with the common prefix of the theory\n"
+           "literals of consecutive Boolean assignments, and prune only\n"
+           "with the literals which differ.\n",
+           "--incremental-theory");
+
   opt_.add("1" /* Default */, false /* Required? */,
            1 /* Number of args expected. */,
            0 /* Delimiter if expecting multiple args. */, "Number of jobs.\n",
@@ -159,6 +321,95 @@ void MainProgram::AddOptions() {
            0 /* Delimiter if expecting multiple args. */,
            "Compute the unsat core (if unsat).\n", "--unsat-core", "-c");
 
+  auto* const search_option_validator =
+      new ez::ezOptionValidator("t", "in", "depth-first,best-first", false);
+  opt_.add("depth-first" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Search strategy of ICP. Any one of these (default = "
+           "depth-first):\n"
+           "depth-first, best-first\n",
+           "--search", search_option_validator);
+
+  auto* const best_first_score_option_validator = new ez::ezOptionValidator(
+      "t", "in", "volume,undecided,violation", false);
+  opt_.add("volume" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Score to order boxes in best-first search. Any one of these\n"
+           "(default = volume):\n"
+           "  volume    = prefer a larger box\n"
+           "  undecided = prefer a box with fewer variables to branch on\n"
+           "  violation = prefer a box whose mid-point violates less\n",
+           "--best-first-score", best_first_score_option_validator);
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Race a portfolio of ICP configurations (one per job) and take\n"
+           "the result of the first one to finish.\n",
+           "--portfolio");
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Make parallel ICP deterministic (reproducible results with\n"
+           "--jobs > 1).\n",
+           "--deterministic");
+
+  opt_.add("" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Distribute ICP over worker processes. The coordinator listens\n"
+           "on the given address, unix:<path> or tcp:<host>:<port>.\n",
+           "--distributed");
+
+  opt_.add("1" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Number of workers to wait for in distributed ICP "
+           "(default = 1).\n",
+           "--distributed-workers", positive_int_option_validator);
+
+  opt_.add("1" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Spawn this many workers on the local machine in distributed\n"
+           "ICP. It also sets --distributed-workers.\n",
+           "--distributed-local-workers", positive_int_option_validator);
+
+  opt_.add("" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Run as a worker of distributed ICP, connecting to the\n"
+           "coordinator at the given address. No input file is needed.\n",
+           "--worker");
+
+  opt_.add("" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Periodically save the learned clauses and the ICP frontier\n"
+           "to the given file.\n",
+           "--checkpoint");
+
+  const string kDefaultCheckpointInterval{
+      fmt::format("{}", Config::kDefaultCheckpointInterval)};
+  opt_.add(kDefaultCheckpointInterval.c_str() /* Default */,
+           false /* Required? */, 1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           fmt::format("Interval between two checkpoints (in second) "
+                       "(default = {} sec)\n",
+                       kDefaultCheckpointInterval)
+               .c_str(),
+           "--checkpoint-interval", positive_double_option_validator);
+
+  opt_.add("" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Resume the search from the given checkpoint file. A missing\n"
+           "file is ignored.\n",
+           "--resume");
+
   const string kDefaultNloptFtolRel{
       fmt::format("{}", Config::kDefaultNloptFtolRel)};
   opt_.add(kDefaultNloptFtolRel.c_str() /* Default */, false /* Required? */,
@@ -227,6 +478,18 @@ void MainProgram::AddOptions() {
            "  3 = random initial phase\n",
            "--sat-default-phase");
 
+  auto* const sat_backend_option_validator =
+      new ez::ezOptionValidator("t", "in", "picosat,cdcl", false);
+  opt_.add("picosat" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "SAT solver for the Boolean abstraction. Any one of these\n"
+           "(default = picosat):\n"
+           "  picosat = PicoSAT\n"
+           "  cdcl    = incremental CDCL solver with assumption-based\n"
+           "            push/pop (no --unsat-core)\n",
+           "--sat-backend", sat_backend_option_validator);
+
   opt_.add("0" /* Default */, false /* Required? */,
            1 /* Number of args expected. */,
            0 /* Delimiter if expecting multiple args. */,
@@ -276,6 +539,9 @@ bool MainProgram::ValidateOptions() {
   if (opt_.isSet("--version")) {
     return true;
   }
+  if (opt_.isSet("--worker") && args_.empty()) {
+    return true;
+  }
   if (opt_.isSet("-h") || (args_.empty() && !opt_.isSet("--in")) ||
       args_.size() > 1) {
     PrintUsage();
@@ -357,6 +623,105 @@ void MainProgram::ExtractOptions() {
                     config_.unsat_core());
   }
 
+  // --search
+  if (opt_.isSet("--search")) {
+    string search;
+    opt_.get("--search")->getString(search);
+    config_.mutable_search_strategy().set_from_command_line(
+        search == "best-first" ? Config::SearchStrategy::BestFirst
+                               : Config::SearchStrategy::DepthFirst);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --search = {}",
+                    config_.search_strategy());
+  }
+
+  // --best-first-score
+  if (opt_.isSet("--best-first-score")) {
+    string score;
+    opt_.get("--best-first-score")->getString(score);
+    if (score == "undecided") {
+      config_.mutable_best_first_score().set_from_command_line(
+          Config::BestFirstScore::Undecided);
+    } else if (score == "violation") {
+      config_.mutable_best_first_score().set_from_command_line(
+          Config::BestFirstScore::Violation);
+    } else {
+      config_.mutable_best_first_score().set_from_command_line(
+          Config::BestFirstScore::Volume);
+    }
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --best-first-score = {}",
+                    config_.best_first_score());
+  }
+
+  // --portfolio
+  if (opt_.isSet("--portfolio")) {
+    config_.mutable_portfolio().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --portfolio = {}",
+                    config_.portfolio());
+  }
+
+  // --deterministic
+  if (opt_.isSet("--deterministic")) {
+    config_.mutable_deterministic().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --deterministic = {}",
+                    config_.deterministic());
+  }
+
+  // --distributed
+  if (opt_.isSet("--distributed")) {
+    string address;
+    opt_.get("--distributed")->getString(address);
+    config_.mutable_distributed_address().set_from_command_line(address);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --distributed = {}",
+                    config_.distributed_address());
+  }
+
+  // --distributed-workers
+  if (opt_.isSet("--distributed-workers")) {
+    int workers{};
+    opt_.get("--distributed-workers")->getInt(workers);
+    config_.mutable_distributed_workers().set_from_command_line(workers);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --distributed-workers = {}",
+                    config_.distributed_workers());
+  }
+
+  // --distributed-local-workers
+  if (opt_.isSet("--distributed-local-workers")) {
+    opt_.get("--distributed-local-workers")->getInt(num_local_workers_);
+    config_.mutable_distributed_workers().set_from_command_line(
+        num_local_workers_);
+    DREAL_LOG_DEBUG(
+        "MainProgram::ExtractOptions() --distributed-local-workers = {}",
+        num_local_workers_);
+  }
+
+  // --checkpoint
+  if (opt_.isSet("--checkpoint")) {
+    string checkpoint;
+    opt_.get("--checkpoint")->getString(checkpoint);
+    config_.mutable_checkpoint().set_from_command_line(checkpoint);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --checkpoint = {}",
+                    config_.checkpoint());
+  }
+
+  // --checkpoint-interval
+  if (opt_.isSet("--checkpoint-interval")) {
+    double checkpoint_interval{0.0};
+    opt_.get("--checkpoint-interval")->getDouble(checkpoint_interval);
+    config_.mutable_checkpoint_interval().set_from_command_line(
+        checkpoint_interval);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --checkpoint-interval = {}",
+                    config_.checkpoint_interval());
+  }
+
+  // --resume
+  if (opt_.isSet("--resume")) {
+    string resume;
+    opt_.get("--resume")->getString(resume);
+    config_.mutable_resume().set_from_command_line(resume);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --resume = {}",
+                    config_.resume());
+  }
+
   // --forall-polytope
   if (opt_.isSet("--forall-polytope")) {
     config_.mutable_use_polytope_in_forall().set_from_command_line(true);
@@ -364,6 +729,31 @@ void MainProgram::ExtractOptions() {
                     config_.use_polytope_in_forall());
   }
 
+  // --polytope-frequency
+  if (opt_.isSet("--polytope-frequency")) {
+    int polytope_frequency{0};
+    opt_.get("--polytope-frequency")->getInt(polytope_frequency);
+    config_.mutable_polytope_frequency().set_from_command_line(
+        polytope_frequency);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --polytope-frequency = {}",
+                    config_.polytope_frequency());
+  }
+
+  // --polytope-on-stall
+  if (opt_.isSet("--polytope-on-stall")) {
+    config_.mutable_polytope_on_stall().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --polytope-on-stall = {}",
+                    config_.polytope_on_stall());
+  }
+
+  // --polytope-skip-unchanged
+  if (opt_.isSet("--polytope-skip-unchanged")) {
+    config_.mutable_polytope_skip_unchanged().set_from_command_line(true);
+    DREAL_LOG_DEBUG(
+        "MainProgram::ExtractOptions() --polytope-skip-unchanged = {}",
+        config_.polytope_skip_unchanged());
+  }
+
   // --worklist-fixpoint
   if (opt_.isSet("--worklist-fixpoint")) {
     config_.mutable_use_worklist_fixpoint().set_from_command_line(true);
@@ -378,6 +768,136 @@ void MainProgram::ExtractOptions() {
                     config_.use_local_optimization());
   }
 
+  // --native-hc4
+  if (opt_.isSet("--native-hc4")) {
+    config_.mutable_use_native_hc4().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --native-hc4 = {}",
+                    config_.use_native_hc4());
+  }
+
+  // --shared-dag
+  if (opt_.isSet("--shared-dag")) {
+    config_.mutable_use_shared_dag().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --shared-dag = {}",
+                    config_.use_shared_dag());
+  }
+
+  // --batch-evaluation
+  if (opt_.isSet("--batch-evaluation")) {
+    config_.mutable_use_batch_evaluation().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --batch-evaluation = {}",
+                    config_.use_batch_evaluation());
+  }
+
+  // --adaptive-fixpoint
+  if (opt_.isSet("--adaptive-fixpoint")) {
+    config_.mutable_use_adaptive_fixpoint().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --adaptive-fixpoint = {}",
+                    config_.use_adaptive_fixpoint());
+  }
+
+  // --adaptive-fixpoint-decay
+  if (opt_.isSet("--adaptive-fixpoint-decay")) {
+    double adaptive_fixpoint_decay{0.0};
+    opt_.get("--adaptive-fixpoint-decay")
+        ->getDouble(adaptive_fixpoint_decay);
+    config_.mutable_adaptive_fixpoint_decay().set_from_command_line(
+        adaptive_fixpoint_decay);
+    DREAL_LOG_DEBUG(
+        "MainProgram::ExtractOptions() --adaptive-fixpoint-decay = {}",
+        config_.adaptive_fixpoint_decay());
+  }
+
+  // --linear-contractor
+  if (opt_.isSet("--linear-contractor")) {
+    config_.mutable_use_linear_contractor().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --linear-contractor = {}",
+                    config_.use_linear_contractor());
+  }
+
+  // --newton
+  if (opt_.isSet("--newton")) {
+    config_.mutable_use_newton().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --newton = {}",
+                    config_.use_newton());
+  }
+
+  // --newton-threshold
+  if (opt_.isSet("--newton-threshold")) {
+    double newton_threshold{0.0};
+    opt_.get("--newton-threshold")->getDouble(newton_threshold);
+    config_.mutable_newton_threshold().set_from_command_line(newton_threshold);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --newton-threshold = {}",
+                    config_.newton_threshold());
+  }
+
+  // --shaving
+  if (opt_.isSet("--shaving")) {
+    string shaving;
+    opt_.get("--shaving")->getString(shaving);
+    if (shaving == "3b") {
+      config_.mutable_shaving().set_from_command_line(
+          Config::Shaving::ThreeB);
+    } else if (shaving == "cid") {
+      config_.mutable_shaving().set_from_command_line(Config::Shaving::Cid);
+    } else if (shaving == "acid") {
+      config_.mutable_shaving().set_from_command_line(Config::Shaving::Acid);
+    } else {
+      config_.mutable_shaving().set_from_command_line(Config::Shaving::None);
+    }
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --shaving = {}",
+                    config_.shaving());
+  }
+
+  // --shaving-slices
+  if (opt_.isSet("--shaving-slices")) {
+    int shaving_slices{0};
+    opt_.get("--shaving-slices")->getInt(shaving_slices);
+    config_.mutable_shaving_slices().set_from_command_line(shaving_slices);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --shaving-slices = {}",
+                    config_.shaving_slices());
+  }
+
+  // --online-theory-check
+  if (opt_.isSet("--online-theory-check")) {
+    config_.mutable_use_online_theory_check().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --online-theory-check = {}",
+                    config_.use_online_theory_check());
+  }
+
+  // --theory-propagation
+  if (opt_.isSet("--theory-propagation")) {
+    config_.mutable_use_theory_propagation().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --theory-propagation = {}",
+                    config_.use_theory_propagation());
+  }
+
+  // --minimize-explanation
+  if (opt_.isSet("--minimize-explanation")) {
+    config_.mutable_use_explanation_minimization().set_from_command_line(true);
+    DREAL_LOG_DEBUG(
+        "MainProgram::ExtractOptions() --minimize-explanation = {}",
+        config_.use_explanation_minimization());
+  }
+
+  // --minimize-explanation-budget
+  if (opt_.isSet("--minimize-explanation-budget")) {
+    double budget{0.0};
+    opt_.get("--minimize-explanation-budget")->getDouble(budget);
+    config_.mutable_explanation_minimization_budget().set_from_command_line(
+        budget);
+    DREAL_LOG_DEBUG(
+        "MainProgram::ExtractOptions() --minimize-explanation-budget = {}",
+        config_.explanation_minimization_budget());
+  }
+
+  // --incremental-theory
+  if (opt_.isSet("--incremental-theory")) {
+    config_.mutable_use_incremental_theory().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --incremental-theory = {}",
+                    config_.use_incremental_theory());
+  }
+
   // --nlopt-ftol-rel
   if (opt_.isSet("--nlopt-ftol-rel")) {
     double nlopt_ftol_rel{0.0};
@@ -424,6 +944,21 @@ void MainProgram::ExtractOptions() {
                     config_.sat_default_phase());
   }
 
+  // --sat-backend
+  if (opt_.isSet("--sat-backend")) {
+    string sat_backend;
+    opt_.get("--sat-backend")->getString(sat_backend);
+    if (sat_backend == "cdcl") {
+      config_.mutable_sat_backend().set_from_command_line(
+          Config::SatBackend::Cdcl);
+    } else {
+      config_.mutable_sat_backend().set_from_command_line(
+          Config::SatBackend::PicoSat);
+    }
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --sat-backend = {}",
+                    config_.sat_backend());
+  }
+
   // --random-seed
   if (opt_.isSet("--random-seed")) {
     // NOLINTNEXTLINE(runtime/int)
@@ -476,6 +1011,12 @@ int MainProgram::Run() {
     return 1;
   }
   ExtractOptions();
+  if (opt_.isSet("--worker")) {
+    string address;
+    opt_.get("--worker")->getString(address);
+    RunSmt2Worker(address, config_);
+    return 0;
+  }
   string filename;
   if (!args_.empty()) {
     filename = *args_[0];
@@ -492,12 +1033,19 @@ int MainProgram::Run() {
   const string extension{get_extension(filename)};
   string format_opt;
   opt_.get("--format")->getString(format_opt);
+  if (num_local_workers_ > 0 && config_.distributed_address().empty()) {
+    cerr << "--distributed-local-workers requires --distributed.\n" << endl;
+    PrintUsage();
+    return 1;
+  }
   if (format_opt == "smt2" ||
       (format_opt == "auto" && (extension == "smt2" || opt_.isSet("--in")))) {
+    const LocalWorkersGuard local_workers_guard{this};
     RunSmt2(filename, config_, opt_.isSet("--debug-scanning"),
             opt_.isSet("--debug-parsing"));
   } else if (format_opt == "dr" ||
              (format_opt == "auto" && extension == "dr")) {
+    const LocalWorkersGuard local_workers_guard{this};
     RunDr(filename, config_, opt_.isSet("--debug-scanning"),
           opt_.isSet("--debug-parsing"));
   } else {
@@ -507,6 +1055,53 @@ int MainProgram::Run() {
   }
   return 0;
 }
+
+MainProgram::LocalWorkersGuard::LocalWorkersGuard(
+    MainProgram* const main_program)
+    : main_program_{main_program} {
+  try {
+    main_program_->SpawnLocalWorkers();
+  } catch (...) {
+    // Stops the workers spawned before the failure.
+    main_program_->StopLocalWorkers();
+    throw;
+  }
+}
+
+MainProgram::LocalWorkersGuard::~LocalWorkersGuard() {
+  main_program_->StopLocalWorkers();
+}
+
+void MainProgram::SpawnLocalWorkers() {
+  // A worker runs this program with `--worker <address>`. Note that
+  // it retries connecting until the coordinator starts listening.
+  const string address{config_.distributed_address()};
+  for (int i = 0; i < num_local_workers_; ++i) {
+    const pid_t pid{fork()};
+    if (pid < 0) {
+      throw DREAL_RUNTIME_ERROR("Failed to spawn a local worker: {}",
+                                std::strerror(errno));
+    }
+    if (pid == 0) {
+      execlp(program_.c_str(), program_.c_str(), "--worker", address.c_str(),
+             static_cast<char*>(nullptr));
+      // execlp returns only on failure.
+      cerr << "Failed to run a local worker: " << std::strerror(errno) << endl;
+      std::_Exit(1);
+    }
+    local_workers_.push_back(pid);
+  }
+}
+
+void MainProgram::StopLocalWorkers() {
+  // The coordinator has shut down the workers already if it ran a
+  // query. Otherwise, they are still waiting for the coordinator.
+  for (const pid_t pid : local_workers_) {
+    kill(pid, SIGTERM);
+    waitpid(pid, nullptr, 0);
+  }
+  local_workers_.clear();
+}
 }  // namespace dreal
 
 namespace {
@@ -520,5 +1115,12 @@ void HandleSigInt(const int) {
 int main(int argc, const char* argv[]) {
   std::signal(SIGINT, HandleSigInt);
   dreal::MainProgram main_program{argc, argv};
-  return main_program.Run();
+  try {
+    return main_program.Run();
+  } catch (...) {
+    // An uncaught exception may terminate the program without unwinding
+    // the stack. Rethrowing it here makes sure that the destructors in
+    // Run(), which stop the local workers, run first.
+    throw;
+  }
 }
@@ -15,6 +15,8 @@
 */
 #pragma once
 
+#include <sys/types.h>
+
 #include <iostream>
 #include <string>
 #include <vector>
@@ -53,9 +55,35 @@ class MainProgram {
   // Extracts options from `opt_` and construts `config_`.
   void ExtractOptions();
 
+  // Spawns `num_local_workers_` worker processes for distributed ICP.
+  void SpawnLocalWorkers();
+
+  // Stops the spawned worker processes and waits for them to exit.
+  void StopLocalWorkers();
+
+  // Spawns the local workers when it is constructed and stops them
+  // when it is destructed, even if running a query throws.
+  class LocalWorkersGuard {
+   public:
+    explicit LocalWorkersGuard(MainProgram* main_program);
+    LocalWorkersGuard(const LocalWorkersGuard&) = delete;
+    LocalWorkersGuard(LocalWorkersGuard&&) = delete;
+    LocalWorkersGuard& operator=(const LocalWorkersGuard&) = delete;
+    LocalWorkersGuard& operator=(LocalWorkersGuard&&) = delete;
+    ~LocalWorkersGuard();
+
+   private:
+    MainProgram* const main_program_;
+  };
+
   bool is_options_all_valid_{false};
   ez::ezOptionParser opt_;
   std::vector<const std::string*> args_;  // List of valid option arguments.
   Config config_;
+
+  // Path of this program, used to spawn local workers.
+  std::string program_;
+  int num_local_workers_{0};
+  std::vector<pid_t> local_workers_;
 };
 }  // namespace dreal
@@ -696,6 +696,20 @@ PYBIND11_MODULE(_dreal_py, m) {
                       self.mutable_use_polytope_in_forall() =
                           use_polytope_in_forall;
                     })
+      .def_property("polytope_frequency", &Config::polytope_frequency,
+                    [](Config& self, const int polytope_frequency) {
+                      self.mutable_polytope_frequency() = polytope_frequency;
+                    })
+      .def_property("polytope_on_stall", &Config::polytope_on_stall,
+                    [](Config& self, const bool polytope_on_stall) {
+                      self.mutable_polytope_on_stall() = polytope_on_stall;
+                    })
+      .def_property("polytope_skip_unchanged",
+                    &Config::polytope_skip_unchanged,
+                    [](Config& self, const bool polytope_skip_unchanged) {
+                      self.mutable_polytope_skip_unchanged() =
+                          polytope_skip_unchanged;
+                    })
       .def_property("use_worklist_fixpoint", &Config::use_worklist_fixpoint,
                     [](Config& self, const bool use_worklist_fixpoint) {
                       self.mutable_use_worklist_fixpoint() =
@@ -706,6 +720,72 @@ PYBIND11_MODULE(_dreal_py, m) {
                       self.mutable_use_local_optimization() =
                           use_local_optimization;
                     })
+      .def_property("use_native_hc4", &Config::use_native_hc4,
+                    [](Config& self, const bool use_native_hc4) {
+                      self.mutable_use_native_hc4() = use_native_hc4;
+                    })
+      .def_property("use_shared_dag", &Config::use_shared_dag,
+                    [](Config& self, const bool use_shared_dag) {
+                      self.mutable_use_shared_dag() = use_shared_dag;
+                    })
+      .def_property("use_batch_evaluation", &Config::use_batch_evaluation,
+                    [](Config& self, const bool use_batch_evaluation) {
+                      self.mutable_use_batch_evaluation() =
+                          use_batch_evaluation;
+                    })
+      .def_property("use_adaptive_fixpoint", &Config::use_adaptive_fixpoint,
+                    [](Config& self, const bool use_adaptive_fixpoint) {
+                      self.mutable_use_adaptive_fixpoint() =
+                          use_adaptive_fixpoint;
+                    })
+      .def_property("adaptive_fixpoint_decay",
+                    &Config::adaptive_fixpoint_decay,
+                    [](Config& self, const double adaptive_fixpoint_decay) {
+                      self.mutable_adaptive_fixpoint_decay() =
+                          adaptive_fixpoint_decay;
+                    })
+      .def_property("use_linear_contractor", &Config::use_linear_contractor,
+                    [](Config& self, const bool use_linear_contractor) {
+                      self.mutable_use_linear_contractor() =
+                          use_linear_contractor;
+                    })
+      .def_property("use_newton", &Config::use_newton,
+                    [](Config& self, const bool use_newton) {
+                      self.mutable_use_newton() = use_newton;
+                    })
+      .def_property("newton_threshold", &Config::newton_threshold,
+                    [](Config& self, const double newton_threshold) {
+                      self.mutable_newton_threshold() = newton_threshold;
+                    })
+      .def_property("use_online_theory_check",
+                    &Config::use_online_theory_check,
+                    [](Config& self, const bool use_online_theory_check) {
+                      self.mutable_use_online_theory_check() =
+                          use_online_theory_check;
+                    })
+      .def_property("use_theory_propagation", &Config::use_theory_propagation,
+                    [](Config& self, const bool use_theory_propagation) {
+                      self.mutable_use_theory_propagation() =
+                          use_theory_propagation;
+                    })
+      .def_property("use_explanation_minimization",
+                    &Config::use_explanation_minimization,
+                    [](Config& self, const bool use_explanation_minimization) {
+                      self.mutable_use_explanation_minimization() =
+                          use_explanation_minimization;
+                    })
+      .def_property("explanation_minimization_budget",
+                    &Config::explanation_minimization_budget,
+                    [](Config& self,
+                       const double explanation_minimization_budget) {
+                      self.mutable_explanation_minimization_budget() =
+                          explanation_minimization_budget;
+                    })
+      .def_property("use_incremental_theory", &Config::use_incremental_theory,
+                    [](Config& self, const bool use_incremental_theory) {
+                      self.mutable_use_incremental_theory() =
+                          use_incremental_theory;
+                    })
       .def_property("nlopt_ftol_rel", &Config::nlopt_ftol_rel,
                     [](Config& self, const bool nlopt_ftol_rel) {
                       self.mutable_nlopt_ftol_rel() = nlopt_ftol_rel;
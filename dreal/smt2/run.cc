@@ -15,12 +15,19 @@
 */
 #include "dreal/smt2/run.h"
 
+#include <vector>
+
+#include <fmt/format.h>
+
 #include "dreal/smt2/driver.h"
+#include "dreal/solver/icp_distributed.h"
+#include "dreal/util/exception.h"
 #include "dreal/util/logging.h"
 
 namespace dreal {
 
 using std::string;
+using std::vector;
 
 void RunSmt2(const string& filename, const Config& config,
              const bool debug_scanning, const bool debug_parsing) {
@@ -35,4 +42,29 @@ void RunSmt2(const string& filename, const Config& config,
                   smt2_driver.trace_parsing());
   smt2_driver.parse_file(filename);
 }
+
+void RunSmt2Worker(const string& address, const Config& config) {
+  // See MakeDistributedQuery for the format of a query.
+  const auto parse = [&config](const string& script, const int num_variables,
+                               const int num_assertions,
+                               vector<Variable>* const variables,
+                               vector<Formula>* const assertions) {
+    Smt2Driver smt2_driver{Context{config}};
+    if (!smt2_driver.parse_string(script, "distributed query")) {
+      throw DREAL_RUNTIME_ERROR("Failed to parse a distributed query.");
+    }
+    for (int i = 0; i < num_variables; ++i) {
+      variables->push_back(
+          smt2_driver.lookup_variable(fmt::format("v{}", i)));
+    }
+    // The value of the dummy parameter does not matter.
+    const vector<Term> dummy_argument{Term{Expression::Zero()}};
+    for (int i = 0; i < num_assertions; ++i) {
+      assertions->push_back(
+          smt2_driver.LookupFunction(fmt::format("a{}", i), dummy_argument)
+              .formula());
+    }
+  };
+  RunDistributedWorker(address, config, parse);
+}
 }  // namespace dreal
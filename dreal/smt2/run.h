@@ -24,4 +24,8 @@ namespace dreal {
 void RunSmt2(const std::string& filename, const Config& config,
              bool debug_scanning, bool debug_parsing);
 
+/// Runs a worker of distributed ICP which connects to the coordinator
+/// at @p address. See IcpDistributed.
+void RunSmt2Worker(const std::string& address, const Config& config);
+
 }  // namespace dreal
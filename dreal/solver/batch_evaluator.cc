@@ -0,0 +1,86 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/solver/batch_evaluator.h"
+
+#include <stdexcept>
+#include <utility>
+
+#include "dreal/solver/relational_formula_evaluator.h"
+#include "dreal/util/logging.h"
+
+namespace dreal {
+
+using std::make_unique;
+using std::vector;
+
+BatchEvaluator::BatchEvaluator(vector<FormulaEvaluator> formula_evaluators,
+                               const Box& box)
+    : formula_evaluators_{std::move(formula_evaluators)} {
+  vector<Expression> roots;
+  for (const FormulaEvaluator& formula_evaluator : formula_evaluators_) {
+    const Formula& f{formula_evaluator.formula()};
+    if (!is_forall(f)) {
+      ops_.push_back(GetRelationalOperator(f));
+      roots_.push_back(static_cast<int>(roots.size()));
+      roots.push_back(ExtractExpression(f));
+    } else {
+      ops_.push_back(RelationalOperator::EQ);  // Not used.
+      roots_.push_back(-1);
+    }
+  }
+  if (roots.empty()) {
+    return;
+  }
+  try {
+    tape_ = make_unique<const ExpressionTape>(roots, box);
+  } catch (const std::runtime_error& e) {
+    // A formula includes an expression which a tape does not support
+    // (e.g. an uninterpreted function). We evaluate all the formulas
+    // box by box.
+    DREAL_LOG_DEBUG("BatchEvaluator::BatchEvaluator() {}", e.what());
+    roots_.assign(roots_.size(), -1);
+  }
+}
+
+vector<vector<FormulaEvaluationResult>> BatchEvaluator::operator()(
+    const vector<const Box*>& boxes) const {
+  // The values of the tape nodes. It is shared by all the batch
+  // evaluators which run in this thread.
+  thread_local ExpressionTape::BatchValues values;
+  if (tape_) {
+    thread_local vector<const Box::IntervalVector*> ivs;
+    ivs.clear();
+    for (const Box* const box : boxes) {
+      ivs.push_back(&box->interval_vector());
+    }
+    tape_->EvaluateBatch(ivs, &values);
+  }
+  vector<vector<FormulaEvaluationResult>> results(boxes.size());
+  for (size_t j = 0; j < boxes.size(); ++j) {
+    results[j].reserve(formula_evaluators_.size());
+    for (size_t i = 0; i < formula_evaluators_.size(); ++i) {
+      if (roots_[i] < 0) {
+        results[j].push_back(formula_evaluators_[i](*boxes[j]));
+      } else {
+        results[j].push_back(EvaluateRelationalConstraint(
+            ops_[i], values.value(tape_->root(roots_[i]), j)));
+      }
+    }
+  }
+  return results;
+}
+
+}  // namespace dreal
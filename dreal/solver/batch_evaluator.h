@@ -0,0 +1,83 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "dreal/solver/formula_evaluator.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+#include "dreal/util/expression_tape.h"
+
+namespace dreal {
+
+/// Evaluates a set of formulas over multiple boxes at once.
+///
+/// The relational formulas are compiled into a single ExpressionTape
+/// and they are evaluated over all the boxes by
+/// ExpressionTape::EvaluateBatch. The other formulas (i.e. universally
+/// quantified ones) are evaluated box by box with their
+/// FormulaEvaluators. An instance is immutable once it is constructed
+/// and it can be shared by multiple threads.
+class BatchEvaluator {
+ public:
+  /// Deleted default constructor.
+  BatchEvaluator() = delete;
+
+  /// Constructs a batch evaluator of @p formula_evaluators whose
+  /// variables are in @p box.
+  BatchEvaluator(std::vector<FormulaEvaluator> formula_evaluators,
+                 const Box& box);
+
+  /// Deleted copy constructor.
+  BatchEvaluator(const BatchEvaluator&) = delete;
+
+  /// Deleted move constructor.
+  BatchEvaluator(BatchEvaluator&&) = delete;
+
+  /// Deleted copy assign operator.
+  BatchEvaluator& operator=(const BatchEvaluator&) = delete;
+
+  /// Deleted move assign operator.
+  BatchEvaluator& operator=(BatchEvaluator&&) = delete;
+
+  /// Default destructor.
+  ~BatchEvaluator() = default;
+
+  /// Returns the formula evaluators.
+  const std::vector<FormulaEvaluator>& formula_evaluators() const {
+    return formula_evaluators_;
+  }
+
+  /// Evaluates the formulas over @p boxes. The i-th element of the j-th
+  /// vector of the result is the evaluation of the i-th formula over
+  /// `*boxes[j]`.
+  std::vector<std::vector<FormulaEvaluationResult>> operator()(
+      const std::vector<const Box*>& boxes) const;
+
+ private:
+  std::vector<FormulaEvaluator> formula_evaluators_;
+
+  // For the i-th formula, ops_[i] is its relational operator and
+  // roots_[i] is the index of its expression in tape_. roots_[i] is -1
+  // if the formula is evaluated by formula_evaluators_[i].
+  std::vector<RelationalOperator> ops_;
+  std::vector<int> roots_;
+  std::unique_ptr<const ExpressionTape> tape_;
+};
+
+}  // namespace dreal
@@ -0,0 +1,657 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/solver/cdcl_backend.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+#include "dreal/util/assert.h"
+#include "dreal/util/exception.h"
+#include "dreal/util/logging.h"
+#include "dreal/util/stat.h"
+#include "dreal/util/timer.h"
+
+using std::cout;
+using std::make_unique;
+using std::unique_ptr;
+using std::vector;
+
+namespace dreal {
+
+namespace {
+class CdclBackendStat : public Stat {
+ public:
+  explicit CdclBackendStat(const bool enabled) : Stat{enabled} {};
+  CdclBackendStat(const CdclBackendStat&) = delete;
+  CdclBackendStat(CdclBackendStat&&) = delete;
+  CdclBackendStat& operator=(const CdclBackendStat&) = delete;
+  CdclBackendStat& operator=(CdclBackendStat&&) = delete;
+  ~CdclBackendStat() override {
+    if (enabled()) {
+      using fmt::print;
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of CDCL Conflicts",
+            "SAT level", num_conflicts_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of CDCL Restarts",
+            "SAT level", num_restarts_);
+    }
+  }
+
+  int64_t num_conflicts_{0};
+  int num_restarts_{0};
+};
+
+constexpr double kVarDecay{0.95};
+constexpr double kClauseDecay{0.999};
+
+// The first reduction of the learned clauses happens after
+// kReduceBase conflicts. The interval grows by kReduceInc.
+constexpr int64_t kReduceBase{2000};
+constexpr int64_t kReduceInc{300};
+
+// Returns the i-th element of the Luby sequence 1, 1, 2, 1, 1, 2, 4, ...
+int64_t Luby(int i) {
+  int size{1};
+  int seq{0};
+  while (size < i + 1) {
+    ++seq;
+    size = 2 * size + 1;
+  }
+  while (size - 1 != i) {
+    size = (size - 1) >> 1;
+    --seq;
+    i = i % size;
+  }
+  return int64_t{1} << seq;
+}
+}  // namespace
+
+constexpr int CdclBackend::kGlueLbd;
+constexpr int CdclBackend::kRestartUnit;
+
+CdclBackend::CdclBackend(const Config& config)
+    : assigns_(1, 0),
+      level_(1, 0),
+      reason_(1, nullptr),
+      activity_(1, 0.0),
+      polarity_(1, false),
+      decision_(1, false),
+      seen_(1, false),
+      heap_index_(1, -1),
+      next_reduce_{kReduceBase},
+      default_phase_{config.sat_default_phase()},
+      rng_{config.random_seed()} {
+  watches_.resize(2);
+}
+
+CdclBackend::~CdclBackend() = default;
+
+int CdclBackend::NewVar() {
+  const int var{static_cast<int>(assigns_.size())};
+  assigns_.push_back(0);
+  level_.push_back(0);
+  reason_.push_back(nullptr);
+  activity_.push_back(0.0);
+  switch (default_phase_) {
+    case Config::SatDefaultPhase::True:
+      polarity_.push_back(false);
+      break;
+    case Config::SatDefaultPhase::RandomInitialPhase:
+      polarity_.push_back(rng_() & 1);
+      break;
+    case Config::SatDefaultPhase::False:
+    case Config::SatDefaultPhase::JeroslowWang:
+      polarity_.push_back(true);
+      break;
+  }
+  decision_.push_back(true);
+  seen_.push_back(false);
+  heap_index_.push_back(-1);
+  watches_.emplace_back();
+  watches_.emplace_back();
+  HeapInsert(var);
+  return var;
+}
+
+void CdclBackend::Add(const int lit) {
+  if (lit != 0) {
+    DREAL_ASSERT(std::abs(lit) <= num_vars());
+    clause_.push_back(MakeLit(std::abs(lit), lit < 0));
+    return;
+  }
+  ++num_added_clauses_;
+  if (!scopes_.empty()) {
+    clause_.push_back(MakeLit(scopes_.back(), true));
+  }
+  AddClause(std::move(clause_));
+  clause_.clear();
+}
+
+bool CdclBackend::AddClause(vector<Lit> lits) {
+  CancelUntil(0);
+  if (!ok_) {
+    return false;
+  }
+  // Removes the duplicated and false literals. Note that l and ¬l are
+  // adjacent after sorting.
+  std::sort(lits.begin(), lits.end());
+  int j{0};
+  Lit prev{-1};
+  for (const Lit l : lits) {
+    if (LitValue(l) == 1 || l == Negate(prev)) {
+      // Satisfied or tautology.
+      return true;
+    }
+    if (LitValue(l) == -1 || l == prev) {
+      continue;
+    }
+    lits[j++] = l;
+    prev = l;
+  }
+  lits.resize(j);
+  if (lits.empty()) {
+    ok_ = false;
+  } else if (lits.size() == 1) {
+    Enqueue(lits[0], nullptr);
+    ok_ = Propagate() == nullptr;
+  } else {
+    clauses_.push_back(make_unique<Clause>());
+    clauses_.back()->lits = std::move(lits);
+    Attach(clauses_.back().get());
+  }
+  return ok_;
+}
+
+void CdclBackend::Attach(Clause* const c) {
+  DREAL_ASSERT(c->lits.size() >= 2);
+  watches_[c->lits[0]].push_back(Watcher{c, c->lits[1]});
+  watches_[c->lits[1]].push_back(Watcher{c, c->lits[0]});
+}
+
+void CdclBackend::Enqueue(const Lit lit, Clause* const reason) {
+  const int var{VarOf(lit)};
+  DREAL_ASSERT(assigns_[var] == 0);
+  assigns_[var] = IsNegated(lit) ? -1 : 1;
+  level_[var] = DecisionLevel();
+  reason_[var] = reason;
+  trail_.push_back(lit);
+}
+
+void CdclBackend::NewDecisionLevel() {
+  trail_lim_.push_back(static_cast<int>(trail_.size()));
+}
+
+void CdclBackend::CancelUntil(const int level) {
+  if (DecisionLevel() <= level) {
+    return;
+  }
+  for (int i = static_cast<int>(trail_.size()) - 1; i >= trail_lim_[level];
+       --i) {
+    const int var{VarOf(trail_[i])};
+    polarity_[var] = IsNegated(trail_[i]);
+    assigns_[var] = 0;
+    reason_[var] = nullptr;
+    if (!HeapContains(var)) {
+      HeapInsert(var);
+    }
+  }
+  qhead_ = trail_lim_[level];
+  trail_.resize(trail_lim_[level]);
+  trail_lim_.resize(level);
+}
+
+CdclBackend::Clause* CdclBackend::Propagate() {
+  Clause* conflict{nullptr};
+  while (qhead_ < static_cast<int>(trail_.size())) {
+    const Lit false_lit{Negate(trail_[qhead_++])};
+    vector<Watcher>& ws{watches_[false_lit]};
+    size_t i{0};
+    size_t j{0};
+    while (i < ws.size()) {
+      const Watcher w{ws[i++]};
+      if (LitValue(w.blocker) == 1) {
+        ws[j++] = w;
+        continue;
+      }
+      vector<Lit>& lits{w.clause->lits};
+      if (lits[0] == false_lit) {
+        std::swap(lits[0], lits[1]);
+      }
+      const Lit first{lits[0]};
+      const Watcher new_watcher{w.clause, first};
+      if (first != w.blocker && LitValue(first) == 1) {
+        ws[j++] = new_watcher;
+        continue;
+      }
+      // Looks for a new literal to watch.
+      bool found{false};
+      for (size_t k = 2; k < lits.size(); ++k) {
+        if (LitValue(lits[k]) != -1) {
+          lits[1] = lits[k];
+          lits[k] = false_lit;
+          watches_[lits[1]].push_back(new_watcher);
+          found = true;
+          break;
+        }
+      }
+      if (found) {
+        continue;
+      }
+      // The clause is unit or conflicting.
+      ws[j++] = new_watcher;
+      if (LitValue(first) == -1) {
+        conflict = w.clause;
+        qhead_ = static_cast<int>(trail_.size());
+        while (i < ws.size()) {
+          ws[j++] = ws[i++];
+        }
+      } else {
+        Enqueue(first, w.clause);
+      }
+    }
+    ws.resize(j);
+  }
+  return conflict;
+}
+
+int CdclBackend::Analyze(Clause* const conflict, vector<Lit>* const learned,
+                         int* const lbd) {
+  learned->clear();
+  learned->push_back(-1);  // The asserting literal, which is set later.
+  int path_count{0};
+  Lit p{-1};
+  int index{static_cast<int>(trail_.size()) - 1};
+  Clause* c{conflict};
+  do {
+    DREAL_ASSERT(c != nullptr);
+    if (c->learned) {
+      BumpClause(c);
+    }
+    for (const Lit q : c->lits) {
+      const int var{VarOf(q)};
+      if (q == p || seen_[var] || level_[var] == 0) {
+        continue;
+      }
+      BumpVar(var);
+      seen_[var] = true;
+      if (level_[var] >= DecisionLevel()) {
+        ++path_count;
+      } else {
+        learned->push_back(q);
+      }
+    }
+    // Selects the next literal to look at.
+    while (!seen_[VarOf(trail_[index--])]) {
+    }
+    p = trail_[index + 1];
+    c = reason_[VarOf(p)];
+    seen_[VarOf(p)] = false;
+    --path_count;
+  } while (path_count > 0);
+  (*learned)[0] = Negate(p);
+
+  // Removes the literals implied by the others.
+  const vector<Lit> marked{*learned};
+  int j{1};
+  for (size_t i = 1; i < learned->size(); ++i) {
+    const Lit l{(*learned)[i]};
+    if (reason_[VarOf(l)] == nullptr || !IsRedundant(l)) {
+      (*learned)[j++] = l;
+    }
+  }
+  learned->resize(j);
+  for (const Lit l : marked) {
+    seen_[VarOf(l)] = false;
+  }
+
+  *lbd = ComputeLbd(*learned);
+
+  // Finds the backjump level, which is the second highest level.
+  if (learned->size() == 1) {
+    return 0;
+  }
+  size_t max_i{1};
+  for (size_t i = 2; i < learned->size(); ++i) {
+    if (level_[VarOf((*learned)[i])] > level_[VarOf((*learned)[max_i])]) {
+      max_i = i;
+    }
+  }
+  std::swap((*learned)[1], (*learned)[max_i]);
+  return level_[VarOf((*learned)[1])];
+}
+
+bool CdclBackend::IsRedundant(const Lit lit) const {
+  const Clause& c{*reason_[VarOf(lit)]};
+  // c.lits[0] is ¬lit, which is implied by c.
+  for (size_t i = 1; i < c.lits.size(); ++i) {
+    const int var{VarOf(c.lits[i])};
+    if (!seen_[var] && level_[var] > 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int CdclBackend::ComputeLbd(const vector<Lit>& lits) const {
+  vector<int> levels;
+  levels.reserve(lits.size());
+  for (const Lit l : lits) {
+    levels.push_back(level_[VarOf(l)]);
+  }
+  std::sort(levels.begin(), levels.end());
+  return static_cast<int>(std::unique(levels.begin(), levels.end()) -
+                          levels.begin());
+}
+
+int CdclBackend::Search(const int64_t max_conflicts) {
+  int64_t conflicts{0};
+  vector<Lit> learned;
+  while (true) {
+    Clause* const conflict{Propagate()};
+    if (conflict != nullptr) {
+      ++conflicts;
+      ++num_conflicts_;
+      if (DecisionLevel() == 0) {
+        ok_ = false;
+        return -1;
+      }
+      int lbd{0};
+      CancelUntil(Analyze(conflict, &learned, &lbd));
+      if (learned.size() == 1) {
+        Enqueue(learned[0], nullptr);
+      } else {
+        learned_.push_back(make_unique<Clause>());
+        Clause* const c{learned_.back().get()};
+        c->lits = learned;
+        c->learned = true;
+        c->lbd = lbd;
+        Attach(c);
+        BumpClause(c);
+        Enqueue(learned[0], c);
+      }
+      var_inc_ /= kVarDecay;
+      clause_inc_ /= kClauseDecay;
+      continue;
+    }
+    if (conflicts >= max_conflicts) {
+      CancelUntil(0);
+      return 0;
+    }
+    if (num_conflicts_ >= next_reduce_) {
+      ++num_reductions_;
+      next_reduce_ =
+          num_conflicts_ + kReduceBase + kReduceInc * num_reductions_;
+      ReduceLearned();
+    }
+    // Assumes the activation variables of the open scopes first, one
+    // per decision level.
+    Lit next{-1};
+    while (DecisionLevel() < static_cast<int>(scopes_.size())) {
+      const Lit a{MakeLit(scopes_[DecisionLevel()], false)};
+      if (LitValue(a) == 1) {
+        NewDecisionLevel();
+      } else if (LitValue(a) == -1) {
+        // UNSAT under the assumptions.
+        return -1;
+      } else {
+        next = a;
+        break;
+      }
+    }
+    if (next < 0) {
+      next = PickBranchLit();
+      if (next < 0) {
+        return 1;
+      }
+    }
+    NewDecisionLevel();
+    Enqueue(next, nullptr);
+  }
+}
+
+CdclBackend::Lit CdclBackend::PickBranchLit() {
+  while (!heap_.empty()) {
+    const int var{HeapPop()};
+    if (assigns_[var] == 0 && decision_[var]) {
+      return MakeLit(var, polarity_[var]);
+    }
+  }
+  return -1;
+}
+
+bool CdclBackend::Solve() {
+  thread_local CdclBackendStat stat{DREAL_LOG_INFO_ENABLED};
+  CancelUntil(0);
+  if (!ok_) {
+    return false;
+  }
+  const int64_t old_num_conflicts{num_conflicts_};
+  int status{0};
+  for (int restart = 0; status == 0; ++restart) {
+    status = Search(Luby(restart) * kRestartUnit);
+    if (status == 0 && stat.enabled()) {
+      stat.num_restarts_++;
+    }
+  }
+  if (stat.enabled()) {
+    stat.num_conflicts_ += num_conflicts_ - old_num_conflicts;
+  }
+  DREAL_LOG_DEBUG("CdclBackend::Solve() {} after {} conflicts.",
+                  status == 1 ? "SAT" : "UNSAT",
+                  num_conflicts_ - old_num_conflicts);
+  if (status == 1) {
+    ComputeModel();
+  }
+  CancelUntil(0);
+  return status == 1;
+}
+
+void CdclBackend::ComputeModel() {
+  model_ = assigns_;
+  needed_.assign(assigns_.size(), false);
+  const int root_size{trail_lim_.empty() ? static_cast<int>(trail_.size())
+                                         : trail_lim_[0]};
+  for (int i = 0; i < root_size; ++i) {
+    needed_[VarOf(trail_[i])] = true;
+  }
+  for (const unique_ptr<Clause>& c : clauses_) {
+    Lit choice{-1};
+    for (const Lit l : c->lits) {
+      if (LitValue(l) != 1) {
+        continue;
+      }
+      if (needed_[VarOf(l)]) {
+        choice = -1;
+        break;
+      }
+      if (choice < 0) {
+        choice = l;
+      }
+    }
+    if (choice >= 0) {
+      needed_[VarOf(choice)] = true;
+    }
+  }
+}
+
+int CdclBackend::Value(const int var) const {
+  DREAL_ASSERT(var > 0);
+  if (var >= static_cast<int>(needed_.size()) || !needed_[var]) {
+    return 0;
+  }
+  return model_[var];
+}
+
+void CdclBackend::Push() {
+  const int a{NewVar()};
+  decision_[a] = false;
+  scopes_.push_back(a);
+}
+
+void CdclBackend::Pop() {
+  DREAL_ASSERT(!scopes_.empty());
+  const int a{scopes_.back()};
+  scopes_.pop_back();
+  if (AddClause({MakeLit(a, true)})) {
+    RemoveSatisfied();
+  }
+}
+
+void CdclBackend::WriteClausalCore(FILE*) {
+  throw DREAL_RUNTIME_ERROR("CdclBackend does not support unsat cores.");
+}
+
+int CdclBackend::num_vars() const {
+  return static_cast<int>(assigns_.size()) - 1;
+}
+
+int CdclBackend::num_clauses() const { return num_added_clauses_; }
+
+int CdclBackend::num_learned_clauses() const {
+  return static_cast<int>(learned_.size());
+}
+
+void CdclBackend::BumpVar(const int var) {
+  activity_[var] += var_inc_;
+  if (activity_[var] > 1e100) {
+    for (double& a : activity_) {
+      a *= 1e-100;
+    }
+    var_inc_ *= 1e-100;
+  }
+  if (HeapContains(var)) {
+    HeapUp(heap_index_[var]);
+  }
+}
+
+void CdclBackend::BumpClause(Clause* const c) {
+  c->activity += clause_inc_;
+  if (c->activity > 1e20) {
+    for (const unique_ptr<Clause>& l : learned_) {
+      l->activity *= 1e-20;
+    }
+    clause_inc_ *= 1e-20;
+  }
+}
+
+void CdclBackend::ReduceLearned() {
+  vector<Clause*> candidates;
+  for (const unique_ptr<Clause>& c : learned_) {
+    const Lit first{c->lits[0]};
+    const bool locked{reason_[VarOf(first)] == c.get() &&
+                      LitValue(first) == 1};
+    if (c->lbd > kGlueLbd && !locked) {
+      candidates.push_back(c.get());
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Clause* const c1, const Clause* const c2) {
+              return c1->activity < c2->activity;
+            });
+  for (size_t i = 0; i < candidates.size() / 2; ++i) {
+    candidates[i]->deleted = true;
+  }
+  CollectGarbage();
+}
+
+void CdclBackend::RemoveSatisfied() {
+  DREAL_ASSERT(DecisionLevel() == 0);
+  for (const Lit l : trail_) {
+    // The reasons at the root level are never used.
+    reason_[VarOf(l)] = nullptr;
+  }
+  for (auto* db : {&clauses_, &learned_}) {
+    for (const unique_ptr<Clause>& c : *db) {
+      c->deleted =
+          std::any_of(c->lits.begin(), c->lits.end(),
+                      [this](const Lit l) { return LitValue(l) == 1; });
+    }
+  }
+  CollectGarbage();
+}
+
+void CdclBackend::CollectGarbage() {
+  for (vector<Watcher>& ws : watches_) {
+    ws.erase(std::remove_if(ws.begin(), ws.end(),
+                            [](const Watcher& w) { return w.clause->deleted; }),
+             ws.end());
+  }
+  for (auto* db : {&clauses_, &learned_}) {
+    db->erase(std::remove_if(
+                  db->begin(), db->end(),
+                  [](const unique_ptr<Clause>& c) { return c->deleted; }),
+              db->end());
+  }
+}
+
+void CdclBackend::HeapInsert(const int var) {
+  heap_index_[var] = static_cast<int>(heap_.size());
+  heap_.push_back(var);
+  HeapUp(heap_index_[var]);
+}
+
+int CdclBackend::HeapPop() {
+  const int var{heap_[0]};
+  const int last{heap_.back()};
+  heap_.pop_back();
+  heap_index_[var] = -1;
+  if (!heap_.empty()) {
+    heap_[0] = last;
+    heap_index_[last] = 0;
+    HeapDown(0);
+  }
+  return var;
+}
+
+void CdclBackend::HeapUp(int pos) {
+  const int var{heap_[pos]};
+  while (pos > 0) {
+    const int parent{(pos - 1) / 2};
+    if (activity_[heap_[parent]] >= activity_[var]) {
+      break;
+    }
+    heap_[pos] = heap_[parent];
+    heap_index_[heap_[pos]] = pos;
+    pos = parent;
+  }
+  heap_[pos] = var;
+  heap_index_[var] = pos;
+}
+
+void CdclBackend::HeapDown(int pos) {
+  const int var{heap_[pos]};
+  const int size{static_cast<int>(heap_.size())};
+  while (true) {
+    int child{2 * pos + 1};
+    if (child >= size) {
+      break;
+    }
+    if (child + 1 < size &&
+        activity_[heap_[child + 1]] > activity_[heap_[child]]) {
+      ++child;
+    }
+    if (activity_[heap_[child]] <= activity_[var]) {
+      break;
+    }
+    heap_[pos] = heap_[child];
+    heap_index_[heap_[pos]] = pos;
+    pos = child;
+  }
+  heap_[pos] = var;
+  heap_index_[var] = pos;
+}
+
+}  // namespace dreal
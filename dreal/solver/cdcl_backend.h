@@ -0,0 +1,183 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "dreal/solver/config.h"
+#include "dreal/solver/sat_backend.h"
+
+namespace dreal {
+
+/// Incremental CDCL SAT solver.
+///
+/// It uses two watched literals with blockers, VSIDS with phase
+/// saving, first-UIP learning with clause minimization, and Luby
+/// restarts. The learned clauses are reduced periodically by their
+/// activities, while the ones whose LBD (the number of decision levels
+/// in them) is at most kGlueLbd are kept forever.
+///
+/// A scope is implemented with an activation variable `a`: a clause
+/// `c` added in the scope is stored as `c ∨ ¬a` and Solve assumes `a`
+/// for all the open scopes. Pop adds the unit clause `¬a`, which
+/// satisfies the clauses of the scope so that they are removed. Since
+/// a learned clause depends on `a` only through `¬a`, all the learned
+/// clauses are still valid after Pop and they are kept.
+///
+/// The model of Solve is partial. A variable is needed if it is
+/// assigned at the root level or if it is chosen to satisfy an added
+/// clause which is not satisfied by the other chosen literals.
+class CdclBackend : public SatBackend {
+ public:
+  /// Learned clauses whose LBD is at most this value are never removed.
+  static constexpr int kGlueLbd{2};
+
+  /// The number of conflicts in a unit of the Luby restart sequence.
+  static constexpr int kRestartUnit{100};
+
+  /// Constructs a CDCL backend using the SAT options in @p config.
+  explicit CdclBackend(const Config& config);
+
+  ~CdclBackend() override;
+
+  int NewVar() override;
+  void Add(int lit) override;
+  bool Solve() override;
+  int Value(int var) const override;
+  void Push() override;
+  void Pop() override;
+  void WriteClausalCore(FILE* file) override;
+  int num_vars() const override;
+  int num_clauses() const override;
+
+  /// Returns the number of learned clauses in the database.
+  int num_learned_clauses() const;
+
+ private:
+  // A literal of variable v is encoded as 2v (v) or 2v + 1 (¬v).
+  using Lit = int;
+
+  struct Clause {
+    std::vector<Lit> lits;
+    bool learned{false};
+    bool deleted{false};
+    int lbd{0};
+    double activity{0.0};
+  };
+
+  struct Watcher {
+    Clause* clause;
+    // A literal of the clause. If it is true, the clause is satisfied
+    // and we do not need to visit it.
+    Lit blocker;
+  };
+
+  static Lit MakeLit(int var, bool negated) { return 2 * var + negated; }
+  static int VarOf(Lit lit) { return lit >> 1; }
+  static bool IsNegated(Lit lit) { return lit & 1; }
+  static Lit Negate(Lit lit) { return lit ^ 1; }
+
+  // Returns 1 (true), -1 (false), or 0 (unassigned).
+  int LitValue(Lit lit) const {
+    const int v{assigns_[VarOf(lit)]};
+    return IsNegated(lit) ? -v : v;
+  }
+
+  int DecisionLevel() const { return static_cast<int>(trail_lim_.size()); }
+
+  // Adds @p lits as a clause at the root level. Returns false if the
+  // clauses become unsatisfiable.
+  bool AddClause(std::vector<Lit> lits);
+  void Attach(Clause* c);
+  void Enqueue(Lit lit, Clause* reason);
+  void NewDecisionLevel();
+  void CancelUntil(int level);
+
+  // Returns a conflicting clause or nullptr.
+  Clause* Propagate();
+
+  // Computes the first-UIP clause of @p conflict into @p learned with
+  // the asserting literal at the front. Returns the backjump level.
+  int Analyze(Clause* conflict, std::vector<Lit>* learned, int* lbd);
+  // Returns true if @p lit is implied by the other literals of the
+  // learned clause, which are marked in seen_.
+  bool IsRedundant(Lit lit) const;
+  int ComputeLbd(const std::vector<Lit>& lits) const;
+
+  // Searches for at most @p max_conflicts conflicts. Returns 1 (SAT),
+  // -1 (UNSAT), or 0 (restart).
+  int Search(int64_t max_conflicts);
+  Lit PickBranchLit();
+
+  void BumpVar(int var);
+  void BumpClause(Clause* c);
+  void ReduceLearned();
+  // Removes the clauses satisfied at the root level.
+  void RemoveSatisfied();
+  // Removes the deleted clauses from the watch lists and the database.
+  void CollectGarbage();
+  void ComputeModel();
+
+  // Max-heap of the variables ordered by their activities.
+  bool HeapContains(int var) const { return heap_index_[var] >= 0; }
+  void HeapInsert(int var);
+  int HeapPop();
+  void HeapUp(int pos);
+  void HeapDown(int pos);
+
+  // false if the clauses are unsatisfiable at the root level.
+  bool ok_{true};
+
+  std::vector<std::unique_ptr<Clause>> clauses_;
+  std::vector<std::unique_ptr<Clause>> learned_;
+  std::vector<std::vector<Watcher>> watches_;  // Indexed by literals.
+
+  // Indexed by variables. The index 0 is not used.
+  std::vector<int8_t> assigns_;
+  std::vector<int> level_;
+  std::vector<Clause*> reason_;
+  std::vector<double> activity_;
+  std::vector<bool> polarity_;  // Saved phase. true means negated.
+  std::vector<bool> decision_;  // false for activation variables.
+  std::vector<bool> seen_;
+  std::vector<int> heap_index_;
+  std::vector<int> heap_;
+
+  std::vector<Lit> trail_;
+  std::vector<int> trail_lim_;
+  int qhead_{0};
+
+  std::vector<Lit> clause_;    // The clause being added.
+  std::vector<int> scopes_;    // Activation variables.
+  std::vector<int8_t> model_;  // The (total) model of the last Solve.
+  std::vector<bool> needed_;   // See the class documentation.
+
+  double var_inc_{1.0};
+  double clause_inc_{1.0};
+  int64_t num_conflicts_{0};
+  int64_t next_reduce_;
+  int num_reductions_{0};
+  int num_added_clauses_{0};
+
+  Config::SatDefaultPhase default_phase_;
+  std::mt19937 rng_;
+};
+
+}  // namespace dreal
@@ -0,0 +1,246 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/solver/checkpoint.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "dreal/util/exception.h"
+#include "dreal/util/logging.h"
+
+namespace dreal {
+
+using std::set;
+using std::size_t;
+using std::string;
+using std::uint64_t;
+using std::vector;
+using std::chrono::steady_clock;
+
+namespace {
+
+// Identifies a checkpoint file ("dRealCkp" in little-endian).
+constexpr uint64_t kMagic{0x706B436C61655264};
+// Incremented whenever the file format changes.
+constexpr uint64_t kVersion{1};
+
+// 64-bit FNV-1a hash.
+class Fnv1a {
+ public:
+  void Add(const void* const data, const size_t size) {
+    const unsigned char* const bytes{static_cast<const unsigned char*>(data)};
+    for (size_t i = 0; i < size; ++i) {
+      hash_ = (hash_ ^ bytes[i]) * kPrime;
+    }
+  }
+  void Add(const string& s) {
+    const uint64_t size{s.size()};
+    Add(&size, sizeof(size));
+    Add(s.data(), s.size());
+  }
+  void Add(const double v) { Add(&v, sizeof(v)); }
+  uint64_t get() const { return hash_; }
+
+ private:
+  static constexpr uint64_t kPrime{0x100000001b3};
+  uint64_t hash_{0xcbf29ce484222325};
+};
+
+}  // namespace
+
+uint64_t ComputeQueryFingerprint(const Box& box,
+                                 const vector<Formula>& formulas) {
+  Fnv1a hash;
+  for (int i = 0; i < box.size(); ++i) {
+    hash.Add(box.variable(i).get_name());
+    hash.Add(box[i].lb());
+    hash.Add(box[i].ub());
+  }
+  for (const Formula& f : formulas) {
+    hash.Add(f.to_string());
+  }
+  return hash.get();
+}
+
+Checkpointer::Checkpointer(string path, const double interval,
+                           const string& resume_path)
+    : path_{std::move(path)},
+      interval_{std::chrono::duration_cast<steady_clock::duration>(
+          std::chrono::duration<double>(interval))},
+      last_save_{steady_clock::now()} {
+  if (resume_path.empty()) {
+    return;
+  }
+  std::ifstream in(resume_path, std::ios::binary);
+  if (!in) {
+    DREAL_LOG_WARN(
+        "Checkpointer: Cannot open {}. Start the search from scratch.",
+        resume_path);
+    return;
+  }
+  const string data{std::istreambuf_iterator<char>(in),
+                    std::istreambuf_iterator<char>()};
+  InputArchive archive{data};
+  if (archive.ReadUint64() != kMagic) {
+    throw DREAL_RUNTIME_ERROR("{} is not a checkpoint file.", resume_path);
+  }
+  const uint64_t version{archive.ReadUint64()};
+  if (version != kVersion) {
+    throw DREAL_RUNTIME_ERROR(
+        "{} has an unsupported checkpoint version {} (expected {}).",
+        resume_path, version, kVersion);
+  }
+  const uint64_t num_clauses{archive.ReadUint64()};
+  for (uint64_t i = 0; i < num_clauses; ++i) {
+    Clause clause;
+    clause.fingerprint = archive.ReadUint64();
+    const uint64_t num_literals{archive.ReadUint64()};
+    for (uint64_t j = 0; j < num_literals; ++j) {
+      clause.literals.push_back(archive.ReadString());
+    }
+    clauses_.push_back(std::move(clause));
+  }
+  has_resumed_frontier_ = archive.ReadUint64() != 0;
+  if (has_resumed_frontier_) {
+    resumed_frontier_fingerprint_ = archive.ReadUint64();
+    resumed_frontier_ = archive.ReadString();
+  }
+  if (!archive.done()) {
+    throw DREAL_RUNTIME_ERROR("{} has trailing bytes.", resume_path);
+  }
+  DREAL_LOG_INFO("Checkpointer: Resume {} learned clauses{} from {}",
+                 clauses_.size(),
+                 has_resumed_frontier_ ? " and a frontier" : "", resume_path);
+}
+
+bool Checkpointer::due() const {
+  return enabled() &&
+         steady_clock::now() - last_save_ >= interval_;
+}
+
+void Checkpointer::AddLearnedClause(const uint64_t fingerprint,
+                                    const set<Formula>& literals) {
+  if (!enabled()) {
+    return;
+  }
+  Clause clause{fingerprint, {}};
+  clause.literals.reserve(literals.size());
+  for (const Formula& l : literals) {
+    clause.literals.push_back(l.to_string());
+  }
+  clauses_.push_back(std::move(clause));
+}
+
+vector<vector<string>> Checkpointer::TakeResumedClauses(
+    const uint64_t fingerprint) {
+  vector<vector<string>> ret;
+  if (!taken_clauses_.insert(fingerprint).second) {
+    return ret;
+  }
+  for (const Clause& clause : clauses_) {
+    if (clause.fingerprint == fingerprint) {
+      ret.push_back(clause.literals);
+    }
+  }
+  return ret;
+}
+
+optional<vector<FrontierEntry>> Checkpointer::TakeResumedFrontier(
+    const uint64_t fingerprint, const Box& root) {
+  if (!has_resumed_frontier_ || resumed_frontier_fingerprint_ != fingerprint) {
+    return {};
+  }
+  has_resumed_frontier_ = false;
+  InputArchive archive{resumed_frontier_};
+  const uint64_t size{archive.ReadUint64()};
+  vector<FrontierEntry> frontier;
+  frontier.reserve(size);
+  for (uint64_t i = 0; i < size; ++i) {
+    const int branching_point{static_cast<int>(archive.ReadInt64())};
+    Box box{root};
+    ReadBox(&archive, &box);
+    frontier.emplace_back(std::move(box), branching_point);
+  }
+  resumed_frontier_.clear();
+  DREAL_LOG_INFO("Checkpointer: Resume a frontier of {} boxes", size);
+  return frontier;
+}
+
+void Checkpointer::Save(const uint64_t fingerprint,
+                        const vector<FrontierEntry>& frontier) {
+  OutputArchive boxes;
+  boxes.WriteUint64(frontier.size());
+  for (const FrontierEntry& entry : frontier) {
+    boxes.WriteInt64(entry.second);
+    WriteBox(entry.first, &boxes);
+  }
+
+  OutputArchive archive;
+  WriteHeaderAndClauses(&archive);
+  archive.WriteUint64(1);
+  archive.WriteUint64(fingerprint);
+  archive.WriteString(boxes.data());
+  Write(archive.data());
+  DREAL_LOG_INFO(
+      "Checkpointer: Save {} learned clauses and a frontier of {} boxes to {}",
+      clauses_.size(), frontier.size(), path_);
+}
+
+void Checkpointer::Save() {
+  OutputArchive archive;
+  WriteHeaderAndClauses(&archive);
+  archive.WriteUint64(0);
+  Write(archive.data());
+  DREAL_LOG_INFO("Checkpointer: Save {} learned clauses to {}",
+                 clauses_.size(), path_);
+}
+
+void Checkpointer::WriteHeaderAndClauses(OutputArchive* const archive) const {
+  archive->WriteUint64(kMagic);
+  archive->WriteUint64(kVersion);
+  archive->WriteUint64(clauses_.size());
+  for (const Clause& clause : clauses_) {
+    archive->WriteUint64(clause.fingerprint);
+    archive->WriteUint64(clause.literals.size());
+    for (const string& l : clause.literals) {
+      archive->WriteString(l);
+    }
+  }
+}
+
+void Checkpointer::Write(const string& data) {
+  const string tmp_path{path_ + ".tmp"};
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    out.flush();
+    if (!out) {
+      throw DREAL_RUNTIME_ERROR("Failed to write a checkpoint to {}.",
+                                tmp_path);
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path_.c_str()) != 0) {
+    throw DREAL_RUNTIME_ERROR("Failed to rename {} to {}: {}", tmp_path,
+                              path_, std::strerror(errno));
+  }
+  last_save_ = steady_clock::now();
+}
+
+}  // namespace dreal
@@ -0,0 +1,128 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/archive.h"
+#include "dreal/util/box.h"
+#include "dreal/util/optional.h"
+
+namespace dreal {
+
+/// A pending box in a branch-and-prune search along with the branching
+/// dimension which produced it (-1 if unknown).
+using FrontierEntry = std::pair<Box, int>;
+
+/// Returns a fingerprint of a query which consists of the initial box
+/// @p box and the assertions @p formulas. A checkpoint only restores
+/// the data which was saved for a query with the same fingerprint.
+std::uint64_t ComputeQueryFingerprint(const Box& box,
+                                      const std::vector<Formula>& formulas);
+
+/// Saves the state of a long-running search into a file and restores
+/// it in a later run.
+///
+/// A checkpoint file keeps two kinds of data:
+///
+///  - The clauses learned from theory conflicts. They are written as
+///    the string representations of their literals because symbolic
+///    variables are not stable across processes. Each clause is tagged
+///    with the fingerprint of the SMT query which learned it.
+///
+///  - The frontier of the ICP search which was running when the file
+///    was written, that is, the boxes which are not explored yet. It is
+///    tagged with the fingerprint of the theory query.
+///
+/// A file is written to a temporary file first and then renamed, so
+/// that a crash during a save does not destroy the previous checkpoint.
+class Checkpointer {
+ public:
+  /// Constructs a checkpointer which writes to @p path every @p
+  /// interval seconds. If @p resume_path is not empty, it loads the
+  /// checkpoint in the file. A missing @p resume_path is not an error,
+  /// so that the same command line can be used for the first run and
+  /// for the following ones.
+  ///
+  /// @throws std::runtime_error if @p resume_path is not a valid
+  /// checkpoint file.
+  Checkpointer(std::string path, double interval,
+               const std::string& resume_path);
+
+  /// Returns true if it writes checkpoints.
+  bool enabled() const { return !path_.empty(); }
+
+  /// Returns true if it is time to write a checkpoint.
+  bool due() const;
+
+  /// Records a learned clause (¬l₁ ∨ ... ∨ ¬lₙ) for the query @p
+  /// fingerprint. @p literals are {l₁, ..., lₙ}.
+  void AddLearnedClause(std::uint64_t fingerprint,
+                        const std::set<Formula>& literals);
+
+  /// Returns the string representations of the literals of the resumed
+  /// clauses for the query @p fingerprint. It returns them only once.
+  std::vector<std::vector<std::string>> TakeResumedClauses(
+      std::uint64_t fingerprint);
+
+  /// Returns the resumed frontier for the theory query @p fingerprint
+  /// whose initial box is @p root. It returns it only once.
+  optional<std::vector<FrontierEntry>> TakeResumedFrontier(
+      std::uint64_t fingerprint, const Box& root);
+
+  /// Writes a checkpoint with the learned clauses and the frontier @p
+  /// frontier of the theory query @p fingerprint.
+  void Save(std::uint64_t fingerprint,
+            const std::vector<FrontierEntry>& frontier);
+
+  /// Writes a checkpoint with the learned clauses only.
+  void Save();
+
+ private:
+  struct Clause {
+    std::uint64_t fingerprint;
+    std::vector<std::string> literals;
+  };
+
+  // Writes the file header and the learned clauses into @p archive.
+  void WriteHeaderAndClauses(OutputArchive* archive) const;
+
+  // Writes @p data into the checkpoint file.
+  void Write(const std::string& data);
+
+  std::string path_;
+  std::chrono::steady_clock::duration interval_;
+  std::chrono::steady_clock::time_point last_save_;
+
+  std::vector<Clause> clauses_;
+  // Fingerprints of the queries which already took their resumed
+  // clauses.
+  std::set<std::uint64_t> taken_clauses_;
+
+  // The resumed frontier, stored as a serialized archive because we
+  // need the variables of the root box to read it.
+  bool has_resumed_frontier_{false};
+  std::uint64_t resumed_frontier_fingerprint_{0};
+  std::string resumed_frontier_;
+};
+
+}  // namespace dreal
@@ -30,6 +30,10 @@ constexpr double Config::kDefaultNloptFtolRel;
 constexpr double Config::kDefaultNloptFtolAbs;
 constexpr int Config::kDefaultNloptMaxEval;
 constexpr double Config::kDefaultNloptMaxTime;
+constexpr double Config::kDefaultCheckpointInterval;
+constexpr double Config::kDefaultAdaptiveFixpointDecay;
+constexpr double Config::kDefaultNewtonThreshold;
+constexpr double Config::kDefaultExplanationMinimizationBudget;
 #endif
 
 double Config::precision() const { return precision_.get(); }
@@ -48,6 +52,23 @@ OptionValue<bool>& Config::mutable_use_polytope_in_forall() {
   return use_polytope_in_forall_;
 }
 
+int Config::polytope_frequency() const { return polytope_frequency_.get(); }
+OptionValue<int>& Config::mutable_polytope_frequency() {
+  return polytope_frequency_;
+}
+
+bool Config::polytope_on_stall() const { return polytope_on_stall_.get(); }
+OptionValue<bool>& Config::mutable_polytope_on_stall() {
+  return polytope_on_stall_;
+}
+
+bool Config::polytope_skip_unchanged() const {
+  return polytope_skip_unchanged_.get();
+}
+OptionValue<bool>& Config::mutable_polytope_skip_unchanged() {
+  return polytope_skip_unchanged_;
+}
+
 bool Config::use_worklist_fixpoint() const {
   return use_worklist_fixpoint_.get();
 }
@@ -62,6 +83,93 @@ OptionValue<bool>& Config::mutable_use_local_optimization() {
   return use_local_optimization_;
 }
 
+bool Config::use_native_hc4() const { return use_native_hc4_.get(); }
+OptionValue<bool>& Config::mutable_use_native_hc4() {
+  return use_native_hc4_;
+}
+
+bool Config::use_shared_dag() const { return use_shared_dag_.get(); }
+OptionValue<bool>& Config::mutable_use_shared_dag() {
+  return use_shared_dag_;
+}
+
+bool Config::use_batch_evaluation() const {
+  return use_batch_evaluation_.get();
+}
+OptionValue<bool>& Config::mutable_use_batch_evaluation() {
+  return use_batch_evaluation_;
+}
+
+bool Config::use_adaptive_fixpoint() const {
+  return use_adaptive_fixpoint_.get();
+}
+OptionValue<bool>& Config::mutable_use_adaptive_fixpoint() {
+  return use_adaptive_fixpoint_;
+}
+
+double Config::adaptive_fixpoint_decay() const {
+  return adaptive_fixpoint_decay_.get();
+}
+OptionValue<double>& Config::mutable_adaptive_fixpoint_decay() {
+  return adaptive_fixpoint_decay_;
+}
+
+bool Config::use_linear_contractor() const {
+  return use_linear_contractor_.get();
+}
+OptionValue<bool>& Config::mutable_use_linear_contractor() {
+  return use_linear_contractor_;
+}
+
+bool Config::use_newton() const { return use_newton_.get(); }
+OptionValue<bool>& Config::mutable_use_newton() { return use_newton_; }
+
+double Config::newton_threshold() const { return newton_threshold_.get(); }
+OptionValue<double>& Config::mutable_newton_threshold() {
+  return newton_threshold_;
+}
+
+Config::Shaving Config::shaving() const { return shaving_.get(); }
+OptionValue<Config::Shaving>& Config::mutable_shaving() { return shaving_; }
+
+int Config::shaving_slices() const { return shaving_slices_.get(); }
+OptionValue<int>& Config::mutable_shaving_slices() { return shaving_slices_; }
+
+bool Config::use_online_theory_check() const {
+  return use_online_theory_check_.get();
+}
+OptionValue<bool>& Config::mutable_use_online_theory_check() {
+  return use_online_theory_check_;
+}
+
+bool Config::use_theory_propagation() const {
+  return use_theory_propagation_.get();
+}
+OptionValue<bool>& Config::mutable_use_theory_propagation() {
+  return use_theory_propagation_;
+}
+
+bool Config::use_explanation_minimization() const {
+  return use_explanation_minimization_.get();
+}
+OptionValue<bool>& Config::mutable_use_explanation_minimization() {
+  return use_explanation_minimization_;
+}
+
+double Config::explanation_minimization_budget() const {
+  return explanation_minimization_budget_.get();
+}
+OptionValue<double>& Config::mutable_explanation_minimization_budget() {
+  return explanation_minimization_budget_;
+}
+
+bool Config::use_incremental_theory() const {
+  return use_incremental_theory_.get();
+}
+OptionValue<bool>& Config::mutable_use_incremental_theory() {
+  return use_incremental_theory_;
+}
+
 int Config::number_of_jobs() const { return number_of_jobs_.get(); }
 OptionValue<int>& Config::mutable_number_of_jobs() { return number_of_jobs_; }
 
@@ -110,6 +218,12 @@ OptionValue<Config::SatDefaultPhase>& Config::mutable_sat_default_phase() {
   return sat_default_phase_;
 }
 
+Config::SatBackend Config::sat_backend() const { return sat_backend_.get(); }
+
+OptionValue<Config::SatBackend>& Config::mutable_sat_backend() {
+  return sat_backend_;
+}
+
 uint32_t Config::random_seed() const { return random_seed_.get(); }
 
 OptionValue<uint32_t>& Config::mutable_random_seed() { return random_seed_; }
@@ -117,6 +231,51 @@ OptionValue<uint32_t>& Config::mutable_random_seed() { return random_seed_; }
 bool Config::mcts() const { return mcts_.get(); }
 OptionValue<bool>& Config::mutable_mcts() { return mcts_; }
 
+Config::SearchStrategy Config::search_strategy() const {
+  return search_strategy_.get();
+}
+OptionValue<Config::SearchStrategy>& Config::mutable_search_strategy() {
+  return search_strategy_;
+}
+
+Config::BestFirstScore Config::best_first_score() const {
+  return best_first_score_.get();
+}
+OptionValue<Config::BestFirstScore>& Config::mutable_best_first_score() {
+  return best_first_score_;
+}
+
+bool Config::portfolio() const { return portfolio_.get(); }
+OptionValue<bool>& Config::mutable_portfolio() { return portfolio_; }
+
+bool Config::deterministic() const { return deterministic_.get(); }
+OptionValue<bool>& Config::mutable_deterministic() { return deterministic_; }
+
+std::string Config::distributed_address() const {
+  return distributed_address_.get();
+}
+OptionValue<std::string>& Config::mutable_distributed_address() {
+  return distributed_address_;
+}
+
+int Config::distributed_workers() const { return distributed_workers_.get(); }
+OptionValue<int>& Config::mutable_distributed_workers() {
+  return distributed_workers_;
+}
+
+std::string Config::checkpoint() const { return checkpoint_.get(); }
+OptionValue<std::string>& Config::mutable_checkpoint() { return checkpoint_; }
+
+double Config::checkpoint_interval() const {
+  return checkpoint_interval_.get();
+}
+OptionValue<double>& Config::mutable_checkpoint_interval() {
+  return checkpoint_interval_;
+}
+
+std::string Config::resume() const { return resume_.get(); }
+OptionValue<std::string>& Config::mutable_resume() { return resume_; }
+
 bool Config::unsat_core() const { return unsat_core_.get(); }
 OptionValue<bool>& Config::mutable_unsat_core() { return unsat_core_; }
 
@@ -142,6 +301,54 @@ std::ostream& operator<<(std::ostream& os,
   DREAL_UNREACHABLE();
 }
 
+ostream& operator<<(ostream& os, const Config::SatBackend& sat_backend) {
+  switch (sat_backend) {
+    case Config::SatBackend::PicoSat:
+      return os << "picosat";
+    case Config::SatBackend::Cdcl:
+      return os << "cdcl";
+  }
+  DREAL_UNREACHABLE();
+}
+
+ostream& operator<<(ostream& os,
+                    const Config::SearchStrategy& search_strategy) {
+  switch (search_strategy) {
+    case Config::SearchStrategy::DepthFirst:
+      return os << "depth-first";
+    case Config::SearchStrategy::BestFirst:
+      return os << "best-first";
+  }
+  DREAL_UNREACHABLE();
+}
+
+ostream& operator<<(ostream& os,
+                    const Config::BestFirstScore& best_first_score) {
+  switch (best_first_score) {
+    case Config::BestFirstScore::Volume:
+      return os << "volume";
+    case Config::BestFirstScore::Undecided:
+      return os << "undecided";
+    case Config::BestFirstScore::Violation:
+      return os << "violation";
+  }
+  DREAL_UNREACHABLE();
+}
+
+ostream& operator<<(ostream& os, const Config::Shaving& shaving) {
+  switch (shaving) {
+    case Config::Shaving::None:
+      return os << "none";
+    case Config::Shaving::ThreeB:
+      return os << "3b";
+    case Config::Shaving::Cid:
+      return os << "cid";
+    case Config::Shaving::Acid:
+      return os << "acid";
+  }
+  DREAL_UNREACHABLE();
+}
+
 ostream& operator<<(ostream& os, const Config& config) {
   return os << fmt::format(
              "Config("
@@ -149,22 +356,66 @@ ostream& operator<<(ostream& os, const Config& config) {
              "produce_model = {}, "
              "use_polytope = {}, "
              "use_polytope_in_forall = {}, "
+             "polytope_frequency = {}, "
+             "polytope_on_stall = {}, "
+             "polytope_skip_unchanged = {}, "
              "use_worklist_fixpoint = {}, "
              "use_local_optimization = {}, "
+             "use_native_hc4 = {}, "
+             "use_shared_dag = {}, "
+             "use_batch_evaluation = {}, "
+             "use_adaptive_fixpoint = {}, "
+             "adaptive_fixpoint_decay = {}, "
+             "use_linear_contractor = {}, "
+             "use_newton = {}, "
+             "newton_threshold = {}, "
+             "shaving = {}, "
+             "shaving_slices = {}, "
+             "use_online_theory_check = {}, "
+             "use_theory_propagation = {}, "
+             "use_explanation_minimization = {}, "
+             "explanation_minimization_budget = {}, "
+             "use_incremental_theory = {}, "
              "number_of_jobs = {}, "
              "nlopt_ftol_rel = {}, "
              "nlopt_ftol_abs = {}, "
              "nlopt_maxeval = {}, "
              "nlopt_maxtime = {}, "
              "sat_default_phase = {}, "
-             "random_seed = {}"
+             "sat_backend = {}, "
+             "random_seed = {}, "
+             "search_strategy = {}, "
+             "best_first_score = {}, "
+             "portfolio = {}, "
+             "deterministic = {}, "
+             "distributed_address = {}, "
+             "distributed_workers = {}, "
+             "checkpoint = {}, "
+             "checkpoint_interval = {}, "
+             "resume = {}"
              ")",
              config.precision(), config.produce_models(), config.use_polytope(),
-             config.use_polytope_in_forall(), config.use_worklist_fixpoint(),
-             config.use_local_optimization(), config.number_of_jobs(),
+             config.use_polytope_in_forall(), config.polytope_frequency(),
+             config.polytope_on_stall(), config.polytope_skip_unchanged(),
+             config.use_worklist_fixpoint(),
+             config.use_local_optimization(), config.use_native_hc4(),
+             config.use_shared_dag(), config.use_batch_evaluation(),
+             config.use_adaptive_fixpoint(), config.adaptive_fixpoint_decay(),
+             config.use_linear_contractor(), config.use_newton(),
+             config.newton_threshold(), config.shaving(),
+             config.shaving_slices(), config.use_online_theory_check(),
+             config.use_theory_propagation(),
+             config.use_explanation_minimization(),
+             config.explanation_minimization_budget(),
+             config.use_incremental_theory(), config.number_of_jobs(),
              config.nlopt_ftol_rel(), config.nlopt_ftol_abs(),
              config.nlopt_maxeval(), config.nlopt_maxtime(),
-             config.sat_default_phase(), config.random_seed());
+             config.sat_default_phase(), config.sat_backend(),
+             config.random_seed(), config.search_strategy(),
+             config.best_first_score(), config.portfolio(),
+             config.deterministic(), config.distributed_address(),
+             config.distributed_workers(), config.checkpoint(),
+             config.checkpoint_interval(), config.resume());
 }
 
 }  // namespace dreal
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <ostream>
+#include <string>
 
 #include "dreal/solver/brancher.h"
 #include "dreal/util/box.h"
@@ -60,6 +61,29 @@ class Config {
   /// Returns a mutable OptionValue for 'use_polytope_in_forall'.
   OptionValue<bool>& mutable_use_polytope_in_forall();
 
+  /// Returns the number of calls of the polytope contractor per LP
+  /// solving. The polytope contractor solves its LPs at every k-th
+  /// call and does nothing at the other calls.
+  int polytope_frequency() const;
+
+  /// Returns a mutable OptionValue for 'polytope_frequency'.
+  OptionValue<int>& mutable_polytope_frequency();
+
+  /// Returns whether the polytope contractor runs only when the other
+  /// contractors reach a fixpoint.
+  bool polytope_on_stall() const;
+
+  /// Returns a mutable OptionValue for 'polytope_on_stall'.
+  OptionValue<bool>& mutable_polytope_on_stall();
+
+  /// Returns whether the polytope contractor skips a call if the
+  /// domains of its input variables are the same as the ones it
+  /// returned at its last call.
+  bool polytope_skip_unchanged() const;
+
+  /// Returns a mutable OptionValue for 'polytope_skip_unchanged'.
+  OptionValue<bool>& mutable_polytope_skip_unchanged();
+
   /// Returns whether it uses worklist-fixpoint algorithm.
   bool use_worklist_fixpoint() const;
 
@@ -73,6 +97,121 @@ class Config {
   /// Returns a mutable OptionValue for 'use_local_optimization'.
   OptionValue<bool>& mutable_use_local_optimization();
 
+  /// Returns whether it uses the native HC4 contractor (ContractorHc4)
+  /// instead of IBEX's forward/backward contractor.
+  bool use_native_hc4() const;
+
+  /// Returns a mutable OptionValue for 'use_native_hc4'.
+  OptionValue<bool>& mutable_use_native_hc4();
+
+  /// Returns whether it compiles all the constraints into a single
+  /// expression DAG (ContractorHc4Dag) instead of building a contractor
+  /// per constraint.
+  bool use_shared_dag() const;
+
+  /// Returns a mutable OptionValue for 'use_shared_dag'.
+  OptionValue<bool>& mutable_use_shared_dag();
+
+  /// Returns whether it evaluates the sub-boxes of a branching at once
+  /// (BatchEvaluator) in the best-first and MCTS searches.
+  bool use_batch_evaluation() const;
+
+  /// Returns a mutable OptionValue for 'use_batch_evaluation'.
+  OptionValue<bool>& mutable_use_batch_evaluation();
+
+  /// Returns whether it uses the adaptive fixpoint algorithm
+  /// (ContractorAdaptiveFixpoint), which schedules the contractors by
+  /// their observed pruning gain and cost.
+  bool use_adaptive_fixpoint() const;
+
+  /// Returns a mutable OptionValue for 'use_adaptive_fixpoint'.
+  OptionValue<bool>& mutable_use_adaptive_fixpoint();
+
+  /// Returns the decay factor of the scores in the adaptive fixpoint
+  /// algorithm. It should be in (0, 1). A larger value makes the
+  /// scores change more slowly.
+  double adaptive_fixpoint_decay() const;
+
+  /// Returns a mutable OptionValue for 'adaptive_fixpoint_decay'.
+  OptionValue<double>& mutable_adaptive_fixpoint_decay();
+
+  /// Returns whether it handles the linear constraints with a single
+  /// sparse bound-propagation contractor (ContractorLinear).
+  bool use_linear_contractor() const;
+
+  /// Returns a mutable OptionValue for 'use_linear_contractor'.
+  OptionValue<bool>& mutable_use_linear_contractor();
+
+  /// Returns whether it uses the interval Newton contractor
+  /// (ContractorNewton) on the square system of equalities.
+  bool use_newton() const;
+
+  /// Returns a mutable OptionValue for 'use_newton'.
+  OptionValue<bool>& mutable_use_newton();
+
+  /// Returns the width under which the interval Newton contractor
+  /// starts to prune the domains of its variables.
+  double newton_threshold() const;
+
+  /// Returns a mutable OptionValue for 'newton_threshold'.
+  OptionValue<double>& mutable_newton_threshold();
+
+  enum class Shaving {
+    None = 0,  // Default option
+    ThreeB = 1,
+    Cid = 2,
+    Acid = 3,
+  };
+
+  /// Returns the shaving contractor which wraps the contractor of the
+  /// theory solver.
+  Shaving shaving() const;
+
+  /// Returns a mutable OptionValue for 'shaving'.
+  OptionValue<Shaving>& mutable_shaving();
+
+  /// Returns the number of slices into which the shaving contractors
+  /// cut a domain.
+  int shaving_slices() const;
+
+  /// Returns a mutable OptionValue for 'shaving_slices'.
+  OptionValue<int>& mutable_shaving_slices();
+
+  /// Returns whether it checks the theory literals of a Boolean
+  /// assignment without branching before it runs ICP on them.
+  bool use_online_theory_check() const;
+
+  /// Returns a mutable OptionValue for 'use_online_theory_check'.
+  OptionValue<bool>& mutable_use_online_theory_check();
+
+  /// Returns whether it adds the theory literals implied by the box
+  /// pruned with a Boolean assignment to the SAT solver.
+  bool use_theory_propagation() const;
+
+  /// Returns a mutable OptionValue for 'use_theory_propagation'.
+  OptionValue<bool>& mutable_use_theory_propagation();
+
+  /// Returns whether it shrinks an explanation of a theory conflict
+  /// before it is learned by the SAT solver.
+  bool use_explanation_minimization() const;
+
+  /// Returns a mutable OptionValue for 'use_explanation_minimization'.
+  OptionValue<bool>& mutable_use_explanation_minimization();
+
+  /// Returns the time budget (in seconds) to minimize an explanation.
+  double explanation_minimization_budget() const;
+
+  /// Returns a mutable OptionValue for 'explanation_minimization_budget'.
+  OptionValue<double>& mutable_explanation_minimization_budget();
+
+  /// Returns whether the theory solver reuses the boxes pruned with
+  /// the common prefix of the theory literals of consecutive Boolean
+  /// assignments.
+  bool use_incremental_theory() const;
+
+  /// Returns a mutable OptionValue for 'use_incremental_theory'.
+  OptionValue<bool>& mutable_use_incremental_theory();
+
   /// Returns the number of parallel jobs.
   int number_of_jobs() const;
 
@@ -137,6 +276,17 @@ class Config {
   /// Returns a mutable OptionValue for `sat_default_phase`.
   OptionValue<SatDefaultPhase>& mutable_sat_default_phase();
 
+  enum class SatBackend {
+    PicoSat = 0,  // Default option
+    Cdcl = 1,
+  };
+
+  /// Returns the propositional SAT solver used by SatSolver.
+  SatBackend sat_backend() const;
+
+  /// Returns a mutable OptionValue for `sat_backend`.
+  OptionValue<SatBackend>& mutable_sat_backend();
+
   /// Returns the random seed.
   uint32_t random_seed() const;
 
@@ -155,6 +305,77 @@ class Config {
   /// Returns a mutable OptionValue for `mcts`.
   OptionValue<bool>& mutable_mcts();
 
+  enum class SearchStrategy {
+    DepthFirst = 0,  // Default option
+    BestFirst = 1,
+  };
+
+  /// Returns the search strategy of the ICP algorithm.
+  SearchStrategy search_strategy() const;
+
+  /// Returns a mutable OptionValue for `search_strategy`.
+  OptionValue<SearchStrategy>& mutable_search_strategy();
+
+  enum class BestFirstScore {
+    Volume = 0,  // Default option
+    Undecided = 1,
+    Violation = 2,
+  };
+
+  /// Returns the score which orders the boxes in best-first search.
+  BestFirstScore best_first_score() const;
+
+  /// Returns a mutable OptionValue for `best_first_score`.
+  OptionValue<BestFirstScore>& mutable_best_first_score();
+
+  /// Returns whether it runs a portfolio of ICP configurations
+  /// concurrently. The number of configurations is `number_of_jobs`.
+  bool portfolio() const;
+
+  /// Returns a mutable OptionValue for `portfolio`.
+  OptionValue<bool>& mutable_portfolio();
+
+  /// Returns whether the parallel ICP algorithm is deterministic, that
+  /// is, its result does not depend on the timing of threads.
+  bool deterministic() const;
+
+  /// Returns a mutable OptionValue for `deterministic`.
+  OptionValue<bool>& mutable_deterministic();
+
+  /// Returns the address on which the coordinator of distributed ICP
+  /// listens, `unix:<path>` or `tcp:<host>:<port>`. An empty string
+  /// disables distributed ICP.
+  std::string distributed_address() const;
+
+  /// Returns a mutable OptionValue for `distributed_address`.
+  OptionValue<std::string>& mutable_distributed_address();
+
+  /// Returns the number of worker processes in distributed ICP.
+  int distributed_workers() const;
+
+  /// Returns a mutable OptionValue for `distributed_workers`.
+  OptionValue<int>& mutable_distributed_workers();
+
+  /// Returns the path of the file to which the solver periodically
+  /// saves its search state. An empty string disables checkpointing.
+  std::string checkpoint() const;
+
+  /// Returns a mutable OptionValue for `checkpoint`.
+  OptionValue<std::string>& mutable_checkpoint();
+
+  /// Returns the interval between two checkpoints in seconds.
+  double checkpoint_interval() const;
+
+  /// Returns a mutable OptionValue for `checkpoint_interval`.
+  OptionValue<double>& mutable_checkpoint_interval();
+
+  /// Returns the path of the checkpoint file from which the solver
+  /// resumes its search. An empty string disables resuming.
+  std::string resume() const;
+
+  /// Returns a mutable OptionValue for `resume`.
+  OptionValue<std::string>& mutable_resume();
+
   /// Returns whether it computes the unsat core.
   bool unsat_core() const;
 
@@ -180,6 +401,10 @@ class Config {
   static constexpr double kDefaultNloptFtolAbs{1e-6};
   static constexpr int kDefaultNloptMaxEval{100};
   static constexpr double kDefaultNloptMaxTime{0.01};
+  static constexpr double kDefaultCheckpointInterval{60.0};
+  static constexpr double kDefaultAdaptiveFixpointDecay{0.8};
+  static constexpr double kDefaultNewtonThreshold{0.1};
+  static constexpr double kDefaultExplanationMinimizationBudget{0.1};
 
  private:
   // NOTE: Make sure to match the default values specified here with the ones
@@ -188,8 +413,70 @@ class Config {
   OptionValue<bool> produce_models_{false};
   OptionValue<bool> use_polytope_{false};
   OptionValue<bool> use_polytope_in_forall_{false};
+  // The polytope contractor solves its LPs at every
+  // `polytope_frequency`-th call. If `polytope_on_stall` is true, it is
+  // taken out of the fixpoint of the other contractors and runs after
+  // the fixpoint stalls. If `polytope_skip_unchanged` is true, it skips
+  // a call if its input is the same as its last output. Note that this
+  // changes the pruning, as ibex::CtcPolytopeHull is not idempotent.
+  OptionValue<int> polytope_frequency_{1};
+  OptionValue<bool> polytope_on_stall_{false};
+  OptionValue<bool> polytope_skip_unchanged_{false};
   OptionValue<bool> use_worklist_fixpoint_{false};
   OptionValue<bool> use_local_optimization_{false};
+  // If true, it builds a ContractorHc4, which runs over a flat
+  // expression tape, for each constraint instead of a
+  // ContractorIbexFwdbwd.
+  OptionValue<bool> use_native_hc4_{false};
+  // If true, it builds a single ContractorHc4Dag for all the
+  // non-quantified constraints so that common sub-expressions across
+  // the constraints are evaluated only once.
+  OptionValue<bool> use_shared_dag_{false};
+  // If true, the best-first and MCTS searches prune the two sub-boxes
+  // of a branching first and evaluate them together with a
+  // BatchEvaluator.
+  OptionValue<bool> use_batch_evaluation_{false};
+  // If true, it uses ContractorAdaptiveFixpoint instead of
+  // ContractorFixpoint (or ContractorWorklistFixpoint). Each score is
+  // updated as `s ← d * s + (1 - d) * observed` where `d` is
+  // `adaptive_fixpoint_decay`.
+  OptionValue<bool> use_adaptive_fixpoint_{false};
+  OptionValue<double> adaptive_fixpoint_decay_{kDefaultAdaptiveFixpointDecay};
+  // If true, the non-quantified linear constraints are collected into
+  // a ContractorLinear instead of having a contractor per constraint.
+  OptionValue<bool> use_linear_contractor_{false};
+  // If true, it adds a ContractorNewton which runs once the domains of
+  // its variables are narrower than `newton_threshold`.
+  OptionValue<bool> use_newton_{false};
+  OptionValue<double> newton_threshold_{kDefaultNewtonThreshold};
+  // Shaving contractor to wrap the contractor of the theory solver:
+  //   None (default) = no shaving
+  //   ThreeB         = ContractorShaving
+  //   Cid            = ContractorCid
+  //   Acid           = ContractorAcid
+  OptionValue<Shaving> shaving_{Shaving::None};
+  OptionValue<int> shaving_slices_{4};
+  // If true, the theory literals of each Boolean assignment are added
+  // one by one to a pruning-only check (TheorySolver::CheckPartial) so
+  // that an inconsistent prefix is learned before ICP runs.
+  OptionValue<bool> use_online_theory_check_{false};
+  // If true, after TheorySolver::CheckPartial succeeds, each unassigned
+  // theory atom decided by the pruned box is added to the SAT solver
+  // as a clause `reason → literal`. It implies
+  // `use_online_theory_check`.
+  OptionValue<bool> use_theory_propagation_{false};
+  // If true, a theory conflict is shrunk by deleting its constraints
+  // one by one while pruning without branching still refutes the rest
+  // (TheorySolver::MinimizeExplanation). It stops after
+  // `explanation_minimization_budget` seconds per conflict.
+  OptionValue<bool> use_explanation_minimization_{false};
+  OptionValue<double> explanation_minimization_budget_{
+      kDefaultExplanationMinimizationBudget};
+  // If true, the theory solver keeps a trail of the boxes pruned with
+  // the prefixes of the last list of theory literals. The next check
+  // backtracks the trail to the longest common prefix and only prunes
+  // with the remaining literals, before ICP starts from the result.
+  OptionValue<bool> use_incremental_theory_{false};
   OptionValue<int> number_of_jobs_{1};
   OptionValue<bool> stack_left_box_first_{false};
   OptionValue<bool> smtlib2_compliant_{false};
@@ -241,15 +528,68 @@ class Config {
   OptionValue<SatDefaultPhase> sat_default_phase_{
       SatDefaultPhase::JeroslowWang};
 
+  // Propositional SAT solver:
+  //   PicoSat (default) = PicosatBackend
+  //   Cdcl              = CdclBackend
+  OptionValue<SatBackend> sat_backend_{SatBackend::PicoSat};
+
   // Seed for Random Number Generator.
   OptionValue<uint32_t> random_seed_{0};
 
+  // Search strategy of the ICP algorithm:
+  //   DepthFirst (default) = IcpSeq / IcpParallel / IcpMcts
+  //   BestFirst            = IcpBestFirst / IcpBestFirstParallel
+  OptionValue<SearchStrategy> search_strategy_{SearchStrategy::DepthFirst};
+
+  // Score to order the boxes in best-first search:
+  //   Volume (default) = prefer a larger box
+  //   Undecided        = prefer a box with fewer variables to branch on
+  //   Violation        = prefer a box whose mid-point violates less
+  OptionValue<BestFirstScore> best_first_score_{BestFirstScore::Volume};
+
+  // If true, the theory solver races `number_of_jobs` heterogeneous
+  // configurations, each of which uses a single job, and takes the
+  // result of the first one to finish.
+  OptionValue<bool> portfolio_{false};
+
+  // If true and `number_of_jobs` > 1, it uses IcpParallelDeterministic
+  // which processes boxes in epoch-synchronous batches. It also
+  // disables the portfolio mode, whose result depends on which member
+  // finishes first.
+  OptionValue<bool> deterministic_{false};
+
+  // If non-empty, the theory solver uses IcpDistributed. It listens on
+  // this address and waits for `distributed_workers` worker processes
+  // to connect. It takes priority over the other ICP algorithms.
+  OptionValue<std::string> distributed_address_{std::string{}};
+  OptionValue<int> distributed_workers_{1};
+
+  // If `checkpoint` is non-empty, the solver saves the learned clauses
+  // and the frontier of the ICP search to this file every
+  // `checkpoint_interval` seconds. If `resume` is non-empty, it loads
+  // a checkpoint from this file and continues the search from it. Only
+  // IcpSeq and IcpParallel save and restore their frontiers.
+  OptionValue<std::string> checkpoint_{std::string{}};
+  OptionValue<double> checkpoint_interval_{kDefaultCheckpointInterval};
+  OptionValue<std::string> resume_{std::string{}};
+
   // Brancher to use. By default it uses `BranchLargestFirst`.
   OptionValue<Brancher> brancher_{BranchLargestFirst};
 };
 std::ostream& operator<<(std::ostream& os,
                          const Config::SatDefaultPhase& sat_default_phase);
 
+std::ostream& operator<<(std::ostream& os,
+                         const Config::SatBackend& sat_backend);
+
+std::ostream& operator<<(std::ostream& os,
+                         const Config::SearchStrategy& search_strategy);
+
+std::ostream& operator<<(std::ostream& os,
+                         const Config::BestFirstScore& best_first_score);
+
+std::ostream& operator<<(std::ostream& os, const Config::Shaving& shaving);
+
 std::ostream& operator<<(std::ostream& os, const Config& config);
 
 }  // namespace dreal
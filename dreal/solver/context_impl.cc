@@ -17,10 +17,13 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <limits>
+#include <memory>
 #include <ostream>
 #include <set>
 #include <sstream>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
@@ -41,6 +44,7 @@ using std::ostringstream;
 using std::pair;
 using std::set;
 using std::string;
+using std::unordered_map;
 using std::unordered_set;
 using std::vector;
 
@@ -84,6 +88,44 @@ bool ParseBooleanOption(const string& key, const string& val) {
   throw DREAL_RUNTIME_ERROR("Unknown value {} is provided for option {}", val,
                             key);
 }
+
+// Adds the learned clauses which @p checkpointer restored for the query
+// @p fingerprint to @p sat_solver. A literal of a clause is restored
+// from its string representation, and we skip a clause if one of its
+// literals is not a theory literal of @p sat_solver.
+void AddResumedClauses(const std::uint64_t fingerprint,
+                       Checkpointer* const checkpointer,
+                       SatSolver* const sat_solver) {
+  const vector<vector<string>> clauses{
+      checkpointer->TakeResumedClauses(fingerprint)};
+  if (clauses.empty()) {
+    return;
+  }
+  unordered_map<string, Formula> literals;
+  for (const auto& p : sat_solver->theory_literals()) {
+    const Formula& f{p.second};
+    literals.emplace(f.to_string(), f);
+    literals.emplace((!f).to_string(), !f);
+  }
+  int num_added{0};
+  for (const vector<string>& clause : clauses) {
+    set<Formula> formulas;
+    for (const string& l : clause) {
+      const auto it = literals.find(l);
+      if (it == literals.end()) {
+        break;
+      }
+      formulas.insert(it->second);
+    }
+    if (formulas.size() == clause.size()) {
+      sat_solver->AddLearnedClause(formulas);
+      checkpointer->AddLearnedClause(fingerprint, formulas);
+      ++num_added;
+    }
+  }
+  DREAL_LOG_DEBUG("AddResumedClauses() {} out of {} clauses are restored",
+                  num_added, clauses.size());
+}
 }  // namespace
 
 Context::Impl::Impl() : Impl{Config{}} {}
@@ -143,6 +185,14 @@ optional<Box> Context::Impl::CheckSatCore(const ScopedVector<Formula>& stack,
     DREAL_LOG_DEBUG("ContextImpl::CheckSatCore() - Found Model\n{}", box);
     return box;
   }
+  // Identifies this query in a checkpoint.
+  std::uint64_t fingerprint{0};
+  if (checkpointer_) {
+    fingerprint = ComputeQueryFingerprint(box, stack.get_vector());
+    AddResumedClauses(fingerprint, checkpointer_.get(), sat_solver);
+  }
+  // Clauses added by PropagateTheory.
+  set<Formula> propagated;
   while (true) {
     // Note that 'DREAL_CHECK_INTERRUPT' is only defined in setup.py,
     // when we build dReal python package.
@@ -170,7 +220,21 @@ optional<Box> Context::Impl::CheckSatCore(const ScopedVector<Formula>& stack,
           assertions.push_back(p.second ? sat_solver->theory_literal(p.first)
                                         : !sat_solver->theory_literal(p.first));
         }
-        if (theory_solver_.CheckSat(box, assertions)) {
+        // With --online-theory-check, a pruning-only check on the
+        // prefixes of the assignment runs first. It cuts an inconsistent
+        // prefix without running branch-and-prune. With
+        // --theory-propagation, the literals implied by the box which
+        // it prunes are also added to the SAT solver.
+        bool consistent{true};
+        if (config_.use_online_theory_check() ||
+            config_.use_theory_propagation()) {
+          consistent = theory_solver_.CheckPartial(box, assertions);
+          if (consistent && config_.use_theory_propagation()) {
+            PropagateTheory(theory_model, fingerprint, sat_solver,
+                            &propagated);
+          }
+        }
+        if (consistent && theory_solver_.CheckSat(box, assertions)) {
           // SAT from TheorySolver.
           DREAL_LOG_DEBUG(
               "ContextImpl::CheckSatCore() - Theroy Check = delta-SAT");
@@ -185,6 +249,12 @@ optional<Box> Context::Impl::CheckSatCore(const ScopedVector<Formula>& stack,
               "size = {}",
               explanation.size(), stack.get_vector().size());
           sat_solver->AddLearnedClause(explanation);
+          if (checkpointer_) {
+            checkpointer_->AddLearnedClause(fingerprint, explanation);
+            if (checkpointer_->due()) {
+              checkpointer_->Save();
+            }
+          }
           if (DREAL_LOG_TRACE_ENABLED) {
             for (const auto& f_i : stack.get_vector()) {
               DREAL_LOG_TRACE("ContextImpl::CheckSatCore: Stack {}", f_i);
@@ -205,7 +275,39 @@ optional<Box> Context::Impl::CheckSatCore(const ScopedVector<Formula>& stack,
   }
 }
 
+void Context::Impl::PropagateTheory(
+    const vector<pair<Variable, bool>>& theory_model,
+    const std::uint64_t fingerprint, SatSolver* const sat_solver,
+    set<Formula>* const propagated) {
+  unordered_set<Variable, hash_value<Variable>> assigned;
+  for (const pair<Variable, bool>& p : theory_model) {
+    assigned.insert(p.first);
+  }
+  vector<Formula> atoms;
+  for (const auto& p : sat_solver->theory_literals()) {
+    if (assigned.count(p.first) == 0) {
+      atoms.push_back(p.second);
+    }
+  }
+  for (const auto& implied : theory_solver_.GetImpliedLiterals(atoms)) {
+    // `reason → literal` is the learned clause of `reason ∪ {¬literal}`.
+    set<Formula> clause{implied.second};
+    clause.insert(!implied.first);
+    if (!propagated->insert(make_conjunction(clause)).second) {
+      continue;
+    }
+    DREAL_LOG_DEBUG(
+        "ContextImpl::PropagateTheory() - {} is implied (reason size = {})",
+        implied.first, implied.second.size());
+    sat_solver->AddLearnedClause(clause);
+    if (checkpointer_) {
+      checkpointer_->AddLearnedClause(fingerprint, clause);
+    }
+  }
+}
+
 optional<Box> Context::Impl::CheckSat() {
+  SetupCheckpointer();
   auto result = CheckSatCore(stack_, box(), &sat_solver_);
   if (result) {
     // In case of delta-sat, do post-processing.
@@ -222,6 +324,16 @@ optional<Box> Context::Impl::CheckSat() {
   }
 }
 
+void Context::Impl::SetupCheckpointer() {
+  if (checkpointer_ ||
+      (config_.checkpoint().empty() && config_.resume().empty())) {
+    return;
+  }
+  checkpointer_ = std::make_unique<Checkpointer>(
+      config_.checkpoint(), config_.checkpoint_interval(), config_.resume());
+  theory_solver_.set_checkpointer(checkpointer_.get());
+}
+
 void Context::Impl::AddToBox(const Variable& v) {
   DREAL_LOG_DEBUG("ContextImpl::AddToBox({})", v);
   const auto& variables = box().variables();
@@ -377,6 +489,30 @@ void Context::Impl::SetOption(const string& key, const double val) {
     }
     return config_.mutable_precision().set_from_file(val);
   }
+  if (key == ":adaptive-fixpoint-decay" || key == ":adaptive_fixpoint_decay") {
+    if (val <= 0.0 || val >= 1.0) {
+      throw DREAL_RUNTIME_ERROR(
+          "Adaptive fixpoint decay has to be in (0, 1) (input = {}).", val);
+    }
+    return config_.mutable_adaptive_fixpoint_decay().set_from_file(val);
+  }
+  if (key == ":newton-threshold" || key == ":newton_threshold") {
+    if (val <= 0.0) {
+      throw DREAL_RUNTIME_ERROR(
+          "Newton threshold has to be positive (input = {}).", val);
+    }
+    return config_.mutable_newton_threshold().set_from_file(val);
+  }
+  if (key == ":minimize-explanation-budget" ||
+      key == ":minimize_explanation_budget") {
+    if (val <= 0.0) {
+      throw DREAL_RUNTIME_ERROR(
+          "Explanation minimization budget has to be positive (input = {}).",
+          val);
+    }
+    return config_.mutable_explanation_minimization_budget().set_from_file(
+        val);
+  }
 }
 
 optional<string> Context::Impl::GetOption(const string& key) const {
@@ -403,10 +539,59 @@ void Context::Impl::SetOption(const string& key, const string& val) {
     return config_.mutable_use_polytope_in_forall().set_from_file(
         ParseBooleanOption(key, val));
   }
+  if (key == ":polytope-on-stall" || key == ":polytope_on_stall") {
+    return config_.mutable_polytope_on_stall().set_from_file(
+        ParseBooleanOption(key, val));
+  }
+  if (key == ":polytope-skip-unchanged" ||
+      key == ":polytope_skip_unchanged") {
+    return config_.mutable_polytope_skip_unchanged().set_from_file(
+        ParseBooleanOption(key, val));
+  }
   if (key == ":local-optimization" || key == "local_optimization") {
     return config_.mutable_use_local_optimization().set_from_file(
         ParseBooleanOption(key, val));
   }
+  if (key == ":native-hc4" || key == ":native_hc4") {
+    return config_.mutable_use_native_hc4().set_from_file(
+        ParseBooleanOption(key, val));
+  }
+  if (key == ":shared-dag" || key == ":shared_dag") {
+    return config_.mutable_use_shared_dag().set_from_file(
+        ParseBooleanOption(key, val));
+  }
+  if (key == ":batch-evaluation" || key == ":batch_evaluation") {
+    return config_.mutable_use_batch_evaluation().set_from_file(
+        ParseBooleanOption(key, val));
+  }
+  if (key == ":adaptive-fixpoint" || key == ":adaptive_fixpoint") {
+    return config_.mutable_use_adaptive_fixpoint().set_from_file(
+        ParseBooleanOption(key, val));
+  }
+  if (key == ":linear-contractor" || key == ":linear_contractor") {
+    return config_.mutable_use_linear_contractor().set_from_file(
+        ParseBooleanOption(key, val));
+  }
+  if (key == ":newton") {
+    return config_.mutable_use_newton().set_from_file(
+        ParseBooleanOption(key, val));
+  }
+  if (key == ":online-theory-check" || key == ":online_theory_check") {
+    return config_.mutable_use_online_theory_check().set_from_file(
+        ParseBooleanOption(key, val));
+  }
+  if (key == ":theory-propagation" || key == ":theory_propagation") {
+    return config_.mutable_use_theory_propagation().set_from_file(
+        ParseBooleanOption(key, val));
+  }
+  if (key == ":minimize-explanation" || key == ":minimize_explanation") {
+    return config_.mutable_use_explanation_minimization().set_from_file(
+        ParseBooleanOption(key, val));
+  }
+  if (key == ":incremental-theory" || key == ":incremental_theory") {
+    return config_.mutable_use_incremental_theory().set_from_file(
+        ParseBooleanOption(key, val));
+  }
   if (key == ":worklist-fixpoint" || key == ":worklist_fixpoint") {
     return config_.mutable_use_worklist_fixpoint().set_from_file(
         ParseBooleanOption(key, val));
@@ -15,11 +15,16 @@
 */
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include "dreal/solver/checkpoint.h"
 #include "dreal/solver/context.h"
 #include "dreal/solver/sat_solver.h"
 #include "dreal/solver/theory_solver.h"
@@ -72,6 +77,21 @@ class Context::Impl {
   optional<Box> CheckSatCore(const ScopedVector<Formula>& stack, Box box,
                              SatSolver* sat_solver);
 
+  // Adds the theory literals implied by the box pruned in the last
+  // TheorySolver::CheckPartial call to @p sat_solver (see
+  // Config::use_theory_propagation). The atoms assigned in @p
+  // theory_model are skipped. @p propagated keeps the clauses added
+  // so far in a CheckSatCore call so that they are not added twice. A
+  // clause `¬f₁ ∨ ... ∨ ¬fₙ` is kept as `f₁ ∧ ... ∧ fₙ`.
+  void PropagateTheory(
+      const std::vector<std::pair<Variable, bool>>& theory_model,
+      std::uint64_t fingerprint, SatSolver* sat_solver,
+      std::set<Formula>* propagated);
+
+  // Creates `checkpointer_` if checkpointing or resuming is enabled
+  // in the configuration and it is not created yet.
+  void SetupCheckpointer();
+
   // Marks variable @p v as a model variable
   void mark_model_variable(const Variable& v);
 
@@ -100,6 +120,10 @@ class Context::Impl {
   std::unordered_set<Variable::Id> model_variables_;
   TheorySolver theory_solver_;
 
+  // Saves and restores the learned clauses and the ICP frontier. It is
+  // nullptr unless `checkpoint` or `resume` is set in `config_`.
+  std::unique_ptr<Checkpointer> checkpointer_;
+
   // Stores the result of the latest checksat.
   // Note that if the checksat result was UNSAT, this box holds an empty box.
   Box model_;
@@ -19,6 +19,7 @@
 #include <tuple>
 #include <utility>
 
+#include "dreal/util/exception.h"
 #include "dreal/util/logging.h"
 
 using std::vector;
@@ -27,52 +28,122 @@ namespace dreal {
 
 Icp::Icp(const Config& config) : config_{config} {}
 
+namespace {
+// Updates @p branching_candidates with the @p result of @p
+// formula_evaluator over @p box. Returns false if the result is UNSAT.
+bool ProcessEvaluationResult(const FormulaEvaluator& formula_evaluator,
+                             const FormulaEvaluationResult& result,
+                             const Box& box, const double precision,
+                             ContractorStatus* const cs,
+                             DynamicBitset* const branching_candidates) {
+  switch (result.type()) {
+    case FormulaEvaluationResult::Type::UNSAT:
+      DREAL_LOG_DEBUG(
+          "Icp::EvaluateBox() Found that the box\n"
+          "{0}\n"
+          "has no solution for {1} (evaluation = {2}).",
+          box, formula_evaluator, result.evaluation());
+      cs->AddUsedConstraint(formula_evaluator.formula());
+      return false;
+    case FormulaEvaluationResult::Type::VALID:
+      DREAL_LOG_DEBUG(
+          "Icp::EvaluateBox() Found that all points in the box\n"
+          "{0}\n"
+          "satisfies the constraint {1} (evaluation = {2}).",
+          box, formula_evaluator, result.evaluation());
+      return true;
+    case FormulaEvaluationResult::Type::UNKNOWN: {
+      const Box::Interval& evaluation{result.evaluation()};
+      const double diam = evaluation.diam();
+      if (diam > precision) {
+        if (cs->IsCertified(box, formula_evaluator.formula())) {
+          // We do not branch on a constraint which is certified to
+          // have a solution in the box.
+          DREAL_LOG_DEBUG(
+              "Icp::EvaluateBox() Found that the box has a solution of {}.",
+              formula_evaluator);
+          return true;
+        }
+        DREAL_LOG_DEBUG(
+            "Icp::EvaluateBox() Found an interval >= precision({2}):\n"
+            "{0} -> {1}",
+            formula_evaluator, evaluation, precision);
+        if (formula_evaluator.is_simple_relational() ||
+            formula_evaluator.is_neq()) {
+          // Note: when the base formula is simple relational or not-equal, we
+          // do not need to branch on the base variable.
+        } else {
+          for (const Variable& v : formula_evaluator.variables()) {
+            branching_candidates->set(box.index(v));
+          }
+        }
+      }
+      return true;
+    }
+  }
+  DREAL_UNREACHABLE();
+}
+}  // namespace
+
 optional<DynamicBitset> EvaluateBox(
     const vector<FormulaEvaluator>& formula_evaluators, const Box& box,
     const double precision, ContractorStatus* const cs) {
   DynamicBitset branching_candidates(box.size());  // Return value.
   for (const FormulaEvaluator& formula_evaluator : formula_evaluators) {
-    const FormulaEvaluationResult result{formula_evaluator(box)};
-    switch (result.type()) {
-      case FormulaEvaluationResult::Type::UNSAT:
-        DREAL_LOG_DEBUG(
-            "Icp::EvaluateBox() Found that the box\n"
-            "{0}\n"
-            "has no solution for {1} (evaluation = {2}).",
-            box, formula_evaluator, result.evaluation());
-        cs->mutable_box().set_empty();
-        cs->AddUsedConstraint(formula_evaluator.formula());
-        return nullopt;
-      case FormulaEvaluationResult::Type::VALID:
-        DREAL_LOG_DEBUG(
-            "Icp::EvaluateBox() Found that all points in the box\n"
-            "{0}\n"
-            "satisfies the constraint {1} (evaluation = {2}).",
-            box, formula_evaluator, result.evaluation());
-        continue;
-      case FormulaEvaluationResult::Type::UNKNOWN: {
-        const Box::Interval& evaluation{result.evaluation()};
-        const double diam = evaluation.diam();
-        if (diam > precision) {
-          DREAL_LOG_DEBUG(
-              "Icp::EvaluateBox() Found an interval >= precision({2}):\n"
-              "{0} -> {1}",
-              formula_evaluator, evaluation, precision);
-          if (formula_evaluator.is_simple_relational() ||
-              formula_evaluator.is_neq()) {
-            // Note: when the base formula is simple relational or not-equal, we
-            // do not need to branch on the base variable.
-          } else {
-            for (const Variable& v : formula_evaluator.variables()) {
-              branching_candidates.set(box.index(v));
-            }
-          }
-        }
-        break;
-      }
+    if (!ProcessEvaluationResult(formula_evaluator, formula_evaluator(box),
+                                 box, precision, cs, &branching_candidates)) {
+      cs->mutable_box().set_empty();
+      return nullopt;
     }
   }
   return branching_candidates;
 }
 
+vector<optional<DynamicBitset>> EvaluateBoxes(
+    const BatchEvaluator& evaluator, const vector<const Box*>& boxes,
+    const double precision, ContractorStatus* const cs) {
+  const vector<FormulaEvaluator>& formula_evaluators{
+      evaluator.formula_evaluators()};
+  const vector<vector<FormulaEvaluationResult>> results{evaluator(boxes)};
+  vector<optional<DynamicBitset>> ret;  // Return value.
+  ret.reserve(boxes.size());
+  for (size_t j = 0; j < boxes.size(); ++j) {
+    const Box& box{*boxes[j]};
+    DynamicBitset branching_candidates(box.size());
+    bool unsat{false};
+    for (size_t i = 0; i < formula_evaluators.size() && !unsat; ++i) {
+      unsat = !ProcessEvaluationResult(formula_evaluators[i], results[j][i],
+                                       box, precision, cs,
+                                       &branching_candidates);
+    }
+    if (unsat) {
+      ret.emplace_back(nullopt);
+    } else {
+      ret.emplace_back(std::move(branching_candidates));
+    }
+  }
+  return ret;
+}
+
+std::uint64_t ComputeQueryFingerprint(
+    const Box& box, const vector<FormulaEvaluator>& formula_evaluators) {
+  vector<Formula> formulas;
+  formulas.reserve(formula_evaluators.size());
+  for (const FormulaEvaluator& formula_evaluator : formula_evaluators) {
+    formulas.push_back(formula_evaluator.formula());
+  }
+  return ComputeQueryFingerprint(box, formulas);
+}
+
+void AddConservativeExplanation(
+    const vector<FormulaEvaluator>& formula_evaluators, const Box& box,
+    ContractorStatus* const cs) {
+  for (const FormulaEvaluator& formula_evaluator : formula_evaluators) {
+    cs->AddUsedConstraint(formula_evaluator.formula());
+  }
+  for (const Variable& var : box.variables()) {
+    cs->AddUnsatWitness(var);
+  }
+}
+
 }  // namespace dreal
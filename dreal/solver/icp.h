@@ -15,10 +15,14 @@
 */
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <vector>
 
 #include "dreal/contractor/contractor.h"
 #include "dreal/contractor/contractor_status.h"
+#include "dreal/solver/batch_evaluator.h"
+#include "dreal/solver/checkpoint.h"
 #include "dreal/solver/config.h"
 #include "dreal/solver/formula_evaluator.h"
 #include "dreal/util/box.h"
@@ -51,11 +55,35 @@ class Icp {
                         const std::vector<FormulaEvaluator>& formula_evaluators,
                         ContractorStatus* cs) = 0;
 
+  /// Sets a flag to cancel CheckSat. Once `*flag` becomes true, a
+  /// running CheckSat stops searching and returns false. In this case,
+  /// the result and the contractor status should be ignored.
+  void set_cancel_flag(const std::atomic<bool>* flag) { cancel_flag_ = flag; }
+
+  /// Sets a checkpointer. An ICP algorithm which supports
+  /// checkpointing saves its frontier with @p checkpointer when it is
+  /// due, and resumes from the frontier restored by @p checkpointer.
+  /// The other algorithms ignore it.
+  void set_checkpointer(Checkpointer* checkpointer) {
+    checkpointer_ = checkpointer;
+  }
+
  protected:
   const Config& config() const { return config_; }
 
+  /// Returns true if CheckSat is cancelled (see set_cancel_flag).
+  bool cancelled() const {
+    return cancel_flag_ != nullptr &&
+           cancel_flag_->load(std::memory_order_relaxed);
+  }
+
+  /// Returns the checkpointer or nullptr (see set_checkpointer).
+  Checkpointer* checkpointer() const { return checkpointer_; }
+
  private:
   const Config& config_;
+  const std::atomic<bool>* cancel_flag_{nullptr};
+  Checkpointer* checkpointer_{nullptr};
 };
 
 /// Evaluates each formula with @p box using interval
@@ -93,4 +121,29 @@ optional<DynamicBitset> EvaluateBox(
     const std::vector<FormulaEvaluator>& formula_evaluators, const Box& box,
     double precision, ContractorStatus* cs);
 
+/// Evaluates the formulas in @p evaluator with each box in @p boxes at
+/// once. The i-th element of the result is what EvaluateBox returns
+/// for `*boxes[i]`, except that it does not empty the box of @p cs
+/// when it detects UNSAT. It still calls cs->AddUsedConstraint to store
+/// the constraint that is responsible for the UNSAT.
+std::vector<optional<DynamicBitset>> EvaluateBoxes(
+    const BatchEvaluator& evaluator, const std::vector<const Box*>& boxes,
+    double precision, ContractorStatus* cs);
+
+/// Returns the fingerprint of the theory query whose initial box is @p
+/// box and whose constraints are @p formula_evaluators. An ICP
+/// algorithm uses it to identify its frontier in a checkpoint.
+std::uint64_t ComputeQueryFingerprint(
+    const Box& box, const std::vector<FormulaEvaluator>& formula_evaluators);
+
+/// Adds all the constraints in @p formula_evaluators and all the
+/// variables in @p box to the explanation in @p cs.
+///
+/// An ICP algorithm which resumes its search from a checkpoint calls
+/// it because it does not know why the boxes explored before the
+/// checkpoint were infeasible.
+void AddConservativeExplanation(
+    const std::vector<FormulaEvaluator>& formula_evaluators, const Box& box,
+    ContractorStatus* cs);
+
 }  // namespace dreal
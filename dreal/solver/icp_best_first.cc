@@ -0,0 +1,297 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/solver/icp_best_first.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <queue>
+#include <utility>
+
+#include "ThreadPool/ThreadPool.h"
+
+#include "dreal/solver/batch_evaluator.h"
+#include "dreal/solver/icp_stat.h"
+#include "dreal/util/assert.h"
+#include "dreal/util/exception.h"
+#include "dreal/util/interrupt.h"
+#include "dreal/util/logging.h"
+
+using std::priority_queue;
+using std::vector;
+
+namespace dreal {
+
+namespace {
+
+// Returns the volume score of @p box, Σᵢ log(1 + |box[i]|). We use
+// log(1 + ·) so that a degenerated dimension does not make the whole
+// score -∞.
+double VolumeScore(const Box& box) {
+  double score{0.0};
+  for (int i = 0; i < box.size(); ++i) {
+    score += std::log1p(box[i].diam());
+  }
+  return score;
+}
+
+// Given a relational formula @p f = (e₁ rop e₂) (or its negation) and
+// a value @p v of (e₁ - e₂), returns how much @p v violates @p f.
+double Violation(const Formula& f, const double v, const bool negated) {
+  switch (f.get_kind()) {
+    case FormulaKind::Eq:
+      return negated ? 0.0 : std::abs(v);
+    case FormulaKind::Neq:
+      return negated ? std::abs(v) : 0.0;
+    case FormulaKind::Gt:
+    case FormulaKind::Geq:
+      return negated ? std::max(0.0, v) : std::max(0.0, -v);
+    case FormulaKind::Lt:
+    case FormulaKind::Leq:
+      return negated ? std::max(0.0, -v) : std::max(0.0, v);
+    case FormulaKind::Not:
+      return Violation(get_operand(f), v, !negated);
+    default:
+      // We do not measure the violation of the other formulas (i.e.
+      // forall formulas).
+      return 0.0;
+  }
+}
+
+// Returns the sum of the violations of the constraints at the
+// mid-point of @p box.
+double ComputeViolation(const vector<FormulaEvaluator>& formula_evaluators,
+                        const Box& box) {
+  Box mid_point{box};
+  for (int i = 0; i < box.size(); ++i) {
+    mid_point[i] = box[i].mid();
+  }
+  double violation{0.0};
+  for (const FormulaEvaluator& formula_evaluator : formula_evaluators) {
+    const Formula& f{formula_evaluator.formula()};
+    if (is_forall(f)) {
+      // Evaluating a forall formula requires a nested SMT query. Skip it.
+      continue;
+    }
+    const FormulaEvaluationResult result{formula_evaluator(mid_point)};
+    violation += Violation(f, result.evaluation().mid(), false);
+  }
+  return violation;
+}
+
+}  // namespace
+
+bool operator<(const BestFirstEntry& e1, const BestFirstEntry& e2) {
+  if (e1.score != e2.score) {
+    return e1.score < e2.score;
+  }
+  return e1.seq < e2.seq;
+}
+
+double ComputeBestFirstScore(const Config::BestFirstScore score,
+                             const vector<FormulaEvaluator>& formula_evaluators,
+                             const Box& box,
+                             const DynamicBitset& branching_candidates) {
+  switch (score) {
+    case Config::BestFirstScore::Volume:
+      return VolumeScore(box);
+    case Config::BestFirstScore::Undecided:
+      return -static_cast<double>(branching_candidates.count());
+    case Config::BestFirstScore::Violation:
+      return -ComputeViolation(formula_evaluators, box);
+  }
+  DREAL_UNREACHABLE();
+}
+
+IcpBestFirst::IcpBestFirst(const Config& config) : Icp{config} {}
+
+bool IcpBestFirst::CheckSat(const Contractor& contractor,
+                            const vector<FormulaEvaluator>& formula_evaluators,
+                            ContractorStatus* const cs) {
+  thread_local IcpStat stat{DREAL_LOG_INFO_ENABLED,
+                            ThreadPool::get_thread_id()};
+  DREAL_LOG_DEBUG("IcpBestFirst::CheckSat()");
+
+  // `current_box` always points to the box in the contractor status
+  // as a mutable reference.
+  Box& current_box{cs->mutable_box()};
+  // `current_branching_point` always points to the branching_point in
+  // the contractor status as a mutable reference.
+  int& current_branching_point{cs->mutable_branching_point()};
+
+  TimerGuard prune_timer_guard(&stat.timer_prune_, stat.enabled(),
+                               false /* start_timer */);
+  TimerGuard eval_timer_guard(&stat.timer_eval_, stat.enabled(),
+                              false /* start_timer */);
+  TimerGuard branch_timer_guard(&stat.timer_branch_, stat.enabled(),
+                                false /* start_timer */);
+
+  priority_queue<BestFirstEntry> queue;
+  std::int64_t seq{0};
+
+  // Evaluates the two sub-boxes of a branching at once if
+  // --batch-evaluation is set.
+  std::unique_ptr<const BatchEvaluator> batch_evaluator;
+  if (config().use_batch_evaluation()) {
+    batch_evaluator =
+        std::make_unique<const BatchEvaluator>(formula_evaluators, current_box);
+  }
+
+  // Prunes the box in `cs`. Returns false if it becomes empty.
+  auto prune = [&]() {
+    prune_timer_guard.resume();
+    contractor.Prune(cs);
+    prune_timer_guard.pause();
+    stat.num_prune_++;
+    if (current_box.empty()) {
+      DREAL_LOG_DEBUG("IcpBestFirst::CheckSat() Box is empty after pruning");
+      return false;
+    }
+    return true;
+  };
+
+  // Handles the @p evaluation_result of @p box. If it is a delta-box,
+  // returns true. If it's still feasible but bigger than delta, adds it
+  // to the queue.
+  auto accept = [&](const Box& box, const int branching_point,
+                    const optional<DynamicBitset>& evaluation_result) {
+    if (!evaluation_result) {
+      DREAL_LOG_DEBUG(
+          "IcpBestFirst::CheckSat() Detect that the current box is not "
+          "feasible by evaluation:\n{}",
+          box);
+      return false;
+    }
+    if (evaluation_result->none()) {
+      DREAL_LOG_DEBUG("IcpBestFirst::CheckSat() Found a delta-box:\n{}", box);
+      return true;
+    }
+    const double score{ComputeBestFirstScore(config().best_first_score(),
+                                             formula_evaluators, box,
+                                             *evaluation_result)};
+    queue.push(BestFirstEntry{score, seq++, box, branching_point,
+                              *evaluation_result});
+    return false;
+  };
+
+  // Prunes and evaluates the box in `cs`. If it is a delta-box, returns
+  // true. If it's still feasible but bigger than delta, adds it to the
+  // queue.
+  auto prune_and_evaluate = [&]() {
+    if (!prune()) {
+      return false;
+    }
+    eval_timer_guard.resume();
+    const optional<DynamicBitset> evaluation_result{EvaluateBox(
+        formula_evaluators, current_box, config().precision(), cs)};
+    const bool found{
+        accept(current_box, current_branching_point, evaluation_result)};
+    eval_timer_guard.pause();
+    return found;
+  };
+
+  if (prune_and_evaluate()) {
+    return true;
+  }
+
+  while (!queue.empty()) {
+    DREAL_LOG_DEBUG("IcpBestFirst::CheckSat() Loop Head");
+
+    // Note that 'DREAL_CHECK_INTERRUPT' is only defined in setup.py,
+    // when we build dReal python package.
+#ifdef DREAL_CHECK_INTERRUPT
+    if (g_interrupted) {
+      DREAL_LOG_DEBUG("KeyboardInterrupt(SIGINT) Detected.");
+      throw std::runtime_error("KeyboardInterrupt(SIGINT) Detected.");
+    }
+#endif
+    if (cancelled()) {
+      DREAL_LOG_DEBUG("IcpBestFirst::CheckSat() Cancelled");
+      current_box.set_empty();
+      return false;
+    }
+
+    // 1. Pick the best box from the queue. Note that it was already
+    // pruned and evaluated.
+    const BestFirstEntry entry{queue.top()};
+    queue.pop();
+    DREAL_LOG_TRACE("IcpBestFirst::CheckSat() Current Box (score = {}):\n{}",
+                    entry.score, entry.box);
+
+    // 2. Branch.
+    branch_timer_guard.resume();
+    Box box_left;
+    Box box_right;
+    const int branching_dim = config().brancher()(entry.box, entry.bitset,
+                                                  &box_left, &box_right);
+    branch_timer_guard.pause();
+    if (branching_dim < 0) {
+      DREAL_LOG_DEBUG(
+          "IcpBestFirst::CheckSat() Found that the current box is not "
+          "satisfying delta-condition but it's not bisectable.:\n{}",
+          entry.box);
+      current_box = entry.box;
+      current_branching_point = entry.branching_point;
+      return true;
+    }
+    stat.num_branch_++;
+
+    // 3. Prune and evaluate the two sub-boxes.
+    if (!batch_evaluator) {
+      for (Box* const child : {&box_left, &box_right}) {
+        current_box = std::move(*child);
+        current_branching_point = branching_dim;
+        if (prune_and_evaluate()) {
+          return true;
+        }
+      }
+      continue;
+    }
+    // With a batch evaluator, we prune both of them first and evaluate
+    // the non-empty ones together.
+    vector<Box> children;
+    vector<int> branching_points;
+    for (Box* const child : {&box_left, &box_right}) {
+      current_box = std::move(*child);
+      current_branching_point = branching_dim;
+      if (prune()) {
+        children.push_back(current_box);
+        branching_points.push_back(current_branching_point);
+      }
+    }
+    eval_timer_guard.resume();
+    vector<const Box*> boxes;
+    for (const Box& child : children) {
+      boxes.push_back(&child);
+    }
+    const vector<optional<DynamicBitset>> evaluation_results{EvaluateBoxes(
+        *batch_evaluator, boxes, config().precision(), cs)};
+    for (size_t i = 0; i < children.size(); ++i) {
+      if (accept(children[i], branching_points[i], evaluation_results[i])) {
+        eval_timer_guard.pause();
+        current_box = std::move(children[i]);
+        current_branching_point = branching_points[i];
+        return true;
+      }
+    }
+    eval_timer_guard.pause();
+  }
+  DREAL_LOG_DEBUG("IcpBestFirst::CheckSat() No solution");
+  current_box.set_empty();
+  return false;
+}
+
+}  // namespace dreal
@@ -0,0 +1,82 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "dreal/contractor/contractor.h"
+#include "dreal/contractor/contractor_status.h"
+#include "dreal/solver/config.h"
+#include "dreal/solver/formula_evaluator.h"
+#include "dreal/solver/icp.h"
+#include "dreal/util/box.h"
+#include "dreal/util/dynamic_bitset.h"
+
+namespace dreal {
+
+/// A pending box in best-first search. The box has been pruned and
+/// evaluated already, and @p bitset keeps the dimensions on which we
+/// need to branch (the result of EvaluateBox).
+struct BestFirstEntry {
+  double score{0.0};
+  // Creation order of this entry. It breaks ties between entries with
+  // the same score (a newer entry comes first) so that the search order
+  // does not depend on the implementation of a priority queue.
+  std::int64_t seq{0};
+  Box box;
+  int branching_point{-1};
+  DynamicBitset bitset;
+};
+
+/// Returns true if @p e1 should be explored after @p e2. It is used to
+/// build a max-heap of entries.
+bool operator<(const BestFirstEntry& e1, const BestFirstEntry& e2);
+
+/// Computes the score of @p box in best-first search. A box with a
+/// higher score is explored first.
+///
+/// - Config::BestFirstScore::Volume prefers a box with a larger volume.
+/// - Config::BestFirstScore::Undecided prefers a box with fewer
+///   variables to branch on, that is, fewer bits set in
+///   @p branching_candidates.
+/// - Config::BestFirstScore::Violation prefers a box whose mid-point
+///   is closer to satisfy all the constraints.
+///
+/// @pre @p box has been pruned and @p branching_candidates is what
+/// EvaluateBox returns for @p box.
+double ComputeBestFirstScore(
+    Config::BestFirstScore score,
+    const std::vector<FormulaEvaluator>& formula_evaluators, const Box& box,
+    const DynamicBitset& branching_candidates);
+
+/// Class for ICP (Interval Constraint Propagation) algorithm which
+/// explores the boxes in a best-first order.
+///
+/// Unlike IcpSeq, it prunes and evaluates a box when the box is
+/// created by branching, and keeps the box in a priority queue along
+/// with its score (see ComputeBestFirstScore).
+class IcpBestFirst : public Icp {
+ public:
+  /// Constructs an IcpBestFirst based on @p config.
+  explicit IcpBestFirst(const Config& config);
+
+  bool CheckSat(const Contractor& contractor,
+                const std::vector<FormulaEvaluator>& formula_evaluators,
+                ContractorStatus* cs) override;
+};
+
+}  // namespace dreal
@@ -0,0 +1,314 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/solver/icp_best_first_parallel.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <utility>
+
+#include "dreal/solver/icp_best_first.h"
+#include "dreal/solver/icp_stat.h"
+#include "dreal/util/assert.h"
+#include "dreal/util/cds.h"
+#include "dreal/util/idle_backoff.h"
+#include "dreal/util/interrupt.h"
+#include "dreal/util/logging.h"
+
+using std::atomic;
+using std::lock_guard;
+using std::make_unique;
+using std::mutex;
+using std::priority_queue;
+using std::vector;
+
+namespace dreal {
+
+#if __cplusplus < 201703L
+constexpr int IcpBestFirstParallel::kQueueCapacity;
+#endif
+
+namespace {
+
+struct BestFirstEntryComparator {
+  int operator()(const BestFirstEntry& e1, const BestFirstEntry& e2) const {
+    if (e1 < e2) {
+      return -1;
+    }
+    if (e2 < e1) {
+      return 1;
+    }
+    return 0;
+  }
+};
+
+}  // namespace
+
+class IcpBestFirstParallel::Queue
+    : public PriorityQueue<BestFirstEntry, BestFirstEntryComparator> {
+ public:
+  using PriorityQueue<BestFirstEntry, BestFirstEntryComparator>::PriorityQueue;
+};
+
+namespace {
+
+using Queue = IcpBestFirstParallel::Queue;
+
+// Shared heap of the boxes which do not fit in the bounded `Queue`. As
+// it is only used when `Queue` is full, we guard it with a mutex.
+class OverflowQueue {
+ public:
+  void push(BestFirstEntry entry) {
+    lock_guard<mutex> lock{mutex_};
+    heap_.push(std::move(entry));
+    size_.fetch_add(1, std::memory_order_release);
+  }
+
+  // Replaces @p entry with the top of the heap if the top has a higher
+  // score, pushing @p entry back to the heap. If @p valid is false,
+  // that is, @p entry does not hold a box, pops the top into @p entry.
+  // Returns true if @p entry holds a box after the call.
+  bool exchange_if_better(BestFirstEntry* const entry, const bool valid) {
+    if (size_.load(std::memory_order_acquire) == 0) {
+      return valid;
+    }
+    lock_guard<mutex> lock{mutex_};
+    if (heap_.empty()) {
+      return valid;
+    }
+    if (valid && !(*entry < heap_.top())) {
+      return true;
+    }
+    BestFirstEntry top{heap_.top()};
+    heap_.pop();
+    if (valid) {
+      heap_.push(std::move(*entry));
+    } else {
+      size_.fetch_sub(1, std::memory_order_release);
+    }
+    *entry = std::move(top);
+    return true;
+  }
+
+ private:
+  mutex mutex_;
+  priority_queue<BestFirstEntry> heap_;
+  atomic<int> size_{0};
+};
+
+void Worker(const Contractor& contractor, const Config& config,
+            const vector<FormulaEvaluator>& formula_evaluators, const int id,
+            const bool main_thread, Queue* const queue,
+            OverflowQueue* const overflow, ContractorStatus* const cs,
+            atomic<int>* const found_delta_sat,
+            atomic<int>* const number_of_boxes,
+            atomic<std::int64_t>* const seq) {
+  thread_local IcpStat stat{DREAL_LOG_INFO_ENABLED, id};
+  TimerGuard prune_timer_guard(&stat.timer_prune_, stat.enabled(),
+                               false /* start_timer */);
+  TimerGuard eval_timer_guard(&stat.timer_eval_, stat.enabled(),
+                              false /* start_timer */);
+  TimerGuard branch_timer_guard(&stat.timer_branch_, stat.enabled(),
+                                false /* start_timer */);
+
+  thread_local CdsScopeGuard cds_scope_guard(!main_thread);
+
+  // `current_box` always points to the box in the contractor status
+  // as a mutable reference.
+  Box& current_box{cs->mutable_box()};
+  int& current_branching_point{cs->mutable_branching_point()};
+
+  IdleBackoff backoff;
+  BestFirstEntry entry;
+
+  while ((*found_delta_sat == -1) &&
+         (number_of_boxes->load(std::memory_order_acquire) > 0)) {
+    // Note that 'DREAL_CHECK_INTERRUPT' is only defined in setup.py,
+    // when we build dReal python package.
+#ifdef DREAL_CHECK_INTERRUPT
+    if (g_interrupted) {
+      DREAL_LOG_DEBUG("KeyboardInterrupt(SIGINT) Detected.");
+      throw std::runtime_error("KeyboardInterrupt(SIGINT) Detected.");
+    }
+#endif
+
+    // 1. Pick the best box from the queue and the overflow heap.
+    if (!overflow->exchange_if_better(&entry, queue->pop(entry))) {
+      backoff.Idle();
+      continue;
+    }
+    backoff.Reset();
+
+    // 2. Branch. Note that the box was already pruned and evaluated.
+    branch_timer_guard.resume();
+    Box box_left;
+    Box box_right;
+    const int branching_dim = config.brancher()(entry.box, entry.bitset,
+                                                &box_left, &box_right);
+    branch_timer_guard.pause();
+    if (branching_dim < 0) {
+      DREAL_LOG_DEBUG(
+          "IcpBestFirstParallel::Worker() Found that the current box is not "
+          "satisfying delta-condition but it's not bisectable.:\n{}",
+          entry.box);
+      current_box = entry.box;
+      current_branching_point = entry.branching_point;
+      *found_delta_sat = id;
+      return;
+    }
+    stat.num_branch_++;
+
+    // 3. Prune and evaluate the two sub-boxes.
+    for (Box* const child : {&box_left, &box_right}) {
+      current_box = std::move(*child);
+      current_branching_point = branching_dim;
+      prune_timer_guard.resume();
+      contractor.Prune(cs);
+      prune_timer_guard.pause();
+      if (stat.enabled()) {
+        stat.num_prune_++;
+      }
+      if (current_box.empty()) {
+        continue;
+      }
+      eval_timer_guard.resume();
+      const optional<DynamicBitset> evaluation_result{
+          EvaluateBox(formula_evaluators, current_box, config.precision(), cs)};
+      if (!evaluation_result) {
+        eval_timer_guard.pause();
+        continue;
+      }
+      if (evaluation_result->none()) {
+        DREAL_LOG_DEBUG("IcpBestFirstParallel::Worker() Found a delta-box:\n{}",
+                        current_box);
+        *found_delta_sat = id;
+        return;
+      }
+      const double score{
+          ComputeBestFirstScore(config.best_first_score(), formula_evaluators,
+                                current_box, *evaluation_result)};
+      eval_timer_guard.pause();
+      BestFirstEntry child_entry{score,
+                                 seq->fetch_add(1, std::memory_order_relaxed),
+                                 current_box, branching_dim,
+                                 *evaluation_result};
+      number_of_boxes->fetch_add(1, std::memory_order_relaxed);
+      if (!queue->push(child_entry)) {
+        // The queue is full.
+        overflow->push(std::move(child_entry));
+      }
+    }
+    // We are done with the parent box. Note that we increase the counter
+    // for the children before decreasing it for the parent, so that the
+    // counter does not reach zero while there are boxes to process.
+    number_of_boxes->fetch_sub(1, std::memory_order_acq_rel);
+  }
+}
+}  // namespace
+
+IcpBestFirstParallel::IcpBestFirstParallel(const Config& config)
+    : Icp{config},
+      pool_{static_cast<size_t>(config.number_of_jobs() - 1)},
+      queue_{make_unique<Queue>(kQueueCapacity)} {
+  results_.reserve(config.number_of_jobs() - 1);
+  status_vector_.reserve(config.number_of_jobs());
+}
+
+IcpBestFirstParallel::~IcpBestFirstParallel() = default;
+
+bool IcpBestFirstParallel::CheckSat(
+    const Contractor& contractor,
+    const vector<FormulaEvaluator>& formula_evaluators,
+    ContractorStatus* const cs) {
+  // Initial Prune and Evaluation.
+  contractor.Prune(cs);
+  if (cs->box().empty()) {
+    return false;
+  }
+  const optional<DynamicBitset> evaluation_result{EvaluateBox(
+      formula_evaluators, cs->box(), config().precision(), cs)};
+  if (!evaluation_result) {
+    return false;
+  }
+  if (evaluation_result->none()) {
+    return true;
+  }
+
+  results_.clear();
+  status_vector_.clear();
+
+  // -1 indicates that the process does not find a solution yet. i >= 0
+  // indicates that the i-th worker already found a solution.
+  atomic<int> found_delta_sat{-1};
+  static CdsInit cds_init{
+      true /* main thread is using lock-free containers. */};
+  // The previous call may leave boxes in the queue when it finds a
+  // delta-sat box.
+  Queue& queue{*queue_};
+  queue.clear();
+  OverflowQueue overflow;
+
+  const int number_of_jobs = config().number_of_jobs();
+
+  // Total number of boxes that are either 1) under processing in a worker or
+  // 2) waiting for a worker in the queue or in the overflow heap. This number
+  // goes zero when there is no more work to do.
+  atomic<int> number_of_boxes{0};
+  atomic<std::int64_t> seq{0};
+
+  queue.push(BestFirstEntry{
+      ComputeBestFirstScore(config().best_first_score(), formula_evaluators,
+                            cs->box(), *evaluation_result),
+      seq++, cs->box(), cs->branching_point(), *evaluation_result});
+  ++number_of_boxes;
+
+  for (int i = 0; i < number_of_jobs; ++i) {
+    status_vector_.push_back(*cs);
+  }
+
+  for (int i = 0; i < number_of_jobs - 1; ++i) {
+    results_.push_back(pool_.enqueue(
+        Worker, contractor, config(), formula_evaluators, i,
+        false /* not main thread */, &queue, &overflow, &status_vector_[i],
+        &found_delta_sat, &number_of_boxes, &seq));
+  }
+
+  const int last_index{number_of_jobs - 1};
+  Worker(contractor, config(), formula_evaluators, last_index,
+         true /* main thread */, &queue, &overflow, &status_vector_[last_index],
+         &found_delta_sat, &number_of_boxes, &seq);
+
+  // barrier.
+  for (auto&& result : results_) {
+    result.get();
+  }
+
+  // Post-processing: Join all the contractor statuses.
+  for (const auto& cs_i : status_vector_) {
+    cs->InplaceJoin(cs_i);
+  }
+
+  if (found_delta_sat >= 0) {
+    cs->mutable_box() = status_vector_[found_delta_sat].box();
+    return true;
+  } else {
+    DREAL_ASSERT(found_delta_sat == -1);
+    cs->mutable_box().set_empty();
+    return false;
+  }
+}
+}  // namespace dreal
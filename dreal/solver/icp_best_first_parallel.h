@@ -0,0 +1,81 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "ThreadPool/ThreadPool.h"
+
+#include "dreal/contractor/contractor.h"
+#include "dreal/contractor/contractor_status.h"
+#include "dreal/solver/config.h"
+#include "dreal/solver/formula_evaluator.h"
+#include "dreal/solver/icp.h"
+
+namespace dreal {
+
+/// Class for Parallel ICP (Interval Constraint Propagation) algorithm
+/// which explores the boxes in a best-first order.
+///
+/// The workers share a concurrent priority queue of pending boxes
+/// (PriorityQueue in dreal/util/cds.h) ordered by the score computed by
+/// ComputeBestFirstScore. As the queue has a bounded capacity, the
+/// boxes that do not fit in the queue go to a shared overflow heap, and
+/// a worker takes the better of the two tops. The queue is allocated
+/// once and reused across the calls of CheckSat.
+class IcpBestFirstParallel : public Icp {
+ public:
+  /// Constructs an IcpBestFirstParallel based on @p config.
+  explicit IcpBestFirstParallel(const Config& config);
+
+  /// Deleted copy constructor.
+  IcpBestFirstParallel(const IcpBestFirstParallel&) = delete;
+
+  /// Deleted move constructor.
+  IcpBestFirstParallel(IcpBestFirstParallel&&) = delete;
+
+  /// Deleted copy assign operator.
+  IcpBestFirstParallel& operator=(const IcpBestFirstParallel&) = delete;
+
+  /// Deleted move assign operator.
+  IcpBestFirstParallel& operator=(IcpBestFirstParallel&&) = delete;
+
+  ~IcpBestFirstParallel() override;
+
+  bool CheckSat(const Contractor& contractor,
+                const std::vector<FormulaEvaluator>& formula_evaluators,
+                ContractorStatus* cs) override;
+
+  /// The capacity of the shared priority queue.
+  static constexpr int kQueueCapacity{1 << 16};
+
+  /// The shared priority queue. It is defined in the .cc file.
+  class Queue;
+
+ private:
+  ThreadPool pool_;
+
+  // Constructing the queue allocates all of its kQueueCapacity entries,
+  // so we keep it instead of constructing one in each CheckSat call.
+  std::unique_ptr<Queue> queue_;
+
+  std::vector<std::future<void>> results_;
+  std::vector<ContractorStatus> status_vector_;
+};
+
+}  // namespace dreal
@@ -0,0 +1,482 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/solver/icp_distributed.h"
+
+#include <cstdint>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "dreal/solver/icp_stat.h"
+#include "dreal/solver/theory_solver.h"
+#include "dreal/symbolic/prefix_printer.h"
+#include "dreal/util/archive.h"
+#include "dreal/util/assert.h"
+#include "dreal/util/exception.h"
+#include "dreal/util/interrupt.h"
+#include "dreal/util/logging.h"
+
+namespace dreal {
+
+using std::ostringstream;
+using std::pair;
+using std::string;
+using std::unordered_map;
+using std::vector;
+
+namespace {
+
+// Kinds of the messages between the coordinator and the workers.
+enum class MessageKind : std::int64_t {
+  // Coordinator -> worker.
+  Query,
+  Box,
+  Shutdown,
+  // Worker -> coordinator.
+  Empty,
+  DeltaSat,
+  Branched,
+};
+
+// Number of boxes which a worker can have at a time. Having more than
+// one box hides the latency of the network: the worker can start the
+// next box while the coordinator handles the result of the previous
+// one.
+constexpr int kBoxesPerWorker{2};
+
+// A worker keeps trying to connect to the coordinator for this many
+// seconds.
+constexpr double kConnectTimeout{30.0};
+
+void WriteKind(const MessageKind kind, OutputArchive* const archive) {
+  archive->WriteInt64(static_cast<std::int64_t>(kind));
+}
+
+MessageKind ReadKind(InputArchive* const archive) {
+  return static_cast<MessageKind>(archive->ReadInt64());
+}
+
+const char* ToSmt2Sort(const Variable::Type type) {
+  switch (type) {
+    case Variable::Type::CONTINUOUS:
+      return "Real";
+    case Variable::Type::INTEGER:
+    case Variable::Type::BINARY:
+      return "Int";
+    case Variable::Type::BOOLEAN:
+      return "Bool";
+  }
+  DREAL_UNREACHABLE();
+}
+
+// Prunes and evaluates @p box and writes the reply to @p archive. Each
+// assertion used in an explanation is written as its index in
+// `index_of`.
+void ProcessBox(const Contractor& contractor,
+                const vector<FormulaEvaluator>& formula_evaluators,
+                const unordered_map<Formula, int>& index_of,
+                const Config& config, Box box, OutputArchive* const archive) {
+  ContractorStatus cs{std::move(box)};
+  contractor.Prune(&cs);
+  optional<DynamicBitset> evaluation_result;
+  if (!cs.box().empty()) {
+    evaluation_result = EvaluateBox(formula_evaluators, cs.box(),
+                                    config.precision(), &cs);
+  }
+  if (cs.box().empty() || !evaluation_result) {
+    vector<int> indices;
+    for (const Formula& f : cs.Explanation()) {
+      const auto it = index_of.find(f);
+      // A contractor only reports the assertions which it is built from.
+      DREAL_ASSERT(it != index_of.end());
+      if (it != index_of.end()) {
+        indices.push_back(it->second);
+      }
+    }
+    WriteKind(MessageKind::Empty, archive);
+    archive->WriteInt64(indices.size());
+    for (const int index : indices) {
+      archive->WriteInt64(index);
+    }
+    return;
+  }
+  if (evaluation_result->none()) {
+    WriteKind(MessageKind::DeltaSat, archive);
+    WriteBox(cs.box(), archive);
+    return;
+  }
+  Box box_left;
+  Box box_right;
+  const int branching_dim{
+      config.brancher()(cs.box(), *evaluation_result, &box_left, &box_right)};
+  if (branching_dim < 0) {
+    // The box is not bisectable. We report it as a delta-sat box as
+    // the other ICP algorithms do.
+    WriteKind(MessageKind::DeltaSat, archive);
+    WriteBox(cs.box(), archive);
+    return;
+  }
+  WriteKind(MessageKind::Branched, archive);
+  archive->WriteInt64(branching_dim);
+  WriteBox(box_left, archive);
+  WriteBox(box_right, archive);
+}
+
+}  // namespace
+
+string MakeDistributedQuery(const vector<Variable>& variables,
+                            const vector<Formula>& assertions,
+                            vector<Expression>* const real_constants) {
+  // We rename the variables to `v<i>` because the original names may
+  // not be unique or valid SMT2 symbols (e.g. the variables introduced
+  // by IfThenElseEliminator).
+  ExpressionSubstitution subst;
+  ostringstream oss;
+  for (size_t i = 0; i < variables.size(); ++i) {
+    const Variable v{fmt::format("v{}", i), variables[i].get_type()};
+    subst.emplace(variables[i], v);
+    oss << "(declare-fun " << v << " () "
+        << ToSmt2Sort(variables[i].get_type()) << ")\n";
+  }
+  // The j-th real constant is printed as `v<n + j>` where n is the
+  // number of the variables.
+  const auto real_constant_symbol = [&variables,
+                                     real_constants](const Expression& e) {
+    real_constants->push_back(e);
+    return fmt::format("v{}", variables.size() + real_constants->size() - 1);
+  };
+  ostringstream definitions;
+  PrefixPrinter printer{definitions, real_constant_symbol};
+  for (size_t i = 0; i < assertions.size(); ++i) {
+    const Formula& f{assertions[i]};
+    if (is_forall(f)) {
+      throw DREAL_RUNTIME_ERROR(
+          "Distributed ICP does not support universally quantified formulas: "
+          "{}",
+          f);
+    }
+    // A nullary define-fun is handled as a declaration of a variable
+    // plus an assertion. We add a dummy parameter to avoid it.
+    definitions << "(define-fun a" << i << " ((p Real)) Bool ";
+    printer.Print(f.Substitute(subst));
+    definitions << ")\n";
+  }
+  for (size_t j = 0; j < real_constants->size(); ++j) {
+    oss << "(declare-fun v" << variables.size() + j << " () Real)\n";
+  }
+  return oss.str() + definitions.str();
+}
+
+IcpDistributed::IcpDistributed(const Config& config) : Icp{config} {}
+
+IcpDistributed::~IcpDistributed() {
+  OutputArchive archive;
+  WriteKind(MessageKind::Shutdown, &archive);
+  for (SocketChannel& worker : workers_) {
+    try {
+      worker.Send(archive.data());
+    } catch (const std::runtime_error& e) {
+      DREAL_LOG_WARN("IcpDistributed: failed to shut down a worker: {}",
+                     e.what());
+    }
+  }
+}
+
+void IcpDistributed::AcceptWorkers() {
+  if (config().distributed_workers() < 1) {
+    throw DREAL_RUNTIME_ERROR("Distributed ICP needs at least one worker.");
+  }
+  listener_ =
+      std::make_unique<SocketListener>(config().distributed_address());
+  DREAL_LOG_INFO("IcpDistributed: waiting for {} workers at {}",
+                 config().distributed_workers(),
+                 config().distributed_address());
+  while (static_cast<int>(workers_.size()) < config().distributed_workers()) {
+    workers_.push_back(listener_->Accept());
+    DREAL_LOG_INFO("IcpDistributed: worker {} connected", workers_.size());
+  }
+}
+
+bool IcpDistributed::CheckSat(const Contractor&,
+                              const vector<FormulaEvaluator>& formula_evaluators,
+                              ContractorStatus* const cs) {
+  static IcpStat stat{DREAL_LOG_INFO_ENABLED};
+  DREAL_LOG_DEBUG("IcpDistributed::CheckSat()");
+  if (cs->box().empty()) {
+    return false;
+  }
+
+  // 1. Send the query to the workers.
+  vector<Formula> assertions;
+  assertions.reserve(formula_evaluators.size());
+  for (const FormulaEvaluator& formula_evaluator : formula_evaluators) {
+    assertions.push_back(formula_evaluator.formula());
+  }
+  const vector<Variable>& variables{cs->box().variables()};
+  {
+    OutputArchive archive;
+    WriteKind(MessageKind::Query, &archive);
+    vector<Expression> real_constants;
+    archive.WriteString(
+        MakeDistributedQuery(variables, assertions, &real_constants));
+    archive.WriteInt64(variables.size());
+    archive.WriteInt64(assertions.size());
+    archive.WriteInt64(real_constants.size());
+    for (const Expression& e : real_constants) {
+      archive.WriteDouble(get_lb_of_real_constant(e));
+      archive.WriteDouble(get_ub_of_real_constant(e));
+      archive.WriteUint64(e.Evaluate() == get_lb_of_real_constant(e) ? 1 : 0);
+    }
+    archive.WriteDouble(config().precision());
+    archive.WriteUint64(config().use_polytope() ? 1 : 0);
+    archive.WriteUint64(config().use_worklist_fixpoint() ? 1 : 0);
+    WriteBox(cs->box(), &archive);
+    if (workers_.empty()) {
+      AcceptWorkers();
+    }
+    for (SocketChannel& worker : workers_) {
+      worker.Send(archive.data());
+    }
+  }
+
+  // 2. Branch-and-prune. The coordinator explores boxes in depth-first
+  // order. The number of boxes sent to worker i and not replied yet is
+  // in `num_pending[i]`.
+  vector<pair<Box, int>> stack;  // (box, branching point)
+  stack.emplace_back(cs->box(), cs->branching_point());
+  vector<int> num_pending(workers_.size(), 0);
+  int total_pending{0};
+  vector<SocketChannel*> channels;
+  for (SocketChannel& worker : workers_) {
+    channels.push_back(&worker);
+  }
+  // The branching point of the box sent to worker i, in order.
+  vector<vector<int>> sent_branching_points(workers_.size());
+  optional<pair<Box, int>> delta_sat_box;
+  bool stop{false};
+
+  while (!stop) {
+    // Note that 'DREAL_CHECK_INTERRUPT' is only defined in setup.py,
+    // when we build dReal python package.
+#ifdef DREAL_CHECK_INTERRUPT
+    if (g_interrupted) {
+      DREAL_LOG_DEBUG("KeyboardInterrupt(SIGINT) Detected.");
+      throw std::runtime_error("KeyboardInterrupt(SIGINT) Detected.");
+    }
+#endif
+    if (cancelled()) {
+      DREAL_LOG_DEBUG("IcpDistributed::CheckSat() Cancelled");
+      break;
+    }
+
+    // 2.1. Hand out boxes to the workers with free slots.
+    for (size_t i = 0; i < workers_.size() && !stack.empty(); ++i) {
+      while (num_pending[i] < kBoxesPerWorker && !stack.empty()) {
+        OutputArchive archive;
+        WriteKind(MessageKind::Box, &archive);
+        WriteBox(stack.back().first, &archive);
+        workers_[i].Send(archive.data());
+        sent_branching_points[i].push_back(stack.back().second);
+        stack.pop_back();
+        ++num_pending[i];
+        ++total_pending;
+      }
+    }
+    if (total_pending == 0) {
+      // The stack is empty and no box is being processed.
+      break;
+    }
+
+    // 2.2. Handle a reply.
+    const int i{WaitForMessage(channels)};
+    const string message{workers_[i].Receive()};
+    --num_pending[i];
+    --total_pending;
+    const int branching_point{sent_branching_points[i].front()};
+    sent_branching_points[i].erase(sent_branching_points[i].begin());
+    stat.num_prune_++;
+
+    InputArchive archive{message};
+    switch (ReadKind(&archive)) {
+      case MessageKind::Empty: {
+        const std::int64_t size{archive.ReadInt64()};
+        for (std::int64_t j = 0; j < size; ++j) {
+          const Formula& f{assertions.at(archive.ReadInt64())};
+          // The worker proved the emptiness using `f`. We mark all of
+          // its variables as witnesses so that the explanation computed
+          // at the coordinator includes `f`.
+          cs->AddUsedConstraint(f);
+          for (const Variable& v : f.GetFreeVariables()) {
+            cs->AddUnsatWitness(v);
+          }
+        }
+        break;
+      }
+      case MessageKind::DeltaSat: {
+        Box box{variables};
+        ReadBox(&archive, &box);
+        DREAL_LOG_DEBUG("IcpDistributed::CheckSat() Found a delta-box:\n{}",
+                        box);
+        delta_sat_box.emplace(std::move(box), branching_point);
+        stop = true;
+        break;
+      }
+      case MessageKind::Branched: {
+        stat.num_branch_++;
+        const int branching_dim{static_cast<int>(archive.ReadInt64())};
+        Box box_left{variables};
+        Box box_right{variables};
+        ReadBox(&archive, &box_left);
+        ReadBox(&archive, &box_right);
+        // Follow the order of IcpSeq: the box pushed last is explored
+        // first.
+        if (config().stack_left_box_first()) {
+          stack.emplace_back(std::move(box_left), branching_dim);
+          stack.emplace_back(std::move(box_right), branching_dim);
+        } else {
+          stack.emplace_back(std::move(box_right), branching_dim);
+          stack.emplace_back(std::move(box_left), branching_dim);
+        }
+        break;
+      }
+      default:
+        throw DREAL_RUNTIME_ERROR(
+            "IcpDistributed: unexpected message from worker {}.", i);
+    }
+  }
+
+  // 3. Drain the replies of the boxes still being processed, so that
+  // they are not mixed with the next query.
+  while (total_pending > 0) {
+    const int i{WaitForMessage(channels)};
+    workers_[i].Receive();
+    --num_pending[i];
+    --total_pending;
+  }
+
+  if (delta_sat_box) {
+    cs->mutable_box() = std::move(delta_sat_box->first);
+    cs->mutable_branching_point() = delta_sat_box->second;
+    return true;
+  }
+  DREAL_LOG_DEBUG("IcpDistributed::CheckSat() No solution");
+  cs->mutable_box().set_empty();
+  return false;
+}
+
+void RunDistributedWorker(const string& address, const Config& config,
+                          const DistributedQueryParser& parse) {
+  SocketChannel channel{ConnectSocket(address, kConnectTimeout)};
+  DREAL_LOG_INFO("RunDistributedWorker: connected to {}", address);
+
+  // States built from the current query. The theory solver keeps a
+  // reference to `query_config`.
+  Config query_config{config};
+  std::unique_ptr<TheorySolver> theory_solver;
+  vector<FormulaEvaluator> formula_evaluators;
+  optional<Contractor> contractor;
+  unordered_map<Formula, int> index_of;
+  Box box_template;
+
+  while (true) {
+    string message;
+    try {
+      message = channel.Receive();
+    } catch (const std::runtime_error& e) {
+      // The coordinator has exited without shutting down the worker.
+      DREAL_LOG_WARN("RunDistributedWorker: {}", e.what());
+      return;
+    }
+    InputArchive archive{message};
+    switch (ReadKind(&archive)) {
+      case MessageKind::Query: {
+        const string script{archive.ReadString()};
+        const int num_variables{static_cast<int>(archive.ReadInt64())};
+        const int num_assertions{static_cast<int>(archive.ReadInt64())};
+        const int num_real_constants{static_cast<int>(archive.ReadInt64())};
+        vector<Variable> variables;
+        vector<Formula> assertions;
+        parse(script, num_variables + num_real_constants, num_assertions,
+              &variables, &assertions);
+        // Replaces the symbols of the real constants with their exact
+        // bounds. See MakeDistributedQuery.
+        ExpressionSubstitution real_constants;
+        for (int j = 0; j < num_real_constants; ++j) {
+          const double lb{archive.ReadDouble()};
+          const double ub{archive.ReadDouble()};
+          const bool use_lb_as_representative{archive.ReadUint64() != 0};
+          real_constants.emplace(
+              variables[num_variables + j],
+              real_constant(lb, ub, use_lb_as_representative));
+        }
+        variables.erase(variables.begin() + num_variables, variables.end());
+        if (!real_constants.empty()) {
+          for (Formula& f : assertions) {
+            f = f.Substitute(real_constants);
+          }
+        }
+
+        query_config = config;
+        query_config.mutable_precision() = archive.ReadDouble();
+        query_config.mutable_use_polytope() = archive.ReadUint64() != 0;
+        query_config.mutable_use_worklist_fixpoint() =
+            archive.ReadUint64() != 0;
+        query_config.mutable_number_of_jobs() = 1;
+        query_config.mutable_distributed_address() = string{};
+
+        box_template = Box{variables};
+        ReadBox(&archive, &box_template);
+        index_of.clear();
+        for (int i = 0; i < num_assertions; ++i) {
+          index_of.emplace(assertions[i], i);
+        }
+        theory_solver = std::make_unique<TheorySolver>(query_config);
+        ContractorStatus cs{box_template};
+        contractor = theory_solver->BuildContractor(assertions, &cs);
+        formula_evaluators = theory_solver->BuildFormulaEvaluator(assertions);
+        DREAL_LOG_DEBUG("RunDistributedWorker: received a query\n{}", script);
+        break;
+      }
+      case MessageKind::Box: {
+        Box box{box_template};
+        ReadBox(&archive, &box);
+        OutputArchive reply;
+        if (contractor) {
+          ProcessBox(*contractor, formula_evaluators, index_of, query_config,
+                     std::move(box), &reply);
+        } else {
+          // BuildContractor found that the assertions are UNSAT. It is
+          // unlikely as the coordinator has checked them over the same
+          // box. Report an empty box without an explanation.
+          WriteKind(MessageKind::Empty, &reply);
+          reply.WriteInt64(0);
+        }
+        channel.Send(reply.data());
+        break;
+      }
+      case MessageKind::Shutdown:
+        DREAL_LOG_INFO("RunDistributedWorker: shut down");
+        return;
+      default:
+        throw DREAL_RUNTIME_ERROR(
+            "RunDistributedWorker: unexpected message from the coordinator.");
+    }
+  }
+}
+
+}  // namespace dreal
@@ -0,0 +1,127 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dreal/contractor/contractor.h"
+#include "dreal/contractor/contractor_status.h"
+#include "dreal/solver/config.h"
+#include "dreal/solver/formula_evaluator.h"
+#include "dreal/solver/icp.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/socket.h"
+
+namespace dreal {
+
+/// Class for ICP (Interval Constraint Propagation) algorithm which
+/// distributes branch-and-prune over worker processes.
+///
+/// This class is the coordinator. It listens on
+/// Config::distributed_address() and waits until
+/// Config::distributed_workers() workers (see RunDistributedWorker)
+/// connect to it. The workers can run on the same machine or on other
+/// hosts.
+///
+/// At each CheckSat call, the coordinator sends the query (see
+/// MakeDistributedQuery) to all the workers, which rebuild the same
+/// contractor and formula evaluators from it. Then the coordinator runs
+/// a depth-first search over its own stack of boxes. It sends a box to
+/// an idle worker, which prunes and evaluates the box and replies with
+/// one of the following:
+///
+///  - Empty: the box has no solution. The reply includes the indices of
+///    the assertions used to prove it, to build an explanation.
+///  - DeltaSat: the pruned box is a delta-sat box.
+///  - Branched: the two sub-boxes obtained by branching the pruned box.
+///
+/// Boxes are sent with WriteBox, so that the workers see exactly the
+/// same bounds as the coordinator.
+///
+/// @note Assertions with universal quantifiers are not supported.
+class IcpDistributed : public Icp {
+ public:
+  /// Constructs an IcpDistributed based on @p config.
+  explicit IcpDistributed(const Config& config);
+
+  /// Deleted copy constructor.
+  IcpDistributed(const IcpDistributed&) = delete;
+
+  /// Deleted move constructor.
+  IcpDistributed(IcpDistributed&&) = delete;
+
+  /// Deleted copy assign operator.
+  IcpDistributed& operator=(const IcpDistributed&) = delete;
+
+  /// Deleted move assign operator.
+  IcpDistributed& operator=(IcpDistributed&&) = delete;
+
+  /// Shuts down the connected workers.
+  ~IcpDistributed() override;
+
+  bool CheckSat(const Contractor& contractor,
+                const std::vector<FormulaEvaluator>& formula_evaluators,
+                ContractorStatus* cs) override;
+
+ private:
+  // Waits for the workers to connect. It is called at the first
+  // CheckSat.
+  void AcceptWorkers();
+
+  std::unique_ptr<SocketListener> listener_;
+  std::vector<SocketChannel> workers_;
+};
+
+/// Returns an SMT2 script which encodes @p assertions over @p
+/// variables. The i-th variable is declared as `v<i>` and the i-th
+/// assertion is defined as a nullary Boolean function `a<i>`, so that a
+/// worker recovers them in the same order without running the
+/// simplifications in Context::Assert.
+///
+/// The floating-point constants are printed as hexadecimal floats so
+/// that a worker reads the same values. A real constant has no exact
+/// form in SMT2. The j-th one is printed as a variable `v<n + j>`,
+/// where n is the size of @p variables, and appended to @p
+/// real_constants. The coordinator sends their bounds separately and
+/// the worker substitutes them back.
+///
+/// @throws std::runtime_error if an assertion includes a universal
+/// quantifier.
+std::string MakeDistributedQuery(const std::vector<Variable>& variables,
+                                 const std::vector<Formula>& assertions,
+                                 std::vector<Expression>* real_constants);
+
+/// Parses a script made by MakeDistributedQuery. It stores the declared
+/// variables in @p variables and the assertions in @p assertions,
+/// preserving their orders.
+///
+/// The solver library cannot depend on the SMT2 front end, so the
+/// front end provides it (see RunSmt2Worker).
+using DistributedQueryParser = std::function<void(
+    const std::string& script, int num_variables, int num_assertions,
+    std::vector<Variable>* variables, std::vector<Formula>* assertions)>;
+
+/// Runs a worker of IcpDistributed. It connects to the coordinator at
+/// @p address and serves its requests until the coordinator shuts it
+/// down. The precision and the contractor options in @p config are
+/// overridden by the ones sent by the coordinator.
+void RunDistributedWorker(const std::string& address, const Config& config,
+                          const DistributedQueryParser& parse);
+
+}  // namespace dreal
@@ -15,15 +15,23 @@
 */
 #include "dreal/solver/icp_mcts.h"
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <random>
 #include <tuple>
 #include <utility>
 
+#include "ThreadPool/ThreadPool.h"
+
 #include "dreal/contractor/contractor.h"
 #include "dreal/contractor/contractor_fixpoint.h"
 #include "dreal/contractor/contractor_worklist_fixpoint.h"
+#include "dreal/solver/batch_evaluator.h"
 #include "dreal/solver/brancher.h"
 #include "dreal/solver/icp_stat.h"
+#include "dreal/util/assert.h"
 #include "dreal/util/box.h"
 #include "dreal/util/interrupt.h"
 #include "dreal/util/logging.h"
@@ -34,15 +42,61 @@ using std::tie;
 using std::vector;
 
 namespace dreal {
-static int node_index = 0;
-MctsNode::MctsNode(Box box) : box_{box}, parent_{NULL}, index_{node_index++} {}
-MctsNode::MctsNode(Box box, MctsNode* parent)
-    : box_{box}, parent_{parent}, index_{node_index++} {}
-MctsNode::~MctsNode() {
-  for (MctsNode* child : children_) {
-    delete child;
+
+namespace {
+
+std::atomic<int> node_index{0};
+
+// Atomically adds @p v to @p x.
+void AtomicAdd(std::atomic<double>* const x, const double v) {
+  double old_value{x->load(std::memory_order_relaxed)};
+  while (!x->compare_exchange_weak(old_value, old_value + v,
+                                   std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace
+
+MctsNodeArena::~MctsNodeArena() {
+  for (Chunk& chunk : chunks_) {
+    MctsNode* const nodes{reinterpret_cast<MctsNode*>(chunk.storage.get())};
+    for (int i = 0; i < chunk.size; ++i) {
+      nodes[i].~MctsNode();
+    }
   }
 }
+
+MctsNode* MctsNodeArena::Allocate(const int n) {
+  DREAL_ASSERT(n <= kChunkSize);
+  if (chunks_.empty() || chunks_.back().size + n > kChunkSize) {
+    chunks_.emplace_back();
+    chunks_.back().storage.reset(new Storage[kChunkSize]);
+  }
+  Chunk& chunk{chunks_.back()};
+  MctsNode* const nodes{reinterpret_cast<MctsNode*>(chunk.storage.get()) +
+                        chunk.size};
+  chunk.size += n;
+  return nodes;
+}
+
+MctsNode* MctsNodeArena::New(Box box) {
+  std::lock_guard<std::mutex> guard{mutex_};
+  return new (Allocate(1)) MctsNode(std::move(box));
+}
+
+MctsNode* MctsNodeArena::NewChildren(MctsNode* const parent, Box first,
+                                     Box second) {
+  std::lock_guard<std::mutex> guard{mutex_};
+  MctsNode* const nodes{Allocate(2)};
+  new (&nodes[0]) MctsNode(std::move(first), parent);
+  new (&nodes[1]) MctsNode(std::move(second), parent);
+  return nodes;
+}
+
+MctsNode::MctsNode(Box box)
+    : box_{std::move(box)}, parent_{NULL}, index_{node_index++} {}
+MctsNode::MctsNode(Box box, MctsNode* parent)
+    : box_{std::move(box)}, parent_{parent}, index_{node_index++} {}
 void MctsNode::evaluate(TimerGuard& eval_timer_guard,
                         // const Contractor& contractor,
                         const vector<FormulaEvaluator>& formula_evaluators,
@@ -58,59 +112,71 @@ void MctsNode::evaluate(TimerGuard& eval_timer_guard,
     DREAL_LOG_DEBUG("Unsat");
   } else {
     eval_timer_guard.resume();
-    evaluation_result_ =
-        EvaluateBox(formula_evaluators, box_, config.precision(), cs);
-    if (!evaluation_result_) {
-      // 3.2.1. We detect that the current box is not a feasible solution.
-      DREAL_LOG_DEBUG(
-          "IcpMcts::CheckSat() Detect that the current box is not feasible by "
-          "evaluation:\n{}",
-          box_);
-      eval_timer_guard.pause();
-      unsat_ = true;
-      delta_sat_ = false;
-      sat_ = false;
-      terminal_ = true;
-      DREAL_LOG_DEBUG("Unsat");
-    } else if (evaluation_result_->none()) {
-      // 3.2.2. delta-SAT : We find a box which is small enough.
-      DREAL_LOG_DEBUG("IcpMcts::CheckSat() Found a delta-box:\n{}", box_);
-      delta_sat_ = true;
-      terminal_ = true;
-      DREAL_LOG_DEBUG("Delta-Sat");
-
-      // Set the contractor_status box to this.box_
-      delta_sat_box_ = cs->mutable_box();
-      DREAL_LOG_DEBUG("IcpMcts::evalute Found a delta-box:\n{}",
-                      delta_sat_box_);
-    }
+    set_evaluation_result(
+        EvaluateBox(formula_evaluators, box_, config.precision(), cs));
     eval_timer_guard.pause();
   }
 }
 
+void MctsNode::set_evaluation_result(
+    optional<DynamicBitset> evaluation_result) {
+  evaluation_result_ = std::move(evaluation_result);
+  if (!evaluation_result_) {
+    // 3.2.1. We detect that the current box is not a feasible solution.
+    DREAL_LOG_DEBUG(
+        "IcpMcts::CheckSat() Detect that the current box is not feasible by "
+        "evaluation:\n{}",
+        box_);
+    unsat_ = true;
+    delta_sat_ = false;
+    sat_ = false;
+    terminal_ = true;
+    DREAL_LOG_DEBUG("Unsat");
+  } else if (evaluation_result_->none()) {
+    // 3.2.2. delta-SAT : We find a box which is small enough.
+    DREAL_LOG_DEBUG("IcpMcts::CheckSat() Found a delta-box:\n{}", box_);
+    // The delta-sat box is this.box_ itself.
+    delta_sat_box_ = &box_;
+    delta_sat_ = true;
+    terminal_ = true;
+    DREAL_LOG_DEBUG("Delta-Sat");
+  }
+}
+
 const Box& MctsNode::box() const { return box_; }
-const vector<MctsNode*>& MctsNode::children() const { return children_; }
+int MctsNode::num_children() const { return num_children_; }
+MctsNode* MctsNode::child(const int i) const {
+  DREAL_ASSERT(0 <= i && i < num_children_);
+  return &children_[i];
+}
 const MctsNode* MctsNode::parent() const { return parent_; }
 double MctsNode::visited() const { return visited_; }
-void MctsNode::increment_visited() { visited_++; }
+void MctsNode::increment_visited() { AtomicAdd(&visited_, 1.0); }
 double MctsNode::wins() const { return wins_; }
-void MctsNode::increment_wins() { visited_++; }
+void MctsNode::increment_wins() { AtomicAdd(&visited_, 1.0); }
 double MctsNode::value() {
   // compute UCT
-  if (!visited_) {
+  const double visited{visited_};
+  // A virtual loss counts as a visit without a win. It is always zero
+  // in the sequential algorithm.
+  const double virtual_loss = virtual_loss_;
+  if (!visited && !virtual_loss) {
     // this is a newly generated node, so choice among siblings
     // is arbitrary (maybe)
     value_ = 1.0;
-  } else if (terminal_ | unsat_ | sat_ | delta_sat_) {
+  } else if (terminal_ || unsat_ || sat_ || delta_sat_) {
     value_ = -1.0;
   } else {
-    value_ = (static_cast<double>(wins_) / static_cast<double>(visited_)) +
+    const double n{visited + virtual_loss};
+    value_ = (static_cast<double>(wins_) / n) +
              std::sqrt(2.0) *
-                 std::sqrt(std::log(static_cast<double>(parent_->visited())) /
-                           static_cast<double>(visited_));
+                 std::sqrt(std::log(std::max(1.0, parent_->visited())) / n);
   }
   return value_;
 }
+std::mutex& MctsNode::mutex() { return mutex_; }
+void MctsNode::add_virtual_loss() { ++virtual_loss_; }
+void MctsNode::remove_virtual_loss() { --virtual_loss_; }
 int MctsNode::index() const { return index_; }
 
 bool MctsNode::expand(const vector<FormulaEvaluator>& formula_evaluators,
@@ -118,7 +184,9 @@ bool MctsNode::expand(const vector<FormulaEvaluator>& formula_evaluators,
                       TimerGuard& branch_timer_guard,
                       TimerGuard& eval_timer_guard,
                       TimerGuard& prune_timer_guard, const Config& config,
-                      IcpStat& stat, double preferred_threshold) {
+                      IcpStat& stat, double preferred_threshold,
+                      MctsNodeArena* const arena,
+                      const BatchEvaluator* const batch_evaluator) {
   DREAL_LOG_DEBUG("MCTSNode::expand()");
   if (this->terminal()) return false;
 
@@ -132,31 +200,63 @@ bool MctsNode::expand(const vector<FormulaEvaluator>& formula_evaluators,
                            preferred_threshold, &box_left, &box_right);
 
   if (branching_dim >= 0) {
+    // The right child comes first so that select() prefers it on ties.
+    // Each child is pruned in place before it is evaluated.
+    MctsNode* const children{arena->NewChildren(this, std::move(box_right),
+                                                std::move(box_left))};
+    MctsNode& child_right{children[0]};
+    MctsNode& child_left{children[1]};
     Box& contractor_box{cs->mutable_box()};
     prune_timer_guard.resume();
-    DREAL_LOG_DEBUG("MCTSNode::expand(), pre-prune left: {}", box_left);
-    contractor_box = box_left;
+    DREAL_LOG_DEBUG("MCTSNode::expand(), pre-prune left: {}", child_left.box_);
+    contractor_box = child_left.box_;
     contractor.Prune(cs);
-    box_left = contractor_box;
+    child_left.box_ = contractor_box;
     stat.num_prune_++;
     prune_timer_guard.pause();
-    DREAL_LOG_DEBUG("MCTSNode::expand(), post-prune left: {}", box_left);
-    MctsNode* child_left = new MctsNode(box_left, this);
-    child_left->evaluate(eval_timer_guard, formula_evaluators, cs, config);
-    children_.insert(children_.begin(), child_left);
+    DREAL_LOG_DEBUG("MCTSNode::expand(), post-prune left: {}",
+                    child_left.box_);
+    if (!batch_evaluator) {
+      child_left.evaluate(eval_timer_guard, formula_evaluators, cs, config);
+    }
 
     prune_timer_guard.resume();
-    DREAL_LOG_DEBUG("MCTSNode::expand(), pre-prune right: {}", box_right);
-    contractor_box = box_right;
+    DREAL_LOG_DEBUG("MCTSNode::expand(), pre-prune right: {}",
+                    child_right.box_);
+    contractor_box = child_right.box_;
 
     contractor.Prune(cs);
-    box_right = contractor_box;
+    child_right.box_ = contractor_box;
     stat.num_prune_++;
     prune_timer_guard.pause();
-    DREAL_LOG_DEBUG("MCTSNode::expand(), post-prune right: {}", box_right);
-    MctsNode* child_right = new MctsNode(box_right, this);
-    child_right->evaluate(eval_timer_guard, formula_evaluators, cs, config);
-    children_.insert(children_.begin(), child_right);
+    DREAL_LOG_DEBUG("MCTSNode::expand(), post-prune right: {}",
+                    child_right.box_);
+    if (!batch_evaluator) {
+      child_right.evaluate(eval_timer_guard, formula_evaluators, cs, config);
+    } else {
+      // Evaluates the non-empty children at once.
+      vector<MctsNode*> nodes;
+      vector<const Box*> boxes;
+      for (MctsNode* const child : {&child_left, &child_right}) {
+        if (child->box_.empty()) {
+          child->evaluate(eval_timer_guard, formula_evaluators, cs, config);
+        } else {
+          nodes.push_back(child);
+          boxes.push_back(&child->box_);
+        }
+      }
+      eval_timer_guard.resume();
+      vector<optional<DynamicBitset>> evaluation_results{
+          EvaluateBoxes(*batch_evaluator, boxes, config.precision(), cs)};
+      for (size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i]->set_evaluation_result(std::move(evaluation_results[i]));
+      }
+      eval_timer_guard.pause();
+    }
+    children_ = children;
+    num_children_ = 2;
+    // The branching candidates are not needed any more.
+    evaluation_result_.reset();
     branch_timer_guard.pause();
     stat.num_branch_++;
     DREAL_LOG_DEBUG("MCTSNode::expand() exit normal");
@@ -330,7 +430,8 @@ double MctsNode::simulate_box(
                 "MctsNode::simulate_box(), evaluation_result->none(),  Found a "
                 "delta-box:\n{}",
                 next_candidate);
-            delta_sat_box_ = std::move(next_candidate);
+            simulated_box_.reset(new Box(std::move(next_candidate)));
+            delta_sat_box_ = simulated_box_.get();
             delta_sat_ = true;
             terminal_ = true;
             // DREAL_LOG_INFO("IcpMcts::simulate_box(),
@@ -355,19 +456,20 @@ double MctsNode::simulate_box(
         DREAL_LOG_DEBUG(
             "MctsNode::simulate_box() Found a delta-box(next_candidate):\n{}",
             next_candidate);
-        delta_sat_box_ = next_candidate;
+        simulated_box_.reset(new Box(std::move(next_candidate)));
+        delta_sat_box_ = simulated_box_.get();
         delta_sat_ = true;
         terminal_ = true;
         // DREAL_LOG_INFO(
         //     "IcpMcts::simulate_box() Found a delta-box
-        //     (delta_sat_box_):\n{}", delta_sat_box_);
+        //     (delta_sat_box_):\n{}", *delta_sat_box_);
         break;
       }
     }
     if (delta_sat_) {
       DREAL_LOG_DEBUG(
           "MctsNode::simulate_box(): breaking can. simulation, delta_sat_ = {}",
-          delta_sat_);
+          delta_sat_.load());
       break;
     }
 
@@ -393,13 +495,13 @@ double MctsNode::simulate_box(
     if (delta_sat_) {
       DREAL_LOG_DEBUG(
           "MctsNode::simulate_box(): breaking var. selection, delta_sat_ = {}",
-          delta_sat_);
+          delta_sat_.load());
       break;
     }
     DREAL_LOG_DEBUG("MctsNode::simulate_box(): end of main loop");
   }
   DREAL_LOG_DEBUG("MctsNode::simulate_box() exiting, delta_sat_ = {}",
-                  delta_sat_);
+                  delta_sat_.load());
 
   if (num_to_assign > 0) {
     return static_cast<double>(depth) / static_cast<double>(num_to_assign);
@@ -419,7 +521,7 @@ double MctsNode::simulate(
   }
 
   double total_depth = 0;
-  visited_++;
+  AtomicAdd(&visited_, 1.0);
   int iterations = 1;
   // int iterations = 0;
   int i = 1;
@@ -435,31 +537,33 @@ double MctsNode::simulate(
       break;
     }
   }
-  wins_ += (static_cast<double>(total_depth) / static_cast<double>(i));
+  AtomicAdd(&wins_,
+            static_cast<double>(total_depth) / static_cast<double>(i));
   return (static_cast<double>(total_depth) / static_cast<double>(i));
 }
 
 void MctsNode::backpropagate(double wins) {
-  wins_ += wins;
-  if (!unsat_ && !sat_ && !delta_sat_ && children_.size() > 0) {
-    unsat_ = std::all_of(children_.begin(), children_.end(),
-                         [](MctsNode* child) { return child->unsat(); });
+  AtomicAdd(&wins_, wins);
+  MctsNode* const children_end{children_ + num_children_};
+  if (!unsat_ && !sat_ && !delta_sat_ && num_children_ > 0) {
+    unsat_ = std::all_of(children_, children_end,
+                         [](MctsNode& child) { return child.unsat(); });
   }
-  if (!unsat_ && !sat_ && !delta_sat_ && children_.size() > 0) {
-    sat_ = std::any_of(children_.begin(), children_.end(),
-                       [](MctsNode* child) { return child->sat(); });
+  if (!unsat_ && !sat_ && !delta_sat_ && num_children_ > 0) {
+    sat_ = std::any_of(children_, children_end,
+                       [](MctsNode& child) { return child.sat(); });
   }
-  if (!unsat_ && !sat_ && !delta_sat_ && children_.size() > 0) {
-    delta_sat_ =
-        std::any_of(children_.begin(), children_.end(),
-                    [](MctsNode* child) { return child->delta_sat(); });
-    for (auto child : children_) {
+  if (!unsat_ && !sat_ && !delta_sat_ && num_children_ > 0) {
+    for (MctsNode* child = children_; child != children_end; ++child) {
       if (child->delta_sat()) {
-        delta_sat_box_ = child->delta_sat_box_;
+        // Share the child's delta-sat box instead of copying it. It is
+        // published before the child's delta_sat_ flag.
+        delta_sat_box_ = child->delta_sat_box_.load();
         DREAL_LOG_DEBUG("IcpMcts::backpropagate Found a delta-box:\n{}",
-                        delta_sat_box_);
+                        *delta_sat_box_);
       }
     }
+    delta_sat_ = delta_sat_box_ != nullptr;
   }
   if (unsat_ || sat_ || delta_sat_) {
     terminal_ = true;
@@ -468,12 +572,16 @@ void MctsNode::backpropagate(double wins) {
 
 MctsNode* MctsNode::select() {
   // Select a child node by computing its UCT value
-  MctsNode* child = *std::max_element(
-      children_.begin(), children_.end(),
-      [](MctsNode* a, MctsNode* b) { return a->value() < b->value(); });
+  MctsNode* child = std::max_element(
+      children_, children_ + num_children_,
+      [](MctsNode& a, MctsNode& b) { return a.value() < b.value(); });
   return child;
 }
-const Box& MctsNode::delta_sat_box() const { return delta_sat_box_; }
+const Box& MctsNode::delta_sat_box() const {
+  const Box* const delta_sat_box{delta_sat_box_};
+  DREAL_ASSERT(delta_sat_box);
+  return *delta_sat_box;
+}
 bool MctsNode::unsat() { return unsat_; }
 bool MctsNode::delta_sat() { return delta_sat_; }
 bool MctsNode::sat() { return sat_; }
@@ -485,7 +593,8 @@ bool IcpMcts::CheckSat(const Contractor& contractor,
 
                        const vector<FormulaEvaluator>& formula_evaluators,
                        ContractorStatus* const cs) {
-  static IcpStat stat{DREAL_LOG_INFO_ENABLED};
+  thread_local IcpStat stat{DREAL_LOG_INFO_ENABLED,
+                            ThreadPool::get_thread_id()};
   DREAL_LOG_DEBUG("IcpMcts::CheckSat()");
 
   TimerGuard prune_timer_guard(&stat.timer_prune_, stat.enabled(),
@@ -501,8 +610,18 @@ bool IcpMcts::CheckSat(const Contractor& contractor,
   stat.num_prune_++;
 
   DREAL_LOG_DEBUG("After pruning root box: {}", cs->box());
-  MctsNode* root = new MctsNode(Box(cs->box()));
+  // All the nodes of the search tree are freed when `arena` goes out of
+  // scope.
+  MctsNodeArena arena;
+  MctsNode* const root{arena.New(Box(cs->box()))};
   root->evaluate(eval_timer_guard, formula_evaluators, cs, config());
+  // Evaluates the two children of an expansion at once if
+  // --batch-evaluation is set.
+  std::unique_ptr<const BatchEvaluator> batch_evaluator;
+  if (config().use_batch_evaluation()) {
+    batch_evaluator =
+        std::make_unique<const BatchEvaluator>(formula_evaluators, cs->box());
+  }
 
   uint32_t seed_counter = config().random_seed();
   std::seed_seq seed{reinterpret_cast<intptr_t>(&seed_counter)};
@@ -524,22 +643,26 @@ bool IcpMcts::CheckSat(const Contractor& contractor,
                  preferred_precision);
 
   while (!(root->unsat() || root->delta_sat() || root->sat())) {
+    if (cancelled()) {
+      DREAL_LOG_DEBUG("IcpMcts::CheckSat() Cancelled");
+      cs->mutable_box().set_empty();
+      return false;
+    }
     DREAL_LOG_DEBUG("[");
     MctsBP(root, formula_evaluators, cs, contractor,
            contractor  // heuristic_contractor
 
            ,
            branch_timer_guard, eval_timer_guard, prune_timer_guard, stat, rnd,
-           preferred_precision);
+           preferred_precision, &arena, batch_evaluator.get());
     DREAL_LOG_DEBUG("]");
   }
-  DREAL_LOG_DEBUG("IcpMCTS::CheckSAT, result = {}", root->delta_sat_box());
   bool rvalue = !root->unsat();
   if (rvalue) {
+    DREAL_LOG_DEBUG("IcpMCTS::CheckSAT, result = {}", root->delta_sat_box());
     cs->mutable_box() = root->delta_sat_box();
   }
 
-  delete root;
   DREAL_LOG_DEBUG("IcpMCTS::CheckSAT, result = {}", rvalue);
   DREAL_LOG_DEBUG("IcpMCTS::CheckSAT, result = {}", cs->mutable_box());
   return rvalue;
@@ -598,15 +721,16 @@ double IcpMcts::MctsBP(
     ContractorStatus* const cs, const Contractor& contractor,
     const Contractor& heuristic_contractor, TimerGuard& branch_timer_guard,
     TimerGuard& eval_timer_guard, TimerGuard& prune_timer_guard, IcpStat& stat,
-    std::default_random_engine& rnd, double preferred_precision) {
+    std::default_random_engine& rnd, double preferred_precision,
+    MctsNodeArena* const arena, const BatchEvaluator* const batch_evaluator) {
   double wins = 0;
   if (!node->terminal()) {
-    if (node->children().empty()) {
+    if (node->num_children() == 0) {
       // If node has unexplored children, then
       bool expanded =
           node->expand(formula_evaluators, cs, contractor, branch_timer_guard,
                        eval_timer_guard, prune_timer_guard, config(), stat,
-                       preferred_precision);
+                       preferred_precision, arena, batch_evaluator);
 
       if (expanded) {
         DREAL_LOG_DEBUG("X");
@@ -626,7 +750,8 @@ double IcpMcts::MctsBP(
       DREAL_LOG_DEBUG(".");
       wins = MctsBP(child, formula_evaluators, cs, contractor,
                     heuristic_contractor, branch_timer_guard, eval_timer_guard,
-                    prune_timer_guard, stat, rnd, preferred_precision);
+                    prune_timer_guard, stat, rnd, preferred_precision, arena,
+                    batch_evaluator);
     }
   } else {
     // Node is decided
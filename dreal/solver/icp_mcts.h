@@ -15,7 +15,11 @@
 */
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <random>
+#include <type_traits>
 #include <vector>
 
 #include "dreal/contractor/contractor.h"
@@ -28,16 +32,21 @@
 
 namespace dreal {
 
+class MctsNodeArena;
+
 class MctsNode {
  public:
   MctsNode() = delete;
-  ~MctsNode();
+  ~MctsNode() = default;
   explicit MctsNode(Box box);
   explicit MctsNode(Box box, MctsNode* parent);
 
   /// Returns a const reference of the embedded box.
   const Box& box() const;
 
+  /// Returns the delta-sat box found in the subtree rooted at this node.
+  ///
+  /// @pre delta_sat() is true.
   const Box& delta_sat_box() const;
 
   void evaluate(TimerGuard& eval_timer_guard,
@@ -48,7 +57,10 @@ class MctsNode {
                 // IcpStat& stat
   );
 
-  const std::vector<MctsNode*>& children() const;
+  /// Returns the number of children. It is either 0 (not expanded) or 2.
+  int num_children() const;
+  /// Returns the i-th child.
+  MctsNode* child(int i) const;
   const MctsNode* parent() const;
   double visited() const;
   void increment_visited();
@@ -57,11 +69,16 @@ class MctsNode {
   double value();
   int index() const;
 
+  /// Branches the box of this node and adds the two (pruned and
+  /// evaluated) children, allocating them in @p arena. If @p
+  /// batch_evaluator is not nullptr, the two children are evaluated at
+  /// once with it.
   bool expand(const std::vector<FormulaEvaluator>& formula_evaluators,
               ContractorStatus* const cs, const Contractor& contractor,
               TimerGuard& branch_timer_guard, TimerGuard& eval_timer_guard,
               TimerGuard& prune_timer_guard, const Config& config,
-              IcpStat& stat, double preferred_threshold);
+              IcpStat& stat, double preferred_threshold,
+              MctsNodeArena* arena, const BatchEvaluator* batch_evaluator);
   double simulate_box(Box& sim_box,
                       const std::vector<FormulaEvaluator>& formula_evaluators,
                       ContractorStatus* const cs, const Contractor& contractor,
@@ -83,20 +100,110 @@ class MctsNode {
   bool sat();
   bool terminal();
 
+  /// @name Tree parallelism
+  ///
+  /// Members used when multiple workers share a tree (see
+  /// IcpMctsParallel). A worker holds the mutex of a node while it
+  /// expands, simulates, or backpropagates the node. It adds a virtual
+  /// loss to each node on its path so that concurrent workers are
+  /// steered to different parts of the tree. The statistics and the
+  /// flags are atomic so that value() can be computed without holding
+  /// the mutex of a child.
+  ///
+  /// @{
+
+  /// Returns the mutex guarding this node.
+  std::mutex& mutex();
+
+  /// Adds a virtual loss to this node.
+  void add_virtual_loss();
+
+  /// Removes a virtual loss from this node.
+  void remove_virtual_loss();
+
+  /// @}
+
  private:
+  // Sets the result of evaluating the box of this node and updates the
+  // flags accordingly.
+  void set_evaluation_result(optional<DynamicBitset> evaluation_result);
+
   Box box_;
-  Box delta_sat_box_;
+  // Points to the delta-sat box, which is either `box_`, the box found
+  // by simulation (`simulated_box_`), or the delta-sat box of a child.
+  // Boxes are copied only when simulation finds one.
+  std::atomic<const Box*> delta_sat_box_{nullptr};
+  std::unique_ptr<Box> simulated_box_;
   MctsNode* parent_;
-  std::vector<MctsNode*> children_;
-  double visited_{0};
-  double wins_{0};
-  bool unsat_{false};
-  bool delta_sat_{false};
-  bool sat_{false};
-  bool terminal_{false};
-  double value_{0.0};
+  // Children are allocated contiguously in an arena.
+  MctsNode* children_{nullptr};
+  int num_children_{0};
+  std::atomic<double> visited_{0};
+  std::atomic<double> wins_{0};
+  std::atomic<int> virtual_loss_{0};
+  std::atomic<bool> unsat_{false};
+  std::atomic<bool> delta_sat_{false};
+  std::atomic<bool> sat_{false};
+  std::atomic<bool> terminal_{false};
+  std::atomic<double> value_{0.0};
+  // It is released once the node is expanded.
   optional<DynamicBitset> evaluation_result_;
   int index_;
+  std::mutex mutex_;
+};
+
+/// Arena of MctsNode objects.
+///
+/// Nodes are bump-allocated in fixed-size chunks and they are all
+/// destroyed when the arena is destroyed. This avoids a call to the
+/// general-purpose allocator per node, and it tears a tree down
+/// without recursion, however deep the tree is. Allocation is
+/// thread-safe so that the workers of IcpMctsParallel can expand
+/// different nodes concurrently.
+class MctsNodeArena {
+ public:
+  /// Constructs an empty arena.
+  MctsNodeArena() = default;
+
+  /// Deleted copy constructor.
+  MctsNodeArena(const MctsNodeArena&) = delete;
+
+  /// Deleted move constructor.
+  MctsNodeArena(MctsNodeArena&&) = delete;
+
+  /// Deleted copy assignment operator.
+  MctsNodeArena& operator=(const MctsNodeArena&) = delete;
+
+  /// Deleted move assignment operator.
+  MctsNodeArena& operator=(MctsNodeArena&&) = delete;
+
+  /// Destroys all the nodes allocated in this arena.
+  ~MctsNodeArena();
+
+  /// Allocates a root node whose box is @p box.
+  MctsNode* New(Box box);
+
+  /// Allocates two contiguous children of @p parent whose boxes are @p
+  /// first and @p second, and returns a pointer to the first one.
+  MctsNode* NewChildren(MctsNode* parent, Box first, Box second);
+
+ private:
+  static constexpr int kChunkSize{256};
+
+  using Storage =
+      std::aligned_storage<sizeof(MctsNode), alignof(MctsNode)>::type;
+
+  struct Chunk {
+    std::unique_ptr<Storage[]> storage;
+    int size{0};
+  };
+
+  // Returns storage for @p n contiguous nodes. It should be called
+  // while holding `mutex_`.
+  MctsNode* Allocate(int n);
+
+  std::vector<Chunk> chunks_;
+  std::mutex mutex_;
 };
 
 /// Class for ICP (Interval Constraint Propagation) algorithm.
@@ -116,7 +223,8 @@ class IcpMcts : public IcpSeq {
                 const Contractor& heuristic_contractor,
                 TimerGuard& branch_timer_guard, TimerGuard& eval_timer_guard,
                 TimerGuard& prune_timer_guard, IcpStat& stat,
-                std::default_random_engine& rnd, double preferred_precision);
+                std::default_random_engine& rnd, double preferred_precision,
+                MctsNodeArena* arena, const BatchEvaluator* batch_evaluator);
 
   // Generate a lower-cost contractor to use in simulation
   optional<Contractor> make_heuristic_contractor(const Contractor& contractor);
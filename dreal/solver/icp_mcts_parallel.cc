@@ -0,0 +1,220 @@
+/*
+   Copyright 2023 Smart Information Flow Technologies, LLC.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/solver/icp_mcts_parallel.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+
+#include "dreal/solver/batch_evaluator.h"
+#include "dreal/solver/icp_mcts.h"
+#include "dreal/solver/icp_stat.h"
+#include "dreal/util/assert.h"
+#include "dreal/util/interrupt.h"
+#include "dreal/util/logging.h"
+
+using std::vector;
+
+namespace dreal {
+
+namespace {
+
+// Returns true if the search on the tree rooted at @p root is over.
+bool IsDecided(MctsNode* const root) {
+  return root->unsat() || root->delta_sat() || root->sat();
+}
+
+// Runs a single MCTS iteration from @p root.
+//
+// 1. Selection: Starting from the root, it descends the tree by
+//    selecting the child with the highest UCT value, adding a virtual
+//    loss to each node on the path.
+// 2. Expansion: When it reaches a leaf, it expands the leaf while
+//    holding the leaf's mutex so that no other worker expands it.
+// 3. Simulation: It simulates one of the new children.
+// 4. Backpropagation: It updates the nodes on the path in the reverse
+//    order and removes the virtual losses.
+void Iterate(MctsNode* const root,
+             const vector<FormulaEvaluator>& formula_evaluators,
+             ContractorStatus* const cs, const Contractor& contractor,
+             TimerGuard& branch_timer_guard, TimerGuard& eval_timer_guard,
+             TimerGuard& prune_timer_guard, const Config& config,
+             IcpStat& stat, std::default_random_engine& rnd,
+             const double preferred_precision, MctsNodeArena* const arena,
+             const BatchEvaluator* const batch_evaluator) {
+  vector<MctsNode*> path;
+  double wins{0};
+  MctsNode* node{root};
+  while (true) {
+    node->add_virtual_loss();
+    path.push_back(node);
+    std::unique_lock<std::mutex> lock{node->mutex()};
+    if (node->terminal()) {
+      // Node is decided.
+      wins = 1;
+      break;
+    }
+    if (node->num_children() == 0) {
+      const bool expanded{node->expand(
+          formula_evaluators, cs, contractor, branch_timer_guard,
+          eval_timer_guard, prune_timer_guard, config, stat,
+          preferred_precision, arena, batch_evaluator)};
+      if (!expanded) {
+        wins = 1;
+        break;
+      }
+      MctsNode* const child{node->select()};
+      lock.unlock();
+      std::lock_guard<std::mutex> child_guard{child->mutex()};
+      wins = child->simulate(formula_evaluators, cs, contractor,
+                             eval_timer_guard, prune_timer_guard, config, stat,
+                             rnd, preferred_precision);
+      break;
+    }
+    // Node is interior, and need to select child to descend.
+    node = node->select();
+  }
+
+  for (auto it = path.rbegin(); it != path.rend(); ++it) {
+    MctsNode* const n{*it};
+    std::lock_guard<std::mutex> guard{n->mutex()};
+    n->increment_visited();
+    n->backpropagate(wins);
+    n->remove_virtual_loss();
+  }
+}
+
+void Worker(MctsNode* const root, const Contractor& contractor,
+            const Config& config,
+            const vector<FormulaEvaluator>& formula_evaluators, const int id,
+            const double preferred_precision, MctsNodeArena* const arena,
+            const BatchEvaluator* const batch_evaluator,
+            ContractorStatus* const cs) {
+  thread_local IcpStat stat{DREAL_LOG_INFO_ENABLED, id};
+  TimerGuard prune_timer_guard(&stat.timer_prune_, stat.enabled(),
+                               false /* start_timer */);
+  TimerGuard eval_timer_guard(&stat.timer_eval_, stat.enabled(),
+                              false /* start_timer */);
+  TimerGuard branch_timer_guard(&stat.timer_branch_, stat.enabled(),
+                                false /* start_timer */);
+
+  // Each worker has its own random number generator so that the
+  // simulations do not contend on it.
+  std::default_random_engine rnd{config.random_seed() +
+                                 static_cast<uint32_t>(id)};
+
+  while (!IsDecided(root)) {
+    // Note that 'DREAL_CHECK_INTERRUPT' is only defined in setup.py,
+    // when we build dReal python package.
+#ifdef DREAL_CHECK_INTERRUPT
+    if (g_interrupted) {
+      DREAL_LOG_DEBUG("KeyboardInterrupt(SIGINT) Detected.");
+      throw std::runtime_error("KeyboardInterrupt(SIGINT) Detected.");
+    }
+#endif
+    Iterate(root, formula_evaluators, cs, contractor, branch_timer_guard,
+            eval_timer_guard, prune_timer_guard, config, stat, rnd,
+            preferred_precision, arena, batch_evaluator);
+  }
+}
+
+}  // namespace
+
+IcpMctsParallel::IcpMctsParallel(const Config& config)
+    : Icp{config}, pool_{static_cast<size_t>(config.number_of_jobs() - 1)} {
+  results_.reserve(config.number_of_jobs() - 1);
+  status_vector_.reserve(config.number_of_jobs());
+}
+
+bool IcpMctsParallel::CheckSat(
+    const Contractor& contractor,
+    const vector<FormulaEvaluator>& formula_evaluators,
+    ContractorStatus* const cs) {
+  static IcpStat stat{DREAL_LOG_INFO_ENABLED};
+  DREAL_LOG_DEBUG("IcpMctsParallel::CheckSat()");
+
+  TimerGuard prune_timer_guard(&stat.timer_prune_, stat.enabled(),
+                               false /* start_timer */);
+  TimerGuard eval_timer_guard(&stat.timer_eval_, stat.enabled(),
+                              false /* start_timer */);
+
+  // Initial Prune
+  prune_timer_guard.resume();
+  contractor.Prune(cs);
+  prune_timer_guard.pause();
+  stat.num_prune_++;
+  if (cs->box().empty()) {
+    return false;
+  }
+
+  // All the nodes of the shared search tree are freed when `arena` goes
+  // out of scope.
+  MctsNodeArena arena;
+  MctsNode* const root{arena.New(Box(cs->box()))};
+  root->evaluate(eval_timer_guard, formula_evaluators, cs, config());
+  // Evaluates the two children of an expansion at once if
+  // --batch-evaluation is set. It is shared by all the workers.
+  std::unique_ptr<const BatchEvaluator> batch_evaluator;
+  if (config().use_batch_evaluation()) {
+    batch_evaluator =
+        std::make_unique<const BatchEvaluator>(formula_evaluators, cs->box());
+  }
+  const double preferred_precision{root->preferred_width_ratio(config())};
+  std::default_random_engine rnd{config().random_seed()};
+  root->simulate(formula_evaluators, cs, contractor, eval_timer_guard,
+                 prune_timer_guard, config(), stat, rnd, preferred_precision);
+
+  results_.clear();
+  status_vector_.clear();
+  const int number_of_jobs = config().number_of_jobs();
+  for (int i = 0; i < number_of_jobs; ++i) {
+    status_vector_.push_back(*cs);
+  }
+
+  for (int i = 0; i < number_of_jobs - 1; ++i) {
+    results_.push_back(pool_.enqueue(Worker, root, contractor, config(),
+                                     formula_evaluators, i,
+                                     preferred_precision, &arena,
+                                     batch_evaluator.get(),
+                                     &status_vector_[i]));
+  }
+  const int last_index{number_of_jobs - 1};
+  Worker(root, contractor, config(), formula_evaluators, last_index,
+         preferred_precision, &arena, batch_evaluator.get(),
+         &status_vector_[last_index]);
+
+  // barrier.
+  for (auto&& result : results_) {
+    result.get();
+  }
+
+  // Post-processing: Join all the contractor statuses.
+  for (const auto& cs_i : status_vector_) {
+    cs->InplaceJoin(cs_i);
+  }
+
+  const bool delta_sat{!root->unsat()};
+  if (delta_sat) {
+    cs->mutable_box() = root->delta_sat_box();
+  } else {
+    cs->mutable_box().set_empty();
+  }
+  DREAL_LOG_DEBUG("IcpMctsParallel::CheckSat() result = {}", delta_sat);
+  return delta_sat;
+}
+
+}  // namespace dreal
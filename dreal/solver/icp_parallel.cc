@@ -16,13 +16,15 @@
 #include "dreal/solver/icp_parallel.h"
 
 #include <atomic>
+#include <cstdint>
+#include <deque>
 #include <tuple>
 #include <utility>
 
 #include "dreal/solver/brancher.h"
 #include "dreal/solver/icp_stat.h"
 #include "dreal/util/assert.h"
-#include "dreal/util/cds.h"
+#include "dreal/util/idle_backoff.h"
 #include "dreal/util/interrupt.h"
 #include "dreal/util/logging.h"
 
@@ -34,9 +36,141 @@ namespace dreal {
 
 namespace {
 
+using Deques = vector<WorkStealingDeque<Box>>;
+
+// In the initial split phase, we split the root box until there are at
+// least kInitialSplitFactor boxes per worker.
+constexpr int kInitialSplitFactor{4};
+
+// Upper bound of the number of branching operations in the initial
+// split phase, per box that we want to have. When pruning removes most
+// of the sub-boxes, we stop splitting early and let the workers handle
+// the rest.
+constexpr int kMaxInitialSplitStepsPerBox{4};
+
+// Splits the box in @p cs in a breadth-first way until there are at
+// least @p target boxes, using the brancher in @p config. Each sub-box
+// is pruned by @p contractor. The resulting boxes are stored in @p
+// boxes.
+//
+// @returns true if it finds a delta-sat box during the split. In this
+// case, the box is stored in @p cs.
+bool InitialSplit(const Contractor& contractor, const Config& config,
+                  const vector<FormulaEvaluator>& formula_evaluators,
+                  const int target, ContractorStatus* const cs,
+                  std::deque<Box>* const boxes) {
+  boxes->push_back(cs->box());
+  Box& current_box{cs->mutable_box()};
+  const int max_steps{target * kMaxInitialSplitStepsPerBox};
+  for (int step = 0;
+       step < max_steps && !boxes->empty() &&
+       static_cast<int>(boxes->size()) < target;
+       ++step) {
+    // Note that the boxes in `boxes` have been pruned.
+    Box box{std::move(boxes->front())};
+    boxes->pop_front();
+    const optional<DynamicBitset> evaluation_result{
+        EvaluateBox(formula_evaluators, box, config.precision(), cs)};
+    if (!evaluation_result) {
+      continue;
+    }
+    if (evaluation_result->none()) {
+      DREAL_LOG_DEBUG("IcpParallel::InitialSplit() Found a delta-box:\n{}",
+                      box);
+      current_box = std::move(box);
+      return true;
+    }
+    Box box_left;
+    Box box_right;
+    const int branching_dim{
+        config.brancher()(box, *evaluation_result, &box_left, &box_right)};
+    if (branching_dim < 0) {
+      DREAL_LOG_DEBUG(
+          "IcpParallel::InitialSplit() Found that the current box is not "
+          "satisfying delta-condition but it's not bisectable.:\n{}",
+          box);
+      current_box = std::move(box);
+      return true;
+    }
+    for (Box* const child : {&box_left, &box_right}) {
+      current_box = std::move(*child);
+      cs->mutable_branching_point() = branching_dim;
+      contractor.Prune(cs);
+      if (!current_box.empty()) {
+        boxes->push_back(current_box);
+      }
+    }
+  }
+  DREAL_LOG_DEBUG("IcpParallel::InitialSplit() {} boxes (target = {})",
+                  boxes->size(), target);
+  return false;
+}
+
+// Shared state used to save a checkpoint. The worker on the main
+// thread saves a checkpoint while the other workers pause, so that it
+// sees a consistent set of boxes in the deques.
+struct CheckpointState {
+  Checkpointer* checkpointer{nullptr};
+  std::uint64_t fingerprint{0};
+  // The worker on the main thread sets it to ask the others to pause.
+  atomic<bool> requested{false};
+  // Number of workers which are paused or finished.
+  atomic<int> num_stopped{0};
+};
+
+// Saves the boxes in @p deques to a checkpoint. It waits until all the
+// other workers pause or finish, unless a worker finds a delta-sat
+// box in the meantime.
+void SaveCheckpoint(const Deques& deques, const atomic<int>& found_delta_sat,
+                    CheckpointState* const state) {
+  const int number_of_jobs = static_cast<int>(deques.size());
+  state->requested.store(true, std::memory_order_release);
+  IdleBackoff backoff;
+  while (state->num_stopped.load(std::memory_order_acquire) <
+             number_of_jobs - 1 &&
+         found_delta_sat == -1) {
+    backoff.Idle();
+  }
+  if (found_delta_sat == -1) {
+    vector<FrontierEntry> frontier;
+    for (const WorkStealingDeque<Box>& deque : deques) {
+      for (Box& box : deque.snapshot()) {
+        frontier.emplace_back(std::move(box), -1);
+      }
+    }
+    state->checkpointer->Save(state->fingerprint, frontier);
+  }
+  state->requested.store(false, std::memory_order_release);
+}
+
+// Pauses a worker until the worker on the main thread saves a
+// checkpoint.
+void PauseForCheckpoint(CheckpointState* const state) {
+  state->num_stopped.fetch_add(1, std::memory_order_acq_rel);
+  IdleBackoff backoff;
+  while (state->requested.load(std::memory_order_acquire)) {
+    backoff.Idle();
+  }
+  state->num_stopped.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+// Tries to steal a box from the other workers' deques and stores it in
+// @p box. It visits the victims in a round-robin fashion, starting
+// from the one next to @p id, so that thieves spread over the workers.
+bool Steal(const int id, Deques* const deques, Box* const box) {
+  const int number_of_jobs = static_cast<int>(deques->size());
+  for (int i = 1; i < number_of_jobs; ++i) {
+    WorkStealingDeque<Box>& victim{(*deques)[(id + i) % number_of_jobs]};
+    if (victim.steal(*box)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool ParallelBranch(const DynamicBitset& bitset,
                     const bool stack_left_box_first, Box* const box,
-                    Stack<Box>* const global_stack,
+                    WorkStealingDeque<Box>* const local_deque,
                     atomic<int>* const number_of_boxes) {
   const pair<double, int> max_diam_and_idx{FindMaxDiam(*box, bitset)};
   const int branching_point{max_diam_and_idx.second};
@@ -54,7 +188,7 @@ bool ParallelBranch(const DynamicBitset& bitset,
     const Box& box1{*box1_ptr};
     const Box& box2{*box2_ptr};
     number_of_boxes->fetch_add(1, std::memory_order_relaxed);
-    global_stack->push(box1);
+    local_deque->push(box1);
     *box = box2;
     return true;
   }
@@ -64,9 +198,10 @@ bool ParallelBranch(const DynamicBitset& bitset,
 
 void Worker(const Contractor& contractor, const Config& config,
             const vector<FormulaEvaluator>& formula_evaluators, const int id,
-            const bool main_thread, Stack<Box>* const global_stack,
-            ContractorStatus* const cs, atomic<int>* const found_delta_sat,
-            atomic<int>* const number_of_boxes) {
+            Deques* const deques, ContractorStatus* const cs,
+            atomic<int>* const found_delta_sat,
+            atomic<int>* const number_of_boxes,
+            CheckpointState* const checkpoint) {
   thread_local IcpStat stat{DREAL_LOG_INFO_ENABLED, id};
   TimerGuard prune_timer_guard(&stat.timer_prune_, stat.enabled(),
                                false /* start_timer */);
@@ -75,18 +210,26 @@ void Worker(const Contractor& contractor, const Config& config,
   TimerGuard branch_timer_guard(&stat.timer_branch_, stat.enabled(),
                                 false /* start_timer */);
 
-  thread_local CdsScopeGuard cds_scope_guard(!main_thread);
-
   bool stack_left_box_first{config.stack_left_box_first()};
 
+  // The deque owned by this worker. Other workers steal boxes from it.
+  WorkStealingDeque<Box>& local_deque{(*deques)[id]};
+
+  IdleBackoff backoff;
+
   // `current_box` always points to the box in the contractor status
   // as a mutable reference.
   Box& current_box{cs->mutable_box()};
 
-  // When this flag is true, we need to pop a box from the stack. Otherwise, it
-  // indicates that we can work with the box inside of the ContractorStatus.
+  // When this flag is true, we need to pop a box from the deques.
+  // Otherwise, it indicates that we can work with the box inside of the
+  // ContractorStatus.
   bool need_to_pop{true};
 
+  // The worker on the main thread, which has the last index, saves
+  // checkpoints.
+  const bool saves_checkpoint{id == static_cast<int>(deques->size()) - 1};
+
   while ((*found_delta_sat == -1) &&
          (number_of_boxes->load(std::memory_order_acquire) > 0)) {
     // Note that 'DREAL_CHECK_INTERRUPT' is only defined in setup.py,
@@ -98,11 +241,33 @@ void Worker(const Contractor& contractor, const Config& config,
     }
 #endif
 
-    // 1. Pick a box from the global stack if needed.
+    // 0. Save a checkpoint or pause while the other worker saves it.
+    if (checkpoint != nullptr &&
+        (saves_checkpoint
+             ? checkpoint->checkpointer->due()
+             : checkpoint->requested.load(std::memory_order_acquire))) {
+      if (!need_to_pop) {
+        // Put the current box back so that it is in the checkpoint.
+        local_deque.push(current_box);
+        need_to_pop = true;
+      }
+      if (saves_checkpoint) {
+        SaveCheckpoint(*deques, *found_delta_sat, checkpoint);
+      } else {
+        PauseForCheckpoint(checkpoint);
+      }
+      continue;
+    }
+
+    // 1. Pick a box from the local deque if needed. When the local
+    // deque is empty, steal one from the other workers.
     if (need_to_pop) {
-      if (!global_stack->pop(current_box)) {
+      if (!local_deque.pop(current_box) &&
+          !Steal(id, deques, &current_box)) {
+        backoff.Idle();
         continue;
       }
+      backoff.Reset();
     }
     need_to_pop = true;
 
@@ -146,7 +311,7 @@ void Worker(const Contractor& contractor, const Config& config,
     // 3.2.3. This box is bigger than delta. Need branching.
     branch_timer_guard.resume();
     if (!ParallelBranch(*evaluation_result, stack_left_box_first, &current_box,
-                        global_stack, number_of_boxes)) {
+                        &local_deque, number_of_boxes)) {
       DREAL_LOG_DEBUG(
           "IcpParallel::Worker() Found that the current box is not "
           "satisfying "
@@ -164,6 +329,9 @@ void Worker(const Contractor& contractor, const Config& config,
     stack_left_box_first = !stack_left_box_first;
     stat.num_branch_++;
   }
+  if (checkpoint != nullptr) {
+    checkpoint->num_stopped.fetch_add(1, std::memory_order_acq_rel);
+  }
 }
 }  // namespace
 
@@ -176,31 +344,67 @@ IcpParallel::IcpParallel(const Config& config)
 bool IcpParallel::CheckSat(const Contractor& contractor,
                            const vector<FormulaEvaluator>& formula_evaluators,
                            ContractorStatus* const cs) {
-  // Initial Prune
-  contractor.Prune(cs);
-  if (cs->box().empty()) {
-    return false;
+  // Resume the search from a checkpoint if there is a frontier saved
+  // for this query.
+  CheckpointState checkpoint;
+  checkpoint.checkpointer = this->checkpointer();
+  optional<vector<FrontierEntry>> resumed_frontier;
+  if (checkpoint.checkpointer != nullptr) {
+    checkpoint.fingerprint =
+        ComputeQueryFingerprint(cs->box(), formula_evaluators);
+    resumed_frontier = checkpoint.checkpointer->TakeResumedFrontier(
+        checkpoint.fingerprint, cs->box());
   }
 
   results_.clear();
   status_vector_.clear();
 
+  const int number_of_jobs = config().number_of_jobs();
+
+  std::deque<Box> initial_boxes;
+  if (resumed_frontier) {
+    AddConservativeExplanation(formula_evaluators, cs->box(), cs);
+    for (FrontierEntry& entry : *resumed_frontier) {
+      initial_boxes.push_back(std::move(entry.first));
+    }
+  } else {
+    // Initial Prune
+    contractor.Prune(cs);
+    if (cs->box().empty()) {
+      return false;
+    }
+    // Split the root box so that every worker has work from the
+    // beginning.
+    if (InitialSplit(contractor, config(), formula_evaluators,
+                     kInitialSplitFactor * number_of_jobs, cs,
+                     &initial_boxes)) {
+      return true;
+    }
+  }
+  if (initial_boxes.empty()) {
+    cs->mutable_box().set_empty();
+    return false;
+  }
+
   // -1 indicates that the process does not find a solution yet. i >= 0
   // indicates that the i-th worker already found a solution.
   atomic<int> found_delta_sat{-1};
-  static CdsInit cds_init{
-      true /* main thread is using lock-free containers. */};
-  Stack<Box> global_stack;
 
-  const int number_of_jobs = config().number_of_jobs();
+  // Each worker owns a deque. A worker pushes and pops boxes at the back
+  // of its own deque and steals boxes from the front of the others'.
+  Deques deques(number_of_jobs);
 
   // Total number of boxes that are either 1) under processing in a worker or 2)
-  // waiting for a worker in the stack. This number goes zero when there is no
+  // waiting for a worker in a deque. This number goes zero when there is no
   // more work to do.
   atomic<int> number_of_boxes{0};
 
-  global_stack.push(cs->box());
-  ++number_of_boxes;
+  // Distribute the initial boxes in a round-robin fashion.
+  for (int i = 0; i < static_cast<int>(initial_boxes.size()); ++i) {
+    deques[i % number_of_jobs].push(std::move(initial_boxes[i]));
+    ++number_of_boxes;
+  }
+  const int last_index{number_of_jobs - 1};
 
   for (int i = 0; i < number_of_jobs; ++i) {
     status_vector_.push_back(*cs);
@@ -209,14 +413,14 @@ bool IcpParallel::CheckSat(const Contractor& contractor,
   for (int i = 0; i < number_of_jobs - 1; ++i) {
     results_.push_back(
         pool_.enqueue(Worker, contractor, config(), formula_evaluators, i,
-                      false /* not main thread */, &global_stack,
-                      &status_vector_[i], &found_delta_sat, &number_of_boxes));
+                      &deques, &status_vector_[i], &found_delta_sat,
+                      &number_of_boxes,
+                      checkpoint.checkpointer ? &checkpoint : nullptr));
   }
 
-  const int last_index{number_of_jobs - 1};
-  Worker(contractor, config(), formula_evaluators, last_index,
-         true /* main thread */, &global_stack, &status_vector_[last_index],
-         &found_delta_sat, &number_of_boxes);
+  Worker(contractor, config(), formula_evaluators, last_index, &deques,
+         &status_vector_[last_index], &found_delta_sat, &number_of_boxes,
+         checkpoint.checkpointer ? &checkpoint : nullptr);
 
   // barrier.
   for (auto&& result : results_) {
@@ -25,10 +25,22 @@
 #include "dreal/solver/config.h"
 #include "dreal/solver/formula_evaluator.h"
 #include "dreal/solver/icp.h"
+#include "dreal/util/work_stealing_deque.h"
 
 namespace dreal {
 
 /// Class for Parallel ICP (Interval Constraint Propagation) algorithm.
+///
+/// Before starting the workers, it splits the root box in a
+/// breadth-first way until there are a few boxes per worker, and
+/// distributes them to the workers in a round-robin fashion.
+///
+/// Each worker owns a WorkStealingDeque of boxes. A worker pushes the
+/// boxes that it creates by branching into its own deque and pops them
+/// in LIFO order, which keeps the search depth-first locally. When its
+/// deque is empty, a worker steals the oldest box from another worker's
+/// deque. If there is nothing to steal, it backs off (yield and then
+/// sleep) instead of spinning.
 class IcpParallel : public Icp {
  public:
   /// Constructs an IcpParallel based on @p config.
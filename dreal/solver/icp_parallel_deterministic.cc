@@ -0,0 +1,229 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/solver/icp_parallel_deterministic.h"
+
+#include <utility>
+
+#include "dreal/solver/icp_stat.h"
+#include "dreal/util/assert.h"
+#include "dreal/util/interrupt.h"
+#include "dreal/util/logging.h"
+
+using std::pair;
+using std::vector;
+
+namespace dreal {
+
+namespace {
+
+using BoxResult = IcpParallelDeterministic::BoxResult;
+
+// Number of boxes that a worker processes in an epoch.
+constexpr int kBoxesPerJob{2};
+
+// Processes the boxes in @p batch which are assigned to the worker @p
+// id, that is, the i-th boxes where i ≡ id (mod number_of_jobs), and
+// stores the results in @p results. Each box in @p batch is paired
+// with the dimension branched to obtain it (-1 for the initial box).
+void Worker(const Contractor& contractor, const Config& config,
+            const vector<FormulaEvaluator>& formula_evaluators, const int id,
+            const int number_of_jobs,
+            const vector<pair<Box, int>>* const batch,
+            vector<BoxResult>* const results, ContractorStatus* const cs) {
+  thread_local IcpStat stat{DREAL_LOG_INFO_ENABLED, id};
+  TimerGuard prune_timer_guard(&stat.timer_prune_, stat.enabled(),
+                               false /* start_timer */);
+  TimerGuard eval_timer_guard(&stat.timer_eval_, stat.enabled(),
+                              false /* start_timer */);
+  TimerGuard branch_timer_guard(&stat.timer_branch_, stat.enabled(),
+                                false /* start_timer */);
+
+  // `current_box` always points to the box in the contractor status
+  // as a mutable reference.
+  Box& current_box{cs->mutable_box()};
+  // `current_branching_point` always points to the branching_point in
+  // the contractor status as a mutable reference.
+  int& current_branching_point{cs->mutable_branching_point()};
+
+  for (int i = id; i < static_cast<int>(batch->size()); i += number_of_jobs) {
+    BoxResult& result{(*results)[i]};
+    result.kind = BoxResult::Kind::Empty;
+    current_box = (*batch)[i].first;
+    current_branching_point = (*batch)[i].second;
+
+    // 1. Prune the current box.
+    prune_timer_guard.resume();
+    contractor.Prune(cs);
+    prune_timer_guard.pause();
+    stat.num_prune_++;
+    if (current_box.empty()) {
+      // 2.1. The box is empty after pruning.
+      continue;
+    }
+
+    // 2.2. The box is non-empty. Check if the box is still feasible
+    // under evaluation and it's small enough.
+    eval_timer_guard.resume();
+    const optional<DynamicBitset> evaluation_result{
+        EvaluateBox(formula_evaluators, current_box, config.precision(), cs)};
+    eval_timer_guard.pause();
+    if (!evaluation_result) {
+      // 2.2.1. We detect that the current box is not a feasible solution.
+      continue;
+    }
+    if (evaluation_result->none()) {
+      // 2.2.2. delta-SAT : We find a box which is smaller enough.
+      result.kind = BoxResult::Kind::DeltaSat;
+      result.box = current_box;
+      continue;
+    }
+
+    // 2.2.3. This box is bigger than delta. Need branching.
+    branch_timer_guard.resume();
+    result.branching_dim = config.brancher()(current_box, *evaluation_result,
+                                             &result.box_left,
+                                             &result.box_right);
+    branch_timer_guard.pause();
+    if (result.branching_dim < 0) {
+      // The box is not bisectable. We treat it as a delta-sat box as
+      // the other ICP algorithms do.
+      result.kind = BoxResult::Kind::DeltaSat;
+      result.box = current_box;
+      continue;
+    }
+    result.kind = BoxResult::Kind::Branched;
+    stat.num_branch_++;
+  }
+}
+
+}  // namespace
+
+IcpParallelDeterministic::IcpParallelDeterministic(const Config& config)
+    : Icp{config}, pool_{static_cast<size_t>(config.number_of_jobs() - 1)} {
+  results_.reserve(config.number_of_jobs() - 1);
+  status_vector_.reserve(config.number_of_jobs());
+}
+
+bool IcpParallelDeterministic::CheckSat(
+    const Contractor& contractor,
+    const vector<FormulaEvaluator>& formula_evaluators,
+    ContractorStatus* const cs) {
+  DREAL_LOG_DEBUG("IcpParallelDeterministic::CheckSat()");
+  const int number_of_jobs = config().number_of_jobs();
+  status_vector_.clear();
+  for (int i = 0; i < number_of_jobs; ++i) {
+    status_vector_.push_back(*cs);
+  }
+
+  // Stack of boxes to explore, paired with their branching points. The
+  // top of the stack is at the back.
+  vector<pair<Box, int>> stack;
+  stack.emplace_back(cs->box(), -1);
+  vector<pair<Box, int>> batch;
+  vector<BoxResult> batch_results;
+  bool stack_left_box_first{config().stack_left_box_first()};
+  // The batch index of the delta-sat box, if found.
+  int found_delta_sat{-1};
+
+  while (!stack.empty() && found_delta_sat < 0) {
+    // Note that 'DREAL_CHECK_INTERRUPT' is only defined in setup.py,
+    // when we build dReal python package.
+#ifdef DREAL_CHECK_INTERRUPT
+    if (g_interrupted) {
+      DREAL_LOG_DEBUG("KeyboardInterrupt(SIGINT) Detected.");
+      throw std::runtime_error("KeyboardInterrupt(SIGINT) Detected.");
+    }
+#endif
+    if (cancelled()) {
+      DREAL_LOG_DEBUG("IcpParallelDeterministic::CheckSat() Cancelled");
+      break;
+    }
+
+    // 1. Take a batch of boxes from the top of the stack. The first box
+    // in the batch is the top of the stack.
+    batch.clear();
+    while (!stack.empty() &&
+           static_cast<int>(batch.size()) < kBoxesPerJob * number_of_jobs) {
+      batch.push_back(std::move(stack.back()));
+      stack.pop_back();
+    }
+    batch_results.resize(batch.size());
+
+    // 2. Process the batch in parallel.
+    results_.clear();
+    for (int i = 0; i < number_of_jobs - 1; ++i) {
+      results_.push_back(pool_.enqueue(
+          Worker, contractor, config(), formula_evaluators, i, number_of_jobs,
+          &batch, &batch_results, &status_vector_[i]));
+    }
+    const int last_index{number_of_jobs - 1};
+    Worker(contractor, config(), formula_evaluators, last_index,
+           number_of_jobs, &batch, &batch_results,
+           &status_vector_[last_index]);
+
+    // barrier.
+    for (auto&& result : results_) {
+      result.get();
+    }
+
+    // 3. Inspect the results in the order of the batch. We push the
+    // sub-boxes of the last box first, so that the sub-boxes of the
+    // first box are explored first in the next epoch.
+    for (int i = 0; i < static_cast<int>(batch_results.size()); ++i) {
+      if (batch_results[i].kind == BoxResult::Kind::DeltaSat) {
+        found_delta_sat = i;
+        break;
+      }
+    }
+    if (found_delta_sat >= 0) {
+      break;
+    }
+    for (int i = static_cast<int>(batch_results.size()) - 1; i >= 0; --i) {
+      BoxResult& result{batch_results[i]};
+      if (result.kind != BoxResult::Kind::Branched) {
+        continue;
+      }
+      if (stack_left_box_first) {
+        stack.emplace_back(std::move(result.box_left), result.branching_dim);
+        stack.emplace_back(std::move(result.box_right), result.branching_dim);
+      } else {
+        stack.emplace_back(std::move(result.box_right), result.branching_dim);
+        stack.emplace_back(std::move(result.box_left), result.branching_dim);
+      }
+      // We alternate between adding-the-left-box-first policy and
+      // adding-the-right-box-first policy.
+      stack_left_box_first = !stack_left_box_first;
+    }
+  }
+
+  // Post-processing: Join all the contractor statuses in a fixed order.
+  for (const auto& cs_i : status_vector_) {
+    cs->InplaceJoin(cs_i);
+  }
+
+  if (found_delta_sat >= 0) {
+    DREAL_LOG_DEBUG(
+        "IcpParallelDeterministic::CheckSat() Found a delta-box:\n{}",
+        batch_results[found_delta_sat].box);
+    cs->mutable_box() = batch_results[found_delta_sat].box;
+    return true;
+  }
+  DREAL_LOG_DEBUG("IcpParallelDeterministic::CheckSat() No solution");
+  cs->mutable_box().set_empty();
+  return false;
+}
+
+}  // namespace dreal
@@ -0,0 +1,74 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <future>
+#include <vector>
+
+#include "ThreadPool/ThreadPool.h"
+
+#include "dreal/contractor/contractor.h"
+#include "dreal/contractor/contractor_status.h"
+#include "dreal/solver/config.h"
+#include "dreal/solver/formula_evaluator.h"
+#include "dreal/solver/icp.h"
+#include "dreal/util/box.h"
+
+namespace dreal {
+
+/// Class for deterministic Parallel ICP (Interval Constraint
+/// Propagation) algorithm.
+///
+/// Unlike IcpParallel, its result (the delta-sat box or the
+/// explanation of UNSAT) does not depend on the timing of threads. It
+/// proceeds in epochs. In each epoch, it takes a batch of boxes from
+/// the top of a single stack and the workers prune, evaluate, and
+/// branch the boxes of the batch in parallel. Each box of the batch is
+/// statically assigned to a worker. After all the workers finish the
+/// epoch, the main thread inspects the results in the order of the
+/// batch: it returns the first delta-sat box if any, otherwise it pushes
+/// the sub-boxes onto the stack in a fixed order.
+class IcpParallelDeterministic : public Icp {
+ public:
+  /// Constructs an IcpParallelDeterministic based on @p config.
+  explicit IcpParallelDeterministic(const Config& config);
+
+  bool CheckSat(const Contractor& contractor,
+                const std::vector<FormulaEvaluator>& formula_evaluators,
+                ContractorStatus* cs) override;
+
+  /// Result of processing a box in an epoch.
+  struct BoxResult {
+    enum class Kind {
+      Empty,     ///< The box is pruned away (or infeasible).
+      DeltaSat,  ///< The box is a delta-sat box (or not bisectable).
+      Branched,  ///< The box is branched into `box_left` and `box_right`.
+    };
+    Kind kind{Kind::Empty};
+    Box box;
+    Box box_left;
+    Box box_right;
+    int branching_dim{-1};
+  };
+
+ private:
+  ThreadPool pool_;
+
+  std::vector<std::future<void>> results_;
+  std::vector<ContractorStatus> status_vector_;
+};
+
+}  // namespace dreal
@@ -15,20 +15,62 @@
 */
 #include "dreal/solver/icp_seq.h"
 
-#include <tuple>
+#include <algorithm>
+#include <cstdint>
 #include <utility>
 
+#include "ThreadPool/ThreadPool.h"
+
 #include "dreal/solver/brancher.h"
 #include "dreal/solver/icp_stat.h"
 #include "dreal/util/interrupt.h"
 #include "dreal/util/logging.h"
 
 using std::pair;
-using std::tie;
 using std::vector;
 
 namespace dreal {
 
+namespace {
+
+// A list of (dimension, interval) pairs. It represents a box as a diff
+// against another box.
+using BoxDiff = vector<pair<int, Box::Interval>>;
+
+// A branch which is not explored yet.
+struct ChoicePoint {
+  // Size of the trail when the branch was created. Undoing the trail
+  // back to this size restores the parent box.
+  int trail_size;
+  // The unexplored sibling box is `diffs[diff_begin, end)` applied to
+  // the parent box. As choice points are visited in LIFO order, its
+  // diff is always at the end of `diffs` when it is visited.
+  int diff_begin;
+  // Branching dimension which produced the sibling box.
+  int branching_point;
+};
+
+// Returns true if @p brancher is BranchLargestFirst. For this brancher,
+// IcpSeq computes the two sub-boxes without copying the current box.
+bool IsBranchLargestFirst(const Config::Brancher& brancher) {
+  using BrancherFunctionPointer =
+      int (*)(const Box&, const DynamicBitset&, Box*, Box*);
+  const BrancherFunctionPointer* const f{
+      brancher.target<BrancherFunctionPointer>()};
+  return f != nullptr && *f == &BranchLargestFirst;
+}
+
+// Appends the dimensions where @p box2 differs from @p box1 to @p diff.
+void AppendDiff(const Box& box1, const Box& box2, BoxDiff* const diff) {
+  for (int i = 0; i < box1.size(); ++i) {
+    if (box1[i] != box2[i]) {
+      diff->emplace_back(i, box2[i]);
+    }
+  }
+}
+
+}  // namespace
+
 IcpSeq::IcpSeq(const Config& config) : Icp{config} {}
 
 bool IcpSeq::CheckSat(const Contractor& contractor,
@@ -36,21 +78,118 @@ bool IcpSeq::CheckSat(const Contractor& contractor,
                       ContractorStatus* const cs) {
   // Use the stacking policy set by the configuration.
   stack_left_box_first_ = config().stack_left_box_first();
-  static IcpStat stat{DREAL_LOG_INFO_ENABLED};
+  // A portfolio runs this function in multiple threads (see
+  // TheorySolver), so each thread keeps its own statistics.
+  thread_local IcpStat stat{DREAL_LOG_INFO_ENABLED,
+                            ThreadPool::get_thread_id()};
   DREAL_LOG_DEBUG("IcpSeq::CheckSat()");
-  // Stack of Box x BranchingPoint.
-  vector<pair<Box, int>> stack;
-  stack.emplace_back(
-      cs->box(),
-      // -1 indicates that the very first box does not come from a branching.
-      -1);
 
   // `current_box` always points to the box in the contractor status
   // as a mutable reference.
   Box& current_box{cs->mutable_box()};
+  Box::IntervalVector& current_values{current_box.mutable_interval_vector()};
   // `current_branching_point` always points to the branching_point in
   // the contractor status as a mutable reference.
   int& current_branching_point{cs->mutable_branching_point()};
+  // -1 indicates that the very first box does not come from a branching.
+  current_branching_point = -1;
+
+  // We keep only one box, `current_box`, during the search. Instead of
+  // storing copies of boxes in a stack, we record the old value of a
+  // dimension in `trail` whenever we update the dimension, and store an
+  // unexplored sibling box as a diff against its parent box.
+  BoxDiff trail;
+  BoxDiff diffs;
+  vector<ChoicePoint> choice_points;
+  // A copy of `current_box` before pruning. Its memory is reused across
+  // iterations.
+  Box::IntervalVector saved_values{current_values};
+  const bool branch_largest_first{IsBranchLargestFirst(config().brancher())};
+
+  // Resume the search from a checkpoint if there is a frontier saved
+  // for this query. The frontier is ordered from the bottom of the
+  // stack of choice points to the current box. Each choice point keeps
+  // its sibling box as a diff against the initial box, which is
+  // restored by undoing the whole trail.
+  Checkpointer* const checkpointer{this->checkpointer()};
+  std::uint64_t fingerprint{0};
+  if (checkpointer != nullptr) {
+    fingerprint = ComputeQueryFingerprint(current_box, formula_evaluators);
+    const optional<vector<FrontierEntry>> frontier{
+        checkpointer->TakeResumedFrontier(fingerprint, current_box)};
+    if (frontier) {
+      AddConservativeExplanation(formula_evaluators, current_box, cs);
+      if (frontier->empty()) {
+        current_box.set_empty();
+        return false;
+      }
+      for (auto it = frontier->begin(); it != frontier->end() - 1; ++it) {
+        choice_points.push_back(ChoicePoint{0, static_cast<int>(diffs.size()),
+                                            it->second});
+        AppendDiff(current_box, it->first, &diffs);
+      }
+      const Box& top{frontier->back().first};
+      for (int i = 0; i < current_box.size(); ++i) {
+        if (current_values[i] != top[i]) {
+          trail.emplace_back(i, current_values[i]);
+          current_values[i] = top[i];
+        }
+      }
+      current_branching_point = frontier->back().second;
+    }
+  }
+
+  // Saves the unexplored boxes, that is, the siblings in the choice
+  // points and the current box, to the checkpoint.
+  auto save_checkpoint = [&]() {
+    vector<FrontierEntry> frontier;
+    frontier.reserve(choice_points.size() + 1);
+    // Walk the choice points from the top, undoing the trail on a copy
+    // of the current box to restore the parent box of each one.
+    Box parent{current_box};
+    Box::IntervalVector& parent_values{parent.mutable_interval_vector()};
+    int trail_index{static_cast<int>(trail.size())};
+    int diff_end{static_cast<int>(diffs.size())};
+    for (auto it = choice_points.rbegin(); it != choice_points.rend(); ++it) {
+      while (trail_index > it->trail_size) {
+        --trail_index;
+        parent_values[trail[trail_index].first] = trail[trail_index].second;
+      }
+      Box sibling{parent};
+      for (int i = it->diff_begin; i < diff_end; ++i) {
+        sibling[diffs[i].first] = diffs[i].second;
+      }
+      frontier.emplace_back(std::move(sibling), it->branching_point);
+      diff_end = it->diff_begin;
+    }
+    std::reverse(frontier.begin(), frontier.end());
+    frontier.emplace_back(current_box, current_branching_point);
+    checkpointer->Save(fingerprint, frontier);
+  };
+
+  // Updates `current_box` to the next unexplored box. Returns false if
+  // there is no such box.
+  auto backtrack = [&]() {
+    if (choice_points.empty()) {
+      return false;
+    }
+    const ChoicePoint choice_point{choice_points.back()};
+    choice_points.pop_back();
+    // Restore the parent box.
+    while (static_cast<int>(trail.size()) > choice_point.trail_size) {
+      current_values[trail.back().first] = trail.back().second;
+      trail.pop_back();
+    }
+    // Move to the sibling box.
+    for (auto it = diffs.begin() + choice_point.diff_begin; it != diffs.end();
+         ++it) {
+      trail.emplace_back(it->first, current_values[it->first]);
+      current_values[it->first] = it->second;
+    }
+    diffs.erase(diffs.begin() + choice_point.diff_begin, diffs.end());
+    current_branching_point = choice_point.branching_point;
+    return true;
+  };
 
   TimerGuard prune_timer_guard(&stat.timer_prune_, stat.enabled(),
                                false /* start_timer */);
@@ -59,7 +198,9 @@ bool IcpSeq::CheckSat(const Contractor& contractor,
   TimerGuard branch_timer_guard(&stat.timer_branch_, stat.enabled(),
                                 false /* start_timer */);
 
-  while (!stack.empty()) {
+  // It becomes false when there is no box to explore.
+  bool has_box{true};
+  while (has_box) {
     DREAL_LOG_DEBUG("IcpSeq::CheckSat() Loop Head");
 
     // Note that 'DREAL_CHECK_INTERRUPT' is only defined in setup.py,
@@ -70,10 +211,17 @@ bool IcpSeq::CheckSat(const Contractor& contractor,
       throw std::runtime_error("KeyboardInterrupt(SIGINT) Detected.");
     }
 #endif
+    if (cancelled()) {
+      DREAL_LOG_DEBUG("IcpSeq::CheckSat() Cancelled");
+      current_box.set_empty();
+      return false;
+    }
+    if (checkpointer != nullptr && checkpointer->due()) {
+      save_checkpoint();
+    }
 
-    // 1. Pop the current box from the stack
-    tie(current_box, current_branching_point) = stack.back();
-    stack.pop_back();
+    // 1. Save the current box so that we can undo the pruning.
+    saved_values = current_values;
 
     // 2. Prune the current box.
     DREAL_LOG_TRACE("IcpSeq::CheckSat() Current Box:\n{}", current_box);
@@ -87,8 +235,17 @@ bool IcpSeq::CheckSat(const Contractor& contractor,
     if (current_box.empty()) {
       // 3.1. The box is empty after pruning.
       DREAL_LOG_DEBUG("IcpSeq::CheckSat() Box is empty after pruning");
+      current_values = saved_values;
+      has_box = backtrack();
       continue;
     }
+    // Record the dimensions updated by the pruning.
+    for (int i = 0; i < current_box.size(); ++i) {
+      if (current_values[i] != saved_values[i]) {
+        trail.emplace_back(i, saved_values[i]);
+      }
+    }
+
     // 3.2. The box is non-empty. Check if the box is still feasible
     // under evaluation and it's small enough.
     eval_timer_guard.resume();
@@ -101,6 +258,10 @@ bool IcpSeq::CheckSat(const Contractor& contractor,
           "evaluation:\n{}",
           current_box);
       eval_timer_guard.pause();
+      // EvaluateBox has emptied the box. Note that the trail entries for
+      // the pruning above restore `saved_values` as well.
+      current_values = saved_values;
+      has_box = backtrack();
       continue;
     }
     if (evaluation_result->none()) {
@@ -110,27 +271,60 @@ bool IcpSeq::CheckSat(const Contractor& contractor,
     }
     eval_timer_guard.pause();
 
-    // 3.2.3. This box is bigger than delta. Need branching.
+    // 3.2.3. This box is bigger than delta. Need branching. We move to
+    // one sub-box and keep the other one as a choice point. Note that
+    // the last box pushed to the stack was explored first when we kept
+    // a stack of boxes. That is, we explore the right box first if
+    // `stack_left_box_first_` is true.
     branch_timer_guard.resume();
-    Box box_left;
-    Box box_right;
-    const int branching_dim = config().brancher()(
-        current_box, *evaluation_result, &box_left, &box_right);
-    if (branching_dim >= 0) {
-      if (stack_left_box_first_) {
-        stack.emplace_back(box_left, branching_dim);
-        stack.emplace_back(box_right, branching_dim);
-      } else {
-        stack.emplace_back(box_right, branching_dim);
-        stack.emplace_back(box_left, branching_dim);
+    const ChoicePoint choice_point{static_cast<int>(trail.size()),
+                                   static_cast<int>(diffs.size()), -1};
+    int branching_dim{-1};
+    if (branch_largest_first) {
+      branching_dim = FindMaxDiam(current_box, *evaluation_result).second;
+      if (branching_dim >= 0) {
+        const pair<Box::Interval, Box::Interval> bisected_intervals{
+            current_box.bisect_interval(branching_dim)};
+        DREAL_LOG_DEBUG("IcpSeq::CheckSat() Branch {} into {} and {}",
+                        current_box.variable(branching_dim),
+                        bisected_intervals.first, bisected_intervals.second);
+        const Box::Interval& first{stack_left_box_first_
+                                       ? bisected_intervals.second
+                                       : bisected_intervals.first};
+        const Box::Interval& second{stack_left_box_first_
+                                        ? bisected_intervals.first
+                                        : bisected_intervals.second};
+        diffs.emplace_back(branching_dim, second);
+        trail.emplace_back(branching_dim, current_values[branching_dim]);
+        current_values[branching_dim] = first;
       }
     } else {
+      Box box_left;
+      Box box_right;
+      branching_dim = config().brancher()(current_box, *evaluation_result,
+                                          &box_left, &box_right);
+      if (branching_dim >= 0) {
+        const Box& first{stack_left_box_first_ ? box_right : box_left};
+        const Box& second{stack_left_box_first_ ? box_left : box_right};
+        AppendDiff(current_box, second, &diffs);
+        for (int i = 0; i < current_box.size(); ++i) {
+          if (current_values[i] != first[i]) {
+            trail.emplace_back(i, current_values[i]);
+            current_values[i] = first[i];
+          }
+        }
+      }
+    }
+    if (branching_dim < 0) {
       DREAL_LOG_DEBUG(
           "IcpSeq::CheckSat() Found that the current box is not satisfying "
           "delta-condition but it's not bisectable.:\n{}",
           current_box);
       return true;
     }
+    choice_points.push_back(choice_point);
+    choice_points.back().branching_point = branching_dim;
+    current_branching_point = branching_dim;
     branch_timer_guard.pause();
 
     // We alternate between adding-the-left-box-first policy and
@@ -139,6 +333,7 @@ bool IcpSeq::CheckSat(const Contractor& contractor,
     stat.num_branch_++;
   }
   DREAL_LOG_DEBUG("IcpSeq::CheckSat() No solution");
+  current_box.set_empty();
   return false;
 }
 }  // namespace dreal
@@ -36,9 +36,10 @@ class IcpSeq : public Icp {
                 ContractorStatus* cs) override;
 
  private:
-  // If `stack_left_box_first_` is true, we add the left box from the
-  // branching operation to the `stack`. Otherwise, we add the right
-  // box first.
+  // If `stack_left_box_first_` is true, we keep the left box from the
+  // branching operation as a choice point and explore the right box
+  // first, as if the left box were pushed to a stack first. Otherwise,
+  // we explore the left box first.
   bool stack_left_box_first_{false};
 };
 
@@ -23,8 +23,8 @@
 namespace dreal {
 
 /// A class to show statistics information at destruction. We have a
-/// static instance in Icp::CheckSat() to keep track of the numbers of
-/// branching and pruning operations.
+/// thread_local instance in Icp::CheckSat() to keep track of the
+/// numbers of branching and pruning operations.
 class IcpStat : public Stat {
  public:
   explicit IcpStat(const bool enabled, int id = 0)
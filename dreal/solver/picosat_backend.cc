@@ -0,0 +1,83 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/solver/picosat_backend.h"
+
+#include "dreal/util/assert.h"
+#include "dreal/util/exception.h"
+#include "dreal/util/logging.h"
+
+namespace dreal {
+
+PicosatBackend::PicosatBackend(const Config& config) : sat_{picosat_init()} {
+  if (config.unsat_core()) {
+    picosat_enable_trace_generation(sat_);
+  }
+  // Enable partial checks via picosat_deref_partial. See the call-site in
+  // PicosatBackend::Value().
+  picosat_save_original_clauses(sat_);
+  if (config.random_seed() != 0) {
+    picosat_set_seed(sat_, config.random_seed());
+    DREAL_LOG_DEBUG("PicosatBackend::Set Random Seed {}",
+                    config.random_seed());
+  }
+  picosat_set_global_default_phase(
+      sat_, static_cast<int>(config.sat_default_phase()));
+  DREAL_LOG_DEBUG("PicosatBackend::Set Default Phase {}",
+                  config.sat_default_phase());
+}
+
+PicosatBackend::~PicosatBackend() { picosat_reset(sat_); }
+
+int PicosatBackend::NewVar() { return picosat_inc_max_var(sat_); }
+
+void PicosatBackend::Add(const int lit) { picosat_add(sat_, lit); }
+
+bool PicosatBackend::Solve() {
+  const int ret{picosat_sat(sat_, -1 /* decision_limit == no limit */)};
+  if (ret == PICOSAT_SATISFIABLE) {
+    return true;
+  } else if (ret == PICOSAT_UNSATISFIABLE) {
+    return false;
+  } else {
+    DREAL_ASSERT(ret == PICOSAT_UNKNOWN);
+    DREAL_LOG_CRITICAL("PICOSAT returns PICOSAT_UNKNOWN.");
+    throw DREAL_RUNTIME_ERROR("PICOSAT returns PICOSAT_UNKNOWN.");
+  }
+}
+
+int PicosatBackend::Value(const int var) const {
+  return has_picosat_pop_used_ ? picosat_deref(sat_, var)
+                               : picosat_deref_partial(sat_, var);
+}
+
+void PicosatBackend::Push() { picosat_push(sat_); }
+
+void PicosatBackend::Pop() {
+  picosat_pop(sat_);
+  has_picosat_pop_used_ = true;
+}
+
+void PicosatBackend::WriteClausalCore(FILE* const file) {
+  picosat_write_clausal_core(sat_, file);
+}
+
+int PicosatBackend::num_vars() const { return picosat_variables(sat_); }
+
+int PicosatBackend::num_clauses() const {
+  return picosat_added_original_clauses(sat_);
+}
+
+}  // namespace dreal
@@ -0,0 +1,57 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <cstdio>
+
+#include "./picosat.h"
+
+#include "dreal/solver/config.h"
+#include "dreal/solver/sat_backend.h"
+
+namespace dreal {
+
+/// SatBackend using PicoSAT.
+class PicosatBackend : public SatBackend {
+ public:
+  /// Constructs a PicoSAT backend using the SAT options in @p config.
+  explicit PicosatBackend(const Config& config);
+
+  ~PicosatBackend() override;
+
+  int NewVar() override;
+  void Add(int lit) override;
+  bool Solve() override;
+  int Value(int var) const override;
+  void Push() override;
+  void Pop() override;
+  void WriteClausalCore(FILE* file) override;
+  int num_vars() const override;
+  int num_clauses() const override;
+
+ private:
+  // Pointer to the PicoSat solver.
+  PicoSAT* const sat_{};
+
+  /// @note We found an issue when picosat_deref_partial is used with
+  /// picosat_pop. When this variable is true, we use `picosat_deref`
+  /// instead.
+  ///
+  /// TODO(soonho): Remove this hack when it's not needed.
+  bool has_picosat_pop_used_{false};
+};
+
+}  // namespace dreal
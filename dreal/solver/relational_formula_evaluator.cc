@@ -24,8 +24,6 @@ namespace dreal {
 
 using std::ostream;
 
-namespace {
-
 RelationalOperator GetRelationalOperator(const Formula& f) {
   DREAL_ASSERT(is_relational(f) || is_negation(f));
   switch (f.get_kind()) {
@@ -66,7 +64,6 @@ RelationalOperator GetRelationalOperator(const Formula& f) {
   DREAL_UNREACHABLE();
 }
 
-// Decomposes a formula `f = e₁ rop e₂` into `(rop, e₁ - e₂)`.
 Expression ExtractExpression(const Formula& f) {
   if (is_relational(f)) {
     return get_lhs_expression(f) - get_rhs_expression(f);
@@ -75,7 +72,6 @@ Expression ExtractExpression(const Formula& f) {
     return ExtractExpression(get_operand(f));
   }
 }
-}  // namespace
 
 RelationalFormulaEvaluator::RelationalFormulaEvaluator(Formula f)
     : FormulaEvaluatorCell{std::move(f)},
@@ -88,8 +84,12 @@ RelationalFormulaEvaluator::~RelationalFormulaEvaluator() {
 
 FormulaEvaluationResult RelationalFormulaEvaluator::operator()(
     const Box& box) const {
-  const Box::Interval evaluation{expression_evaluator_(box)};
-  switch (op_) {
+  return EvaluateRelationalConstraint(op_, expression_evaluator_(box));
+}
+
+FormulaEvaluationResult EvaluateRelationalConstraint(
+    const RelationalOperator op, const Box::Interval& evaluation) {
+  switch (op) {
     case RelationalOperator::EQ: {
       // e₁ - e₂ = 0
       // VALID if e₁ - e₂ == [0, 0].
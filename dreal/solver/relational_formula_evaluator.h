@@ -59,4 +59,17 @@ class RelationalFormulaEvaluator : public FormulaEvaluatorCell {
   const RelationalOperator op_{};
   const ExpressionEvaluator expression_evaluator_;
 };
+
+/// Returns the relational operator `rop` of @p f = `e₁ rop e₂`. If @p
+/// f is a negation, the operator is negated.
+RelationalOperator GetRelationalOperator(const Formula& f);
+
+/// Decomposes a formula @p f = `e₁ rop e₂` (or its negation) and
+/// returns `e₁ - e₂`.
+Expression ExtractExpression(const Formula& f);
+
+/// Classifies the constraint `e rop 0` given the interval evaluation
+/// of `e` over a box. @p op is `rop`.
+FormulaEvaluationResult EvaluateRelationalConstraint(
+    RelationalOperator op, const Box::Interval& evaluation);
 }  // namespace dreal
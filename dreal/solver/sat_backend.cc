@@ -0,0 +1,46 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/solver/sat_backend.h"
+
+#include "dreal/solver/cdcl_backend.h"
+#include "dreal/solver/picosat_backend.h"
+#include "dreal/util/exception.h"
+#include "dreal/util/logging.h"
+
+using std::make_unique;
+using std::unique_ptr;
+
+namespace dreal {
+
+SatBackend::~SatBackend() = default;
+
+unique_ptr<SatBackend> make_sat_backend(const Config& config) {
+  switch (config.sat_backend()) {
+    case Config::SatBackend::PicoSat:
+      return make_unique<PicosatBackend>(config);
+    case Config::SatBackend::Cdcl:
+      if (config.unsat_core()) {
+        DREAL_LOG_WARN(
+            "make_sat_backend: The CDCL backend does not support unsat "
+            "cores. Use PicoSAT instead.");
+        return make_unique<PicosatBackend>(config);
+      }
+      return make_unique<CdclBackend>(config);
+  }
+  DREAL_UNREACHABLE();
+}
+
+}  // namespace dreal
@@ -0,0 +1,97 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <cstdio>
+#include <memory>
+
+#include "dreal/solver/config.h"
+
+namespace dreal {
+
+/// Abstract propositional SAT solver used by SatSolver.
+///
+/// It follows the DIMACS conventions: a variable is a positive integer
+/// and a literal is a variable or its negation. A clause is added
+/// literal by literal and terminated by 0.
+///
+/// Push and Pop create and discard a scope. A clause added in a scope
+/// is removed at the matching Pop. A backend may allocate variables of
+/// its own to implement scopes. SatSolver ignores them since they have
+/// no corresponding symbolic variables.
+class SatBackend {
+ public:
+  SatBackend() = default;
+
+  /// Deleted copy constructor.
+  SatBackend(const SatBackend&) = delete;
+
+  /// Deleted move constructor.
+  SatBackend(SatBackend&&) = delete;
+
+  /// Deleted copy-assignment operator.
+  SatBackend& operator=(const SatBackend&) = delete;
+
+  /// Deleted move-assignment operator.
+  SatBackend& operator=(SatBackend&&) = delete;
+
+  virtual ~SatBackend();
+
+  /// Creates a new variable and returns it.
+  virtual int NewVar() = 0;
+
+  /// Adds a literal @p lit to the current clause. If @p lit is 0, it
+  /// adds the current clause to the solver and starts a new one.
+  virtual void Add(int lit) = 0;
+
+  /// Checks the satisfiability of the added clauses.
+  ///
+  /// @returns true if they are satisfiable and false otherwise.
+  /// @throws std::runtime_error if the solver fails to decide it.
+  virtual bool Solve() = 0;
+
+  /// Returns the value of the variable @p var in the model found by
+  /// the last call of Solve, which returned true. It returns 1 (true)
+  /// or -1 (false), or 0 if @p var is not needed to satisfy the
+  /// clauses.
+  virtual int Value(int var) const = 0;
+
+  /// Creates a new scope.
+  virtual void Push() = 0;
+
+  /// Removes the clauses added since the matching Push.
+  virtual void Pop() = 0;
+
+  /// Writes the clauses used in the last proof of unsatisfiability to
+  /// @p file in DIMACS format.
+  ///
+  /// @throws std::runtime_error if the backend does not support it.
+  virtual void WriteClausalCore(FILE* file) = 0;
+
+  /// Returns the number of variables.
+  virtual int num_vars() const = 0;
+
+  /// Returns the number of added clauses.
+  virtual int num_clauses() const = 0;
+};
+
+/// Makes the SAT backend selected by `config.sat_backend()`.
+///
+/// @note Only PicoSAT can compute unsat cores. If `config.unsat_core()`
+/// is set, it uses PicoSAT regardless of the selected backend.
+std::unique_ptr<SatBackend> make_sat_backend(const Config& config);
+
+}  // namespace dreal
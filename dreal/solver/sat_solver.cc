@@ -31,32 +31,19 @@ namespace dreal {
 
 using std::cout;
 using std::set;
+using std::string;
 using std::vector;
 
 SatSolver::SatSolver(const Config& config)
-    : sat_{picosat_init()}, compute_unsat_core_{config.unsat_core()} {
-  if (compute_unsat_core_) {
-    picosat_enable_trace_generation(sat_);
-  }
-  // Enable partial checks via picosat_deref_partial. See the call-site in
-  // SatSolver::CheckSat().
-  picosat_save_original_clauses(sat_);
-  if (config.random_seed() != 0) {
-    picosat_set_seed(sat_, config.random_seed());
-    DREAL_LOG_DEBUG("SatSolver::Set Random Seed {}", config.random_seed());
-  }
-  picosat_set_global_default_phase(
-      sat_, static_cast<int>(config.sat_default_phase()));
-  DREAL_LOG_DEBUG("SatSolver::Set Default Phase {}",
-                  config.sat_default_phase());
-}
+    : sat_{make_sat_backend(config)},
+      compute_unsat_core_{config.unsat_core()} {}
 
 SatSolver::SatSolver(const Config& config, const vector<Formula>& clauses)
     : SatSolver{config} {
   AddClauses(clauses);
 }
 
-SatSolver::~SatSolver() { picosat_reset(sat_); }
+SatSolver::~SatSolver() = default;
 
 void SatSolver::AddFormula(const Formula& f) {
   DREAL_LOG_DEBUG("SatSolver::AddFormula({})", f);
@@ -81,7 +68,7 @@ void SatSolver::AddLearnedClause(const set<Formula>& formulas) {
   for (const Formula& f : formulas) {
     AddLiteral(!predicate_abstractor_.Convert(f));
   }
-  picosat_add(sat_, 0);
+  sat_->Add(0);
 }
 
 void SatSolver::AddClauses(const vector<Formula>& formulas) {
@@ -127,30 +114,27 @@ class SatSolverStat : public Stat {
 optional<SatSolver::Model> SatSolver::CheckSat() {
   static SatSolverStat stat{DREAL_LOG_INFO_ENABLED};
   DREAL_LOG_DEBUG("SatSolver::CheckSat(#vars = {}, #clauses = {})",
-                  picosat_variables(sat_),
-                  picosat_added_original_clauses(sat_));
+                  sat_->num_vars(), sat_->num_clauses());
   stat.num_check_sat_++;
   // Call SAT solver.
   TimerGuard check_sat_timer_guard(&stat.timer_check_sat_,
                                    DREAL_LOG_INFO_ENABLED);
-  const int ret{picosat_sat(sat_, -1 /* decision_limit == no limit */)};
+  const bool sat{sat_->Solve()};
   check_sat_timer_guard.pause();
 
   Model model;
-  if (ret == PICOSAT_SATISFIABLE) {
+  if (sat) {
     // SAT Case.
     const auto& var_to_formula_map = predicate_abstractor_.var_to_formula_map();
-    for (int i = 1; i <= picosat_variables(sat_); ++i) {
-      const int model_i{has_picosat_pop_used_ ? picosat_deref(sat_, i)
-                                              : picosat_deref_partial(sat_, i)};
+    for (int i = 1; i <= sat_->num_vars(); ++i) {
+      const int model_i{sat_->Value(i)};
       if (model_i == 0) {
         continue;
       }
       const auto it_var = to_sym_var_.find(i);
       if (it_var == to_sym_var_.end()) {
         // There is no symbolic::Variable corresponding to this
-        // picosat variable (int). This could be because of
-        // picosat_push/pop.
+        // SAT variable (int). This could be because of Push/Pop.
         continue;
       }
       const Variable& var{it_var->second};
@@ -174,17 +158,13 @@ optional<SatSolver::Model> SatSolver::CheckSat() {
     }
     DREAL_LOG_DEBUG("SatSolver::CheckSat() Found a model.");
     return model;
-  } else if (ret == PICOSAT_UNSATISFIABLE) {
+  } else {
     DREAL_LOG_DEBUG("SatSolver::CheckSat() No solution.");
     if (compute_unsat_core_) {
       unsat_core_ = ExtractUnsatCore();
     }
     // UNSAT Case.
     return {};
-  } else {
-    DREAL_ASSERT(ret == PICOSAT_UNKNOWN);
-    DREAL_LOG_CRITICAL("PICOSAT returns PICOSAT_UNKNOWN.");
-    throw DREAL_RUNTIME_ERROR("PICOSAT returns PICOSAT_UNKNOWN.");
   }
 }
 
@@ -193,14 +173,13 @@ void SatSolver::Pop() {
   tseitin_variables_.pop();
   to_sym_var_.pop();
   to_sat_var_.pop();
-  picosat_pop(sat_);
-  has_picosat_pop_used_ = true;
+  sat_->Pop();
   // unsat_core_ = Formula::True();
 }
 
 void SatSolver::Push() {
   DREAL_LOG_DEBUG("SatSolver::Push()");
-  picosat_push(sat_);
+  sat_->Push();
 
   // // Create a variable for the context variable sat_var
   // const int sat_var{picosat_push(sat_)};
@@ -223,14 +202,14 @@ void SatSolver::AddLiteral(const Formula& f) {
     const Variable& var{get_variable(f)};
     DREAL_ASSERT(var.get_type() == Variable::Type::BOOLEAN);
     // Add l = b
-    picosat_add(sat_, to_sat_var_[var.get_id()]);
+    sat_->Add(to_sat_var_[var.get_id()]);
   } else {
     // f = ¬b
     DREAL_ASSERT(is_negation(f) && is_variable(get_operand(f)));
     const Variable& var{get_variable(get_operand(f))};
     DREAL_ASSERT(var.get_type() == Variable::Type::BOOLEAN);
     // Add l = ¬b
-    picosat_add(sat_, -to_sat_var_[var.get_id()]);
+    sat_->Add(-to_sat_var_[var.get_id()]);
   }
 }
 
@@ -244,7 +223,7 @@ void SatSolver::DoAddClause(const Formula& f) {
     // f = b or f = ¬b.
     AddLiteral(f);
   }
-  picosat_add(sat_, 0);
+  sat_->Add(0);
 }
 
 void SatSolver::MakeSatVar(const Variable& var) {
@@ -254,7 +233,7 @@ void SatSolver::MakeSatVar(const Variable& var) {
     return;
   }
   // It's not in the maps, let's make one and add it.
-  const int sat_var{picosat_inc_max_var(sat_)};
+  const int sat_var{sat_->NewVar()};
   to_sat_var_.insert(var.get_id(), sat_var);
   to_sym_var_.insert(sat_var, var);
   DREAL_LOG_DEBUG("SatSolver::MakeSatVar({} ↦ {})", var, sat_var);
@@ -273,7 +252,7 @@ const Formula SatSolver::ExtractUnsatCore() {
   // FILE* core_file;
   FILE* core_file = fopen("core.dimacs", "w");
 
-  picosat_write_clausal_core(sat_, core_file);
+  sat_->WriteClausalCore(core_file);
 
   fclose(core_file);
 
@@ -17,12 +17,12 @@
 
 #include <memory>
 #include <set>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
-#include "./picosat.h"
-
 #include "dreal/solver/config.h"
+#include "dreal/solver/sat_backend.h"
 #include "dreal/symbolic/symbolic.h"
 #include "dreal/util/optional.h"
 #include "dreal/util/predicate_abstractor.h"
@@ -88,6 +88,13 @@ class SatSolver {
     return predicate_abstractor_[var];
   }
 
+  /// Returns the map from a Boolean variable to the theory literal
+  /// which it abstracts.
+  const std::unordered_map<Variable, Formula, hash_value<Variable>>&
+  theory_literals() const {
+    return predicate_abstractor_.var_to_formula_map();
+  }
+
   // Get the stored unsat core.
   const Formula& get_unsat_core() const { return unsat_core_; }
 
@@ -122,28 +129,21 @@ class SatSolver {
 
   // Member variables
   // ----------------
-  // Pointer to the PicoSat solver.
-  PicoSAT* const sat_{};
+  // The SAT solver selected by `Config::sat_backend()`.
+  const std::unique_ptr<SatBackend> sat_;
   TseitinCnfizer cnfizer_;
   PredicateAbstractor predicate_abstractor_;
 
-  // Map symbolic::Variable → int (Variable type in PicoSat).
+  // Map symbolic::Variable → int (Variable type in SatBackend).
   ScopedUnorderedMap<Variable::Id, int> to_sat_var_;
 
-  // Map int (Variable type in PicoSat) → symbolic::Variable.
+  // Map int (Variable type in SatBackend) → symbolic::Variable.
   ScopedUnorderedMap<int, Variable> to_sym_var_;
 
   /// Set of temporary Boolean variables introduced by Tseitin
   /// transformations.
   ScopedUnorderedSet<Variable::Id> tseitin_variables_;
 
-  /// @note We found an issue when picosat_deref_partial is used with
-  /// picosat_pop. When this variable is true, we use `picosat_deref`
-  /// instead.
-  ///
-  /// TODO(soonho): Remove this hack when it's not needed.
-  bool has_picosat_pop_used_{false};
-
   // The unsat core formula.
   Formula unsat_core_;
 
@@ -0,0 +1,126 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/solver/batch_evaluator.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dreal/solver/icp.h"
+
+namespace dreal {
+namespace {
+
+using std::vector;
+
+class BatchEvaluatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    box_.Add(x_);
+    box_.Add(y_);
+    box_.Add(z_);
+  }
+
+  // Evaluates @p formulas over @p boxes with a BatchEvaluator and
+  // checks that the results are the same as the ones from
+  // FormulaEvaluators, up to one ulp.
+  void CheckConsistency(const vector<Formula>& formulas,
+                        const vector<Box>& boxes) {
+    vector<FormulaEvaluator> formula_evaluators;
+    for (const Formula& f : formulas) {
+      formula_evaluators.push_back(make_relational_formula_evaluator(f));
+    }
+    const BatchEvaluator evaluator{formula_evaluators, box_};
+    vector<const Box*> box_ptrs;
+    for (const Box& box : boxes) {
+      box_ptrs.push_back(&box);
+    }
+    const vector<vector<FormulaEvaluationResult>> results{
+        evaluator(box_ptrs)};
+    ASSERT_EQ(results.size(), boxes.size());
+    for (size_t j = 0; j < boxes.size(); ++j) {
+      ASSERT_EQ(results[j].size(), formulas.size());
+      for (size_t i = 0; i < formulas.size(); ++i) {
+        const FormulaEvaluationResult expected{
+            formula_evaluators[i](boxes[j])};
+        const Box::Interval& actual{results[j][i].evaluation()};
+        EXPECT_EQ(results[j][i].type(), expected.type()) << formulas[i];
+        EXPECT_TRUE(expected.evaluation().is_subset(actual)) << formulas[i];
+        EXPECT_NEAR(actual.lb(), expected.evaluation().lb(), 1e-12);
+        EXPECT_NEAR(actual.ub(), expected.evaluation().ub(), 1e-12);
+      }
+    }
+  }
+
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  const Variable z_{"z"};
+  Box box_;
+};
+
+TEST_F(BatchEvaluatorTest, Consistency) {
+  const vector<Formula> formulas{
+      x_ + y_ > z_,
+      x_ * y_ - 2 * z_ <= 3,
+      sin(x_) + cos(y_) == z_,
+      !(x_ - y_ >= 0.5),
+      x_ != exp(y_),
+  };
+  vector<Box> boxes(3, box_);
+  boxes[0][x_] = Box::Interval(0.0, 1.0);
+  boxes[0][y_] = Box::Interval(-1.0, 1.0);
+  boxes[0][z_] = Box::Interval(2.0, 3.0);
+  boxes[1][x_] = Box::Interval(-3.5, -1.25);
+  boxes[1][y_] = Box::Interval(0.1, 0.2);
+  boxes[1][z_] = Box::Interval(-1.0, 1.0);
+  boxes[2][x_] = Box::Interval(5.0);
+  boxes[2][y_] = Box::Interval(2.0);
+  boxes[2][z_] = Box::Interval(1.0, 10.0);
+  CheckConsistency(formulas, boxes);
+}
+
+TEST_F(BatchEvaluatorTest, EvaluateBoxes) {
+  vector<FormulaEvaluator> formula_evaluators{
+      make_relational_formula_evaluator(x_ + y_ <= 1),
+      make_relational_formula_evaluator(x_ * x_ >= 0.25),
+  };
+  const BatchEvaluator evaluator{formula_evaluators, box_};
+  Box unsat{box_};
+  unsat[x_] = Box::Interval(1.0, 2.0);
+  unsat[y_] = Box::Interval(1.0, 2.0);
+  Box delta_sat{box_};
+  delta_sat[x_] = Box::Interval(0.5, 0.5 + 1e-5);
+  delta_sat[y_] = Box::Interval(0.0, 1e-5);
+  Box unknown{box_};
+  unknown[x_] = Box::Interval(0.0, 1.0);
+  unknown[y_] = Box::Interval(-2.0, 2.0);
+
+  ContractorStatus cs{box_};
+  const vector<optional<DynamicBitset>> results{
+      EvaluateBoxes(evaluator, {&unsat, &delta_sat, &unknown}, 1e-3, &cs)};
+  ASSERT_EQ(results.size(), 3);
+  EXPECT_FALSE(results[0]);
+  ASSERT_TRUE(results[1]);
+  EXPECT_TRUE(results[1]->none());
+  ASSERT_TRUE(results[2]);
+  EXPECT_TRUE((*results[2])[unknown.index(x_)]);
+  EXPECT_TRUE((*results[2])[unknown.index(y_)]);
+  // EvaluateBoxes does not empty the box in `cs`.
+  EXPECT_FALSE(cs.box().empty());
+}
+
+}  // namespace
+}  // namespace dreal
@@ -0,0 +1,228 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/solver/cdcl_backend.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dreal/solver/config.h"
+#include "dreal/solver/picosat_backend.h"
+
+namespace dreal {
+namespace {
+
+using std::vector;
+
+// Returns true if the model of @p sat satisfies @p clauses. Note that
+// a tautology is satisfied by any partial model.
+bool Satisfies(const SatBackend& sat, const vector<vector<int>>& clauses) {
+  for (const vector<int>& clause : clauses) {
+    bool satisfied{false};
+    for (const int lit : clause) {
+      const int value{sat.Value(lit > 0 ? lit : -lit)};
+      satisfied = satisfied || (lit > 0 ? value == 1 : value == -1) ||
+                  std::count(clause.begin(), clause.end(), -lit) > 0;
+    }
+    if (!satisfied) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Adds @p n random 3-clauses over the variables 1, ..., @p num_vars to
+// @p solvers. Returns the clauses.
+vector<vector<int>> AddRandom3Sat(const int num_vars, const int n,
+                                  std::mt19937* const rng,
+                                  const vector<SatBackend*>& solvers) {
+  vector<vector<int>> clauses;
+  for (int i = 0; i < n; ++i) {
+    vector<int> clause;
+    for (int k = 0; k < 3; ++k) {
+      const int var{static_cast<int>((*rng)() % num_vars) + 1};
+      clause.push_back((*rng)() % 2 ? var : -var);
+    }
+    for (SatBackend* const sat : solvers) {
+      for (const int lit : clause) {
+        sat->Add(lit);
+      }
+      sat->Add(0);
+    }
+    clauses.push_back(clause);
+  }
+  return clauses;
+}
+
+class CdclBackendTest : public ::testing::Test {
+ protected:
+  void AddClause(const vector<int>& clause) {
+    for (const int lit : clause) {
+      sat_.Add(lit);
+    }
+    sat_.Add(0);
+  }
+
+  // Adds the pigeonhole problem of n + 1 pigeons and n holes, which is
+  // unsatisfiable. Returns its variables.
+  vector<vector<int>> AddPigeonhole(const int n) {
+    vector<vector<int>> p(n + 1, vector<int>(n));
+    for (vector<int>& row : p) {
+      for (int& var : row) {
+        var = sat_.NewVar();
+      }
+    }
+    for (int i = 0; i <= n; ++i) {
+      AddClause(p[i]);
+    }
+    for (int j = 0; j < n; ++j) {
+      for (int i = 0; i <= n; ++i) {
+        for (int k = i + 1; k <= n; ++k) {
+          AddClause({-p[i][j], -p[k][j]});
+        }
+      }
+    }
+    return p;
+  }
+
+  const Config config_;
+  CdclBackend sat_{config_};
+};
+
+TEST_F(CdclBackendTest, Simple) {
+  const int x{sat_.NewVar()};
+  const int y{sat_.NewVar()};
+  AddClause({x, y});
+  AddClause({-x});
+  ASSERT_TRUE(sat_.Solve());
+  EXPECT_EQ(sat_.Value(x), -1);
+  EXPECT_EQ(sat_.Value(y), 1);
+  AddClause({-y});
+  EXPECT_FALSE(sat_.Solve());
+  // Once it is UNSAT without scopes, it stays UNSAT.
+  EXPECT_FALSE(sat_.Solve());
+}
+
+TEST_F(CdclBackendTest, Pigeonhole) {
+  AddPigeonhole(5);
+  EXPECT_FALSE(sat_.Solve());
+}
+
+TEST_F(CdclBackendTest, Random3Sat) {
+  // Random 3-SAT instances with the clause/variable ratio 4.0. We
+  // compare the results with PicoSAT.
+  std::mt19937 rng{1234};
+  const int num_vars{60};
+  for (int round = 0; round < 10; ++round) {
+    CdclBackend cdcl{config_};
+    PicosatBackend picosat{config_};
+    for (int i = 0; i < num_vars; ++i) {
+      cdcl.NewVar();
+      picosat.NewVar();
+    }
+    const vector<vector<int>> clauses{
+        AddRandom3Sat(num_vars, 4 * num_vars, &rng, {&cdcl, &picosat})};
+    const bool result{cdcl.Solve()};
+    EXPECT_EQ(result, picosat.Solve());
+    if (result) {
+      EXPECT_TRUE(Satisfies(cdcl, clauses));
+    }
+  }
+}
+
+TEST_F(CdclBackendTest, PushPop) {
+  const int x{sat_.NewVar()};
+  const int y{sat_.NewVar()};
+  AddClause({x, y});
+  sat_.Push();
+  AddClause({-x});
+  AddClause({-y});
+  EXPECT_FALSE(sat_.Solve());
+  sat_.Pop();
+  ASSERT_TRUE(sat_.Solve());
+  EXPECT_TRUE(Satisfies(sat_, {{x, y}}));
+
+  sat_.Push();
+  AddClause({-x});
+  ASSERT_TRUE(sat_.Solve());
+  EXPECT_TRUE(Satisfies(sat_, {{x, y}, {-x}}));
+  sat_.Push();
+  AddClause({-y});
+  EXPECT_FALSE(sat_.Solve());
+  sat_.Pop();
+  ASSERT_TRUE(sat_.Solve());
+  EXPECT_EQ(sat_.Value(y), 1);
+  sat_.Pop();
+  AddClause({-y});
+  ASSERT_TRUE(sat_.Solve());
+  EXPECT_EQ(sat_.Value(x), 1);
+}
+
+TEST_F(CdclBackendTest, IncrementalRandom3Sat) {
+  // Adds random clauses in a sequence of scopes on top of a common
+  // set of clauses. We compare the results with PicoSAT.
+  std::mt19937 rng{5678};
+  const int num_vars{60};
+  PicosatBackend picosat{config_};
+  for (int i = 0; i < num_vars; ++i) {
+    sat_.NewVar();
+    picosat.NewVar();
+  }
+  const vector<vector<int>> base{
+      AddRandom3Sat(num_vars, 3 * num_vars, &rng, {&sat_, &picosat})};
+  for (int round = 0; round < 10; ++round) {
+    sat_.Push();
+    picosat.Push();
+    vector<vector<int>> clauses{AddRandom3Sat(
+        num_vars, num_vars / 4 + 5 * round, &rng, {&sat_, &picosat})};
+    clauses.insert(clauses.end(), base.begin(), base.end());
+    const bool result{sat_.Solve()};
+    EXPECT_EQ(result, picosat.Solve());
+    if (result) {
+      EXPECT_TRUE(Satisfies(sat_, clauses));
+    }
+    sat_.Pop();
+    picosat.Pop();
+  }
+  ASSERT_TRUE(sat_.Solve());
+  EXPECT_TRUE(Satisfies(sat_, base));
+}
+
+TEST_F(CdclBackendTest, PartialModel) {
+  const int x{sat_.NewVar()};
+  const int y{sat_.NewVar()};
+  const int z{sat_.NewVar()};
+  AddClause({x, y});
+  AddClause({x, z});
+  ASSERT_TRUE(sat_.Solve());
+  EXPECT_TRUE(Satisfies(sat_, {{x, y}, {x, z}}));
+  // At most two of the three variables are needed.
+  int num_needed{0};
+  for (const int var : {x, y, z}) {
+    num_needed += sat_.Value(var) != 0;
+  }
+  EXPECT_LE(num_needed, 2);
+}
+
+TEST_F(CdclBackendTest, UnsatCoreIsNotSupported) {
+  EXPECT_THROW(sat_.WriteClausalCore(nullptr), std::runtime_error);
+}
+
+}  // namespace
+}  // namespace dreal
@@ -0,0 +1,134 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/solver/checkpoint.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using std::set;
+using std::string;
+using std::vector;
+
+namespace dreal {
+namespace {
+
+class CheckpointTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    box_[x_] = Box::Interval(-10, 10);
+    box_[y_] = Box::Interval(0, 5);
+    std::remove(path_.c_str());
+  }
+  void TearDown() override { std::remove(path_.c_str()); }
+
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  Box box_{{x_, y_}};
+  const string path_{::testing::TempDir() + "checkpoint_test.ckpt"};
+};
+
+TEST_F(CheckpointTest, Fingerprint) {
+  const vector<Formula> formulas{x_ > y_, x_ + y_ == 1};
+  EXPECT_EQ(ComputeQueryFingerprint(box_, formulas),
+            ComputeQueryFingerprint(box_, formulas));
+  EXPECT_NE(ComputeQueryFingerprint(box_, formulas),
+            ComputeQueryFingerprint(box_, {x_ > y_}));
+  Box box2{box_};
+  box2[y_] = Box::Interval(0, 6);
+  EXPECT_NE(ComputeQueryFingerprint(box_, formulas),
+            ComputeQueryFingerprint(box2, formulas));
+}
+
+TEST_F(CheckpointTest, MissingResumeFile) {
+  Checkpointer checkpointer{"", 1.0, path_};
+  EXPECT_FALSE(checkpointer.enabled());
+  EXPECT_FALSE(checkpointer.due());
+  EXPECT_TRUE(checkpointer.TakeResumedClauses(0).empty());
+  EXPECT_FALSE(checkpointer.TakeResumedFrontier(0, box_));
+}
+
+TEST_F(CheckpointTest, SaveAndResume) {
+  const set<Formula> clause{x_ > y_, !(x_ + y_ == 1)};
+  Box box1{box_};
+  box1[x_] = Box::Interval(-10, 0);
+  Box box2{box_};
+  box2[x_] = Box::Interval(0, 10);
+  box2[y_] = Box::Interval(2.5, 5);
+  {
+    Checkpointer checkpointer{path_, 0.0, ""};
+    EXPECT_TRUE(checkpointer.due());
+    checkpointer.AddLearnedClause(1, clause);
+    checkpointer.AddLearnedClause(2, {x_ > y_});
+    checkpointer.Save(3, {{box1, 0}, {box2, -1}});
+  }
+
+  Checkpointer checkpointer{"", 0.0, path_};
+  const vector<vector<string>> clauses{checkpointer.TakeResumedClauses(1)};
+  ASSERT_EQ(clauses.size(), 1);
+  ASSERT_EQ(clauses[0].size(), 2);
+  for (const Formula& l : clause) {
+    EXPECT_NE(std::find(clauses[0].begin(), clauses[0].end(), l.to_string()),
+              clauses[0].end());
+  }
+  // The clauses are returned only once.
+  EXPECT_TRUE(checkpointer.TakeResumedClauses(1).empty());
+
+  // The frontier is only restored for the matching fingerprint.
+  EXPECT_FALSE(checkpointer.TakeResumedFrontier(2, box_));
+  const optional<vector<FrontierEntry>> frontier{
+      checkpointer.TakeResumedFrontier(3, box_)};
+  ASSERT_TRUE(frontier);
+  ASSERT_EQ(frontier->size(), 2);
+  EXPECT_EQ((*frontier)[0].first, box1);
+  EXPECT_EQ((*frontier)[0].second, 0);
+  EXPECT_EQ((*frontier)[1].first, box2);
+  EXPECT_EQ((*frontier)[1].second, -1);
+  EXPECT_FALSE(checkpointer.TakeResumedFrontier(3, box_));
+}
+
+TEST_F(CheckpointTest, SaveWithoutFrontier) {
+  {
+    Checkpointer checkpointer{path_, 0.0, ""};
+    checkpointer.AddLearnedClause(1, {x_ > y_});
+    checkpointer.Save();
+  }
+  {
+    // Resume and save again. It keeps the resumed clauses.
+    Checkpointer checkpointer{path_, 0.0, path_};
+    EXPECT_FALSE(checkpointer.TakeResumedFrontier(1, box_));
+    checkpointer.Save();
+  }
+  Checkpointer checkpointer{"", 0.0, path_};
+  EXPECT_EQ(checkpointer.TakeResumedClauses(1).size(), 1);
+}
+
+TEST_F(CheckpointTest, InvalidFile) {
+  {
+    std::ofstream out(path_);
+    out << "This is not a checkpoint file.";
+  }
+  EXPECT_THROW((Checkpointer{"", 0.0, path_}), std::runtime_error);
+}
+
+}  // namespace
+}  // namespace dreal
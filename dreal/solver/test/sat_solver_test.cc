@@ -77,5 +77,30 @@ TEST_F(SatSolverTest, UNSAT2) {
   EXPECT_FALSE(sat_.CheckSat());
 }
 
+TEST_F(SatSolverTest, CdclBackend) {
+  Config config;
+  config.mutable_sat_backend() = Config::SatBackend::Cdcl;
+  SatSolver sat{config};
+  // b1 ∨ b2
+  sat.AddFormula(b1_ || b2_);
+  sat.Push();
+  // ¬b1
+  sat.AddFormula(!b1_);
+  const optional<SatSolver::Model> model{sat.CheckSat()};
+  ASSERT_TRUE(model);
+  bool b2_is_true{false};
+  for (const SatSolver::Literal& l : model->first) {
+    if (l.first.equal_to(b2_)) {
+      b2_is_true = l.second;
+    }
+  }
+  EXPECT_TRUE(b2_is_true);
+  // ¬b2
+  sat.AddFormula(!b2_);
+  EXPECT_FALSE(sat.CheckSat());
+  sat.Pop();
+  EXPECT_TRUE(sat.CheckSat());
+}
+
 }  // namespace
 }  // namespace dreal
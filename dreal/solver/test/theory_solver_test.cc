@@ -16,10 +16,13 @@
 #include "dreal/solver/theory_solver.h"
 
 #include <iostream>
+#include <set>
 #include <vector>
 
 #include <gtest/gtest.h>
 
+#include "dreal/symbolic/symbolic_test_util.h"
+
 namespace dreal {
 namespace {
 
@@ -27,5 +30,241 @@ GTEST_TEST(TheorySolver, Test) {
   // TODO(soonho): Add more tests.
 }
 
+GTEST_TEST(TheorySolver, MakePortfolioConfigs) {
+  Config config;
+  config.mutable_number_of_jobs() = 8;
+  config.mutable_portfolio() = true;
+  const std::vector<Config> configs{MakePortfolioConfigs(config)};
+  ASSERT_EQ(configs.size(), 8);
+  for (const Config& member : configs) {
+    EXPECT_EQ(member.number_of_jobs(), 1);
+    EXPECT_FALSE(member.portfolio());
+  }
+  // The first member uses the given configuration.
+  EXPECT_EQ(configs[0].stack_left_box_first(), config.stack_left_box_first());
+  EXPECT_EQ(configs[0].mcts(), config.mcts());
+  EXPECT_EQ(configs[1].stack_left_box_first(), !config.stack_left_box_first());
+  // The extra members run MCTS with different random seeds.
+  EXPECT_TRUE(configs[6].mcts());
+  EXPECT_TRUE(configs[7].mcts());
+  EXPECT_NE(configs[6].random_seed(), configs[7].random_seed());
+}
+
+GTEST_TEST(TheorySolver, CheckPartial) {
+  const Variable x{"x"};
+  const Variable y{"y"};
+  Box box{{x, y}};
+  box[x] = Box::Interval(-10, 10);
+  box[y] = Box::Interval(-10, 10);
+  Config config;
+  TheorySolver theory_solver{config};
+
+  // y = x² is consistent with x ≥ 1 and y ≤ 5 without branching.
+  const Formula f1{y == x * x};
+  const Formula f2{x >= 1};
+  const Formula f3{y <= 5};
+  EXPECT_TRUE(theory_solver.CheckPartial(box, {f1, f2, f3}));
+
+  // The prefix {f1, f2, f4} is inconsistent. The conflict is found
+  // before f3 is added, so f3 is not in the explanation.
+  const Formula f4{x + y <= 0};
+  EXPECT_FALSE(theory_solver.CheckPartial(box, {f1, f2, f4, f3}));
+  const std::set<Formula>& explanation{theory_solver.GetExplanation()};
+  EXPECT_FALSE(explanation.empty());
+  EXPECT_EQ(explanation.count(f3), 0);
+}
+
+GTEST_TEST(TheorySolver, MinimizeExplanation) {
+  const Variable x{"x"};
+  const Variable y{"y"};
+  Box box{{x, y}};
+  box[x] = Box::Interval(-10, 10);
+  box[y] = Box::Interval(-10, 10);
+  Config config;
+  TheorySolver theory_solver{config};
+
+  // {f1, f2, f4} (or {f1, f4, f5}) is a minimal conflict. f3 and one
+  // of f2 and f5 are redundant.
+  const Formula f1{y == x * x};
+  const Formula f2{x >= 1};
+  const Formula f3{y <= 5};
+  const Formula f4{x + y <= 0};
+  const Formula f5{x >= 2};
+  const std::set<Formula> minimized{
+      theory_solver.MinimizeExplanation(box, {f1, f2, f3, f4, f5})};
+  EXPECT_EQ(minimized.size(), 3);
+  EXPECT_EQ(minimized.count(f1), 1);
+  EXPECT_EQ(minimized.count(f3), 0);
+  EXPECT_EQ(minimized.count(f4), 1);
+
+  // It is returned as it is if pruning does not refute it.
+  EXPECT_EQ(theory_solver.MinimizeExplanation(box, {f1, f2, f3}).size(), 3);
+}
+
+GTEST_TEST(TheorySolver, CheckPartialWithExplanationMinimization) {
+  const Variable x{"x"};
+  const Variable y{"y"};
+  Box box{{x, y}};
+  box[x] = Box::Interval(-10, 10);
+  box[y] = Box::Interval(-10, 10);
+  Config config;
+  config.mutable_use_explanation_minimization() = true;
+  TheorySolver theory_solver{config};
+
+  const Formula f1{y == x * x};
+  const Formula f2{x >= 1};
+  const Formula f3{y <= 5};
+  const Formula f4{x + y <= 0};
+  EXPECT_FALSE(theory_solver.CheckPartial(box, {f3, f1, f2, f4}));
+  const std::set<Formula>& explanation{theory_solver.GetExplanation()};
+  EXPECT_EQ(explanation.size(), 3);
+  EXPECT_EQ(explanation.count(f3), 0);
+}
+
+GTEST_TEST(TheorySolver, CheckPartialIncrementally) {
+  const Variable x{"x"};
+  const Variable y{"y"};
+  Box box{{x, y}};
+  box[x] = Box::Interval(-10, 10);
+  box[y] = Box::Interval(-10, 10);
+  Config config;
+  TheorySolver theory_solver{config};
+  config.mutable_use_incremental_theory() = true;
+  TheorySolver incremental{config};
+
+  // A sequence of calls which share prefixes, as a SAT solver gives
+  // them. The results should be the same as the non-incremental ones.
+  const Formula f1{y == x * x};
+  const Formula f2{x >= 1};
+  const Formula f3{y <= 5};
+  const Formula f4{x + y <= 0};
+  const Formula f5{x <= 2};
+  const std::vector<std::vector<Formula>> calls{
+      {f1, f2, f3}, {f1, f2, f4, f3}, {f1, f2, f3, f5}, {f1, !f2, f4},
+      {f1, f2, f3, f5}};
+  for (const std::vector<Formula>& assertions : calls) {
+    const bool result{theory_solver.CheckPartial(box, assertions)};
+    EXPECT_EQ(incremental.CheckPartial(box, assertions), result);
+    if (!result) {
+      const std::set<Formula>& explanation{theory_solver.GetExplanation()};
+      ASSERT_EQ(incremental.GetExplanation().size(), explanation.size());
+      for (const Formula& f : explanation) {
+        EXPECT_EQ(incremental.GetExplanation().count(f), 1);
+      }
+    }
+  }
+  // The last call reuses the pruning of the first three assertions.
+  // The implied literals are the same.
+  const Formula a1{y >= 0.5};
+  const Formula a2{x > 3};
+  const auto implied = theory_solver.GetImpliedLiterals({a1, a2});
+  const auto implied_incremental = incremental.GetImpliedLiterals({a1, a2});
+  ASSERT_EQ(implied.size(), 2);
+  ASSERT_EQ(implied_incremental.size(), 2);
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_PRED2(FormulaEqual, implied_incremental[i].first,
+                 implied[i].first);
+  }
+
+  // The trail is not used for another box.
+  box[x] = Box::Interval(3, 10);
+  EXPECT_FALSE(incremental.CheckPartial(box, {f1, f2, f3}));
+}
+
+GTEST_TEST(TheorySolver, CheckPartialIncrementallyAfterConflict) {
+  const Variable x{"x"};
+  const Variable y{"y"};
+  Box box{{x, y}};
+  box[x] = Box::Interval(-10, 10);
+  box[y] = Box::Interval(-10, 10);
+  Config config;
+  TheorySolver theory_solver{config};
+  config.mutable_use_incremental_theory() = true;
+  TheorySolver incremental{config};
+
+  // The first call adds f1 and f2 to the trail before it conflicts at
+  // f4. The following calls reuse the prefix {f1, f2}, whose
+  // contractors should be kept.
+  const Formula f1{y == x * x};
+  const Formula f2{x >= 1};
+  const Formula f3{y <= 5};
+  const Formula f4{x + y <= 0};
+  const Formula f5{x <= 2};
+  const std::vector<std::vector<Formula>> calls{
+      {f1, f2, f4}, {f1, f2, f3, f5}, {f1, f2, f3, f4}, {f1, f2, f5}};
+  for (const std::vector<Formula>& assertions : calls) {
+    const bool result{theory_solver.CheckPartial(box, assertions)};
+    EXPECT_EQ(incremental.CheckPartial(box, assertions), result);
+  }
+  const Formula a{y <= 4.5};
+  const auto implied = theory_solver.GetImpliedLiterals({a});
+  const auto implied_incremental = incremental.GetImpliedLiterals({a});
+  ASSERT_EQ(implied.size(), 1);
+  ASSERT_EQ(implied_incremental.size(), 1);
+  EXPECT_PRED2(FormulaEqual, implied_incremental[0].first, implied[0].first);
+}
+
+GTEST_TEST(TheorySolver, CheckSatIncrementally) {
+  const Variable x{"x"};
+  const Variable y{"y"};
+  Box box{{x, y}};
+  box[x] = Box::Interval(-10, 10);
+  box[y] = Box::Interval(-10, 10);
+  Config config;
+  config.mutable_use_incremental_theory() = true;
+  TheorySolver theory_solver{config};
+
+  const Formula f1{y == x * x};
+  const Formula f2{x >= 1};
+  const Formula f3{y <= 5};
+  const Formula f4{x + y <= 0};
+  ASSERT_TRUE(theory_solver.CheckSat(box, {f1, f2, f3}));
+  const Box& model{theory_solver.GetModel()};
+  EXPECT_GE(model[x].ub(), 1.0);
+  EXPECT_LE(model[y].lb(), 5.0);
+
+  // The conflict is found by the pruning on the trail, before f3 is
+  // added.
+  EXPECT_FALSE(theory_solver.CheckSat(box, {f1, f2, f4, f3}));
+  EXPECT_EQ(theory_solver.GetExplanation().count(f3), 0);
+
+  // Backtracks to {f1} and adds the negation of f2.
+  EXPECT_TRUE(theory_solver.CheckSat(box, {f1, !f2, f4}));
+}
+
+GTEST_TEST(TheorySolver, GetImpliedLiterals) {
+  const Variable x{"x"};
+  const Variable y{"y"};
+  const Variable z{"z"};
+  Box box{{x, y, z}};
+  box[x] = Box::Interval(-10, 10);
+  box[y] = Box::Interval(-10, 10);
+  box[z] = Box::Interval(-10, 10);
+  Config config;
+  TheorySolver theory_solver{config};
+
+  const Formula f1{y == x * x};
+  const Formula f2{x >= 2};
+  const Formula f3{z <= 0};
+  ASSERT_TRUE(theory_solver.CheckPartial(box, {f1, f2, f3}));
+
+  // y ≥ 4 in the pruned box, so `y > 3` holds and `y < 1` does not.
+  // `z ≥ -1` is undecided.
+  const Formula a1{y > 3};
+  const Formula a2{y < 1};
+  const Formula a3{z >= -1};
+  const auto implied = theory_solver.GetImpliedLiterals({a1, a2, a3});
+  ASSERT_EQ(implied.size(), 2);
+  EXPECT_PRED2(FormulaEqual, implied[0].first, a1);
+  EXPECT_PRED2(FormulaEqual, implied[1].first, !a2);
+  // The reason of `y > 3` does not include `z ≤ 0`.
+  const std::set<Formula> reason{f1, f2};
+  EXPECT_EQ(implied[0].second, reason);
+
+  // Nothing is implied after a conflict.
+  ASSERT_FALSE(theory_solver.CheckPartial(box, {f1, f2, x + y <= 0}));
+  EXPECT_TRUE(theory_solver.GetImpliedLiterals({a1, a2, a3}).empty());
+}
+
 }  // namespace
 }  // namespace dreal
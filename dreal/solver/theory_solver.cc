@@ -15,18 +15,27 @@
 */
 #include "dreal/solver/theory_solver.h"
 
+#include <algorithm>
 #include <atomic>
+#include <cstdint>
+#include <future>
 #include <iostream>
 #include <limits>
 #include <memory>
 #include <utility>
 
 #include "dreal/contractor/contractor_forall.h"
+#include "dreal/contractor/contractor_linear.h"
 #include "dreal/solver/context.h"
 #include "dreal/solver/filter_assertion.h"
 #include "dreal/solver/formula_evaluator.h"
+#include "dreal/solver/icp_best_first.h"
+#include "dreal/solver/icp_best_first_parallel.h"
+#include "dreal/solver/icp_distributed.h"
 #include "dreal/solver/icp_mcts.h"
+#include "dreal/solver/icp_mcts_parallel.h"
 #include "dreal/solver/icp_parallel.h"
+#include "dreal/solver/icp_parallel_deterministic.h"
 #include "dreal/solver/icp_seq.h"
 #include "dreal/util/assert.h"
 #include "dreal/util/logging.h"
@@ -38,16 +47,90 @@ namespace dreal {
 using std::cout;
 using std::make_unique;
 using std::numeric_limits;
+using std::pair;
 using std::set;
 using std::vector;
 
+vector<Config> MakePortfolioConfigs(const Config& config) {
+  // Each member varies one aspect of `config`. If there are more jobs
+  // than variations, the remaining members run MCTS with different
+  // random seeds.
+  constexpr int kNumVariations{6};
+  vector<Config> configs;
+  configs.reserve(config.number_of_jobs());
+  for (int i = 0; i < config.number_of_jobs(); ++i) {
+    Config member{config};
+    member.mutable_number_of_jobs() = 1;
+    member.mutable_portfolio() = false;
+    switch (i < kNumVariations ? i : kNumVariations - 1) {
+      case 0:
+        // The given configuration.
+        break;
+      case 1:
+        // Depth-first search in the opposite order.
+        member.mutable_stack_left_box_first() = !config.stack_left_box_first();
+        break;
+      case 2:
+        // Polytope contractor on/off.
+        member.mutable_use_polytope() = !config.use_polytope();
+        break;
+      case 3:
+        // Worklist fixpoint on/off.
+        member.mutable_use_worklist_fixpoint() =
+            !config.use_worklist_fixpoint();
+        break;
+      case 4:
+        // Best-first search.
+        member.mutable_mcts() = false;
+        member.mutable_search_strategy() = Config::SearchStrategy::BestFirst;
+        member.mutable_best_first_score() = Config::BestFirstScore::Violation;
+        break;
+      case 5:
+        // MCTS with a different random seed.
+        member.mutable_mcts() = true;
+        member.mutable_random_seed() =
+            config.random_seed() + static_cast<uint32_t>(i);
+        break;
+      default:
+        DREAL_UNREACHABLE();
+    }
+    configs.push_back(member);
+  }
+  return configs;
+}
+
 TheorySolver::TheorySolver(const Config& config)
     : config_{config}, icp_{nullptr} {
+  if (!config_.distributed_address().empty()) {
+    icp_ = make_unique<IcpDistributed>(config_);
+    return;
+  }
+  if (config_.portfolio() && !config_.deterministic() &&
+      config_.number_of_jobs() > 1) {
+    portfolio_configs_ = MakePortfolioConfigs(config_);
+    for (const Config& member_config : portfolio_configs_) {
+      portfolio_.push_back(make_unique<TheorySolver>(member_config));
+    }
+    pool_ = make_unique<ThreadPool>(portfolio_.size() - 1);
+    return;
+  }
+  const bool best_first{config_.search_strategy() ==
+                         Config::SearchStrategy::BestFirst};
   if (config_.number_of_jobs() > 1) {
-    icp_ = make_unique<IcpParallel>(config_);
+    if (config_.deterministic()) {
+      icp_ = make_unique<IcpParallelDeterministic>(config_);
+    } else if (config_.mcts()) {
+      icp_ = make_unique<IcpMctsParallel>(config_);
+    } else if (best_first) {
+      icp_ = make_unique<IcpBestFirstParallel>(config_);
+    } else {
+      icp_ = make_unique<IcpParallel>(config_);
+    }
   } else {
     if (config_.mcts()) {
       icp_ = make_unique<IcpMcts>(config_);
+    } else if (best_first) {
+      icp_ = make_unique<IcpBestFirst>(config_);
     } else {
       icp_ = make_unique<IcpSeq>(config_);
     }
@@ -122,12 +205,149 @@ class TheorySolverStat : public Stat {
   std::atomic<int> num_check_sat_{0};
 };
 
+class ExplanationMinimizationStat : public Stat {
+ public:
+  explicit ExplanationMinimizationStat(const bool enabled) : Stat{enabled} {}
+  ExplanationMinimizationStat(const ExplanationMinimizationStat&) = delete;
+  ExplanationMinimizationStat(ExplanationMinimizationStat&&) = delete;
+  ExplanationMinimizationStat& operator=(const ExplanationMinimizationStat&) =
+      delete;
+  ExplanationMinimizationStat& operator=(ExplanationMinimizationStat&&) =
+      delete;
+  ~ExplanationMinimizationStat() override {
+    if (enabled()) {
+      using fmt::print;
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of Minimized Explanations", "Theory level",
+            num_minimizations_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of Constraints before Minimization", "Theory level",
+            num_constraints_before_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of Constraints after Minimization", "Theory level",
+            num_constraints_after_);
+      print(cout, "{:<45} @ {:<20} = {:>15f} sec\n",
+            "Total time spent in Minimizing Explanations", "Theory level",
+            timer_minimize_.seconds());
+    }
+  }
+
+  int num_minimizations_{0};
+  int64_t num_constraints_before_{0};
+  int64_t num_constraints_after_{0};
+  Timer timer_minimize_;
+};
+
+class IncrementalTheoryStat : public Stat {
+ public:
+  explicit IncrementalTheoryStat(const bool enabled) : Stat{enabled} {}
+  IncrementalTheoryStat(const IncrementalTheoryStat&) = delete;
+  IncrementalTheoryStat(IncrementalTheoryStat&&) = delete;
+  IncrementalTheoryStat& operator=(const IncrementalTheoryStat&) = delete;
+  IncrementalTheoryStat& operator=(IncrementalTheoryStat&&) = delete;
+  ~IncrementalTheoryStat() override {
+    if (enabled()) {
+      using fmt::print;
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of Assertions Reused from Trail", "Theory level",
+            num_reused_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of Assertions Pruned on Trail", "Theory level",
+            num_pruned_);
+    }
+  }
+
+  int64_t num_reused_{0};
+  int64_t num_pruned_{0};
+};
+
+// Returns a fixpoint contractor of @p contractors. The kind of the
+// fixpoint is specified in @p config.
+Contractor MakeFixpoint(const vector<Contractor>& contractors,
+                        const Config& config) {
+  // The adaptive fixpoint orders the contractors based on timing, so
+  // we do not use it if a deterministic result is requested.
+  if (config.use_adaptive_fixpoint() && !config.deterministic()) {
+    return make_contractor_adaptive_fixpoint(DefaultTerminationCondition(),
+                                             contractors, config);
+  }
+  if (config.use_worklist_fixpoint()) {
+    return make_contractor_worklist_fixpoint(DefaultTerminationCondition(),
+                                             contractors, config);
+  } else {
+    return make_contractor_fixpoint(DefaultTerminationCondition(),
+                                    contractors, config);
+  }
+}
+
+// Wraps @p contractor with the shaving contractor specified in @p
+// config. ACID tunes itself with counters shared by the threads, so
+// we use CID instead if a deterministic result is requested.
+Contractor AddShaving(Contractor contractor, const Config& config) {
+  switch (config.shaving()) {
+    case Config::Shaving::None:
+      return contractor;
+    case Config::Shaving::ThreeB:
+      return make_contractor_shaving(std::move(contractor),
+                                     config.shaving_slices(), config);
+    case Config::Shaving::Cid:
+      return make_contractor_cid(std::move(contractor),
+                                 config.shaving_slices(), config);
+    case Config::Shaving::Acid:
+      if (config.deterministic()) {
+        return make_contractor_cid(std::move(contractor),
+                                   config.shaving_slices(), config);
+      }
+      return make_contractor_acid(std::move(contractor),
+                                  config.shaving_slices(), config);
+  }
+  DREAL_UNREACHABLE();
+}
+
+// Returns true if @p f can be handled by ContractorLinear.
+bool IsLinearConstraint(const Formula& f, const Box& box) {
+  vector<pair<int, Box::Interval>> terms;
+  Box::Interval range;
+  return ExtractLinearConstraint(f, box, &terms, &range);
+}
+
 }  // namespace
 
+Contractor TheorySolver::BuildSubContractor(const Formula& f, const Box& box) {
+  auto it = contractor_cache_.find(f);
+  if (it != contractor_cache_.end()) {
+    // Cache hit!
+    return it->second;
+  }
+  // There is no contractor for `f`, build one.
+  DREAL_LOG_DEBUG("TheorySolver::BuildContractor: Turn {} into a contractor",
+                  f);
+  Contractor ctc{config_};
+  if (is_forall(f)) {
+    // We should have `inner_delta < epsilon < delta`.
+    const double delta{config_.precision()};
+    const double epsilon{delta * 0.5};
+    const double inner_delta{epsilon * 0.5};
+    DREAL_ASSERT(inner_delta < epsilon && epsilon < delta);
+    ctc = make_contractor_fixpoint(
+        DefaultTerminationCondition(),
+        {make_contractor_forall<Context>(f, box, epsilon, inner_delta,
+                                         config_)},
+        config_);
+  } else {
+    // With --native-hc4, it is a ContractorHc4 if ExpressionTape
+    // supports `f`.
+    ctc = make_contractor_ibex_fwdbwd(f, box, config_);
+  }
+  // Add it to the cache.
+  contractor_cache_.emplace_hint(it, f, ctc);
+  return ctc;
+}
+
 optional<Contractor> TheorySolver::BuildContractor(
     const vector<Formula>& assertions,
     ContractorStatus* const contractor_status) {
-  static TheorySolverStat stat{DREAL_LOG_INFO_ENABLED};
+  thread_local TheorySolverStat stat{DREAL_LOG_INFO_ENABLED};
 
   Box& box = contractor_status->mutable_box();
   if (assertions.empty()) {
@@ -136,6 +356,11 @@ optional<Contractor> TheorySolver::BuildContractor(
   DREAL_LOG_TRACE("TheorySolver::BuildContractor: Filtering Assertions\n{}",
                   box);
   vector<Contractor> ctcs;
+  // Formulas which are compiled into a shared DAG (--shared-dag).
+  vector<Formula> dag_formulas;
+  // Linear formulas which are handled by a ContractorLinear
+  // (--linear-contractor).
+  vector<Formula> linear_formulas;
   Box old_box;
   TimerGuard filter_assertions_guard(&stat.timer_filter_assertions_,
                                      stat.enabled(), false /* start_timer*/);
@@ -173,38 +398,49 @@ optional<Contractor> TheorySolver::BuildContractor(
     }
     filter_assertions_guard.pause();
     build_sub_contractor_guard.resume();
-    auto it = contractor_cache_.find(f);
-    if (it == contractor_cache_.end()) {
-      // There is no contractor for `f`, build one.
-      DREAL_LOG_DEBUG(
-          "TheorySolver::BuildContractor: Turn {} into a contractor", f);
-      if (is_forall(f)) {
-        // We should have `inner_delta < epsilon < delta`.
-        const double delta{config_.precision()};
-        const double epsilon{delta * 0.5};
-        const double inner_delta{epsilon * 0.5};
-        DREAL_ASSERT(inner_delta < epsilon && epsilon < delta);
-        const Contractor ctc{make_contractor_forall<Context>(
-            f, box, epsilon, inner_delta, config_)};
-        ctcs.emplace_back(make_contractor_fixpoint(
-            DefaultTerminationCondition(), {ctc}, config_));
-      } else {
-        ctcs.emplace_back(make_contractor_ibex_fwdbwd(f, box, config_));
-      }
-      // Add it to the cache.
-      contractor_cache_.emplace_hint(it, f, ctcs.back());
-    } else {
-      // Cache hit!
-      ctcs.emplace_back(it->second);
+    if (config_.use_linear_contractor() && !is_forall(f) &&
+        IsLinearConstraint(f, box)) {
+      linear_formulas.push_back(f);
+      build_sub_contractor_guard.pause();
+      continue;
+    }
+    if (config_.use_shared_dag() && !is_forall(f)) {
+      dag_formulas.push_back(f);
+      build_sub_contractor_guard.pause();
+      continue;
     }
+    ctcs.push_back(BuildSubContractor(f, box));
+    build_sub_contractor_guard.pause();
+  }
+  if (!dag_formulas.empty()) {
+    // Compile all the collected formulas into a single DAG so that
+    // their common sub-expressions are evaluated only once.
+    build_sub_contractor_guard.resume();
+    ctcs.push_back(make_contractor_hc4_dag(dag_formulas, box, config_));
+    build_sub_contractor_guard.pause();
+  }
+  if (!linear_formulas.empty()) {
+    build_sub_contractor_guard.resume();
+    ctcs.push_back(make_contractor_linear(linear_formulas, box, config_));
     build_sub_contractor_guard.pause();
   }
   // Add integer contractor.
   ctcs.push_back(make_contractor_integer(box, config_));
 
+  // With --polytope-on-stall, the polytope contractor is kept out of
+  // the fixpoint below and runs after the fixpoint stalls.
+  optional<Contractor> polytope;
   if (config_.use_polytope()) {
     // Add polytope contractor.
-    ctcs.push_back(make_contractor_ibex_polytope(assertions, box, config_));
+    if (config_.polytope_on_stall()) {
+      polytope = make_contractor_ibex_polytope(assertions, box, config_);
+    } else {
+      ctcs.push_back(make_contractor_ibex_polytope(assertions, box, config_));
+    }
+  }
+  if (config_.use_newton()) {
+    // Add interval Newton contractor.
+    ctcs.push_back(make_contractor_newton(assertions, box, config_));
   }
   if (DREAL_LOG_TRACE_ENABLED) {
     for (const auto& ctc : ctcs) {
@@ -214,13 +450,12 @@ optional<Contractor> TheorySolver::BuildContractor(
       DREAL_LOG_TRACE("TheorySolver::BuildContractor: CTCS = empty");
     }
   }
-  if (config_.use_worklist_fixpoint()) {
-    return make_contractor_worklist_fixpoint(DefaultTerminationCondition(),
-                                             ctcs, config_);
-  } else {
-    return make_contractor_fixpoint(DefaultTerminationCondition(), ctcs,
-                                    config_);
+  Contractor fixpoint{MakeFixpoint(ctcs, config_)};
+  if (polytope) {
+    fixpoint = make_contractor_fixpoint(DefaultTerminationCondition(),
+                                        {fixpoint, *polytope}, config_);
   }
+  return AddShaving(std::move(fixpoint), config_);
 }
 
 vector<FormulaEvaluator> TheorySolver::BuildFormulaEvaluator(
@@ -250,14 +485,235 @@ vector<FormulaEvaluator> TheorySolver::BuildFormulaEvaluator(
   return formula_evaluators;
 }
 
+void TheorySolver::set_cancel_flag(const std::atomic<bool>* const flag) {
+  if (icp_) {
+    icp_->set_cancel_flag(flag);
+  }
+  for (auto& member : portfolio_) {
+    member->set_cancel_flag(flag);
+  }
+}
+
+void TheorySolver::set_checkpointer(Checkpointer* const checkpointer) {
+  if (icp_) {
+    icp_->set_checkpointer(checkpointer);
+  }
+}
+
+bool TheorySolver::CheckSatPortfolio(const Box& box,
+                                     const vector<Formula>& assertions) {
+  DREAL_LOG_DEBUG("TheorySolver::CheckSatPortfolio()");
+  // It becomes true when a member finishes. The other members see it
+  // and give up.
+  std::atomic<bool> done{false};
+  // Index of the member which finishes first, and its result.
+  int winner{-1};
+  bool winner_result{false};
+  for (auto& member : portfolio_) {
+    member->set_cancel_flag(&done);
+  }
+  auto run = [&](const int i) {
+    const bool result{portfolio_[i]->CheckSat(box, assertions)};
+    // A cancelled member comes here after `done` is set, so it cannot
+    // be the winner.
+    if (!done.exchange(true)) {
+      winner = i;
+      winner_result = result;
+    }
+  };
+
+  const int last_index{static_cast<int>(portfolio_.size()) - 1};
+  vector<std::future<void>> results;
+  results.reserve(last_index);
+  for (int i = 0; i < last_index; ++i) {
+    results.push_back(pool_->enqueue(run, i));
+  }
+  run(last_index);
+
+  // barrier.
+  for (auto&& result : results) {
+    result.get();
+  }
+
+  DREAL_ASSERT(winner >= 0);
+  DREAL_LOG_DEBUG(
+      "TheorySolver::CheckSatPortfolio() member {} wins, result = {}, "
+      "config = {}",
+      winner, winner_result, portfolio_configs_[winner]);
+  if (winner_result) {
+    model_ = portfolio_[winner]->GetModel();
+  } else {
+    explanation_ = portfolio_[winner]->GetExplanation();
+  }
+  return winner_result;
+}
+
+bool TheorySolver::PruneAssertions(const Box& box,
+                                   const vector<Formula>& assertions,
+                                   ContractorStatus* const contractor_status) {
+  // Contractors of the non-filtered assertions added so far.
+  vector<Contractor> ctcs;
+  for (const Formula& f : assertions) {
+    if (!PruneAssertion(box, f, &ctcs, contractor_status)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TheorySolver::PruneAssertion(const Box& box, const Formula& f,
+                                  vector<Contractor>* const ctcs,
+                                  ContractorStatus* const contractor_status) {
+  // Forall contractors are too expensive for this check.
+  if (is_forall(f)) {
+    return true;
+  }
+  const Box old_box{contractor_status->box()};
+  const FilterAssertionResult result{
+      FilterAssertion(f, &contractor_status->mutable_box())};
+  if (result == FilterAssertionResult::FilteredWithoutChange) {
+    return true;
+  }
+  if (contractor_status->box() != old_box) {
+    contractor_status->AddUsedConstraint(f);
+    if (contractor_status->box().empty()) {
+      for (const Variable& v : f.GetFreeVariables()) {
+        contractor_status->AddUnsatWitness(v);
+      }
+    }
+  }
+  if (result == FilterAssertionResult::NotFiltered &&
+      !contractor_status->box().empty()) {
+    ctcs->push_back(BuildSubContractor(f, box));
+    ctcs->back().Prune(contractor_status);
+  }
+  // Propagates the change to the assertions added before `f`.
+  if (!contractor_status->box().empty() &&
+      contractor_status->box() != old_box) {
+    make_contractor_fixpoint(DefaultTerminationCondition(), *ctcs, config_)
+        .Prune(contractor_status);
+  }
+  if (contractor_status->box().empty()) {
+    DREAL_LOG_DEBUG("TheorySolver::PruneAssertion() - Conflict at {}", f);
+    return false;
+  }
+  return true;
+}
+
+bool TheorySolver::PruneAssertionsIncrementally(
+    const Box& box, const vector<Formula>& assertions,
+    ContractorStatus* const contractor_status) {
+  thread_local IncrementalTheoryStat stat{DREAL_LOG_INFO_ENABLED};
+  if (box != trail_box_) {
+    // The trail was built for another box.
+    trail_.clear();
+    trail_ctcs_.clear();
+    trail_box_ = box;
+  }
+  // Backtracks to the longest common prefix.
+  size_t prefix{0};
+  while (prefix < trail_.size() && prefix < assertions.size() &&
+         trail_[prefix].assertion.EqualTo(assertions[prefix])) {
+    ++prefix;
+  }
+  trail_.erase(trail_.begin() + prefix, trail_.end());
+  const int num_ctcs{trail_.empty() ? 0 : trail_.back().num_ctcs};
+  trail_ctcs_.erase(trail_ctcs_.begin() + num_ctcs, trail_ctcs_.end());
+  if (stat.enabled()) {
+    stat.num_reused_ += prefix;
+    stat.num_pruned_ += assertions.size() - prefix;
+  }
+  DREAL_LOG_DEBUG(
+      "TheorySolver::PruneAssertionsIncrementally() - Reuse {} of {} "
+      "assertions.",
+      prefix, assertions.size());
+
+  *contractor_status =
+      trail_.empty() ? ContractorStatus{box} : trail_.back().contractor_status;
+  for (size_t i = prefix; i < assertions.size(); ++i) {
+    const Formula& f{assertions[i]};
+    if (!PruneAssertion(box, f, &trail_ctcs_, contractor_status)) {
+      // The conflicting assertion is not added to the trail, but the
+      // assertions added before it in this call are kept.
+      trail_ctcs_.erase(
+          trail_ctcs_.begin() + (trail_.empty() ? 0 : trail_.back().num_ctcs),
+          trail_ctcs_.end());
+      return false;
+    }
+    trail_.push_back(TrailEntry{f, *contractor_status,
+                                static_cast<int>(trail_ctcs_.size())});
+  }
+  return true;
+}
+
+bool TheorySolver::CheckPartial(const Box& box,
+                                const vector<Formula>& assertions) {
+  DREAL_LOG_DEBUG("TheorySolver::CheckPartial()");
+  partial_status_ = nullopt;
+  ContractorStatus contractor_status(box);
+  const bool consistent{
+      config_.use_incremental_theory()
+          ? PruneAssertionsIncrementally(box, assertions, &contractor_status)
+          : PruneAssertions(box, assertions, &contractor_status)};
+  if (!consistent) {
+    SetExplanation(box, contractor_status.Explanation());
+    return false;
+  }
+  partial_status_ = std::move(contractor_status);
+  return true;
+}
+
+vector<pair<Formula, set<Formula>>> TheorySolver::GetImpliedLiterals(
+    const vector<Formula>& atoms) {
+  vector<pair<Formula, set<Formula>>> implied;
+  if (!partial_status_) {
+    return implied;
+  }
+  const Box& box{partial_status_->box()};
+  for (const Formula& atom : atoms) {
+    if (!is_relational(atom)) {
+      continue;
+    }
+    const Variables& vars{atom.GetFreeVariables()};
+    if (!std::all_of(vars.begin(), vars.end(), [&box](const Variable& var) {
+          return box.has_variable(var);
+        })) {
+      // `atom` was introduced in a popped scope.
+      continue;
+    }
+    switch (BuildFormulaEvaluator({atom})[0](box).type()) {
+      case FormulaEvaluationResult::Type::VALID:
+        implied.emplace_back(atom, partial_status_->Explanation(vars));
+        break;
+      case FormulaEvaluationResult::Type::UNSAT:
+        implied.emplace_back(!atom, partial_status_->Explanation(vars));
+        break;
+      case FormulaEvaluationResult::Type::UNKNOWN:
+        break;
+    }
+  }
+  return implied;
+}
+
 bool TheorySolver::CheckSat(const Box& box, const vector<Formula>& assertions) {
-  static TheorySolverStat stat{DREAL_LOG_INFO_ENABLED};
+  if (!portfolio_.empty()) {
+    return CheckSatPortfolio(box, assertions);
+  }
+  thread_local TheorySolverStat stat{DREAL_LOG_INFO_ENABLED};
   stat.increase_num_check_sat();
   TimerGuard check_sat_timer_guard(&stat.timer_check_sat_, stat.enabled(),
                                    true /* start_timer */);
 
   DREAL_LOG_DEBUG("TheorySolver::CheckSat()");
   ContractorStatus contractor_status(box);
+  if (config_.use_incremental_theory()) {
+    // ICP starts from the box pruned with the trail.
+    if (!PruneAssertionsIncrementally(box, assertions, &contractor_status)) {
+      SetExplanation(box, contractor_status.Explanation());
+      return false;
+    }
+    contractor_status.mutable_output().reset();
+  }
 
   // Icp Step
   TimerGuard build_contractor_guard(&stat.timer_build_contractor_,
@@ -269,7 +725,7 @@ bool TheorySolver::CheckSat(const Box& box, const vector<Formula>& assertions) {
     icp_->CheckSat(*contractor, BuildFormulaEvaluator(assertions),
                    &contractor_status);
     if (contractor_status.box().empty()) {
-      explanation_ = contractor_status.Explanation();
+      SetExplanation(box, contractor_status.Explanation());
       return false;
     } else {
       model_ = contractor_status.box();
@@ -278,11 +734,73 @@ bool TheorySolver::CheckSat(const Box& box, const vector<Formula>& assertions) {
     return !contractor_status.box().empty();
   } else {
     DREAL_ASSERT(contractor_status.box().empty());
-    explanation_ = contractor_status.Explanation();
+    SetExplanation(box, contractor_status.Explanation());
     return false;
   }
 }
 
+set<Formula> TheorySolver::MinimizeExplanation(
+    const Box& box, const set<Formula>& explanation) {
+  thread_local ExplanationMinimizationStat stat{DREAL_LOG_INFO_ENABLED};
+  TimerGuard timer_guard(&stat.timer_minimize_, stat.enabled());
+  Timer timer;
+  timer.start();
+  vector<Formula> core{explanation.begin(), explanation.end()};
+  // Keeps the elements of `core` which are in `used`, in the same order.
+  const auto restrict_to = [&core](const set<Formula>& used) {
+    if (used.empty()) {
+      return;
+    }
+    core.erase(std::remove_if(core.begin(), core.end(),
+                              [&used](const Formula& f) {
+                                return used.count(f) == 0;
+                              }),
+               core.end());
+  };
+  {
+    ContractorStatus contractor_status{box};
+    if (PruneAssertions(box, core, &contractor_status)) {
+      DREAL_LOG_DEBUG(
+          "TheorySolver::MinimizeExplanation() - Not refuted by pruning.");
+      return explanation;
+    }
+    restrict_to(contractor_status.Explanation());
+  }
+  for (size_t i = 0; i < core.size();) {
+    if (timer.seconds() > config_.explanation_minimization_budget()) {
+      DREAL_LOG_DEBUG("TheorySolver::MinimizeExplanation() - Out of budget.");
+      break;
+    }
+    vector<Formula> candidate{core};
+    candidate.erase(candidate.begin() + i);
+    ContractorStatus contractor_status{box};
+    if (PruneAssertions(box, candidate, &contractor_status)) {
+      // core[i] is needed.
+      ++i;
+    } else {
+      core = std::move(candidate);
+      restrict_to(contractor_status.Explanation());
+    }
+  }
+  DREAL_LOG_DEBUG("TheorySolver::MinimizeExplanation() - {} -> {}",
+                  explanation.size(), core.size());
+  if (stat.enabled()) {
+    stat.num_minimizations_++;
+    stat.num_constraints_before_ += explanation.size();
+    stat.num_constraints_after_ += core.size();
+  }
+  return set<Formula>{core.begin(), core.end()};
+}
+
+void TheorySolver::SetExplanation(const Box& box,
+                                  const set<Formula>& explanation) {
+  if (config_.use_explanation_minimization()) {
+    explanation_ = MinimizeExplanation(box, explanation);
+  } else {
+    explanation_ = explanation;
+  }
+}
+
 const Box& TheorySolver::GetModel() const {
   DREAL_LOG_DEBUG("TheorySolver::GetModel():\n{}", model_);
   return model_;
@@ -15,12 +15,17 @@
 */
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <set>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "ThreadPool/ThreadPool.h"
+
 #include "dreal/contractor/contractor.h"
+#include "dreal/solver/checkpoint.h"
 #include "dreal/solver/config.h"
 #include "dreal/solver/formula_evaluator.h"
 #include "dreal/solver/icp.h"
@@ -31,6 +36,21 @@
 namespace dreal {
 
 /// Theory solver for nonlinear theory over the Reals.
+///
+/// If Config::portfolio() is set and it uses more than one job, it
+/// runs a portfolio of theory solvers with different configurations
+/// (see MakePortfolioConfigs) concurrently. The first solver which
+/// finishes decides the result, and the other solvers are cancelled.
+///
+/// If Config::distributed_address() is set, it distributes ICP over
+/// worker processes (see IcpDistributed).
+///
+/// If Config::use_incremental_theory() is set, CheckSat and
+/// CheckPartial keep a trail of the boxes pruned with the prefixes of
+/// their assertions (see PruneAssertionsIncrementally). A SAT solver
+/// gives the theory literals in the order of its variables, so the
+/// assertions of consecutive calls often share a long prefix which is
+/// not pruned again.
 class TheorySolver {
  public:
   TheorySolver() = delete;
@@ -46,23 +66,129 @@ class TheorySolver {
   /// Gets a list of used constraints.
   const std::set<Formula>& GetExplanation() const;
 
- private:
-  // Builds a contractor using @p box and @p assertions. It returns
-  // nullopt if it detects an empty box while building a contractor.
-  //
-  // @note This method updates @p box as it calls FilterAssertion
-  // function.
+  /// Sets a flag to cancel CheckSat. See Icp::set_cancel_flag.
+  void set_cancel_flag(const std::atomic<bool>* flag);
+
+  /// Sets a checkpointer. See Icp::set_checkpointer. Note that the
+  /// members of the portfolio mode do not use it.
+  void set_checkpointer(Checkpointer* checkpointer);
+
+  /// Builds a contractor using the box in @p contractor_status and @p
+  /// assertions. It returns nullopt if it detects an empty box while
+  /// building a contractor.
+  ///
+  /// @note This method updates the box in @p contractor_status as it
+  /// calls FilterAssertion function.
   optional<Contractor> BuildContractor(const std::vector<Formula>& assertions,
                                        ContractorStatus* contractor_status);
+
+  /// Checks the consistency of @p assertions without branching. It
+  /// adds the non-quantified assertions one by one, as if they were
+  /// assigned by a SAT solver, and prunes @p box with the ones added so
+  /// far. It returns false as soon as the box becomes empty; then
+  /// GetExplanation() returns a subset of the inconsistent prefix.
+  ///
+  /// @note Returning true does not mean that @p assertions are
+  /// delta-satisfiable. Use CheckSat to find a model.
+  bool CheckPartial(const Box& box, const std::vector<Formula>& assertions);
+
+  /// Returns the theory literals implied by the box pruned in the last
+  /// call of CheckPartial. For each relational atom `a` in @p atoms, it
+  /// evaluates `a` over the box. If every point in the box satisfies
+  /// `a`, it returns `a`. If no point in the box satisfies `a`, it
+  /// returns `¬a`. Each literal comes with its reason, the assertions
+  /// given to CheckPartial which pruned the domains of its variables.
+  ///
+  /// @note It returns an empty vector if the last call of CheckPartial
+  /// returned false.
+  std::vector<std::pair<Formula, std::set<Formula>>> GetImpliedLiterals(
+      const std::vector<Formula>& atoms);
+
+  /// Builds formula evaluators for @p assertions, in the same order.
   std::vector<FormulaEvaluator> BuildFormulaEvaluator(
       const std::vector<Formula>& assertions);
 
+  /// Shrinks @p explanation, a set of assertions which has no solution
+  /// in @p box. It first checks that pruning @p box with @p explanation
+  /// (as in CheckPartial) empties the box; otherwise, for example if
+  /// ICP needed branching to refute it, it returns @p explanation as it
+  /// is. Then it deletes the assertions one by one, keeping a deletion
+  /// if pruning still empties the box. After each successful check, it
+  /// also drops the assertions which were not used in the pruning. It
+  /// stops when Config::explanation_minimization_budget() runs out.
+  std::set<Formula> MinimizeExplanation(const Box& box,
+                                        const std::set<Formula>& explanation);
+
+ private:
+  // Prunes the box in @p contractor_status with @p assertions, adding
+  // them one by one. Returns false as soon as the box becomes empty.
+  // Forall assertions are ignored. @p box is used to build the
+  // contractors.
+  bool PruneAssertions(const Box& box, const std::vector<Formula>& assertions,
+                       ContractorStatus* contractor_status);
+
+  // Adds @p f to the pruning of PruneAssertions. @p ctcs are the
+  // contractors of the assertions added before @p f, and the
+  // contractor of @p f is appended to it. Returns false if the box
+  // becomes empty.
+  bool PruneAssertion(const Box& box, const Formula& f,
+                      std::vector<Contractor>* ctcs,
+                      ContractorStatus* contractor_status);
+
+  // Does the same as PruneAssertions with a fresh contractor status of
+  // @p box, but it backtracks `trail_` to the longest common prefix of
+  // @p assertions and the assertions of the last call and prunes only
+  // with the rest. The result is copied to @p contractor_status. If it
+  // returns false, @p contractor_status is the one with the empty box.
+  bool PruneAssertionsIncrementally(const Box& box,
+                                    const std::vector<Formula>& assertions,
+                                    ContractorStatus* contractor_status);
+
+  // Sets `explanation_` to @p explanation. It is minimized if
+  // Config::use_explanation_minimization() is set.
+  void SetExplanation(const Box& box, const std::set<Formula>& explanation);
+
+  // Returns a contractor for @p f. It is cached in `contractor_cache_`.
+  Contractor BuildSubContractor(const Formula& f, const Box& box);
+
+  // Runs the solvers in `portfolio_` concurrently.
+  bool CheckSatPortfolio(const Box& box, const std::vector<Formula>& assertions);
+
   const Config& config_;
   std::unique_ptr<Icp> icp_;
   Box model_;
   std::set<Formula> explanation_;
+  // The contractor status at the end of the last call of CheckPartial
+  // if it returned true.
+  optional<ContractorStatus> partial_status_;
   std::unordered_map<Formula, Contractor> contractor_cache_;
   std::unordered_map<Formula, FormulaEvaluator> formula_evaluator_cache_;
+
+  // Incremental mode. `trail_[i]` keeps the contractor status of
+  // `trail_box_` pruned with the assertions of `trail_[0..i]`, and the
+  // number of contractors in `trail_ctcs_` built for them.
+  struct TrailEntry {
+    Formula assertion;
+    ContractorStatus contractor_status;
+    int num_ctcs;
+  };
+  Box trail_box_;
+  std::vector<TrailEntry> trail_;
+  std::vector<Contractor> trail_ctcs_;
+
+  // Portfolio mode. Note that `portfolio_` keeps references to the
+  // elements of `portfolio_configs_`.
+  std::vector<Config> portfolio_configs_;
+  std::vector<std::unique_ptr<TheorySolver>> portfolio_;
+  std::unique_ptr<ThreadPool> pool_;
 };
 
+/// Returns @p config.number_of_jobs() configurations derived from @p
+/// config, which are used in portfolio mode. Each of them uses a single
+/// job. The first one is the same as @p config, and the others vary the
+/// search order, the search algorithm (MCTS and best-first search with
+/// different random seeds), and the contractors (polytope and worklist
+/// fixpoint).
+std::vector<Config> MakePortfolioConfigs(const Config& config);
+
 }  // namespace dreal
@@ -18,6 +18,7 @@
 #include <limits>
 #include <sstream>
 #include <stdexcept>
+#include <utility>
 
 using std::ostream;
 using std::ostringstream;
@@ -26,17 +27,6 @@ using std::string;
 
 namespace dreal {
 
-namespace {
-ostream& print_constant(ostream& os, double c) {
-  if (c >= 0) {
-    return os << c;
-  } else {
-    return os << "(- " << (-c) << ")";
-  }
-}
-
-}  // namespace
-
 PrefixPrinter::PrefixPrinter(ostream& os)
     : os_{os}, old_precision_{os.precision()} {
   // See
@@ -44,6 +34,12 @@ PrefixPrinter::PrefixPrinter(ostream& os)
   os_.precision(std::numeric_limits<double>::max_digits10 + 2);
 }
 
+PrefixPrinter::PrefixPrinter(
+    ostream& os, std::function<string(const Expression&)> real_constant_symbol)
+    : PrefixPrinter{os} {
+  real_constant_symbol_ = std::move(real_constant_symbol);
+}
+
 PrefixPrinter::~PrefixPrinter() { os_.precision(old_precision_); }
 
 ostream& PrefixPrinter::Print(const Expression& e) {
@@ -54,18 +50,37 @@ ostream& PrefixPrinter::Print(const Formula& f) {
   return VisitFormula<ostream&>(this, f);
 }
 
+ostream& PrefixPrinter::PrintConstant(const double c) {
+  if (c < 0) {
+    os_ << "(- ";
+    PrintConstant(-c);
+    return os_ << ")";
+  }
+  if (real_constant_symbol_) {
+    // A hexadecimal float is read back exactly.
+    const std::ios_base::fmtflags flags{os_.flags()};
+    os_ << std::hexfloat << c;
+    os_.flags(flags);
+    return os_;
+  }
+  return os_ << c;
+}
+
 ostream& PrefixPrinter::VisitVariable(const Expression& e) {
   return os_ << get_variable(e);
 }
 
 ostream& PrefixPrinter::VisitConstant(const Expression& e) {
-  return print_constant(os_, get_constant_value(e));
+  return PrintConstant(get_constant_value(e));
 }
 
 ostream& PrefixPrinter::VisitRealConstant(const Expression& e) {
+  if (real_constant_symbol_) {
+    return os_ << real_constant_symbol_(e);
+  }
   const double mid{get_lb_of_real_constant(e) / 2.0 +
                    get_ub_of_real_constant(e) / 2.0};
-  return print_constant(os_, mid);
+  return PrintConstant(mid);
 }
 
 ostream& PrefixPrinter::VisitUnaryFunction(const std::string& name,
@@ -89,7 +104,7 @@ ostream& PrefixPrinter::VisitAddition(const Expression& e) {
   os_ << "(+";
   if (constant != 0.0) {
     os_ << " ";
-    print_constant(os_, constant);
+    PrintConstant(constant);
   }
   for (const auto& p : get_expr_to_coeff_map_in_addition(e)) {
     const Expression& e_i{p.first};
@@ -99,7 +114,7 @@ ostream& PrefixPrinter::VisitAddition(const Expression& e) {
       Print(e_i);
     } else {
       os_ << "(* ";
-      print_constant(os_, c_i);
+      PrintConstant(c_i);
       os_ << " ";
       Print(e_i);
       os_ << ")";
@@ -113,7 +128,7 @@ ostream& PrefixPrinter::VisitMultiplication(const Expression& e) {
   os_ << "(*";
   if (constant != 1.0) {
     os_ << " ";
-    print_constant(os_, constant);
+    PrintConstant(constant);
   }
   for (const auto& p : get_base_to_exponent_map_in_multiplication(e)) {
     const Expression& b_i{p.first};
@@ -15,6 +15,7 @@
 */
 #pragma once
 
+#include <functional>
 #include <ios>
 #include <ostream>
 #include <string>
@@ -30,6 +31,14 @@ class PrefixPrinter {
   /// precision of @p os to the maximum precision.
   explicit PrefixPrinter(std::ostream& os);
 
+  /// Constructs a PrefixPrinter with @p os which prints constants
+  /// exactly. A floating-point constant is printed as a hexadecimal
+  /// float. A real constant has no exact form in SMT2, so it is printed
+  /// as the symbol which @p real_constant_symbol returns for it.
+  PrefixPrinter(
+      std::ostream& os,
+      std::function<std::string(const Expression&)> real_constant_symbol);
+
   PrefixPrinter(const PrefixPrinter&) = delete;
   PrefixPrinter(PrefixPrinter&&) = delete;
   PrefixPrinter& operator=(const PrefixPrinter&) = delete;
@@ -45,6 +54,8 @@ class PrefixPrinter {
   std::ostream& Print(const Formula& f);
 
  private:
+  std::ostream& PrintConstant(double c);
+
   std::ostream& VisitVariable(const Expression& e);
   std::ostream& VisitConstant(const Expression& e);
   std::ostream& VisitRealConstant(const Expression& e);
@@ -102,6 +113,7 @@ class PrefixPrinter {
 
   std::ostream& os_;
   std::streamsize old_precision_{};
+  std::function<std::string(const Expression&)> real_constant_symbol_;
 };
 
 /// Returns the prefix-string representation of the expression @p e.
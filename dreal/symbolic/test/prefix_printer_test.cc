@@ -16,6 +16,9 @@
 #include "dreal/symbolic/prefix_printer.h"
 
 #include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -62,6 +65,26 @@ TEST_F(PrefixPrinterTest, Constant4) {
   EXPECT_EQ(ToPrefix(e), "(- 3.141592653589793116)");
 }
 
+TEST_F(PrefixPrinterTest, ExactConstants) {
+  // A floating-point constant is printed as a hexadecimal float.
+  std::vector<Expression> real_constants;
+  const auto symbol = [&real_constants](const Expression& e) {
+    real_constants.push_back(e);
+    return "k" + std::to_string(real_constants.size() - 1);
+  };
+  std::ostringstream oss1;
+  PrefixPrinter{oss1, symbol}.Print(Expression{-1.5});
+  EXPECT_EQ(oss1.str(), "(- 0x1.8p+0)");
+
+  // A real constant is printed as the given symbol.
+  const Expression c{real_constant(0.1, std::nextafter(0.1, 1.0), true)};
+  std::ostringstream oss2;
+  PrefixPrinter{oss2, symbol}.Print(c);
+  EXPECT_EQ(oss2.str(), "k0");
+  ASSERT_EQ(real_constants.size(), 1);
+  EXPECT_TRUE(real_constants[0].EqualTo(c));
+}
+
 TEST_F(PrefixPrinterTest, Addition) {
   const Expression e{-3 + x_ - 2 * y_ + 3 * z_};
   EXPECT_EQ(ToPrefix(e), "(+ (- 3) x (* (- 2) y) (* 3 z))");
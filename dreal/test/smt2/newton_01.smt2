@@ -0,0 +1,9 @@
+(set-logic QF_NRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(assert (and (<= -2 x) (<= x 2)))
+(assert (and (<= -2 y) (<= y 2)))
+(assert (= (+ (* x x) (* y y)) 2))
+(assert (= y (* x x)))
+(check-sat)
+(exit)
@@ -18,6 +18,7 @@ from __future__ import absolute_import
 from __future__ import division
 from __future__ import print_function
 
+import os
 import sys
 import subprocess
 import difflib
@@ -32,14 +33,22 @@ smt2 = sys.argv[2]
 # 3rd Argument: smt2 expected output
 expected_output_filename = sys.argv[3]
 
-options = sys.argv[4:]
+# Options may refer to environment variables such as $TEST_TMPDIR.
+options = [os.path.expandvars(option) for option in sys.argv[4:]]
+
+# dReal runs in $TEST_TMPDIR, so a relative path in the options is in
+# the private directory of the test. It is used for a unix socket
+# whose path is limited to about 100 bytes.
+cwd = os.environ.get('TEST_TMPDIR')
 
 with open(expected_output_filename, "r") as myfile:
     expected_output = myfile.read().strip().splitlines()
 
 try:
     # 1. Run dReal with smt2 file
-    output = subprocess.check_output([dreal, smt2] + options).decode('UTF-8')
+    output = subprocess.check_output(
+        [os.path.abspath(dreal), os.path.abspath(smt2)] + options,
+        cwd=cwd).decode('UTF-8')
     output = output.splitlines()
     print(output)
     # 2. Compare the output with expected output
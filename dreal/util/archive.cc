@@ -0,0 +1,128 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/util/archive.h"
+
+#include <cstring>
+
+#include "dreal/util/exception.h"
+
+namespace dreal {
+
+using std::int64_t;
+using std::size_t;
+using std::string;
+using std::uint64_t;
+
+void OutputArchive::WriteUint64(const uint64_t v) {
+  for (int i = 0; i < 8; ++i) {
+    data_.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+  }
+}
+
+void OutputArchive::WriteInt64(const int64_t v) {
+  WriteUint64(static_cast<uint64_t>(v));
+}
+
+void OutputArchive::WriteDouble(const double v) {
+  static_assert(sizeof(double) == sizeof(uint64_t),
+                "double should be a 64-bit type.");
+  uint64_t bits{};
+  std::memcpy(&bits, &v, sizeof(v));
+  WriteUint64(bits);
+}
+
+void OutputArchive::WriteString(const string& s) {
+  WriteUint64(s.size());
+  data_.append(s);
+}
+
+string OutputArchive::release() {
+  string data;
+  data.swap(data_);
+  return data;
+}
+
+InputArchive::InputArchive(const string& data) : data_{data} {}
+
+uint64_t InputArchive::ReadUint64() {
+  Require(8);
+  uint64_t v{0};
+  for (int i = 0; i < 8; ++i) {
+    v |= static_cast<uint64_t>(static_cast<unsigned char>(data_[pos_ + i]))
+         << (8 * i);
+  }
+  pos_ += 8;
+  return v;
+}
+
+int64_t InputArchive::ReadInt64() {
+  return static_cast<int64_t>(ReadUint64());
+}
+
+double InputArchive::ReadDouble() {
+  const uint64_t bits{ReadUint64()};
+  double v{};
+  std::memcpy(&v, &bits, sizeof(v));
+  return v;
+}
+
+string InputArchive::ReadString() {
+  const uint64_t size{ReadUint64()};
+  Require(size);
+  string s{data_.substr(pos_, size)};
+  pos_ += size;
+  return s;
+}
+
+void InputArchive::Require(const size_t n) const {
+  if (data_.size() - pos_ < n) {
+    throw DREAL_RUNTIME_ERROR(
+        "InputArchive: need {} bytes but only {} bytes are left.", n,
+        data_.size() - pos_);
+  }
+}
+
+void WriteBox(const Box& box, OutputArchive* const archive) {
+  archive->WriteInt64(box.size());
+  archive->WriteUint64(box.empty() ? 1 : 0);
+  if (box.empty()) {
+    return;
+  }
+  for (int i = 0; i < box.size(); ++i) {
+    archive->WriteDouble(box[i].lb());
+    archive->WriteDouble(box[i].ub());
+  }
+}
+
+void ReadBox(InputArchive* const archive, Box* const box) {
+  const int64_t size{archive->ReadInt64()};
+  if (size != box->size()) {
+    throw DREAL_RUNTIME_ERROR(
+        "ReadBox: the archive has {} intervals but the box has {} variables.",
+        size, box->size());
+  }
+  if (archive->ReadUint64() != 0) {
+    box->set_empty();
+    return;
+  }
+  for (int i = 0; i < box->size(); ++i) {
+    const double lb{archive->ReadDouble()};
+    const double ub{archive->ReadDouble()};
+    (*box)[i] = Box::Interval(lb, ub);
+  }
+}
+
+}  // namespace dreal
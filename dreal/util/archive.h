@@ -0,0 +1,101 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "dreal/util/box.h"
+
+namespace dreal {
+
+/// Writes values into a byte string in a portable binary format.
+///
+/// Integers are written in little-endian order and doubles are written
+/// as their IEEE-754 bit patterns, so that a value is read back exactly
+/// on another machine. A string is written as its length followed by
+/// its bytes.
+class OutputArchive {
+ public:
+  /// Writes an unsigned 64-bit integer @p v.
+  void WriteUint64(std::uint64_t v);
+
+  /// Writes a signed 64-bit integer @p v.
+  void WriteInt64(std::int64_t v);
+
+  /// Writes a double @p v.
+  void WriteDouble(double v);
+
+  /// Writes a string @p s.
+  void WriteString(const std::string& s);
+
+  /// Returns the bytes written so far.
+  const std::string& data() const { return data_; }
+
+  /// Returns the bytes written so far and leaves this archive empty.
+  std::string release();
+
+ private:
+  std::string data_;
+};
+
+/// Reads values written by OutputArchive from a byte string.
+///
+/// All the Read methods throw std::runtime_error if there are not
+/// enough bytes left.
+class InputArchive {
+ public:
+  /// Constructs an archive which reads @p data. Note that it keeps a
+  /// reference of @p data.
+  explicit InputArchive(const std::string& data);
+
+  /// Reads an unsigned 64-bit integer.
+  std::uint64_t ReadUint64();
+
+  /// Reads a signed 64-bit integer.
+  std::int64_t ReadInt64();
+
+  /// Reads a double.
+  double ReadDouble();
+
+  /// Reads a string.
+  std::string ReadString();
+
+  /// Returns true if all the bytes have been read.
+  bool done() const { return pos_ == data_.size(); }
+
+ private:
+  // Throws if there are less than @p n bytes left.
+  void Require(std::size_t n) const;
+
+  const std::string& data_;
+  std::size_t pos_{0};
+};
+
+/// Writes the intervals of @p box into @p archive. Note that it does
+/// not write the variables of @p box.
+void WriteBox(const Box& box, OutputArchive* archive);
+
+/// Reads intervals written by WriteBox from @p archive and stores them
+/// in @p box.
+///
+/// @pre @p box has the variables of the box which was written.
+/// @throws std::runtime_error if the number of intervals does not match
+/// the size of @p box.
+void ReadBox(InputArchive* archive, Box* box);
+
+}  // namespace dreal
@@ -245,6 +245,25 @@ pair<double, int> Box::FirstDiamGT(
 }
 
 pair<Box, Box> Box::bisect(const int i) const {
+  const pair<Interval, Interval> bisected_intervals{bisect_interval(i)};
+  Box b1{*this};
+  Box b2{*this};
+  b1[i] = bisected_intervals.first;
+  b2[i] = bisected_intervals.second;
+  return make_pair(b1, b2);
+}
+
+pair<Box, Box> Box::bisect(const Variable& var) const {
+  auto it = var_to_idx_->find(var);
+  if (it != var_to_idx_->end()) {
+    return bisect(it->second);
+  } else {
+    throw DREAL_RUNTIME_ERROR("Variable {} is not found in this box.", var);
+  }
+  return bisect((*var_to_idx_)[var]);
+}
+
+pair<Box::Interval, Box::Interval> Box::bisect_interval(const int i) const {
   const Variable& var{(*idx_to_var_)[i]};
   if (!values_[i].is_bisectable()) {
     throw DREAL_RUNTIME_ERROR(
@@ -263,17 +282,7 @@ pair<Box, Box> Box::bisect(const int i) const {
   DREAL_UNREACHABLE();
 }
 
-pair<Box, Box> Box::bisect(const Variable& var) const {
-  auto it = var_to_idx_->find(var);
-  if (it != var_to_idx_->end()) {
-    return bisect(it->second);
-  } else {
-    throw DREAL_RUNTIME_ERROR("Variable {} is not found in this box.", var);
-  }
-  return bisect((*var_to_idx_)[var]);
-}
-
-pair<Box, Box> Box::bisect_int(const int i) const {
+pair<Box::Interval, Box::Interval> Box::bisect_int(const int i) const {
   DREAL_ASSERT(idx_to_var_->at(i).get_type() == Variable::Type::INTEGER ||
                idx_to_var_->at(i).get_type() == Variable::Type::BINARY);
   const Interval& intv_i{values_[i]};
@@ -286,23 +295,14 @@ pair<Box, Box> Box::bisect_int(const int i) const {
   DREAL_ASSERT(mid_floor + 1 <= ub);
   DREAL_ASSERT(ub <= intv_i.ub());
 
-  Box b1{*this};
-  Box b2{*this};
-  b1[i] = Interval(lb, mid_floor);
-  b2[i] = Interval(mid_floor + 1, ub);
-  return make_pair(b1, b2);
+  return make_pair(Interval(lb, mid_floor), Interval(mid_floor + 1, ub));
 }
 
-pair<Box, Box> Box::bisect_continuous(const int i) const {
+pair<Box::Interval, Box::Interval> Box::bisect_continuous(const int i) const {
   DREAL_ASSERT(idx_to_var_->at(i).get_type() == Variable::Type::CONTINUOUS);
-  Box b1{*this};
-  Box b2{*this};
   const Interval intv_i{values_[i]};
   constexpr double kHalf{0.5};
-  const pair<Interval, Interval> bisected_intervals{intv_i.bisect(kHalf)};
-  b1[i] = bisected_intervals.first;
-  b2[i] = bisected_intervals.second;
-  return make_pair(b1, b2);
+  return intv_i.bisect(kHalf);
 }
 
 Box& Box::InplaceUnion(const Box& b) {
@@ -125,21 +125,27 @@ class Box {
   /// @throws std::runtime if @p i -th dimension is not bisectable.
   std::pair<Box, Box> bisect(const Variable& var) const;
 
+  /// Returns the pair of intervals which `bisect(i)` puts at the @p i
+  /// -th dimension of the two sub-boxes. Unlike `bisect(i)`, it does
+  /// not copy the box.
+  /// @throws std::runtime if @p i -th dimension is not bisectable.
+  std::pair<Interval, Interval> bisect_interval(int i) const;
+
   /// Updates the current box by taking union with @p b.
   ///
   /// @pre variables() == b.variables().
   Box& InplaceUnion(const Box& b);
 
  private:
-  /// Bisects the box at @p i -th dimension.
+  /// Bisects the interval at @p i -th dimension.
   /// @pre i-th variable is bisectable.
   /// @pre i-th variable is of integer type.
-  std::pair<Box, Box> bisect_int(int i) const;
+  std::pair<Interval, Interval> bisect_int(int i) const;
 
-  /// Bisects the box at @p i -th dimension.
+  /// Bisects the interval at @p i -th dimension.
   /// @pre i-th variable is bisectable.
   /// @pre i-th variable is of continuous type.
-  std::pair<Box, Box> bisect_continuous(int i) const;
+  std::pair<Interval, Interval> bisect_continuous(int i) const;
 
   std::shared_ptr<std::vector<Variable>> variables_;
 
@@ -0,0 +1,785 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/util/expression_tape.h"
+
+#include <algorithm>
+#include <cfenv>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+#include "dreal/util/assert.h"
+#include "dreal/util/exception.h"
+#include "dreal/util/math.h"
+#include "dreal/util/rounding_mode_guard.h"
+
+namespace dreal {
+
+using std::ostream;
+using std::unordered_map;
+using std::vector;
+
+using Interval = Box::Interval;
+using Op = ExpressionTape::Op;
+
+/// Visitor class which compiles a symbolic Expression into an
+/// ExpressionTape.
+class ExpressionTapeBuilder {
+ public:
+  ExpressionTapeBuilder(const Box& box, ExpressionTape* const tape)
+      : box_{box}, tape_{*tape} {}
+
+  // Visits @p e and returns the index of the node which represents it.
+  int Visit(const Expression& e) {
+    const auto it = cache_.find(e);
+    if (it != cache_.end()) {
+      return it->second;
+    }
+    const int node{VisitExpression<int>(this, e)};
+    cache_.emplace(e, node);
+    return node;
+  }
+
+ private:
+  int AddNode(const Op op, const int arg1, const int arg2 = -1) {
+    tape_.ops_.push_back(op);
+    tape_.arg1_.push_back(arg1);
+    tape_.arg2_.push_back(arg2);
+    return tape_.size() - 1;
+  }
+
+  int AddConstant(const Interval& c) {
+    tape_.constants_.push_back(c);
+    return AddNode(Op::Const, static_cast<int>(tape_.constants_.size()) - 1);
+  }
+
+  int VisitVariable(const Expression& e) {
+    const Variable& var{get_variable(e)};
+    if (!box_.has_variable(var)) {
+      throw DREAL_RUNTIME_ERROR(
+          "ExpressionTape: Variable {} does not appear in the box.",
+          var.get_name());
+    }
+    const int dim{box_.index(var)};
+    const int node{AddNode(Op::Var, dim)};
+    tape_.var_nodes_.emplace_back(node, dim);
+    return node;
+  }
+
+  int VisitConstant(const Expression& e) {
+    return AddConstant(Interval{get_constant_value(e)});
+  }
+
+  int VisitRealConstant(const Expression& e) {
+    return AddConstant(
+        Interval{get_lb_of_real_constant(e), get_ub_of_real_constant(e)});
+  }
+
+  int VisitAddition(const Expression& e) {
+    // e = c + Σᵢ coeffᵢ * eᵢ.
+    const double c{get_constant_in_addition(e)};
+    int ret{-1};
+    if (c != 0.0) {
+      ret = Visit(Expression{c});
+    }
+    for (const auto& p : get_expr_to_coeff_map_in_addition(e)) {
+      const Expression& e_i{p.first};
+      const double coeff{p.second};
+      if (coeff == 1.0) {
+        ret = ret < 0 ? Visit(e_i) : AddNode(Op::Add, ret, Visit(e_i));
+      } else if (coeff == -1.0) {
+        ret = ret < 0 ? AddNode(Op::Neg, Visit(e_i))
+                      : AddNode(Op::Sub, ret, Visit(e_i));
+      } else {
+        const int term{AddNode(Op::Mul, Visit(Expression{coeff}), Visit(e_i))};
+        ret = ret < 0 ? term : AddNode(Op::Add, ret, term);
+      }
+    }
+    return ret;
+  }
+
+  int ProcessPow(const Expression& base, const Expression& exponent) {
+    // See IbexConverter::ProcessPow. We keep an integer exponent as a
+    // part of the instruction so that we can use the tighter
+    // projection for it.
+    if (is_constant(exponent)) {
+      const double v{get_constant_value(exponent)};
+      if (is_integer(v)) {
+        return AddNode(Op::PowInt, Visit(base), static_cast<int>(v));
+      }
+      if (v == 0.5) {
+        return AddNode(Op::Sqrt, Visit(base));
+      }
+    }
+    return AddNode(Op::Pow, Visit(base), Visit(exponent));
+  }
+
+  int VisitMultiplication(const Expression& e) {
+    // e = c * Πᵢ baseᵢ^exponentᵢ.
+    const double c{get_constant_in_multiplication(e)};
+    int ret{-1};
+    if (c != 1.0) {
+      ret = Visit(Expression{c});
+    }
+    for (const auto& p : get_base_to_exponent_map_in_multiplication(e)) {
+      const int term{ProcessPow(p.first, p.second)};
+      ret = ret < 0 ? term : AddNode(Op::Mul, ret, term);
+    }
+    return ret;
+  }
+
+  int VisitDivision(const Expression& e) { return AddBinary(Op::Div, e); }
+  int VisitLog(const Expression& e) { return AddUnary(Op::Log, e); }
+  int VisitAbs(const Expression& e) { return AddUnary(Op::Abs, e); }
+  int VisitExp(const Expression& e) { return AddUnary(Op::Exp, e); }
+  int VisitSqrt(const Expression& e) { return AddUnary(Op::Sqrt, e); }
+  int VisitPow(const Expression& e) {
+    return ProcessPow(get_first_argument(e), get_second_argument(e));
+  }
+  int VisitSin(const Expression& e) { return AddUnary(Op::Sin, e); }
+  int VisitCos(const Expression& e) { return AddUnary(Op::Cos, e); }
+  int VisitTan(const Expression& e) { return AddUnary(Op::Tan, e); }
+  int VisitAsin(const Expression& e) { return AddUnary(Op::Asin, e); }
+  int VisitAcos(const Expression& e) { return AddUnary(Op::Acos, e); }
+  int VisitAtan(const Expression& e) { return AddUnary(Op::Atan, e); }
+  int VisitAtan2(const Expression& e) { return AddBinary(Op::Atan2, e); }
+  int VisitSinh(const Expression& e) { return AddUnary(Op::Sinh, e); }
+  int VisitCosh(const Expression& e) { return AddUnary(Op::Cosh, e); }
+  int VisitTanh(const Expression& e) { return AddUnary(Op::Tanh, e); }
+  int VisitMin(const Expression& e) { return AddBinary(Op::Min, e); }
+  int VisitMax(const Expression& e) { return AddBinary(Op::Max, e); }
+
+  int VisitIfThenElse(const Expression&) {
+    throw DREAL_RUNTIME_ERROR(
+        "ExpressionTape: If-then-else expression is not supported yet.");
+  }
+
+  int VisitUninterpretedFunction(const Expression&) {
+    throw DREAL_RUNTIME_ERROR(
+        "ExpressionTape: Uninterpreted function is not supported.");
+  }
+
+  int AddUnary(const Op op, const Expression& e) {
+    return AddNode(op, Visit(get_argument(e)));
+  }
+
+  int AddBinary(const Op op, const Expression& e) {
+    const int arg1{Visit(get_first_argument(e))};
+    const int arg2{Visit(get_second_argument(e))};
+    return AddNode(op, arg1, arg2);
+  }
+
+  const Box& box_;
+  ExpressionTape& tape_;
+  // Expression → node. It detects common sub-expressions.
+  unordered_map<Expression, int> cache_;
+
+  // Makes VisitExpression a friend of this class so that it can use private
+  // operator()s.
+  friend int drake::symbolic::VisitExpression<int>(ExpressionTapeBuilder*,
+                                                   const Expression&);
+};
+
+namespace {
+
+// Backward projection of a binary operation y = op(x₁, x₂). It handles
+// the case where x₁ and x₂ are the same node, i.e. op(x, x).
+bool BackwardBinary(bool (*bwd)(const Interval&, Interval&, Interval&),
+                    const Interval& y, Interval* const x1, Interval* const x2) {
+  if (x1 != x2) {
+    return bwd(y, *x1, *x2);
+  }
+  Interval x1_copy{*x1};
+  Interval x2_copy{*x2};
+  if (!bwd(y, x1_copy, x2_copy)) {
+    return false;
+  }
+  *x1 = x1_copy & x2_copy;
+  return !x1->is_empty();
+}
+
+// Returns the number of operand nodes of @p op.
+int NumOperands(const Op op) {
+  switch (op) {
+    case Op::Const:
+    case Op::Var:
+      return 0;
+    case Op::Add:
+    case Op::Sub:
+    case Op::Mul:
+    case Op::Div:
+    case Op::Pow:
+    case Op::Atan2:
+    case Op::Min:
+    case Op::Max:
+      return 2;
+    default:
+      return 1;
+  }
+}
+
+// Returns the value of `op(x, y)`. @p y is ignored if @p op is a unary
+// operation and @p exponent is used only when @p op is Op::PowInt.
+Interval Apply(const Op op, const Interval& x, const Interval& y,
+               const int exponent) {
+  switch (op) {
+    case Op::Const:
+    case Op::Var:
+      break;
+    case Op::Add:
+      return x + y;
+    case Op::Sub:
+      return x - y;
+    case Op::Mul:
+      return x * y;
+    case Op::Div:
+      return x / y;
+    case Op::Neg:
+      return -x;
+    case Op::PowInt:
+      return pow(x, exponent);
+    case Op::Pow:
+      return pow(x, y);
+    case Op::Sqrt:
+      return sqrt(x);
+    case Op::Exp:
+      return exp(x);
+    case Op::Log:
+      return log(x);
+    case Op::Abs:
+      return abs(x);
+    case Op::Sin:
+      return sin(x);
+    case Op::Cos:
+      return cos(x);
+    case Op::Tan:
+      return tan(x);
+    case Op::Asin:
+      return asin(x);
+    case Op::Acos:
+      return acos(x);
+    case Op::Atan:
+      return atan(x);
+    case Op::Atan2:
+      return atan2(x, y);
+    case Op::Sinh:
+      return sinh(x);
+    case Op::Cosh:
+      return cosh(x);
+    case Op::Tanh:
+      return tanh(x);
+    case Op::Min:
+      return min(x, y);
+    case Op::Max:
+      return max(x, y);
+  }
+  DREAL_UNREACHABLE();
+}
+
+// φ = 2^-53 (1 + 2^-52) and η = 2^-1074 from S. M. Rump, P. Zimmermann,
+// S. Boldo, and G. Melquiond, "Computing predecessor and successor in
+// rounding to nearest", BIT 2009. In round-to-nearest mode, we have
+// x - (φ|x| + η) <= pred(x) and succ(x) <= x + (φ|x| + η) for a finite
+// double x.
+constexpr double kPhi{(1.0 + std::numeric_limits<double>::epsilon()) /
+                      9007199254740992.0 /* 2^53 */};
+constexpr double kEta{std::numeric_limits<double>::denorm_min()};
+
+// Returns φ|x| + η, which is at least one ulp of @p x and at most two.
+inline double Ulp(const double x) { return kPhi * std::abs(x) + kEta; }
+
+// The kernels below are written without a branch so that a loop
+// calling them can be vectorized. Instead of a conditional, they
+// multiply Ulp by the result of a quiet comparison (std::isless and
+// std::isgreater), which a compiler can turn into a mask. Note that
+// `<` or `?:` here would stop GCC from vectorizing the loop under the
+// default -ftrapping-math.
+
+// Returns a lower bound of x + y. The rounding error of fl(x + y) is
+// computed by TwoSum and the result is rounded down only if it is
+// inexact. If an operand or the sum is infinite, the result can be NaN.
+inline double AddDown(const double x, const double y) {
+  const double s{x + y};
+  const double t{s - x};
+  const double e{(x - (s - t)) + (y - t)};
+  return s - std::isless(e, 0.0) * Ulp(s);
+}
+
+// Returns an upper bound of x + y. See AddDown.
+inline double AddUp(const double x, const double y) {
+  const double s{x + y};
+  const double t{s - x};
+  const double e{(x - (s - t)) + (y - t)};
+  return s + std::isgreater(e, 0.0) * Ulp(s);
+}
+
+// The rounding error of fl(x * y) is representable, and FMA computes
+// it exactly, only if |x * y| is at least DBL_MIN · 2^53.
+constexpr double kMinExactProduct{std::numeric_limits<double>::min() *
+                                  9007199254740992.0 /* 2^53 */};
+
+// Returns true if fl(x * y) may have underflowed, so that FMA does not
+// give its rounding error. Note that x * y is exact if x or y is zero.
+inline bool MayUnderflow(const double x, const double y, const double p) {
+  return std::isless(std::abs(p), kMinExactProduct) & (x != 0) & (y != 0);
+}
+
+// Returns a lower bound of x * y. The rounding error of fl(x * y) is
+// computed by FMA. If it may have underflowed, the result is rounded
+// down unconditionally. If an operand or the product is infinite, the
+// result can be NaN.
+inline double MulDown(const double x, const double y) {
+  const double p{x * y};
+  const double e{std::fma(x, y, -p)};
+  return p - (std::isless(e, 0.0) | MayUnderflow(x, y, p)) * Ulp(p);
+}
+
+// Returns an upper bound of x * y. See MulDown.
+inline double MulUp(const double x, const double y) {
+  const double p{x * y};
+  const double e{std::fma(x, y, -p)};
+  return p + (std::isgreater(e, 0.0) | MayUnderflow(x, y, p)) * Ulp(p);
+}
+
+}  // namespace
+
+Interval ExpressionTape::BatchValues::value(const int k, const int j) const {
+  const int i{k * n + j};
+  return empty[i] ? Interval::EMPTY_SET : Interval(lb[i], ub[i]);
+}
+
+ExpressionTape::ExpressionTape(const Expression& e, const Box& box)
+    : ExpressionTape{vector<Expression>{e}, box} {}
+
+ExpressionTape::ExpressionTape(const vector<Expression>& roots,
+                               const Box& box) {
+  ExpressionTapeBuilder builder{box, this};
+  for (const Expression& e : roots) {
+    roots_.push_back(builder.Visit(e));
+  }
+
+  // Collect the nodes reachable from each root. Since a node comes
+  // after its operands, we can mark them by a reverse scan.
+  vector<char> reachable(ops_.size());
+  root_offsets_.push_back(0);
+  for (const int root : roots_) {
+    std::fill(reachable.begin(), reachable.end(), 0);
+    reachable[root] = 1;
+    for (int i = root; i >= 0; --i) {
+      if (!reachable[i]) {
+        continue;
+      }
+      const int num_operands{NumOperands(ops_[i])};
+      if (num_operands >= 1) {
+        reachable[arg1_[i]] = 1;
+      }
+      if (num_operands == 2) {
+        reachable[arg2_[i]] = 1;
+      }
+    }
+    for (int i = 0; i <= root; ++i) {
+      if (reachable[i]) {
+        root_nodes_.push_back(i);
+      }
+    }
+    root_offsets_.push_back(static_cast<int>(root_nodes_.size()));
+  }
+}
+
+Interval ExpressionTape::Evaluate(const Box::IntervalVector& iv,
+                                  vector<Interval>* const values) const {
+  if (!Forward(iv, values)) {
+    return Interval::EMPTY_SET;
+  }
+  return (*values)[roots_[0]];
+}
+
+bool ExpressionTape::Forward(const Box::IntervalVector& iv,
+                             vector<Interval>* const values) const {
+  values->resize(ops_.size());
+  Interval* const v{values->data()};
+  const int n{size()};
+  for (int i = 0; i < n; ++i) {
+    const Op op{ops_[i]};
+    const int a{arg1_[i]};
+    const int b{arg2_[i]};
+    switch (op) {
+      case Op::Const:
+        v[i] = constants_[a];
+        break;
+      case Op::Var:
+        v[i] = iv[a];
+        break;
+      default:
+        v[i] = Apply(op, v[a], NumOperands(op) == 2 ? v[b] : v[a], b);
+    }
+    if (v[i].is_empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ExpressionTape::EvaluateBatch(
+    const vector<const Box::IntervalVector*>& boxes,
+    BatchValues* const values) const {
+  const int n{static_cast<int>(boxes.size())};
+  values->n = n;
+  values->lb.resize(ops_.size() * n);
+  values->ub.resize(ops_.size() * n);
+  values->empty.resize(ops_.size() * n);
+  for (int k = 0; k < size(); ++k) {
+    const Op op{ops_[k]};
+    const int a{arg1_[k]};
+    const int b{arg2_[k]};
+    double* const lb{&values->lb[k * n]};
+    double* const ub{&values->ub[k * n]};
+    std::uint8_t* const empty{&values->empty[k * n]};
+    if (op == Op::Const) {
+      const Interval& c{constants_[a]};
+      std::fill(lb, lb + n, c.lb());
+      std::fill(ub, ub + n, c.ub());
+      std::fill(empty, empty + n, 0);
+      continue;
+    }
+    if (op == Op::Var) {
+      for (int j = 0; j < n; ++j) {
+        const Interval& x{(*boxes[j])[a]};
+        empty[j] = x.is_empty();
+        lb[j] = empty[j] ? 0.0 : x.lb();
+        ub[j] = empty[j] ? 0.0 : x.ub();
+      }
+      continue;
+    }
+    // Rows of the operands. For a unary operation, the second row is an
+    // alias of the first one and it is not used.
+    const bool binary{NumOperands(op) == 2};
+    const double* const lb_a{&values->lb[a * n]};
+    const double* const ub_a{&values->ub[a * n]};
+    const std::uint8_t* const empty_a{&values->empty[a * n]};
+    const int b_row{binary ? b : a};
+    const double* const lb_b{&values->lb[b_row * n]};
+    const double* const ub_b{&values->ub[b_row * n]};
+    const std::uint8_t* const empty_b{&values->empty[b_row * n]};
+    for (int j = 0; j < n; ++j) {
+      empty[j] = empty_a[j] | empty_b[j];
+    }
+    // The kernels below run over contiguous rows, without building an
+    // IBEX interval per box. They compute in round-to-nearest mode and
+    // round a result outward if it is inexact. The loop bodies have no
+    // branch or call, so that a compiler can vectorize them over the
+    // boxes (e.g. with -mavx2 -mfma or -mavx512f).
+    //
+    // TwoSum and FMA give the exact rounding errors only in
+    // round-to-nearest mode, while IBEX may leave the FPU in another
+    // mode. We switch to round-to-nearest only around the kernels, since
+    // the IBEX operations below rely on the mode IBEX has set.
+    switch (op) {
+      case Op::Add:
+      case Op::Sub:
+      case Op::Mul: {
+        {
+          const RoundingModeGuard guard{FE_TONEAREST};
+          if (op == Op::Add) {
+            for (int j = 0; j < n; ++j) {
+              lb[j] = AddDown(lb_a[j], lb_b[j]);
+              ub[j] = AddUp(ub_a[j], ub_b[j]);
+            }
+          } else if (op == Op::Sub) {
+            for (int j = 0; j < n; ++j) {
+              lb[j] = AddDown(lb_a[j], -ub_b[j]);
+              ub[j] = AddUp(ub_a[j], -lb_b[j]);
+            }
+          } else {
+            for (int j = 0; j < n; ++j) {
+              const double x1{lb_a[j]};
+              const double x2{ub_a[j]};
+              const double y1{lb_b[j]};
+              const double y2{ub_b[j]};
+              lb[j] = std::min(std::min(MulDown(x1, y1), MulDown(x1, y2)),
+                               std::min(MulDown(x2, y1), MulDown(x2, y2)));
+              ub[j] = std::max(std::max(MulUp(x1, y1), MulUp(x1, y2)),
+                               std::max(MulUp(x2, y1), MulUp(x2, y2)));
+            }
+          }
+        }
+        // With an unbounded operand or an overflow, the kernels may give
+        // NaN or an infinity (e.g. 0 × ∞). We redo those cases with IBEX.
+        for (int j = 0; j < n; ++j) {
+          if (!empty[j] &&
+              (std::isinf(lb_a[j]) || std::isinf(ub_a[j]) ||
+               std::isinf(lb_b[j]) || std::isinf(ub_b[j]) ||
+               !std::isfinite(lb[j]) || !std::isfinite(ub[j]))) {
+            const Interval r{Apply(op, Interval(lb_a[j], ub_a[j]),
+                                   Interval(lb_b[j], ub_b[j]), b)};
+            lb[j] = r.lb();
+            ub[j] = r.ub();
+          }
+        }
+        break;
+      }
+      case Op::Neg:
+        for (int j = 0; j < n; ++j) {
+          lb[j] = -ub_a[j];
+          ub[j] = -lb_a[j];
+        }
+        break;
+      default:
+        // Other operations are evaluated box by box using IBEX.
+        for (int j = 0; j < n; ++j) {
+          if (empty[j]) {
+            continue;
+          }
+          const Interval r{Apply(op, Interval(lb_a[j], ub_a[j]),
+                                 Interval(lb_b[j], ub_b[j]), b)};
+          empty[j] = r.is_empty();
+          lb[j] = empty[j] ? 0.0 : r.lb();
+          ub[j] = empty[j] ? 0.0 : r.ub();
+        }
+    }
+  }
+}
+
+bool ExpressionTape::Backward(const int i, const Interval& range,
+                              vector<Interval>* const values,
+                              bool* const narrowed) const {
+  DREAL_ASSERT(static_cast<int>(values->size()) == size());
+  Interval* const v{values->data()};
+  const int root{roots_[i]};
+  const Interval old_root{v[root]};
+  v[root] &= range;
+  if (v[root].is_empty()) {
+    return false;
+  }
+  if (narrowed && v[root] != old_root) {
+    *narrowed = true;
+  }
+
+  // Since the operands of a node come before the node, visiting the
+  // nodes in reverse order guarantees that all the users of a node
+  // are processed before the node itself.
+  const int* const first{root_nodes_.data() + root_offsets_[i]};
+  for (const int* it = root_nodes_.data() + root_offsets_[i + 1];
+       it != first;) {
+    const int k{*--it};
+    const Op op{ops_[k]};
+    const int num_operands{NumOperands(op)};
+    if (num_operands == 0) {
+      continue;
+    }
+    const int a{arg1_[k]};
+    const int b{arg2_[k]};
+    const Interval& y{v[k]};
+    // Keep the old values of the operands to detect a change.
+    const bool track{narrowed && !*narrowed};
+    const Interval old_a{track ? v[a] : Interval{}};
+    const Interval old_b{track && num_operands == 2 ? v[b] : Interval{}};
+    bool ok{true};
+    switch (op) {
+      case Op::Const:
+      case Op::Var:
+        break;
+      case Op::Add:
+        ok = BackwardBinary(ibex::bwd_add, y, &v[a], &v[b]);
+        break;
+      case Op::Sub:
+        ok = BackwardBinary(ibex::bwd_sub, y, &v[a], &v[b]);
+        break;
+      case Op::Mul:
+        ok = BackwardBinary(ibex::bwd_mul, y, &v[a], &v[b]);
+        break;
+      case Op::Div:
+        ok = BackwardBinary(ibex::bwd_div, y, &v[a], &v[b]);
+        break;
+      case Op::Neg:
+        v[a] &= -y;
+        ok = !v[a].is_empty();
+        break;
+      case Op::PowInt:
+        ok = ibex::bwd_pow(y, b, v[a]);
+        break;
+      case Op::Pow:
+        ok = BackwardBinary(ibex::bwd_pow, y, &v[a], &v[b]);
+        break;
+      case Op::Sqrt:
+        ok = ibex::bwd_sqrt(y, v[a]);
+        break;
+      case Op::Exp:
+        ok = ibex::bwd_exp(y, v[a]);
+        break;
+      case Op::Log:
+        ok = ibex::bwd_log(y, v[a]);
+        break;
+      case Op::Abs:
+        ok = ibex::bwd_abs(y, v[a]);
+        break;
+      case Op::Sin:
+        ok = ibex::bwd_sin(y, v[a]);
+        break;
+      case Op::Cos:
+        ok = ibex::bwd_cos(y, v[a]);
+        break;
+      case Op::Tan:
+        ok = ibex::bwd_tan(y, v[a]);
+        break;
+      case Op::Asin:
+        ok = ibex::bwd_asin(y, v[a]);
+        break;
+      case Op::Acos:
+        ok = ibex::bwd_acos(y, v[a]);
+        break;
+      case Op::Atan:
+        ok = ibex::bwd_atan(y, v[a]);
+        break;
+      case Op::Atan2:
+        ok = BackwardBinary(ibex::bwd_atan2, y, &v[a], &v[b]);
+        break;
+      case Op::Sinh:
+        ok = ibex::bwd_sinh(y, v[a]);
+        break;
+      case Op::Cosh:
+        ok = ibex::bwd_cosh(y, v[a]);
+        break;
+      case Op::Tanh:
+        ok = ibex::bwd_tanh(y, v[a]);
+        break;
+      case Op::Min:
+        ok = BackwardBinary(ibex::bwd_min, y, &v[a], &v[b]);
+        break;
+      case Op::Max:
+        ok = BackwardBinary(ibex::bwd_max, y, &v[a], &v[b]);
+        break;
+    }
+    if (!ok) {
+      return false;
+    }
+    if (track &&
+        (v[a] != old_a || (num_operands == 2 && v[b] != old_b))) {
+      *narrowed = true;
+    }
+  }
+  return true;
+}
+
+void ExpressionTape::Update(const vector<Interval>& values,
+                            Box::IntervalVector* const iv,
+                            DynamicBitset* const output,
+                            bool* const changed) const {
+  for (const auto& p : var_nodes_) {
+    const Interval& projection{values[p.first]};
+    Interval& x{(*iv)[p.second]};
+    if (projection != x) {
+      x = projection;
+      output->set(p.second);
+      *changed = true;
+    }
+  }
+}
+
+bool ExpressionTape::Revise(const Interval& range,
+                            Box::IntervalVector* const iv,
+                            vector<Interval>* const values,
+                            DynamicBitset* const output,
+                            bool* const changed) const {
+  DREAL_ASSERT(num_roots() == 1);
+  if (!Forward(*iv, values) || !Backward(0, range, values, nullptr)) {
+    return false;
+  }
+  Update(*values, iv, output, changed);
+  return true;
+}
+
+ostream& operator<<(ostream& os, const Op op) {
+  switch (op) {
+    case Op::Const:
+      return os << "const";
+    case Op::Var:
+      return os << "var";
+    case Op::Add:
+      return os << "add";
+    case Op::Sub:
+      return os << "sub";
+    case Op::Mul:
+      return os << "mul";
+    case Op::Div:
+      return os << "div";
+    case Op::Neg:
+      return os << "neg";
+    case Op::PowInt:
+      return os << "pow_int";
+    case Op::Pow:
+      return os << "pow";
+    case Op::Sqrt:
+      return os << "sqrt";
+    case Op::Exp:
+      return os << "exp";
+    case Op::Log:
+      return os << "log";
+    case Op::Abs:
+      return os << "abs";
+    case Op::Sin:
+      return os << "sin";
+    case Op::Cos:
+      return os << "cos";
+    case Op::Tan:
+      return os << "tan";
+    case Op::Asin:
+      return os << "asin";
+    case Op::Acos:
+      return os << "acos";
+    case Op::Atan:
+      return os << "atan";
+    case Op::Atan2:
+      return os << "atan2";
+    case Op::Sinh:
+      return os << "sinh";
+    case Op::Cosh:
+      return os << "cosh";
+    case Op::Tanh:
+      return os << "tanh";
+    case Op::Min:
+      return os << "min";
+    case Op::Max:
+      return os << "max";
+  }
+  DREAL_UNREACHABLE();
+}
+
+ostream& operator<<(ostream& os, const ExpressionTape& tape) {
+  for (int i = 0; i < tape.size(); ++i) {
+    os << "%" << i << " = " << tape.ops_[i];
+    switch (tape.ops_[i]) {
+      case Op::Const:
+        os << " " << tape.constants_[tape.arg1_[i]];
+        break;
+      case Op::Var:
+        os << " #" << tape.arg1_[i];
+        break;
+      case Op::PowInt:
+        os << " %" << tape.arg1_[i] << " " << tape.arg2_[i];
+        break;
+      default:
+        os << " %" << tape.arg1_[i];
+        if (tape.arg2_[i] >= 0) {
+          os << " %" << tape.arg2_[i];
+        }
+    }
+    os << "\n";
+  }
+  return os;
+}
+
+}  // namespace dreal
@@ -0,0 +1,213 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+#include "dreal/util/dynamic_bitset.h"
+
+namespace dreal {
+
+class ExpressionTapeBuilder;
+
+/// A symbolic expression compiled into a flat instruction tape.
+///
+/// The nodes of the expression are stored in post-order, that is, the
+/// operands of a node always come before the node itself. A tape may
+/// have multiple roots, one per compiled expression. Each node is
+/// described by three parallel arrays (op, arg1, arg2) and its interval
+/// value is kept in a separate scratch vector provided by a caller.
+/// Common sub-expressions are shared, even across different roots, so
+/// the tape is a DAG rather than a tree.
+///
+/// A tape is immutable once it is constructed. Therefore, one tape can
+/// be used by multiple threads at the same time as long as each thread
+/// uses its own scratch vector.
+class ExpressionTape {
+ public:
+  /// Operations in a tape.
+  enum class Op : std::uint8_t {
+    Const,   ///< constants_[arg1]
+    Var,     ///< box[arg1]
+    Add,     ///< arg1 + arg2
+    Sub,     ///< arg1 - arg2
+    Mul,     ///< arg1 * arg2
+    Div,     ///< arg1 / arg2
+    Neg,     ///< -arg1
+    PowInt,  ///< arg1 ^ n where n = arg2 is an integer
+    Pow,     ///< arg1 ^ arg2
+    Sqrt,
+    Exp,
+    Log,
+    Abs,
+    Sin,
+    Cos,
+    Tan,
+    Asin,
+    Acos,
+    Atan,
+    Atan2,  ///< atan2(arg1, arg2)
+    Sinh,
+    Cosh,
+    Tanh,
+    Min,
+    Max,
+  };
+
+  /// Values of the nodes over a batch of boxes, kept in a
+  /// structure-of-arrays layout. The value of the k-th node over the
+  /// j-th box is `[lb[k * n + j], ub[k * n + j]]`, or the empty set if
+  /// `empty[k * n + j]` is non-zero.
+  struct BatchValues {
+    /// Returns the value of the @p k -th node over the @p j -th box.
+    Box::Interval value(int k, int j) const;
+
+    int n{0};  ///< The number of boxes.
+    std::vector<double> lb;
+    std::vector<double> ub;
+    std::vector<std::uint8_t> empty;
+  };
+
+  /// Deleted default constructor.
+  ExpressionTape() = delete;
+
+  /// Compiles @p e whose variables are in @p box.
+  ///
+  /// @throws std::runtime_error if @p e includes an if-then-else
+  /// expression, an uninterpreted function, or a variable which is not
+  /// in @p box.
+  ExpressionTape(const Expression& e, const Box& box);
+
+  /// Compiles @p roots whose variables are in @p box into a single
+  /// tape. A sub-expression which appears in multiple roots is compiled
+  /// only once. The i-th root of the tape corresponds to `roots[i]`.
+  ///
+  /// @throws std::runtime_error if one of @p roots includes an
+  /// if-then-else expression, an uninterpreted function, or a variable
+  /// which is not in @p box.
+  ExpressionTape(const std::vector<Expression>& roots, const Box& box);
+
+  /// Default copy constructor.
+  ExpressionTape(const ExpressionTape&) = default;
+
+  /// Default move constructor.
+  ExpressionTape(ExpressionTape&&) = default;
+
+  /// Deleted copy assign operator.
+  ExpressionTape& operator=(const ExpressionTape&) = delete;
+
+  /// Deleted move assign operator.
+  ExpressionTape& operator=(ExpressionTape&&) = delete;
+
+  /// Default destructor.
+  ~ExpressionTape() = default;
+
+  /// Returns the number of nodes.
+  int size() const { return static_cast<int>(ops_.size()); }
+
+  /// Returns the number of roots.
+  int num_roots() const { return static_cast<int>(roots_.size()); }
+
+  /// Returns the node of the @p i -th root.
+  int root(int i) const { return roots_[i]; }
+
+  /// Evaluates the expression over @p iv and returns the value of the
+  /// first root. The values of all nodes are written into @p values which
+  /// is resized if needed.
+  Box::Interval Evaluate(const Box::IntervalVector& iv,
+                         std::vector<Box::Interval>* values) const;
+
+  /// Evaluates all nodes over @p iv and writes their values into @p
+  /// values which is resized if needed. Returns false if a node has an
+  /// empty value.
+  bool Forward(const Box::IntervalVector& iv,
+               std::vector<Box::Interval>* values) const;
+
+  /// Evaluates all nodes over the boxes in @p boxes at once and writes
+  /// their values into @p values. Unlike Forward, it runs over a node
+  /// for all the boxes before moving to the next node. The arithmetic
+  /// operations are done by branch-free kernels over the rows of @p
+  /// values, which a compiler can vectorize (see `--config=native` in
+  /// .bazelrc), and the rest are done by IBEX box by box. The results
+  /// are sound, but they can be a few ulps wider than the ones from
+  /// Forward.
+  void EvaluateBatch(const std::vector<const Box::IntervalVector*>& boxes,
+                     BatchValues* values) const;
+
+  /// Intersects the value of the @p i -th root with @p range and
+  /// projects it backward down to the variables. Only the nodes which
+  /// are reachable from the root are visited. @p values should hold
+  /// the result of Forward (possibly narrowed by the backward passes
+  /// of other roots).
+  ///
+  /// If @p narrowed is not nullptr, it is set true when this pass
+  /// narrows the value of a node. Returns false if it detects that the
+  /// constraint has no solution.
+  bool Backward(int i, const Box::Interval& range,
+                std::vector<Box::Interval>* values, bool* narrowed) const;
+
+  /// Writes the values of the variable nodes in @p values back to @p
+  /// iv. It sets the dimensions of @p iv which are changed in @p output
+  /// and sets @p changed true if there is such a dimension.
+  void Update(const std::vector<Box::Interval>& values,
+              Box::IntervalVector* iv, DynamicBitset* output,
+              bool* changed) const;
+
+  /// Contracts @p iv with respect to the constraint `e ∈ range` by
+  /// running HC4Revise, that is, a forward evaluation followed by a
+  /// backward projection from the root down to the variables. @p
+  /// values is used as scratch space.
+  ///
+  /// It sets the dimensions of @p iv which are changed in @p output
+  /// and sets @p changed true if there is such a dimension. It returns
+  /// false if it detects that the constraint has no solution in @p iv.
+  /// In this case, @p iv is unspecified.
+  ///
+  /// @pre The tape has a single root.
+  bool Revise(const Box::Interval& range, Box::IntervalVector* iv,
+              std::vector<Box::Interval>* values, DynamicBitset* output,
+              bool* changed) const;
+
+  friend std::ostream& operator<<(std::ostream& os, const ExpressionTape& tape);
+
+ private:
+  std::vector<Op> ops_;
+  std::vector<int> arg1_;
+  std::vector<int> arg2_;
+  std::vector<Box::Interval> constants_;
+
+  // Pairs of (node, dimension) for the Var nodes.
+  std::vector<std::pair<int, int>> var_nodes_;
+
+  // Root nodes.
+  std::vector<int> roots_;
+
+  // The nodes reachable from the i-th root, in ascending order, are
+  // stored in root_nodes_[root_offsets_[i] .. root_offsets_[i + 1]).
+  std::vector<int> root_offsets_;
+  std::vector<int> root_nodes_;
+
+  friend class ExpressionTapeBuilder;
+};
+
+std::ostream& operator<<(std::ostream& os, ExpressionTape::Op op);
+
+}  // namespace dreal
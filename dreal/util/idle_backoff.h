@@ -0,0 +1,60 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <chrono>
+#include <thread>
+
+namespace dreal {
+
+/// Idle/backoff protocol for a worker thread which has nothing to do.
+///
+/// It first yields the processor a few times, which is cheap when other
+/// workers are about to publish work, and then sleeps for exponentially
+/// increasing periods (bounded by 2^kMaxShift microseconds) so that idle
+/// workers do not keep cores busy while a few workers are making
+/// progress. Call Reset() once the worker finds something to do.
+class IdleBackoff {
+ public:
+  /// Number of times that an idle worker yields before it starts
+  /// sleeping.
+  static constexpr int kNumYields{16};
+
+  /// The longest sleep of an idle worker is 2^kMaxShift = 256
+  /// microseconds.
+  static constexpr int kMaxShift{8};
+
+  /// Waits for a while.
+  void Idle() {
+    if (num_idle_ < kNumYields) {
+      std::this_thread::yield();
+    } else {
+      const int shift{num_idle_ - kNumYields};
+      std::this_thread::sleep_for(std::chrono::microseconds(1 << shift));
+    }
+    if (num_idle_ < kNumYields + kMaxShift) {
+      ++num_idle_;
+    }
+  }
+
+  /// Resets the backoff period.
+  void Reset() { num_idle_ = 0; }
+
+ private:
+  int num_idle_{0};
+};
+
+}  // namespace dreal
@@ -0,0 +1,354 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/util/socket.h"
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <utility>
+
+#include "dreal/util/exception.h"
+
+namespace dreal {
+
+using std::string;
+using std::vector;
+
+namespace {
+
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags{MSG_NOSIGNAL};
+#else
+constexpr int kSendFlags{0};
+#endif
+
+// The maximum size of a message. A header with a larger size is
+// rejected instead of allocating a buffer for it.
+constexpr std::uint64_t kMaxMessageSize{std::uint64_t{1} << 28};
+
+// Parsed form of an address, `unix:<path>` or `tcp:<host>:<port>`.
+struct Address {
+  bool is_unix{false};
+  string path;  // Used if is_unix.
+  string host;  // Used if !is_unix.
+  string port;  // Used if !is_unix.
+};
+
+Address ParseAddress(const string& address) {
+  Address result;
+  if (address.compare(0, 5, "unix:") == 0) {
+    result.is_unix = true;
+    result.path = address.substr(5);
+    if (result.path.empty() ||
+        result.path.size() >= sizeof(sockaddr_un::sun_path)) {
+      throw DREAL_RUNTIME_ERROR("Invalid Unix socket path: {}", address);
+    }
+    return result;
+  }
+  if (address.compare(0, 4, "tcp:") == 0) {
+    const string rest{address.substr(4)};
+    const string::size_type colon{rest.rfind(':')};
+    if (colon == string::npos || colon + 1 == rest.size()) {
+      throw DREAL_RUNTIME_ERROR("Invalid TCP address (no port): {}", address);
+    }
+    result.host = rest.substr(0, colon);
+    result.port = rest.substr(colon + 1);
+    return result;
+  }
+  throw DREAL_RUNTIME_ERROR(
+      "Invalid address {}. It should be unix:<path> or tcp:<host>:<port>.",
+      address);
+}
+
+sockaddr_un MakeUnixAddress(const string& path) {
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+  return addr;
+}
+
+// Returns the list of TCP addresses for `host` and `port`. The caller
+// should free it with freeaddrinfo.
+addrinfo* ResolveTcpAddress(const Address& address, const bool passive) {
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = passive ? AI_PASSIVE : 0;
+  addrinfo* result{nullptr};
+  const char* const host{address.host.empty() ? nullptr
+                                              : address.host.c_str()};
+  const int rc{getaddrinfo(host, address.port.c_str(), &hints, &result)};
+  if (rc != 0) {
+    throw DREAL_RUNTIME_ERROR("getaddrinfo({}:{}) failed: {}", address.host,
+                              address.port, gai_strerror(rc));
+  }
+  return result;
+}
+
+void SetNoDelay(const int fd) {
+  const int one{1};
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+// Tries to connect to `address` once. Returns -1 if it fails.
+int TryConnect(const Address& address) {
+  if (address.is_unix) {
+    const int fd{socket(AF_UNIX, SOCK_STREAM, 0)};
+    if (fd < 0) {
+      throw DREAL_RUNTIME_ERROR("socket() failed: {}", std::strerror(errno));
+    }
+    const sockaddr_un addr{MakeUnixAddress(address.path)};
+    if (connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) ==
+        0) {
+      return fd;
+    }
+    close(fd);
+    return -1;
+  }
+  addrinfo* const addresses{ResolveTcpAddress(address, false)};
+  int fd{-1};
+  for (addrinfo* p = addresses; p != nullptr; p = p->ai_next) {
+    fd = socket(p->ai_family, p->ai_socktype, p->ai_protocol);
+    if (fd < 0) {
+      continue;
+    }
+    if (connect(fd, p->ai_addr, p->ai_addrlen) == 0) {
+      SetNoDelay(fd);
+      break;
+    }
+    close(fd);
+    fd = -1;
+  }
+  freeaddrinfo(addresses);
+  return fd;
+}
+
+void SendAll(const int fd, const char* data, std::size_t size) {
+  while (size > 0) {
+    const ssize_t n{send(fd, data, size, kSendFlags)};
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw DREAL_RUNTIME_ERROR("send() failed: {}", std::strerror(errno));
+    }
+    data += n;
+    size -= static_cast<std::size_t>(n);
+  }
+}
+
+void ReceiveAll(const int fd, char* data, std::size_t size) {
+  while (size > 0) {
+    const ssize_t n{recv(fd, data, size, 0)};
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw DREAL_RUNTIME_ERROR("recv() failed: {}", std::strerror(errno));
+    }
+    if (n == 0) {
+      throw DREAL_RUNTIME_ERROR("The connection is closed by the peer.");
+    }
+    data += n;
+    size -= static_cast<std::size_t>(n);
+  }
+}
+
+}  // namespace
+
+SocketChannel::SocketChannel(const int fd) : fd_{fd} {}
+
+SocketChannel::SocketChannel(SocketChannel&& other) noexcept
+    : fd_{other.fd_} {
+  other.fd_ = -1;
+}
+
+SocketChannel& SocketChannel::operator=(SocketChannel&& other) noexcept {
+  if (this != &other) {
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+    fd_ = other.fd_;
+    other.fd_ = -1;
+  }
+  return *this;
+}
+
+SocketChannel::~SocketChannel() {
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
+
+void SocketChannel::Send(const string& message) {
+  char header[8];
+  const std::uint64_t size{message.size()};
+  if (size > kMaxMessageSize) {
+    throw DREAL_RUNTIME_ERROR(
+        "The message is too large to send: {} bytes (max = {}).", size,
+        kMaxMessageSize);
+  }
+  for (int i = 0; i < 8; ++i) {
+    header[i] = static_cast<char>((size >> (8 * i)) & 0xFF);
+  }
+  SendAll(fd_, header, sizeof(header));
+  SendAll(fd_, message.data(), message.size());
+}
+
+string SocketChannel::Receive() {
+  char header[8];
+  ReceiveAll(fd_, header, sizeof(header));
+  std::uint64_t size{0};
+  for (int i = 0; i < 8; ++i) {
+    size |= static_cast<std::uint64_t>(static_cast<unsigned char>(header[i]))
+            << (8 * i);
+  }
+  if (size > kMaxMessageSize) {
+    throw DREAL_RUNTIME_ERROR(
+        "Received a header of a too large message: {} bytes (max = {}).",
+        size, kMaxMessageSize);
+  }
+  string message(size, '\0');
+  if (size > 0) {
+    ReceiveAll(fd_, &message[0], size);
+  }
+  return message;
+}
+
+SocketListener::SocketListener(const string& address) {
+  const Address parsed{ParseAddress(address)};
+  if (parsed.is_unix) {
+    fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd_ < 0) {
+      throw DREAL_RUNTIME_ERROR("socket() failed: {}", std::strerror(errno));
+    }
+    // Remove a stale socket file left by a previous run. We do not
+    // touch the path if it is not a socket.
+    struct stat st {};
+    if (lstat(parsed.path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) {
+      unlink(parsed.path.c_str());
+    }
+    const sockaddr_un addr{MakeUnixAddress(parsed.path)};
+    if (bind(fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) !=
+        0) {
+      const string error{std::strerror(errno)};
+      close(fd_);
+      throw DREAL_RUNTIME_ERROR("bind({}) failed: {}", address, error);
+    }
+    unix_path_ = parsed.path;
+  } else {
+    addrinfo* const addresses{ResolveTcpAddress(parsed, true)};
+    for (addrinfo* p = addresses; p != nullptr; p = p->ai_next) {
+      fd_ = socket(p->ai_family, p->ai_socktype, p->ai_protocol);
+      if (fd_ < 0) {
+        continue;
+      }
+      const int one{1};
+      setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+      if (bind(fd_, p->ai_addr, p->ai_addrlen) == 0) {
+        break;
+      }
+      close(fd_);
+      fd_ = -1;
+    }
+    freeaddrinfo(addresses);
+    if (fd_ < 0) {
+      throw DREAL_RUNTIME_ERROR("bind({}) failed: {}", address,
+                                std::strerror(errno));
+    }
+  }
+  if (listen(fd_, SOMAXCONN) != 0) {
+    const string error{std::strerror(errno)};
+    close(fd_);
+    throw DREAL_RUNTIME_ERROR("listen({}) failed: {}", address, error);
+  }
+}
+
+SocketListener::~SocketListener() {
+  close(fd_);
+  if (!unix_path_.empty()) {
+    unlink(unix_path_.c_str());
+  }
+}
+
+SocketChannel SocketListener::Accept() {
+  while (true) {
+    const int fd{accept(fd_, nullptr, nullptr)};
+    if (fd >= 0) {
+      if (unix_path_.empty()) {
+        SetNoDelay(fd);
+      }
+      return SocketChannel{fd};
+    }
+    if (errno != EINTR) {
+      throw DREAL_RUNTIME_ERROR("accept() failed: {}", std::strerror(errno));
+    }
+  }
+}
+
+SocketChannel ConnectSocket(const string& address, const double timeout) {
+  const Address parsed{ParseAddress(address)};
+  const auto deadline{std::chrono::steady_clock::now() +
+                      std::chrono::duration<double>(timeout)};
+  while (true) {
+    const int fd{TryConnect(parsed)};
+    if (fd >= 0) {
+      return SocketChannel{fd};
+    }
+    if (std::chrono::steady_clock::now() >= deadline) {
+      throw DREAL_RUNTIME_ERROR("Failed to connect to {}: {}", address,
+                                std::strerror(errno));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+}
+
+int WaitForMessage(const vector<SocketChannel*>& channels) {
+  vector<pollfd> fds(channels.size());
+  for (size_t i = 0; i < channels.size(); ++i) {
+    fds[i].fd = channels[i]->fd();
+    fds[i].events = POLLIN;
+  }
+  while (true) {
+    const int rc{poll(fds.data(), fds.size(), -1)};
+    if (rc < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw DREAL_RUNTIME_ERROR("poll() failed: {}", std::strerror(errno));
+    }
+    for (size_t i = 0; i < fds.size(); ++i) {
+      // POLLHUP and POLLERR are also reported here. The following
+      // Receive call on the channel will throw an exception.
+      if (fds[i].revents != 0) {
+        return static_cast<int>(i);
+      }
+    }
+  }
+}
+
+}  // namespace dreal
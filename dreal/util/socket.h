@@ -0,0 +1,109 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace dreal {
+
+/// A connected stream socket which exchanges messages. A message is an
+/// arbitrary byte string of at most 256 MiB; it is sent with its length
+/// (8 bytes, little-endian) in front of it. Receive() rejects a header
+/// with a larger length instead of allocating a buffer for it.
+///
+/// Addresses are written as `unix:<path>` for a Unix domain socket or
+/// `tcp:<host>:<port>` for a TCP socket.
+///
+/// All the methods throw std::runtime_error when an underlying system
+/// call fails, the peer closes the connection, or a message is too
+/// large.
+class SocketChannel {
+ public:
+  /// Constructs a channel owning a connected socket @p fd.
+  explicit SocketChannel(int fd);
+
+  /// Deleted copy constructor.
+  SocketChannel(const SocketChannel&) = delete;
+
+  /// Move constructor.
+  SocketChannel(SocketChannel&& other) noexcept;
+
+  /// Deleted copy assignment operator.
+  SocketChannel& operator=(const SocketChannel&) = delete;
+
+  /// Move assignment operator.
+  SocketChannel& operator=(SocketChannel&& other) noexcept;
+
+  /// Closes the socket.
+  ~SocketChannel();
+
+  /// Sends @p message.
+  void Send(const std::string& message);
+
+  /// Receives a message. It blocks until a whole message arrives.
+  std::string Receive();
+
+  /// Returns the file descriptor of the socket.
+  int fd() const { return fd_; }
+
+ private:
+  int fd_{-1};
+};
+
+/// A listening socket which accepts connections from
+/// ConnectSocket. For a Unix domain socket, a stale socket file at the
+/// path is replaced (other kinds of files are left untouched and
+/// binding fails), and the socket file is removed when the listener is
+/// destructed.
+class SocketListener {
+ public:
+  /// Binds to @p address and starts listening.
+  explicit SocketListener(const std::string& address);
+
+  /// Deleted copy constructor.
+  SocketListener(const SocketListener&) = delete;
+
+  /// Deleted move constructor.
+  SocketListener(SocketListener&&) = delete;
+
+  /// Deleted copy assignment operator.
+  SocketListener& operator=(const SocketListener&) = delete;
+
+  /// Deleted move assignment operator.
+  SocketListener& operator=(SocketListener&&) = delete;
+
+  /// Closes the socket.
+  ~SocketListener();
+
+  /// Accepts a connection. It blocks until a peer connects.
+  SocketChannel Accept();
+
+ private:
+  int fd_{-1};
+  // The path of the socket file if it is a Unix domain socket.
+  std::string unix_path_;
+};
+
+/// Connects to a SocketListener at @p address. As the listener may not
+/// be ready yet, it keeps trying for @p timeout seconds.
+SocketChannel ConnectSocket(const std::string& address, double timeout);
+
+/// Waits until a message arrives at one of @p channels, and returns the
+/// index of the channel.
+int WaitForMessage(const std::vector<SocketChannel*>& channels);
+
+}  // namespace dreal
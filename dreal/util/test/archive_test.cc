@@ -0,0 +1,92 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/util/archive.h"
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "dreal/symbolic/symbolic.h"
+
+using std::numeric_limits;
+using std::string;
+
+namespace dreal {
+namespace {
+
+GTEST_TEST(ArchiveTest, Values) {
+  OutputArchive out;
+  out.WriteUint64(numeric_limits<std::uint64_t>::max());
+  out.WriteInt64(-42);
+  out.WriteDouble(0.1);
+  out.WriteDouble(-numeric_limits<double>::infinity());
+  out.WriteString("hello world");
+  out.WriteString("");
+
+  const string data{out.release()};
+  EXPECT_TRUE(out.data().empty());
+
+  InputArchive in{data};
+  EXPECT_EQ(in.ReadUint64(), numeric_limits<std::uint64_t>::max());
+  EXPECT_EQ(in.ReadInt64(), -42);
+  EXPECT_EQ(in.ReadDouble(), 0.1);
+  EXPECT_EQ(in.ReadDouble(), -numeric_limits<double>::infinity());
+  EXPECT_EQ(in.ReadString(), "hello world");
+  EXPECT_EQ(in.ReadString(), "");
+  EXPECT_TRUE(in.done());
+  EXPECT_THROW(in.ReadInt64(), std::runtime_error);
+}
+
+GTEST_TEST(ArchiveTest, Box) {
+  const Variable x{"x"};
+  const Variable y{"y"};
+  const Variable i{"i", Variable::Type::INTEGER};
+  Box box{{x, y, i}};
+  box[x] = Box::Interval(0.1, 0.3);
+  box[y] = Box::Interval(-numeric_limits<double>::infinity(), 2.0);
+  box[i] = Box::Interval(-3, 5);
+
+  OutputArchive out;
+  WriteBox(box, &out);
+  Box empty_box{box};
+  empty_box.set_empty();
+  WriteBox(empty_box, &out);
+
+  InputArchive in{out.data()};
+  Box box2{{x, y, i}};
+  ReadBox(&in, &box2);
+  EXPECT_EQ(box, box2);
+  Box box3{{x, y, i}};
+  ReadBox(&in, &box3);
+  EXPECT_TRUE(box3.empty());
+  EXPECT_TRUE(in.done());
+}
+
+GTEST_TEST(ArchiveTest, BoxSizeMismatch) {
+  const Variable x{"x"};
+  const Variable y{"y"};
+  OutputArchive out;
+  WriteBox(Box{{x}}, &out);
+  InputArchive in{out.data()};
+  Box box{{x, y}};
+  EXPECT_THROW(ReadBox(&in, &box), std::runtime_error);
+}
+
+}  // namespace
+}  // namespace dreal
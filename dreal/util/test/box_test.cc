@@ -240,6 +240,21 @@ TEST_F(BoxTest, BisectBinary) {
   EXPECT_EQ(box2[i_], box[i_]);
 }
 
+TEST_F(BoxTest, BisectInterval) {
+  Box box;
+  box.Add(x_, -10, 10);
+  box.Add(i_, -5, 5);
+  box.Add(b1_, 0, 1);
+
+  for (const Variable& var : {x_, i_, b1_}) {
+    const int idx{box.index(var)};
+    const pair<Box, Box> p{box.bisect(idx)};
+    const pair<Box::Interval, Box::Interval> q{box.bisect_interval(idx)};
+    EXPECT_EQ(p.first[idx], q.first);
+    EXPECT_EQ(p.second[idx], q.second);
+  }
+}
+
 TEST_F(BoxTest, NotBisectable) {
   Box box;
   // x = [10, 10 + ε]
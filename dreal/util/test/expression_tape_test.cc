@@ -0,0 +1,246 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/util/expression_tape.h"
+
+#include <cfenv>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dreal/util/rounding_mode_guard.h"
+
+namespace dreal {
+namespace {
+
+using std::vector;
+
+class ExpressionTapeTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    box_[x_] = Box::Interval(-1.0, 2.0);
+    box_[y_] = Box::Interval(0.0, 3.0);
+    box_[z_] = Box::Interval(-5.0, 5.0);
+  }
+
+  const Variable x_{"x", Variable::Type::CONTINUOUS};
+  const Variable y_{"y", Variable::Type::CONTINUOUS};
+  const Variable z_{"z", Variable::Type::CONTINUOUS};
+  Box box_{{x_, y_, z_}};
+  vector<Box::Interval> values_;
+};
+
+TEST_F(ExpressionTapeTest, Evaluate) {
+  const ExpressionTape tape{2 * x_ + y_, box_};
+  const Box::Interval v{tape.Evaluate(box_.interval_vector(), &values_)};
+  EXPECT_EQ(v, Box::Interval(-2.0, 7.0));
+}
+
+TEST_F(ExpressionTapeTest, CommonSubexpression) {
+  // e = sin(x + y) has four nodes: x, y, x + y, and sin(x + y).
+  const Expression e{sin(x_ + y_)};
+  const ExpressionTape tape_single{e, box_};
+  EXPECT_EQ(tape_single.size(), 4);
+  // e appears twice in e² + e but it is compiled only once. We only
+  // have two more nodes, e² and e² + e.
+  const ExpressionTape tape{e * e + e, box_};
+  EXPECT_EQ(tape.size(), tape_single.size() + 2);
+}
+
+TEST_F(ExpressionTapeTest, ReviseLinear) {
+  // x + y = 4 with x ∈ [-1, 2], y ∈ [0, 3] ⇒ x ∈ [1, 2], y ∈ [2, 3].
+  const ExpressionTape tape{x_ + y_ - 4, box_};
+  DynamicBitset output(box_.size());
+  bool changed{false};
+  Box::IntervalVector& iv{box_.mutable_interval_vector()};
+  EXPECT_TRUE(
+      tape.Revise(Box::Interval(0.0), &iv, &values_, &output, &changed));
+  EXPECT_TRUE(changed);
+  EXPECT_EQ(box_[x_], Box::Interval(1.0, 2.0));
+  EXPECT_EQ(box_[y_], Box::Interval(2.0, 3.0));
+  EXPECT_EQ(box_[z_], Box::Interval(-5.0, 5.0));
+  EXPECT_TRUE(output[0]);
+  EXPECT_TRUE(output[1]);
+  EXPECT_FALSE(output[2]);
+}
+
+TEST_F(ExpressionTapeTest, ReviseNonlinear) {
+  // z² ≤ 4 ⇒ z ∈ [-2, 2].
+  const ExpressionTape tape{z_ * z_, box_};
+  DynamicBitset output(box_.size());
+  bool changed{false};
+  Box::IntervalVector& iv{box_.mutable_interval_vector()};
+  EXPECT_TRUE(tape.Revise(Box::Interval(-4.0, 4.0), &iv, &values_, &output,
+                          &changed));
+  EXPECT_TRUE(changed);
+  EXPECT_NEAR(box_[z_].lb(), -2.0, 1e-10);
+  EXPECT_NEAR(box_[z_].ub(), 2.0, 1e-10);
+  EXPECT_FALSE(output[0]);
+  EXPECT_FALSE(output[1]);
+  EXPECT_TRUE(output[2]);
+}
+
+TEST_F(ExpressionTapeTest, ReviseUnsat) {
+  // exp(x) + y ≤ 0 has no solution.
+  const ExpressionTape tape{exp(x_) + y_, box_};
+  DynamicBitset output(box_.size());
+  bool changed{false};
+  Box::IntervalVector& iv{box_.mutable_interval_vector()};
+  EXPECT_FALSE(tape.Revise(Box::Interval::NEG_REALS, &iv, &values_, &output,
+                           &changed));
+}
+
+TEST_F(ExpressionTapeTest, MultipleRoots) {
+  // sin(x + y) is shared by the two roots.
+  const Expression e{sin(x_ + y_)};
+  const ExpressionTape tape{{e + z_, e * z_}, box_};
+  // x, y, x + y, sin(x + y), z, and the two roots.
+  EXPECT_EQ(tape.size(), 7);
+  EXPECT_EQ(tape.num_roots(), 2);
+  EXPECT_EQ(tape.root(1), tape.size() - 1);
+}
+
+TEST_F(ExpressionTapeTest, BackwardMultipleRoots) {
+  // x + y = 4 and x - y = 0 ⇒ x ∈ [1, 2], y ∈ [2, 3] after the first
+  // pass and x ∈ [2, 2], y ∈ [2, 2] after the second pass.
+  const ExpressionTape tape{{x_ + y_ - 4, x_ - y_}, box_};
+  Box::IntervalVector& iv{box_.mutable_interval_vector()};
+  ASSERT_TRUE(tape.Forward(iv, &values_));
+  bool narrowed{false};
+  EXPECT_TRUE(tape.Backward(0, Box::Interval(0.0), &values_, &narrowed));
+  EXPECT_TRUE(narrowed);
+  narrowed = false;
+  EXPECT_TRUE(tape.Backward(1, Box::Interval(0.0), &values_, &narrowed));
+  EXPECT_TRUE(narrowed);
+  DynamicBitset output(box_.size());
+  bool changed{false};
+  tape.Update(values_, &iv, &output, &changed);
+  EXPECT_TRUE(changed);
+  EXPECT_EQ(box_[x_], Box::Interval(2.0));
+  EXPECT_EQ(box_[y_], Box::Interval(2.0));
+  EXPECT_FALSE(output[2]);
+}
+
+TEST_F(ExpressionTapeTest, BackwardNotNarrowed) {
+  // The second root does not depend on z and it narrows nothing.
+  const ExpressionTape tape{{z_ * z_, x_ + y_}, box_};
+  ASSERT_TRUE(tape.Forward(box_.interval_vector(), &values_));
+  bool narrowed{false};
+  EXPECT_TRUE(
+      tape.Backward(1, Box::Interval(-10.0, 10.0), &values_, &narrowed));
+  EXPECT_FALSE(narrowed);
+  // z² ∈ [-2, -1] has no solution.
+  EXPECT_FALSE(
+      tape.Backward(0, Box::Interval(-2.0, -1.0), &values_, &narrowed));
+}
+
+TEST_F(ExpressionTapeTest, EvaluateBatch) {
+  const ExpressionTape tape{{x_ * y_ - z_, sqrt(x_) + exp(y_)}, box_};
+  vector<Box> boxes(3, box_);
+  boxes[1][x_] = Box::Interval(0.1, 0.3);
+  boxes[1][y_] = Box::Interval(-0.7, 1.0 / 3);
+  boxes[2][x_] = Box::Interval(-2.0, -1.0);  // sqrt(x) is empty.
+  vector<const Box::IntervalVector*> ivs;
+  for (const Box& box : boxes) {
+    ivs.push_back(&box.interval_vector());
+  }
+  ExpressionTape::BatchValues batch_values;
+  tape.EvaluateBatch(ivs, &batch_values);
+  EXPECT_EQ(batch_values.n, 3);
+  for (int j = 0; j < 3; ++j) {
+    // The results of EvaluateBatch enclose the ones of Forward and
+    // they are at most a few ulps wider.
+    for (int i = 0; i < tape.num_roots(); ++i) {
+      const Box::Interval expected{
+          ExpressionTape{i == 0 ? x_ * y_ - z_ : sqrt(x_) + exp(y_), box_}
+              .Evaluate(boxes[j].interval_vector(), &values_)};
+      const Box::Interval actual{batch_values.value(tape.root(i), j)};
+      if (expected.is_empty()) {
+        EXPECT_TRUE(actual.is_empty());
+        continue;
+      }
+      EXPECT_TRUE(expected.is_subset(actual));
+      EXPECT_NEAR(actual.lb(), expected.lb(), 1e-14);
+      EXPECT_NEAR(actual.ub(), expected.ub(), 1e-14);
+    }
+  }
+  // x * y - z is exact over the first box.
+  EXPECT_EQ(batch_values.value(tape.root(0), 0), Box::Interval(-8.0, 11.0));
+}
+
+TEST_F(ExpressionTapeTest, EvaluateBatchUnderflow) {
+  // 1e-200 * 1e-200 underflows to zero, but the product is positive.
+  const ExpressionTape tape{x_ * y_, box_};
+  Box box{box_};
+  box[x_] = Box::Interval(1e-200);
+  box[y_] = Box::Interval(1e-200);
+  ExpressionTape::BatchValues batch_values;
+  tape.EvaluateBatch({&box.interval_vector()}, &batch_values);
+  const Box::Interval v{batch_values.value(tape.root(0), 0)};
+  EXPECT_LE(v.lb(), 0.0);
+  EXPECT_GT(v.ub(), 0.0);
+
+  // The same with a negative product.
+  box[y_] = Box::Interval(-1e-200);
+  tape.EvaluateBatch({&box.interval_vector()}, &batch_values);
+  const Box::Interval w{batch_values.value(tape.root(0), 0)};
+  EXPECT_LT(w.lb(), 0.0);
+  EXPECT_GE(w.ub(), 0.0);
+}
+
+TEST_F(ExpressionTapeTest, EvaluateBatchOverflow) {
+  // The sum and the product overflow. Those lanes are redone by IBEX.
+  const ExpressionTape tape{{x_ + y_, x_ * y_}, box_};
+  Box box{box_};
+  box[x_] = Box::Interval(1e308);
+  box[y_] = Box::Interval(1e308);
+  ExpressionTape::BatchValues batch_values;
+  tape.EvaluateBatch({&box.interval_vector()}, &batch_values);
+  for (int i = 0; i < tape.num_roots(); ++i) {
+    const Box::Interval v{batch_values.value(tape.root(i), 0)};
+    EXPECT_EQ(v.lb(), std::numeric_limits<double>::max());
+    EXPECT_EQ(v.ub(), std::numeric_limits<double>::infinity());
+  }
+}
+
+TEST_F(ExpressionTapeTest, EvaluateBatchRoundingMode) {
+  // The kernels need round-to-nearest mode. They should give the same
+  // result when they are called in another mode, and keep that mode.
+  const ExpressionTape tape{x_ * y_ - z_ + 0.1 * x_, box_};
+  ExpressionTape::BatchValues expected;
+  tape.EvaluateBatch({&box_.interval_vector()}, &expected);
+  for (const int mode : {FE_UPWARD, FE_DOWNWARD, FE_TOWARDZERO}) {
+    const RoundingModeGuard guard{mode};
+    ExpressionTape::BatchValues actual;
+    tape.EvaluateBatch({&box_.interval_vector()}, &actual);
+    EXPECT_EQ(fegetround(), mode);
+    EXPECT_EQ(actual.value(tape.root(0), 0), expected.value(tape.root(0), 0));
+  }
+}
+
+TEST_F(ExpressionTapeTest, UnknownVariable) {
+  const Variable w{"w", Variable::Type::CONTINUOUS};
+  EXPECT_THROW((ExpressionTape{x_ + w, box_}), std::runtime_error);
+}
+
+TEST_F(ExpressionTapeTest, IfThenElse) {
+  EXPECT_THROW((ExpressionTape{if_then_else(x_ > y_, x_, y_), box_}),
+               std::runtime_error);
+}
+
+}  // namespace
+}  // namespace dreal
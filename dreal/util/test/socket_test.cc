@@ -0,0 +1,114 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/util/socket.h"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+using std::string;
+using std::vector;
+
+namespace dreal {
+namespace {
+
+string MakeUnixAddress() {
+  return fmt::format("unix:/tmp/dreal_socket_test_{}.sock", getpid());
+}
+
+GTEST_TEST(SocketTest, SendReceive) {
+  const string address{MakeUnixAddress()};
+  SocketListener listener{address};
+  std::thread client{[&address]() {
+    SocketChannel channel{ConnectSocket(address, 10.0)};
+    // Echo two messages back.
+    for (int i = 0; i < 2; ++i) {
+      channel.Send(channel.Receive());
+    }
+  }};
+  SocketChannel server{listener.Accept()};
+  const string large(1 << 20, 'x');
+  server.Send("");
+  server.Send(large);
+  EXPECT_EQ(server.Receive(), "");
+  EXPECT_EQ(server.Receive(), large);
+  client.join();
+  // The client has closed the connection.
+  EXPECT_THROW(server.Receive(), std::runtime_error);
+}
+
+GTEST_TEST(SocketTest, WaitForMessage) {
+  const string address{MakeUnixAddress()};
+  SocketListener listener{address};
+  std::thread client{[&address]() {
+    SocketChannel channel1{ConnectSocket(address, 10.0)};
+    SocketChannel channel2{ConnectSocket(address, 10.0)};
+    channel2.Send("2");
+    // Wait until the server replies, so that it can read the message
+    // before the connections are closed.
+    channel2.Receive();
+  }};
+  SocketChannel server1{listener.Accept()};
+  SocketChannel server2{listener.Accept()};
+  EXPECT_EQ(WaitForMessage({&server1, &server2}), 1);
+  EXPECT_EQ(server2.Receive(), "2");
+  server2.Send("ok");
+  client.join();
+}
+
+GTEST_TEST(SocketTest, TooLargeMessage) {
+  const string address{MakeUnixAddress()};
+  SocketListener listener{address};
+  std::thread client{[&address]() {
+    SocketChannel channel{ConnectSocket(address, 10.0)};
+    // A header claiming a message of 2^40 bytes.
+    char header[8]{0, 0, 0, 0, 0, 1, 0, 0};
+    ASSERT_EQ(write(channel.fd(), header, sizeof(header)), 8);
+    channel.Receive();
+  }};
+  SocketChannel server{listener.Accept()};
+  EXPECT_THROW(server.Receive(), std::runtime_error);
+  server.Send("");
+  client.join();
+}
+
+GTEST_TEST(SocketTest, DoNotRemoveRegularFile) {
+  const string path{fmt::format("/tmp/dreal_socket_test_{}.txt", getpid())};
+  FILE* const fp{fopen(path.c_str(), "w")};
+  ASSERT_NE(fp, nullptr);
+  fclose(fp);
+  EXPECT_THROW(SocketListener{"unix:" + path}, std::runtime_error);
+  // The file is still there.
+  EXPECT_EQ(access(path.c_str(), F_OK), 0);
+  unlink(path.c_str());
+}
+
+GTEST_TEST(SocketTest, InvalidAddress) {
+  EXPECT_THROW(SocketListener{"foo:bar"}, std::runtime_error);
+  EXPECT_THROW(SocketListener{"tcp:localhost"}, std::runtime_error);
+  EXPECT_THROW(ConnectSocket("unix:/nonexistent/dreal.sock", 0.0),
+               std::runtime_error);
+}
+
+}  // namespace
+}  // namespace dreal
@@ -0,0 +1,102 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "dreal/util/work_stealing_deque.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace dreal {
+namespace {
+
+GTEST_TEST(WorkStealingDequeTest, OwnerIsLifoThiefIsFifo) {
+  WorkStealingDeque<int> deque;
+  EXPECT_TRUE(deque.empty());
+  deque.push(1);
+  deque.push(2);
+  deque.push(3);
+  EXPECT_EQ(deque.size(), 3);
+
+  int x{};
+  EXPECT_TRUE(deque.pop(x));
+  EXPECT_EQ(x, 3);
+  EXPECT_TRUE(deque.steal(x));
+  EXPECT_EQ(x, 1);
+  EXPECT_TRUE(deque.pop(x));
+  EXPECT_EQ(x, 2);
+
+  EXPECT_TRUE(deque.empty());
+  EXPECT_FALSE(deque.pop(x));
+  EXPECT_FALSE(deque.steal(x));
+}
+
+GTEST_TEST(WorkStealingDequeTest, Clear) {
+  WorkStealingDeque<int> deque;
+  deque.push(1);
+  deque.push(2);
+  deque.clear();
+  EXPECT_TRUE(deque.empty());
+}
+
+GTEST_TEST(WorkStealingDequeTest, Snapshot) {
+  WorkStealingDeque<int> deque;
+  deque.push(1);
+  deque.push(2);
+  deque.push(3);
+  EXPECT_EQ(deque.snapshot(), (std::vector<int>{1, 2, 3}));
+  // Taking a snapshot does not remove the items.
+  EXPECT_EQ(deque.size(), 3);
+}
+
+GTEST_TEST(WorkStealingDequeTest, ConcurrentSteal) {
+  constexpr int kNumItems{10000};
+  constexpr int kNumThieves{4};
+  WorkStealingDeque<int> deque;
+  for (int i = 0; i < kNumItems; ++i) {
+    deque.push(i);
+  }
+
+  std::atomic<int> num_taken{0};
+  std::atomic<int64_t> sum{0};
+  std::vector<std::thread> thieves;
+  for (int i = 0; i < kNumThieves; ++i) {
+    thieves.emplace_back([&deque, &num_taken, &sum]() {
+      int x{};
+      while (deque.steal(x)) {
+        ++num_taken;
+        sum += x;
+      }
+    });
+  }
+  int x{};
+  while (deque.pop(x)) {
+    ++num_taken;
+    sum += x;
+  }
+  for (auto& thief : thieves) {
+    thief.join();
+  }
+
+  // Every item is taken exactly once.
+  EXPECT_EQ(num_taken, kNumItems);
+  EXPECT_EQ(sum, static_cast<int64_t>(kNumItems) * (kNumItems - 1) / 2);
+}
+
+}  // namespace
+}  // namespace dreal
@@ -0,0 +1,128 @@
+/*
+   Copyright 2017 Toyota Research Institute
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace dreal {
+
+/// A double-ended queue used by work-stealing schedulers.
+///
+/// The owner of a deque uses it as a stack, pushing and popping items
+/// at its back. Other threads steal items from its front, so that they
+/// take the oldest (and typically the largest) pieces of work. Each
+/// deque has its own lock, so contention only happens between the
+/// owner and a thief on the same deque. The number of items is also
+/// kept in an atomic variable so that an idle thread can look for a
+/// victim without acquiring locks.
+template <typename T>
+class WorkStealingDeque {
+ public:
+  /// Constructs an empty deque.
+  WorkStealingDeque() = default;
+
+  /// Deleted copy constructor.
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+
+  /// Deleted move constructor.
+  WorkStealingDeque(WorkStealingDeque&&) = delete;
+
+  /// Deleted copy assignment operator.
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+  /// Deleted move assignment operator.
+  WorkStealingDeque& operator=(WorkStealingDeque&&) = delete;
+
+  /// Default destructor.
+  ~WorkStealingDeque() = default;
+
+  /// Pushes @p item at the back of the deque. Only the owner should
+  /// call this method.
+  void push(T item) {
+    std::lock_guard<std::mutex> guard{mutex_};
+    items_.push_back(std::move(item));
+    size_.store(static_cast<int>(items_.size()), std::memory_order_release);
+  }
+
+  /// Pops an item at the back of the deque and stores it in @p item.
+  /// Only the owner should call this method.
+  ///
+  /// @returns false if the deque is empty.
+  bool pop(T& item) {
+    if (empty()) {
+      return false;
+    }
+    std::lock_guard<std::mutex> guard{mutex_};
+    if (items_.empty()) {
+      return false;
+    }
+    item = std::move(items_.back());
+    items_.pop_back();
+    size_.store(static_cast<int>(items_.size()), std::memory_order_release);
+    return true;
+  }
+
+  /// Steals an item at the front of the deque and stores it in @p
+  /// item. Threads other than the owner should use this method.
+  ///
+  /// @returns false if the deque is empty.
+  bool steal(T& item) {
+    if (empty()) {
+      return false;
+    }
+    std::lock_guard<std::mutex> guard{mutex_};
+    if (items_.empty()) {
+      return false;
+    }
+    item = std::move(items_.front());
+    items_.pop_front();
+    size_.store(static_cast<int>(items_.size()), std::memory_order_release);
+    return true;
+  }
+
+  /// Returns the number of items in the deque. Note that the returned
+  /// value can be outdated when other threads access the deque.
+  int size() const { return size_.load(std::memory_order_acquire); }
+
+  /// Returns true if the deque is empty. Note that the returned value
+  /// can be outdated when other threads access the deque.
+  bool empty() const { return size() == 0; }
+
+  /// Returns a copy of the items in the deque, from the front to the
+  /// back.
+  std::vector<T> snapshot() const {
+    std::lock_guard<std::mutex> guard{mutex_};
+    return std::vector<T>(items_.begin(), items_.end());
+  }
+
+  /// Removes all the items in the deque.
+  void clear() {
+    std::lock_guard<std::mutex> guard{mutex_};
+    items_.clear();
+    size_.store(0, std::memory_order_release);
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::deque<T> items_;
+  std::atomic<int> size_{0};
+};
+
+}  // namespace dreal